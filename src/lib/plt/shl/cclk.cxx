@@ -37,6 +37,12 @@ namespace afnix {
     t_octa result = (((t_octa) ts.tv_sec) << 32) | (t_octa) ts.tv_nsec;
     return result;
   }
+  // this procedure returns a monotonic time in microseconds
+  static t_long cclk_get_tmus (void) {
+    struct timespec ts;
+    if (clock_gettime (CLOCK_MONOTONIC, &ts) == -1) return 0LL;
+    return ((t_long) ts.tv_sec) * 1000000LL + (t_long) (ts.tv_nsec / 1000);
+  }
 }
 #else
 namespace afnix {
@@ -53,6 +59,12 @@ namespace afnix {
     t_octa result = (((t_octa) tval.tv_sec) << 32) | (t_octa) tval.tv_usec;
     return result;
   }
+  // this procedure returns a monotonic time in microseconds
+  static t_long cclk_get_tmus (void) {
+    struct timeval tval;
+    if (gettimeofday (&tval, NULL) == -1) return 0LL;
+    return ((t_long) tval.tv_sec) * 1000000LL + (t_long) tval.tv_usec;
+  }
 }
 #endif  
 
@@ -121,4 +133,10 @@ namespace afnix {
     t_octa result = cclk_get_stamp ();
     return result;
   }
+
+  // return a monotonic time in microseconds
+
+  t_long c_tmus (void) {
+    return cclk_get_tmus ();
+  }
 }
@@ -51,6 +51,9 @@ namespace afnix {
 
   /// @return a machine time stamp
   t_octa c_stamp (void);
+
+  /// @return a monotonic time in microseconds
+  t_long c_tmus (void);
 }
 
 #endif
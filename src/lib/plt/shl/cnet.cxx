@@ -1181,6 +1181,42 @@ namespace afnix {
     return (status == -1) ? c_errmap (errno) : status;
   }
 
+  // receive data from a connected socket without blocking
+
+  long c_iprecvnb (const int sid, char* buf, long size) {
+    if (sid < 0) return AFNIX_ERR_IARG;
+    long status = recv (sid, buf, size, MSG_DONTWAIT);
+    if (status != -1) return status;
+    if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) return AFNIX_ERR_TOUT;
+    return c_errmap (errno);
+  }
+
+  // send a buffer set on a connected socket without blocking
+
+  long c_ipsendv (const int sid, const char** bufs, const long* blen,
+		  const long bnum) {
+    if ((sid < 0) || (bufs == nullptr) || (blen == nullptr) || (bnum <= 0)) {
+      return AFNIX_ERR_IARG;
+    }
+    // prepare the io vector
+    struct iovec* bvec = new struct iovec[bnum];
+    for (long k = 0; k < bnum; k++) {
+      bvec[k].iov_base = (void*) bufs[k];
+      bvec[k].iov_len  = blen[k];
+    }
+    struct msghdr mhdr;
+    mzero (&mhdr, sizeof (mhdr));
+    mhdr.msg_iov    = bvec;
+    mhdr.msg_iovlen = bnum;
+    // send the buffer set
+    long status = sendmsg (sid, &mhdr, MSG_DONTWAIT);
+    long errval = errno;
+    delete [] bvec;
+    if (status != -1) return status;
+    if ((errval == EAGAIN) || (errval == EWOULDBLOCK)) return AFNIX_ERR_TOUT;
+    return c_errmap (errval);
+  }
+
   // send a datagram by address and port
 
   long c_ipsendto (const int sid, t_word port, t_byte* dest, 
@@ -1233,7 +1269,7 @@ namespace afnix {
   bool c_ipshut (const int sid, const t_shut how) {
     bool status = false;
     if (sid == -1) return false;
-    switch (sid) {
+    switch (how) {
     case SHUT_BOTH:
       status = (shutdown (sid, 2) == 0) ? true : false;
       break;
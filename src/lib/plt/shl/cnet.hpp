@@ -244,6 +244,22 @@ namespace afnix {
   /// @param size the buffer size
   long c_iprecv (const int sid, char* buf, long size);
 
+  /// receive data from a socket without blocking
+  /// @param sid the client socket
+  /// @param buf the buffer to receive
+  /// @param size the buffer size
+  /// @return the received size or AFNIX_ERR_TOUT if nothing is available
+  long c_iprecvnb (const int sid, char* buf, long size);
+
+  /// send a buffer set to a socket without blocking
+  /// @param sid  the client socket
+  /// @param bufs the buffers to send
+  /// @param blen the buffers size
+  /// @param bnum the number of buffers
+  /// @return the sent size or AFNIX_ERR_TOUT if the socket is full
+  long c_ipsendv (const int sid, const char** bufs, const long* blen,
+		  const long bnum);
+
   /// receive a datagram on a port and update address
   /// @param sid  the client socket
   /// @param port the received port
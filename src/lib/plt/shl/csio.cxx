@@ -24,6 +24,207 @@
 
 namespace afnix {
 
+#ifdef AFNIX_HAVE_EPOLL
+  // the registration flags
+  static const t_byte SH_IREG = 0x01U; // input registered
+  static const t_byte SH_OREG = 0x02U; // output registered
+  static const t_byte SH_CTRL = 0x04U; // in the epoll set
+  static const t_byte SH_FREG = 0x08U; // always ready descriptor
+  // the default event buffer size
+  static const long   SH_ESIZ = 64L;
+
+  // the selector handle structure
+  struct s_select {
+    // the epoll descriptor
+    int     d_epfd;
+    // the marking event descriptor
+    int     d_mfid;
+    // the mark flag
+    bool    d_mflg;
+    // the edge triggered flag
+    bool    d_eflg;
+    // the wait epoch
+    t_long  d_epoc;
+    // the marking epoch
+    t_long  d_mepo;
+    // the registration size
+    long    d_rsiz;
+    // the registration flags
+    t_byte* p_rflg;
+    // the input ready epoch
+    t_long* p_iepo;
+    // the output ready epoch
+    t_long* p_oepo;
+    // the number of descriptors in the epoll set
+    long    d_ccnt;
+    // the event buffer size
+    long    d_esiz;
+    // the event buffer
+    struct epoll_event* p_evts;
+    // the always ready length
+    long    d_alen;
+    // the always ready descriptors
+    int*    p_asid;
+    // the ready length
+    long    d_rlen;
+    // the ready descriptors
+    int*    p_rsid;
+    // create a new handle by mode
+    s_select (const bool mflg) {
+      d_epfd = epoll_create1 (EPOLL_CLOEXEC);
+      d_mfid = -1;
+      d_mflg = false;
+      d_eflg = false;
+      d_epoc = 0LL;
+      d_mepo = -1LL;
+      d_rsiz = 0L;
+      p_rflg = nullptr;
+      p_iepo = nullptr;
+      p_oepo = nullptr;
+      d_ccnt = 0L;
+      d_esiz = SH_ESIZ;
+      p_evts = new struct epoll_event[d_esiz];
+      d_alen = 0L;
+      p_asid = nullptr;
+      d_rlen = 0L;
+      p_rsid = new int[d_esiz];
+      if ((mflg == true) && (d_epfd != -1)) {
+	d_mfid = eventfd (0, EFD_CLOEXEC | EFD_NONBLOCK);
+	struct epoll_event evt;
+	evt.events  = EPOLLIN;
+	evt.data.u64 = 0ULL;
+	evt.data.fd = d_mfid;
+	if ((d_mfid != -1) &&
+	    (epoll_ctl (d_epfd, EPOLL_CTL_ADD, d_mfid, &evt) == -1)) {
+	  close (d_mfid);
+	  d_mfid = -1;
+	}
+      }
+    }
+    // destroy this handle
+    ~s_select (void) {
+      if (d_mfid != -1) close (d_mfid);
+      if (d_epfd != -1) close (d_epfd);
+      delete [] p_rflg;
+      delete [] p_iepo;
+      delete [] p_oepo;
+      delete [] p_evts;
+      delete [] p_asid;
+      delete [] p_rsid;
+    }
+    // check if the marking mode is active
+    bool ismmod (void) const {
+      return (d_mfid != -1);
+    }
+    // check if a descriptor is registered
+    bool isreg (const int sid) const {
+      return (sid < d_rsiz) && ((p_rflg[sid] & (SH_IREG | SH_OREG)) != 0);
+    }
+    // resize the registration arrays for a descriptor
+    void resize (const int sid) {
+      if (sid < d_rsiz) return;
+      long size = (d_rsiz == 0L) ? SH_ESIZ : d_rsiz;
+      while (size <= sid) size *= 2L;
+      t_byte* rflg = new t_byte[size];
+      t_long* iepo = new t_long[size];
+      t_long* oepo = new t_long[size];
+      int*    asid = new int[size];
+      for (long k = 0L; k < size; k++) {
+	rflg[k] = (k < d_rsiz) ? p_rflg[k] : 0x00U;
+	iepo[k] = (k < d_rsiz) ? p_iepo[k] : -1LL;
+	oepo[k] = (k < d_rsiz) ? p_oepo[k] : -1LL;
+      }
+      for (long k = 0L; k < d_alen; k++) asid[k] = p_asid[k];
+      delete [] p_rflg; p_rflg = rflg;
+      delete [] p_iepo; p_iepo = iepo;
+      delete [] p_oepo; p_oepo = oepo;
+      delete [] p_asid; p_asid = asid;
+      d_rsiz = size;
+    }
+    // resize the event buffer with the registered descriptors
+    void evsize (void) {
+      long size = d_esiz;
+      while (size < d_ccnt + d_alen + 1L) size *= 2L;
+      if (size == d_esiz) return;
+      delete [] p_evts; p_evts = new struct epoll_event[size];
+      delete [] p_rsid; p_rsid = new int[size];
+      d_esiz = size;
+    }
+    // clear the always ready state of a descriptor which is added again
+    // since a closed descriptor might have been reused
+    void unfreg (const int sid) {
+      if ((p_rflg[sid] & SH_FREG) == 0) return;
+      for (long k = 0L; k < d_alen; k++) {
+	if (p_asid[k] != sid) continue;
+	p_asid[k] = p_asid[--d_alen];
+	break;
+      }
+      p_rflg[sid] &= ~SH_FREG;
+    }
+    // update a descriptor registration
+    void update (const int sid) {
+      t_byte flg = p_rflg[sid];
+      // check for an always ready descriptor
+      if ((flg & SH_FREG) != 0) {
+	if ((flg & (SH_IREG | SH_OREG)) != 0) return;
+	for (long k = 0L; k < d_alen; k++) {
+	  if (p_asid[k] != sid) continue;
+	  p_asid[k] = p_asid[--d_alen];
+	  break;
+	}
+	p_rflg[sid] = 0x00U;
+	return;
+      }
+      // check for a removed descriptor
+      if ((flg & (SH_IREG | SH_OREG)) == 0) {
+	if ((flg & SH_CTRL) != 0) {
+	  epoll_ctl (d_epfd, EPOLL_CTL_DEL, sid, nullptr);
+	  d_ccnt--;
+	}
+	p_rflg[sid] = 0x00U;
+	return;
+      }
+      // prepare the event
+      struct epoll_event evt;
+      evt.events = 0U;
+      if ((flg & SH_IREG) != 0) evt.events |= EPOLLIN;
+      if ((flg & SH_OREG) != 0) evt.events |= EPOLLOUT;
+      if (d_eflg == true) evt.events |= EPOLLET;
+      evt.data.u64 = 0ULL;
+      evt.data.fd = sid;
+      // modify a controlled descriptor - a closed one is added again
+      if ((flg & SH_CTRL) != 0) {
+	if (epoll_ctl (d_epfd, EPOLL_CTL_MOD, sid, &evt) == 0) return;
+	if (errno != ENOENT) return;
+	p_rflg[sid] &= ~SH_CTRL;
+	d_ccnt--;
+      }
+      // add the descriptor - regular files are always ready
+      if (epoll_ctl (d_epfd, EPOLL_CTL_ADD, sid, &evt) == 0) {
+	p_rflg[sid] |= SH_CTRL;
+	d_ccnt++;
+      } else if (errno == EPERM) {
+	p_rflg[sid] |= SH_FREG;
+	p_asid[d_alen++] = sid;
+      }
+      evsize ();
+    }
+    // mark a descriptor as ready
+    void setrdy (const int sid, const bool iflg, const bool oflg) {
+      t_byte flg = p_rflg[sid];
+      bool   rdy = false;
+      if ((iflg == true) && ((flg & SH_IREG) != 0)) {
+	p_iepo[sid] = d_epoc;
+	rdy = true;
+      }
+      if ((oflg == true) && ((flg & SH_OREG) != 0)) {
+	p_oepo[sid] = d_epoc;
+	rdy = true;
+      }
+      if (rdy == true) p_rsid[d_rlen++] = sid;
+    }
+  };
+#else
   // the selector handle structure
   struct s_select {
     // input reference set
@@ -40,6 +241,10 @@ namespace afnix {
     bool   d_mflg;
     // the pipe sid
     int    d_psid[2];
+    // the ready length
+    long   d_rlen;
+    // the ready descriptors
+    int    d_rsid[FD_SETSIZE];
     // create a new handle by mode
     s_select (const bool mflg) {
       FD_ZERO (&d_irfd);
@@ -50,6 +255,7 @@ namespace afnix {
       d_mflg = false;
       d_psid[0] = -1;
       d_psid[1] = -1;
+      d_rlen = 0L;
       if ((mflg == true) && (pipe (d_psid) == -1)) {
 	d_psid[0] = -1;
 	d_psid[1] = -1;
@@ -75,7 +281,18 @@ namespace afnix {
 	if (FD_ISSET (i, &d_orfd) != 0) FD_SET (i, &d_osfd);
       }
     }
+    // collect the ready descriptors
+    void fdrlst (void) {
+      d_rlen = 0L;
+      for (int i = 0; i <= d_smax; i++) {
+	if (i == d_psid[0]) continue;
+	if ((FD_ISSET (i, &d_isfd) != 0) || (FD_ISSET (i, &d_osfd) != 0)) {
+	  d_rsid[d_rlen++] = i;
+	}
+      }
+    }
   };
+#endif
 
   // return the default input stream associated with this process
 
@@ -318,6 +535,14 @@ namespace afnix {
     return true;
   }
 
+  // get a file current position
+
+  t_long c_ftell (const int sid) {
+    off_t status = lseek (sid, 0, SEEK_CUR);
+    if (status == (off_t) -1) return AFNIX_ERR_IARG;
+    return status;
+  }
+
   // lock completly a file
 
   bool c_flock (const int sid, const bool wlk) {
@@ -365,6 +590,191 @@ namespace afnix {
     return (unlink (name) == 0) ? true : false;
   }
 
+#ifdef AFNIX_HAVE_EPOLL
+  // create a new selector handle
+
+  void* c_shnew (const bool mflg) {
+    return new s_select (mflg);
+  }
+
+  // free a selector handle
+
+  void c_shfree (void* handle) {
+    s_select* sh = (s_select*) handle;
+    delete sh;
+  }
+
+  // add an input descriptor to the select handle - the descriptor is
+  // always updated since a closed descriptor is silently removed from
+  // the epoll set and its number might have been reused
+
+  void c_shiadd (void* handle, const int sid) {
+    if ((handle == nullptr) || (sid < 0)) return;
+    s_select* sh = (s_select*) handle;
+    sh->resize (sid);
+    sh->p_rflg[sid] |= SH_IREG;
+    sh->unfreg (sid);
+    sh->update (sid);
+  }
+
+  // add an output descriptor to the select handle
+
+  void c_shoadd (void* handle, const int sid) {
+    if ((handle == nullptr) || (sid < 0)) return;
+    s_select* sh = (s_select*) handle;
+    sh->resize (sid);
+    sh->p_rflg[sid] |= SH_OREG;
+    sh->unfreg (sid);
+    sh->update (sid);
+  }
+
+  // remove an input descriptor from the select handle
+
+  void c_shirmv (void* handle, const int sid) {
+    if ((handle == nullptr) || (sid < 0)) return;
+    s_select* sh = (s_select*) handle;
+    if (sh->isreg (sid) == false) return;
+    if ((sh->p_rflg[sid] & SH_IREG) == 0) return;
+    sh->p_rflg[sid] &= ~SH_IREG;
+    sh->p_iepo[sid] = -1LL;
+    sh->update (sid);
+  }
+
+  // remove an output descriptor from the select handle
+
+  void c_shormv (void* handle, const int sid) {
+    if ((handle == nullptr) || (sid < 0)) return;
+    s_select* sh = (s_select*) handle;
+    if (sh->isreg (sid) == false) return;
+    if ((sh->p_rflg[sid] & SH_OREG) == 0) return;
+    sh->p_rflg[sid] &= ~SH_OREG;
+    sh->p_oepo[sid] = -1LL;
+    sh->update (sid);
+  }
+
+  // set the selector edge triggered mode
+
+  bool c_shsete (void* handle, const bool eflg) {
+    if (handle == nullptr) return false;
+    s_select* sh = (s_select*) handle;
+    if (sh->d_eflg == eflg) return true;
+    sh->d_eflg = eflg;
+    // update the registered descriptors
+    for (long k = 0L; k < sh->d_rsiz; k++) {
+      if ((sh->p_rflg[k] & SH_CTRL) != 0) sh->update ((int) k);
+    }
+    return true;
+  }
+
+  // wait for a descriptor to be ready
+
+  long c_shwait (void* handle, const long tout) {
+    // check for valid call
+    if (handle == nullptr) return 0;
+    s_select* sh = (s_select*) handle;
+    // start a new epoch
+    sh->d_epoc++;
+    sh->d_rlen = 0L;
+    // always ready descriptors do not block
+    int tmo = (tout < 0) ? -1 : (int) tout;
+    if (sh->d_alen > 0L) tmo = 0;
+    // now call epoll
+    int result = epoll_wait (sh->d_epfd, sh->p_evts, sh->d_esiz, tmo);
+    // check for error and remap
+    if (result == -1) return c_errmap (errno);
+    // collect the ready descriptors
+    for (int k = 0; k < result; k++) {
+      int      sid = sh->p_evts[k].data.fd;
+      t_quad   evt = sh->p_evts[k].events;
+      if (sid == sh->d_mfid) {
+	sh->d_mepo = sh->d_epoc;
+	continue;
+      }
+      if (sh->isreg (sid) == false) continue;
+      bool iflg = (evt & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0;
+      bool oflg = (evt & (EPOLLOUT | EPOLLHUP | EPOLLERR)) != 0;
+      sh->setrdy (sid, iflg, oflg);
+    }
+    // add the always ready descriptors
+    for (long k = 0L; k < sh->d_alen; k++) {
+      sh->setrdy (sh->p_asid[k], true, true);
+    }
+    return (sh->d_mepo == sh->d_epoc) ? sh->d_rlen + 1L : sh->d_rlen;
+  }
+
+  // mark a selector if possible
+
+  void c_shmark (void* handle) {
+    // check valid handle
+    if (handle == nullptr) return;
+    s_select* sh = (s_select*) handle;
+    // check for marking mode
+    if (sh->ismmod () == false) return;
+    // check for marking set
+    if (sh->d_mflg == true) return;
+    // signal the event descriptor
+    t_octa ectr = 1ULL;
+    if (write (sh->d_mfid, &ectr, sizeof (ectr)) == sizeof (ectr)) {
+      sh->d_mflg = true;
+    }
+  }
+
+  // return true if a marking descriptor is set
+
+  bool c_shmtst (void* handle) {
+    // check valid handle
+    if (handle == nullptr) return false;
+    s_select* sh = (s_select*) handle;
+    // check for marking mode
+    if (sh->ismmod () == false) return false;
+    // check for marking set
+    if (sh->d_mflg == false) return false;
+    // check the selector
+    if (sh->d_mepo != sh->d_epoc) return false;
+    // reset the event counter
+    t_octa ectr = 0ULL;
+    bool result = (read (sh->d_mfid, &ectr, sizeof (ectr)) == sizeof (ectr));
+    sh->d_mflg = false;
+    return result;
+  }
+
+  // return true if an input descriptor is set
+
+  bool c_shitst (void* handle, const int sid) {
+    // check for valid call
+    if ((handle == nullptr) || (sid < 0)) return false;
+    s_select* sh = (s_select*) handle;
+    if (sid >= sh->d_rsiz) return false;
+    return (sh->p_iepo[sid] == sh->d_epoc);
+  }
+
+  // return true if an output descriptor is set
+
+  bool c_shotst (void* handle, const int sid) {
+    // check for valid call
+    if ((handle == nullptr) || (sid < 0)) return false;
+    s_select* sh = (s_select*) handle;
+    if (sid >= sh->d_rsiz) return false;
+    return (sh->p_oepo[sid] == sh->d_epoc);
+  }
+
+  // return the number of ready descriptors
+
+  long c_shrlen (void* handle) {
+    if (handle == nullptr) return 0L;
+    s_select* sh = (s_select*) handle;
+    return sh->d_rlen;
+  }
+
+  // return a ready descriptor by index
+
+  int c_shrsid (void* handle, const long index) {
+    if (handle == nullptr) return -1;
+    s_select* sh = (s_select*) handle;
+    if ((index < 0L) || (index >= sh->d_rlen)) return -1;
+    return sh->p_rsid[index];
+  }
+#else
   // create a new selector handle
 
   void* c_shnew (const bool mflg) {
@@ -387,7 +797,7 @@ namespace afnix {
   // add an input descriptor to the select handle
 
   void c_shiadd (void* handle, const int sid) {
-    if ((handle == nullptr) || (sid < 0)) return;
+    if ((handle == nullptr) || (sid < 0) || (sid >= FD_SETSIZE)) return;
     s_select* sh = (s_select*) handle;
     FD_SET (sid, &(sh->d_irfd));
     if (sid > sh->d_smax) sh->d_smax = sid;
@@ -396,12 +806,34 @@ namespace afnix {
   // add an output descriptor to the select handle
 
   void c_shoadd (void* handle, const int sid) {
-    if ((handle == nullptr) || (sid < 0)) return;
+    if ((handle == nullptr) || (sid < 0) || (sid >= FD_SETSIZE)) return;
     s_select* sh = (s_select*) handle;
     FD_SET (sid, &(sh->d_orfd));
     if (sid > sh->d_smax) sh->d_smax = sid;
   }
 
+  // remove an input descriptor from the select handle
+
+  void c_shirmv (void* handle, const int sid) {
+    if ((handle == nullptr) || (sid < 0) || (sid >= FD_SETSIZE)) return;
+    s_select* sh = (s_select*) handle;
+    FD_CLR (sid, &(sh->d_irfd));
+  }
+
+  // remove an output descriptor from the select handle
+
+  void c_shormv (void* handle, const int sid) {
+    if ((handle == nullptr) || (sid < 0) || (sid >= FD_SETSIZE)) return;
+    s_select* sh = (s_select*) handle;
+    FD_CLR (sid, &(sh->d_orfd));
+  }
+
+  // set the selector edge triggered mode
+
+  bool c_shsete (void* handle, const bool eflg) {
+    return (handle != nullptr) && (eflg == false);
+  }
+
   // wait for a descriptor to be ready
 
   long c_shwait (void* handle, const long tout) {
@@ -423,7 +855,9 @@ namespace afnix {
       result = select (nsh, &(sh->d_isfd), &(sh->d_osfd), NULL, &timeout);
     }
     // check for error and remap
-    if (result == -1) result = c_errmap (errno);
+    if (result == -1) return c_errmap (errno);
+    // collect the ready descriptors
+    sh->fdrlst ();
     return result;
   }
 
@@ -469,7 +903,9 @@ namespace afnix {
 
   bool c_shitst (void* handle, const int sid) {
     // check for valid call
-    if ((handle == nullptr) || (sid < 0)) return false;
+    if ((handle == nullptr) || (sid < 0) || (sid >= FD_SETSIZE)) {
+      return false;
+    }
     s_select* sh = (s_select*) handle;
     return (FD_ISSET (sid, &(sh->d_isfd)) == 0) ? false : true;
   }
@@ -478,8 +914,28 @@ namespace afnix {
 
   bool c_shotst (void* handle, const int sid) {
     // check for valid call
-    if ((handle == nullptr) || (sid < 0)) return false;
+    if ((handle == nullptr) || (sid < 0) || (sid >= FD_SETSIZE)) {
+      return false;
+    }
     s_select* sh = (s_select*) handle;
     return (FD_ISSET (sid, &(sh->d_osfd)) == 0) ? false : true;
   }
+
+  // return the number of ready descriptors
+
+  long c_shrlen (void* handle) {
+    if (handle == nullptr) return 0L;
+    s_select* sh = (s_select*) handle;
+    return sh->d_rlen;
+  }
+
+  // return a ready descriptor by index
+
+  int c_shrsid (void* handle, const long index) {
+    if (handle == nullptr) return -1;
+    s_select* sh = (s_select*) handle;
+    if ((index < 0L) || (index >= sh->d_rlen)) return -1;
+    return sh->d_rsid[index];
+  }
+#endif
 }
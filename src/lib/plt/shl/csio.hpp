@@ -134,6 +134,11 @@ namespace afnix {
   /// @return true on success
   bool c_lseek (const int sid, const t_long pos);
 
+  /// get a file current position
+  /// @param  sid the file id
+  /// @return the file position or -1 in case of error
+  t_long c_ftell (const int sid);
+
   /// lock completly a file or wait
   /// @param sid the file id to lock
   /// @param wlk flag for lock in reading or writing
@@ -172,6 +177,22 @@ namespace afnix {
   /// @param sid the descriptor to add
   void c_shoadd (void* handle, const int sid);
 
+  /// remove an input descriptor from the select handle
+  /// @param handle the selector handle
+  /// @param sid the descriptor to remove
+  void c_shirmv (void* handle, const int sid);
+
+  /// remove an output descriptor from the select handle
+  /// @param handle the selector handle
+  /// @param sid the descriptor to remove
+  void c_shormv (void* handle, const int sid);
+
+  /// set the selector edge triggered mode
+  /// @param handle the selector handle
+  /// @param eflg the edge triggered flag
+  /// @return true if the mode is supported
+  bool c_shsete (void* handle, const bool eflg);
+
   /// wait for a descriptor to be ready
   /// @param handle the selector handle
   /// @param tout the timeout in milliseconds
@@ -194,6 +215,15 @@ namespace afnix {
   /// @param handle the selector handle
   /// @param sid the descriptor to test
   bool c_shotst (void* handle, const int sid);
+
+  /// @return the number of ready descriptors after a wait
+  /// @param handle the selector handle
+  long c_shrlen (void* handle);
+
+  /// @return a ready descriptor by index
+  /// @param handle the selector handle
+  /// @param index the ready descriptor index
+  int c_shrsid (void* handle, const long index);
 }
 
 #endif
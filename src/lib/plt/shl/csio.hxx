@@ -34,6 +34,8 @@
 #define _LARGEFILE_SOURCE
 #endif
 #include <sys/select.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
@@ -41,6 +43,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <errno.h>
+#define AFNIX_HAVE_EPOLL
 #endif
 
 // solaris platform
@@ -394,6 +394,28 @@ namespace afnix {
     pthread_join (tsko->d_tid, nullptr);
   }
 
+  // run a set of tasks and wait for their completion
+
+  void c_tskrun (t_tskf func, void** args, const long tnum) {
+    // check for nil
+    if ((func == nullptr) || (args == nullptr) || (tnum <= 0L)) return;
+    // start the secondary tasks
+    void** ptsk = new void*[tnum];
+    ptsk[0] = nullptr;
+    for (long t = 1L; t < tnum; t++) ptsk[t] = c_tsknew (func, args[t]);
+    // run the first task and those without a thread
+    func (args[0]);
+    for (long t = 1L; t < tnum; t++) {
+      if (ptsk[t] == nullptr) func (args[t]);
+    }
+    // wait for the tasks
+    for (long t = 1L; t < tnum; t++) {
+      c_tskwait (ptsk[t]);
+      c_tskdel  (ptsk[t]);
+    }
+    delete [] ptsk;
+  }
+
   // -------------------------------------------------------------------------
   // - thread section                                                        -
   // -------------------------------------------------------------------------
@@ -732,7 +754,7 @@ namespace afnix {
   void c_tcvbdcast (void* tcv) {
     if (tcv == nullptr) return;
     pthread_cond_t* condv = (pthread_cond_t*) tcv;
-    pthread_cond_signal (condv);
+    pthread_cond_broadcast (condv);
   }
 
   // -------------------------------------------------------------------------
@@ -54,6 +54,14 @@ namespace afnix {
   /// wait for a task to complete
   /// @param ptsk the task pointer
   void c_tskwait (void* ptsk);
+
+  /// run a set of tasks and wait for their completion - the first task
+  /// runs in the calling thread as well as the tasks which cannot be
+  /// started, and the task function is not expected to throw
+  /// @param func the function to execute
+  /// @param args the task arguments array
+  /// @param tnum the number of tasks
+  void c_tskrun (t_tskf func, void** args, const long tnum);
   
   // -------------------------------------------------------------------------
   // - thread section                                                        -
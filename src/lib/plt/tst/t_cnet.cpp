@@ -15,6 +15,7 @@
 // ---------------------------------------------------------------------------
 
 #include "cnet.hpp"
+#include "csio.hpp"
 #include "cstr.hpp"
 
 // IPV4 loopback address
@@ -76,7 +77,28 @@ int main (int, char**) {
   const t_byte MADDR[] = {0x04, 0xFF, 0xFF, 0xFF, 0xFF};
   addr = c_nxaddr (MADDR);
   if (c_eqaddr (addr, ZADDR) == false) return 1;
-  // clean and return
+  // clean the address
   delete [] addr;
+
+  // check that a reused descriptor is selected again
+  t_byte LADDR[] = {0x04, 0x7F, 0x00, 0x00, 0x01};
+  void* sh  = c_shnew (false);
+  int  usid = c_ipsockudp (IAPF_IPV4);
+  if (usid < 0) return 1;
+  c_shiadd (sh, usid);
+  c_close (usid);
+  int  rsid = c_ipsockudp (IAPF_IPV4);
+  if (rsid < 0) return 1;
+  if (rsid == usid) {
+    if (c_ipbind (rsid, 0, LADDR) == false) return 1;
+    t_word port = c_ipsockport (rsid);
+    if (c_ipsendto (rsid, port, LADDR, "x", 1) != 1) return 1;
+    c_shiadd (sh, rsid);
+    if (c_shwait (sh, 1000) < 1) return 1;
+    if (c_shitst (sh, rsid) == false) return 1;
+  }
+  // clean and return
+  c_close (rsid);
+  c_shfree (sh);
   return 0;
 }
@@ -32,6 +32,13 @@ static void* tsk_test (void* args) {
   return nullptr;
 }
 
+// this procedure is run in a task set
+static void* tsk_runs (void* args) {
+  auto ival = reinterpret_cast<int*> (args);
+  if (ival != nullptr) *ival = *ival + 1;
+  return nullptr;
+}
+
 // this procedure is ran in a thread and check for its self equality
 static void* thr_test (void* args) {
   using namespace afnix;
@@ -76,6 +83,12 @@ int main (int, char**) {
   if (status != ival) return -1;
   c_tskdel (ptsk);
 
+  // run a task set
+  int  ivec[4] = {0, 1, 2, 3};
+  void* args[4] = {&ivec[0], &ivec[1], &ivec[2], &ivec[3]};
+  c_tskrun (tsk_runs, args, 4L);
+  for (int i = 0; i < 4; i++) if (ivec[i] != i + 1) return -1;
+
   // with no thread - check that getting self still work
   void* thr = c_thrself ();
   if (thr != 0) return -1;
@@ -92,6 +92,24 @@ namespace afnix {
     } 
   }
 
+  // add a character buffer to this block buffer
+
+  long BlockBuffer::add (const char* cbuf, const long size) {
+    wrlock ();
+    try {
+      // add the character buffer
+      long result = Buffer::add (cbuf, size);
+      // update the write counter
+      d_wcnt += result;
+      // unlock and return
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    } 
+  }
+
   // get the next available character
 
   char BlockBuffer::read (void) {
@@ -163,7 +181,7 @@ namespace afnix {
       // reset the buffer in bound mode
       if (full () == true) Buffer::reset ();
       // add the buffer data
-      long result = Buffer::add (data, size);
+      long result = add (data, size);
       // unlock and return
       unlock ();
       return result;
@@ -228,6 +246,7 @@ namespace afnix {
       // copy directly the block
       if (empty () == true ) {
 	// copy directly by block
+	unshare ();
 	result = is.copy (p_data, d_size);
 	// update indexes
 	d_blen  = result;
@@ -67,6 +67,11 @@ namespace afnix {
     /// @param value the character to add
     long add (const char value) override;
 
+    /// add a character buffer to this block buffer
+    /// @param cbuf the character buffer to add
+    /// @param size the character buffer size
+    long add (const char* cbuf, const long size) override;
+
     /// @return the next available character
     char read (void) override;
 
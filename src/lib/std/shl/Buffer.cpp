@@ -17,18 +17,21 @@
 #include "Byte.hpp"
 #include "Ascii.hpp"
 #include "Stdsid.hxx"
+#include "Mutex.hpp"
 #include "Vector.hpp"
 #include "Buffer.hpp"
 #include "System.hpp"
 #include "Utility.hpp"
 #include "Unicode.hpp"
 #include "Integer.hpp"
+#include "Monitor.hpp"
 #include "Boolean.hpp"
 #include "QuarkZone.hpp"
 #include "Exception.hpp"
 #include "InputStream.hpp"
 #include "OutputStream.hpp"
 #include "ccnv.hpp"
+#include "cmem.hpp"
 
 namespace afnix {
 
@@ -38,6 +41,64 @@ namespace afnix {
 
   // the buffer serialization array size
   static const long BUF_ARRY_SIZE = 8192L;
+
+  // the shared storage structure
+  struct s_bsto {
+    // the storage data
+    char*   p_data;
+    // the reference count
+    long    d_rcnt;
+    // the reference count monitor
+    Monitor d_rmon;
+    // create a storage by data
+    s_bsto (char* data) {
+      p_data = data;
+      d_rcnt = 1L;
+    }
+    // destroy this storage
+    ~s_bsto (void) {
+      delete [] p_data;
+    }
+  };
+
+  // the storage creation mutex
+  static Mutex& bsto_mtx (void) {
+    static Mutex mtx;
+    return mtx;
+  }
+
+  // increment the storage reference count
+  static s_bsto* bsto_iref (s_bsto* bsto) {
+    bsto->d_rmon.enter ();
+    bsto->d_rcnt++;
+    bsto->d_rmon.leave ();
+    return bsto;
+  }
+
+  // decrement the storage reference count and clean
+  static void bsto_dref (s_bsto* bsto) {
+    if (bsto == nullptr) return;
+    bsto->d_rmon.enter ();
+    if (--bsto->d_rcnt > 0L) {
+      bsto->d_rmon.leave ();
+      return;
+    }
+    bsto->d_rmon.leave ();
+    delete bsto;
+  }
+
+  // release a single owned storage but keep the data
+  static bool bsto_take (s_bsto* bsto) {
+    bsto->d_rmon.enter ();
+    if (bsto->d_rcnt > 1L) {
+      bsto->d_rmon.leave ();
+      return false;
+    }
+    bsto->d_rmon.leave ();
+    bsto->p_data = nullptr;
+    delete bsto;
+    return true;
+  }
   
   // -------------------------------------------------------------------------
   // - public section                                                        -
@@ -74,6 +135,7 @@ namespace afnix {
     d_rflg = true;
     d_pflg = false;
     d_emod = Encoding::EMOD_BYTE;
+    p_bsto = nullptr;
   }
 
   // create a new buffer with a predefined size
@@ -86,6 +148,7 @@ namespace afnix {
     d_rflg = true;
     d_pflg = false;
     d_emod = Encoding::EMOD_BYTE;
+    p_bsto = nullptr;
   }
 
   // create a new buffer by mode
@@ -98,6 +161,7 @@ namespace afnix {
     d_rflg = true;
     d_pflg = false;
     d_emod = emod;
+    p_bsto = nullptr;
   }
 
   // create a new buffer by size with a mode
@@ -110,6 +174,7 @@ namespace afnix {
     d_rflg = true;
     d_pflg = false;
     d_emod = emod;
+    p_bsto = nullptr;
   }
 
   // create a new buffer and initialize it with a c string
@@ -122,6 +187,7 @@ namespace afnix {
     d_rflg = true;
     d_pflg = false;
     d_emod = Encoding::EMOD_UTF8;
+    p_bsto = nullptr;
     add (value, Ascii::strlen (value));
   }
 
@@ -135,6 +201,7 @@ namespace afnix {
     d_pflg = false;
     p_data = new char[d_size];
     d_emod = Encoding::EMOD_UTF8;
+    p_bsto = nullptr;
     add (value);
   }
 
@@ -148,6 +215,7 @@ namespace afnix {
     d_pflg = true;
     p_data = data;
     d_emod = Encoding::EMOD_BYTE;
+    p_bsto = nullptr;
   }
 
   // copy construct a buffer
@@ -161,8 +229,18 @@ namespace afnix {
       d_rflg = that.d_rflg;
       d_pflg = false;
       d_emod = that.d_emod;
-      p_data = new char[d_size];
-      add (that.p_data + that.d_ridx, that.d_blen);
+      p_bsto = nullptr;
+      if (that.d_pflg == false) {
+	// share the storage
+	p_bsto = that.mkshare ();
+	p_data = that.p_data;
+	d_blen = that.d_blen;
+	d_ridx = that.d_ridx;
+      } else {
+	// copy the unprotected data
+	p_data = new char[d_size];
+	add (that.p_data + that.d_ridx, that.d_blen);
+      }
       that.unlock ();
     } catch (...) {
       that.unlock ();
@@ -185,6 +263,7 @@ namespace afnix {
       d_pflg = that.d_pflg; that.d_pflg = false;
       p_data = that.p_data; that.p_data = nullptr;
       d_emod = that.d_emod; that.d_emod = Encoding::EMOD_BYTE;
+      p_bsto = that.p_bsto; that.p_bsto = nullptr;
     } catch (...) {
       d_size = 0L;
       d_blen = 0L;
@@ -193,6 +272,7 @@ namespace afnix {
       d_pflg = false;
       p_data = nullptr;
       d_emod = Encoding::EMOD_BYTE;
+      p_bsto = nullptr;
     }
     that.unlock ();
   }
@@ -200,7 +280,11 @@ namespace afnix {
   // destroy this buffer
   
   Buffer::~Buffer (void) {
-    if (d_pflg == false) delete [] p_data;
+    if (p_bsto != nullptr) {
+      bsto_dref (p_bsto);
+    } else if (d_pflg == false) {
+      delete [] p_data;
+    }
   }
 
   // assign a buffer to this one
@@ -211,8 +295,13 @@ namespace afnix {
     that.rdlock ();
     try {
       // clean the old data
-      delete [] p_data;
+      if (p_bsto != nullptr) {
+	bsto_dref (p_bsto);
+      } else if (d_pflg == false) {
+	delete [] p_data;
+      }
       p_data = nullptr;
+      p_bsto = nullptr;
       d_blen = 0L;
       d_ridx = 0L;
       // add the new data
@@ -220,8 +309,17 @@ namespace afnix {
       d_rflg = that.d_rflg;
       d_pflg = false;
       d_emod = that.d_emod;
-      p_data = new char[d_size];
-      add (that.p_data + that.d_ridx, that.d_blen);
+      if (that.d_pflg == false) {
+	// share the storage
+	p_bsto = that.mkshare ();
+	p_data = that.p_data;
+	d_blen = that.d_blen;
+	d_ridx = that.d_ridx;
+      } else {
+	// copy the unprotected data
+	p_data = new char[d_size];
+	add (that.p_data + that.d_ridx, that.d_blen);
+      }
       unlock ();
       that.unlock ();
       return *this;
@@ -242,7 +340,11 @@ namespace afnix {
     that.wrlock ();
     try {
       // clean locally
-      delete [] p_data;
+      if (p_bsto != nullptr) {
+	bsto_dref (p_bsto);
+      } else if (d_pflg == false) {
+	delete [] p_data;
+      }
       // move base viewable
       Viewable::operator = (static_cast<Viewable&&>(that));
       // move locally
@@ -253,6 +355,7 @@ namespace afnix {
       d_pflg = that.d_pflg; that.d_pflg = false;
       p_data = that.p_data; that.p_data = nullptr;
       d_emod = that.d_emod; that.d_emod = Encoding::EMOD_BYTE;
+      p_bsto = that.p_bsto; that.p_bsto = nullptr;
     } catch (...) {
       d_size = 0L;
       d_blen = 0L;
@@ -261,6 +364,7 @@ namespace afnix {
       d_pflg = false;
       p_data = nullptr;
       d_emod = Encoding::EMOD_BYTE;
+      p_bsto = nullptr;
     }
     unlock ();
     that.unlock ();
@@ -317,6 +421,8 @@ namespace afnix {
       if (d_blen != that.d_blen) {
 	throw Exception ("buffer-error", "inconsistent length with xor");
       }
+      // make the storage private
+      unshare ();
       // xor in the target buffer
       for (long k = 0L; k < d_blen; k++) {
 	p_data[k + d_ridx] ^= that.p_data[k + that.d_ridx];
@@ -402,6 +508,13 @@ namespace afnix {
       d_emod = Encoding::toemod ((t_byte) is.read ());
       // check for data
       if (Serial::rdbool (is) == true) {
+	if (p_bsto != nullptr) {
+	  bsto_dref (p_bsto);
+	} else if (d_pflg == false) {
+	  delete [] p_data;
+	}
+	p_bsto = nullptr;
+	d_pflg = false;
         p_data = new char[d_size];
         for (long i = 0L; i < d_blen; i++) {
           Array arry = Serial::rdarry (is);
@@ -439,6 +552,7 @@ namespace afnix {
   t_byte* Buffer::tobyte (void) {
     wrlock ();
     try {
+      unshare ();
       auto result = reinterpret_cast<t_byte*>(p_data + d_ridx);
       unlock ();
       return result;
@@ -591,6 +705,8 @@ namespace afnix {
   long Buffer::add (const char value) {
     wrlock ();
     try {
+      // make the storage private
+      unshare ();
       // check if we normalize
       if (d_ridx >= (d_size / 2)) normalize ();
       // first check if we are at the buffer end
@@ -733,11 +849,28 @@ namespace afnix {
     if ((cbuf == nullptr) || (size == 0)) return 0;
     wrlock ();
     try {
-      long result = 0L;
-      for (long k = 0L; k < size; k++) {
-	result += add (cbuf[k]);
-	if (full () == true) break;
+      // make the storage private
+      unshare ();
+      // check if we normalize
+      if ((d_ridx + d_blen + size) > d_size) {
+	if (d_blen == 0L) d_ridx = 0L; else normalize ();
+      }
+      // check if we resize
+      if (((d_blen + size) > d_size) && (d_rflg == true)) {
+	long bsiz = (d_size == 0L) ? size : d_size * 2;
+	while (bsiz < (d_blen + size)) bsiz *= 2;
+	char* buf = new char[bsiz];
+	c_memcpy (buf, d_blen, p_data + d_ridx);
+	delete [] p_data;
+	d_size = bsiz;
+	d_ridx = 0L;
+	p_data = buf;
       }
+      // copy the data block
+      long bavl = d_size - d_ridx - d_blen;
+      long result = (size < bavl) ? size : bavl;
+      if (result > 0L) c_memcpy (p_data + d_ridx + d_blen, result, cbuf);
+      d_blen += result;
       unlock ();
       return result;
     } catch (...) {
@@ -973,6 +1106,7 @@ namespace afnix {
       if ((index < 0L) || (index >= d_blen)) {
 	throw Exception ("range-error", "out-of-bound buffer index");
       }
+      unshare ();
       p_data[index + d_ridx] = value;
       unlock ();
     } catch (...) {
@@ -1010,8 +1144,8 @@ namespace afnix {
     try {
       // initialize result
       long blen = (size <= d_blen) ? size : d_blen;
-      // copy by loop
-      for (long k = 0L; k < blen; k++) rbuf[k] = p_data[k + d_ridx];
+      // copy the buffer content
+      c_memcpy (rbuf, blen, &p_data[d_ridx]);
       // adjust buffer content and size
       if (blen < d_blen) {
 	d_ridx += blen;
@@ -1043,6 +1177,15 @@ namespace afnix {
       if (size <= 0L) {
 	throw Exception ("buffer-error", "invalid buffer size to move");
       }
+      // move by slice
+      if ((size <= d_blen) && (d_pflg == false)) {
+	Buffer result = slice (0L, size);
+	d_ridx += size;
+	d_blen -= size;
+	if (d_blen == 0L) d_ridx = 0L;
+	unlock ();
+	return result;
+      }
       // initialize result
       long blen = (size <= d_blen) ? size : d_blen;
       // create target buffer and move
@@ -1076,6 +1219,8 @@ namespace afnix {
   void Buffer::shl (const long asl) {
     wrlock ();
     try {
+      // make the storage private
+      unshare ();
       // normalize the buffer
       normalize ();
       // check for amount
@@ -1110,6 +1255,8 @@ namespace afnix {
 	unlock ();
 	return false;
       }
+      // make the storage private
+      unshare ();
       // normalize the buffer
       normalize ();
       // check if we adjust to the size
@@ -1169,6 +1316,8 @@ namespace afnix {
   long Buffer::pushback (const char value) {
     wrlock ();
     try {
+      // make the storage private
+      unshare ();
       // check if we are full
       if (((d_blen + d_ridx) >= d_size) && (d_ridx == 0L)) {
 	if (d_rflg == true) {
@@ -1243,6 +1392,32 @@ namespace afnix {
     if ((s == nullptr) || (size == 0)) return 0;
     wrlock ();
     try {
+      // make the storage private
+      unshare ();
+      // check if the block fits before the read index
+      if (d_ridx >= size) {
+	d_ridx -= size;
+	c_memcpy (p_data + d_ridx, size, s);
+	d_blen += size;
+	unlock ();
+	return size;
+      }
+      // check if we resize
+      if (d_rflg == true) {
+	long bsiz = (d_size == 0L) ? d_blen + size : d_size;
+	while (bsiz < (d_blen + size)) bsiz *= 2;
+	char* buf = new char[bsiz];
+	c_memcpy (buf, size, s);
+	if (d_blen > 0L) c_memcpy (buf + size, d_blen, p_data + d_ridx);
+	delete [] p_data;
+	d_size = bsiz;
+	d_ridx = 0L;
+	d_blen += size;
+	p_data = buf;
+	unlock ();
+	return size;
+      }
+      // pushback by byte until full
       long    len = size - 1L;
       long result = 0L;
       for (long k = len; k >= 0; k--) {
@@ -1308,6 +1483,13 @@ namespace afnix {
       if (size <= 0L) {
 	throw Exception ("buffer-error", "invalid size in collect");
       }
+      // collect by slice
+      if ((size <= d_blen) && (d_pflg == false)) {
+	Buffer result = slice (d_blen - size, size);
+	d_blen -= size;
+	unlock ();
+	return result;
+      }
       // compute collect length
       long blen = (size <= d_blen) ? size : d_blen;
       // create a result buffer by size
@@ -1341,6 +1523,12 @@ namespace afnix {
       if ((size <= 0L) || (boff < 0L)) {
 	throw Exception ("buffer-error", "invalid size/offset in extract");
       }
+      // extract by slice
+      if (((boff + size) <= d_blen) && (d_pflg == false)) {
+	Buffer result = slice (boff, size);
+	unlock ();
+	return result;
+      }
       // compute copy length
       long blen = (size <= (d_blen - boff)) ? size : (d_blen - boff);
       // create a result buffer by size
@@ -1363,13 +1551,68 @@ namespace afnix {
     }
   }
   
+  // get a buffer view which shares this buffer storage
+
+  Buffer Buffer::slice (const long boff, const long size) const {
+    rdlock ();
+    try {
+      // check for valid arguments
+      if ((boff < 0L) || (size < 0L) || ((boff + size) > d_blen)) {
+	throw Exception ("buffer-error", "invalid size/offset in slice");
+      }
+      // create the buffer view
+      Buffer result (0L, 0L, nullptr);
+      result.d_rflg = true;
+      result.d_emod = d_emod;
+      if (d_pflg == false) {
+	// share the storage
+	result.d_pflg = false;
+	result.d_size = d_size;
+	result.d_ridx = d_ridx + boff;
+	result.d_blen = size;
+	result.p_bsto = mkshare ();
+	result.p_data = p_data;
+      } else {
+	// copy the unprotected data
+	result.d_pflg = false;
+	result.d_size = (size == 0L) ? 1L : size;
+	result.p_data = new char[result.d_size];
+	result.add (p_data + d_ridx + boff, size);
+      }
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // return true if the buffer storage is shared
+
+  bool Buffer::isshared (void) const {
+    rdlock ();
+    try {
+      bool result = false;
+      if (p_bsto != nullptr) {
+	p_bsto->d_rmon.enter ();
+	result = (p_bsto->d_rcnt > 1L);
+	p_bsto->d_rmon.leave ();
+      }
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // return the buffer content
 
   char* Buffer::tochar (void) const {
     rdlock ();
     try {
       char* result = (d_blen == 0L) ? nullptr : new char[d_blen];
-      for (long k = 0L; k < d_blen; k++) result[k] = p_data[k];
+      for (long k = 0L; k < d_blen; k++) result[k] = p_data[k + d_ridx];
       unlock ();
       return result;
     } catch (...) {
@@ -1417,7 +1660,7 @@ namespace afnix {
     rdlock ();
     try {
       // format the string
-      String result = Ascii::btos ((const t_byte*) p_data, d_blen);
+      String result = Ascii::btos ((const t_byte*) p_data + d_ridx, d_blen);
       unlock ();
       return result;
     } catch (...) {
@@ -1457,20 +1700,18 @@ namespace afnix {
     char* cbuf = Unicode::encode (Encoding::EMOD_UTF8, bnds);
     long  clen = Ascii::strlen (cbuf);
     try {
-      // normalize the buffer
-      normalize ();
       // reset matching flag
       bool mflg = false;
       long mpos = 0;
       // loop into the buffer
       for (mpos = 0; mpos < d_blen; mpos++) {
 	// check for matching
-	if (p_data[mpos] != cbuf[0]) continue;
+	if (p_data[d_ridx + mpos] != cbuf[0]) continue;
 	// try to match
 	mflg = true;
 	for (long l = 0; l < clen; l++) {
 	  long j = mpos + l;
-	  if ((j >= d_blen) || (p_data[j] != cbuf[l])) {
+	  if ((j >= d_blen) || (p_data[d_ridx + j] != cbuf[l])) {
 	    mflg = false;
 	    break;
 	  }
@@ -1482,19 +1723,13 @@ namespace afnix {
 	throw Exception ("internal-error", "inconsistent buffer copy position");
       }
       // we have a matching at position mpos - which is the length of the
-      // new buffer to copy
-      Buffer* result = new Buffer (mpos);
+      // new buffer to view
+      Buffer* result = new Buffer (slice (0L, mpos));
       result->setrflg (false);
-      // copy to the new buffer
-      for (long k = 0; k < mpos; k++) result->p_data[k] = p_data[k];
-      result->d_blen = mpos;
       // clean boundary buffer
       delete [] cbuf;
-      // update the buffer by shifting upto mpos position
-      for (long k = mpos; k < d_blen; k++) {
-	long l = k - mpos;
-	p_data[l] = p_data[k];
-      }
+      // update the buffer upto mpos position
+      d_ridx += mpos;
       d_blen -= mpos;
       // done
       unlock ();
@@ -1516,11 +1751,9 @@ namespace afnix {
 	unlock ();
 	return false;
       }
-      // normalize the buffer
-      normalize ();
       // check for 1 character
       if (d_blen == 1) {
-	if (p_data[0] == eolc) {
+	if (p_data[d_ridx] == eolc) {
 	  d_blen--;
 	  unlock ();
 	  return true;
@@ -1530,7 +1763,8 @@ namespace afnix {
 	}
       }
       // check for cr/nl
-      if ((p_data[d_blen-2] == crlc) && (p_data[d_blen-1] == eolc)) {
+      long eidx = d_ridx + d_blen;
+      if ((p_data[eidx-2] == crlc) && (p_data[eidx-1] == eolc)) {
 	d_blen-= 2;
 	unlock ();
 	return true;
@@ -1556,6 +1790,11 @@ namespace afnix {
 	unlock ();
 	return;
       }
+      unshare ();
+      if (d_ridx == 0L) {
+	unlock ();
+	return;
+      }
       for (long k = 0L; k < d_blen; k++) p_data[k] = p_data[k + d_ridx];
       d_ridx = 0L;
       unlock ();
@@ -1565,18 +1804,67 @@ namespace afnix {
     }
   }
   
+  // make the buffer storage private
+
+  void Buffer::unshare (void) {
+    wrlock ();
+    try {
+      // check for a shared storage
+      if (p_bsto == nullptr) {
+	unlock ();
+	return;
+      }
+      // take the storage if single owned
+      if (bsto_take (p_bsto) == true) {
+	p_bsto = nullptr;
+	unlock ();
+	return;
+      }
+      // copy the buffer content
+      long  size = d_rflg ? d_blen + System::blocksz () : d_size;
+      char* data = new char[size];
+      c_memcpy (data, d_blen, p_data + d_ridx);
+      // release the shared storage
+      bsto_dref (p_bsto);
+      p_bsto = nullptr;
+      p_data = data;
+      d_size = size;
+      d_ridx = 0L;
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // share the buffer storage
+
+  s_bsto* Buffer::mkshare (void) const {
+    bsto_mtx().lock ();
+    try {
+      if (p_bsto == nullptr) p_bsto = new s_bsto (p_data);
+      s_bsto* result = bsto_iref (p_bsto);
+      bsto_mtx().unlock ();
+      return result;
+    } catch (...) {
+      bsto_mtx().unlock ();
+      throw;
+    }
+  }
+
   // -------------------------------------------------------------------------
   // - object section                                                        -
   // -------------------------------------------------------------------------
 
   // the quark zone
-  static const long QUARK_ZONE_LENGTH = 20;
+  static const long QUARK_ZONE_LENGTH = 23;
   static QuarkZone  zone (QUARK_ZONE_LENGTH);
   
   // the object supported quarks
   static const long QUARK_ADD      = zone.intern ("add");
   static const long QUARK_GET      = zone.intern ("get");
   static const long QUARK_SHL      = zone.intern ("shl");
+  static const long QUARK_SLICE    = zone.intern ("slice");
   static const long QUARK_READ     = zone.intern ("read");
   static const long QUARK_MOVE     = zone.intern ("move");
   static const long QUARK_RESET    = zone.intern ("reset");
@@ -1595,18 +1883,24 @@ namespace afnix {
   static const long QUARK_TOSTRING = zone.intern ("to-string");
   static const long QUARK_PUSHBACK = zone.intern ("pushback");
   static const long QUARK_ISRESIZE = zone.intern ("resize-p");
+  static const long QUARK_ISSHARED = zone.intern ("shared-p");
 
   // create a new object in a generic way
 
   Object* Buffer::mknew (Vector* argv) {
     long argc = (argv == nullptr) ? 0 : argv->length ();
+    // check for a buffer copy
+    if (argc == 1) {
+      auto bobj = dynamic_cast <Buffer*> (argv->get (0));
+      if (bobj != nullptr) return new Buffer (*bobj);
+    }
     // create an empty buffer with 0 arguments
     Buffer* result = new Buffer;
     // loop with objects
     for (long i = 0; i < argc; i++) {
       Object* obj = argv->get (i);
       // check for a viewable
-      auto wobj = dynamic_cast <Viewable*> (obj);
+      auto wobj = dynamic_cast <const Viewable*> (obj);
       if (wobj != nullptr) {
 	result->add ((const char*) wobj->tobyte(), wobj->tosize ());
 	continue;
@@ -1668,6 +1962,7 @@ namespace afnix {
       if (quark == QUARK_GETSIZE)  return new Integer (getsize  ());
       if (quark == QUARK_TOSTRING) return new String  (tostring ());
       if (quark == QUARK_ISRESIZE) return new Boolean (getrflg  ());
+      if (quark == QUARK_ISSHARED) return new Boolean (isshared ());
       if (quark == QUARK_RESET) {
 	reset ();
 	return nullptr;
@@ -1781,6 +2076,11 @@ namespace afnix {
 	long size = argv->getlong (1);
 	return new Buffer (extract (boff, size));
       }
+      if (quark == QUARK_SLICE) {
+	long boff = argv->getlong (0);
+	long size = argv->getlong (1);
+	return new Buffer (slice (boff, size));
+      }
     }
     // call the serial method
     return Serial::apply (zobj, nset, quark, argv);
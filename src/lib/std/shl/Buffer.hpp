@@ -35,7 +35,9 @@ namespace afnix {
   /// characters. By default, the class automatically resize itself when full.
   /// However, a flag controls whther or not this operation can proceed. If
   /// the buffer is full, an exception is raised. Standard methods to read 
-  /// or write or extract data is provided. 
+  /// or write or extract data is provided. A buffer copy or a buffer slice
+  /// shares the buffer storage with the original buffer. The storage is
+  /// copied when one of the buffers is modified.
   /// @author amaury darsch
 
   class Buffer : public virtual Serial, public Viewable {
@@ -59,6 +61,8 @@ namespace afnix {
     char* p_data;
     /// the buffer encoding
     Encoding::t_emod d_emod;
+    /// the shared storage
+    mutable struct s_bsto* p_bsto;
 
   public:
     /// create a default buffer
@@ -302,6 +306,14 @@ namespace afnix {
     /// @param boff the buffer offset
     /// @param size the buffer size
     virtual Buffer extract (const long boff, const long size) const;
+
+    /// get a buffer view which shares this buffer storage
+    /// @param boff the buffer offset
+    /// @param size the buffer size
+    virtual Buffer slice (const long boff, const long size) const;
+
+    /// @return true if the buffer storage is shared
+    virtual bool isshared (void) const;
     
     /// @return the buffer content as character buffer
     virtual char* tochar (void) const;
@@ -330,6 +342,13 @@ namespace afnix {
   protected:
     /// normalize the buffer
     virtual void normalize (void);
+
+    /// make the buffer storage private before a write
+    virtual void unshare (void);
+
+  private:
+    // share the buffer storage
+    struct s_bsto* mkshare (void) const;
     
   public:
     /// create a new object in a generic way
@@ -226,9 +226,15 @@ namespace afnix {
       d_vflg = false;
     }
     
-    // destroy this object
+    // destroy this object - the nodes are deleted in a loop since a
+    // long confinement list would exhaust the stack recursively
     ~Confiner (void) {
-      if (p_root != nullptr) delete p_root;
+      while (p_root != nullptr) {
+	s_cnod* next = p_root->p_next;
+	p_root->p_next = nullptr;
+	delete p_root;
+	p_root = next;
+      }
     }
 
     // confine a collectable object
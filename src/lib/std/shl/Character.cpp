@@ -140,9 +140,7 @@ namespace afnix {
   void Character::wrstream (OutputStream& os) const {
     rdlock ();
     try {
-      t_byte data[4];
-      c_qhton (d_value, data);
-      os.write ((char*) data, 4);
+      Serial::wrchar (d_value, os);
       unlock ();
     } catch (...) {
       unlock ();
@@ -155,9 +153,7 @@ namespace afnix {
   void Character::rdstream (InputStream& is) {
     wrlock ();
     try {
-      t_byte data[4];
-      for (long i = 0; i < 4; i++) data[i] = (t_byte) is.read ();
-      d_value = c_qntoh (data);
+      d_value = Serial::rdchar (is);
       unlock ();
     } catch (...) {
       unlock ();
@@ -279,6 +279,25 @@ namespace afnix {
     }
   }
 
+  // return the file marker position
+
+  t_long InputFile::tell (void) const {
+    rdlock ();
+    try {
+      t_long result = c_ftell (d_sid);
+      if (result < 0) {
+	throw Exception ("file-error", "cannot access file position");
+      }
+      // remove the pushback characters
+      result -= d_sbuf.length ();
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // return the file modification time
 
   t_long InputFile::mtime (void) const {
@@ -301,10 +320,11 @@ namespace afnix {
   // -------------------------------------------------------------------------
 
   // the quark zone
-  static const long QUARK_ZONE_LENGTH = 3;
+  static const long QUARK_ZONE_LENGTH = 4;
   static QuarkZone  zone (QUARK_ZONE_LENGTH);
 
   // the object supported quarks
+  static const long QUARK_TELL   = zone.intern ("tell");
   static const long QUARK_LSEEK  = zone.intern ("lseek");
   static const long QUARK_MTIME  = zone.intern ("get-modification-time");
   static const long QUARK_LENGTH = zone.intern ("length");
@@ -361,6 +381,7 @@ namespace afnix {
 
     // dispatch 0 argument
     if (argc == 0) {
+      if (quark == QUARK_TELL)   return new Integer (tell   ());
       if (quark == QUARK_MTIME)  return new Integer (mtime  ());
       if (quark == QUARK_LENGTH) return new Integer (length ());
     }
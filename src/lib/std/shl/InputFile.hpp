@@ -88,6 +88,9 @@ namespace afnix {
     /// @param pos the position to go
     virtual void lseek (const t_long pos);
 
+    /// @return the file marker position
+    virtual t_long tell (void) const;
+
     /// @return the input file size
     virtual t_long length (void) const;
 
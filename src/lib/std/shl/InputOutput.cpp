@@ -161,6 +161,40 @@ namespace afnix {
     }
   }
 
+  // write a character array to the output stream
+
+  long InputOutput::write (const char* rbuf, const long size) {
+    wrlock ();
+    try {
+      long result = d_sbuf.add (rbuf, size);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // set the stream serial version
+
+  void InputOutput::setsver (const long sver) {
+    setsver (sver, false);
+  }
+
+  // set the stream serial version and length prefix flag
+
+  void InputOutput::setsver (const long sver, const bool slpf) {
+    wrlock ();
+    try {
+      InputBuffer::setsver  (sver, slpf);
+      OutputStream::setsver (sver, slpf);
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // set the stream with a string after a buffer flush
 
   void InputOutput::set (const String& data) {
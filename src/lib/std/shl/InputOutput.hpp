@@ -92,6 +92,20 @@ namespace afnix {
     /// @param value the character string to write
     long write (const char* value) override;
 
+    /// write a character array to the output stream
+    /// @param rbuf the buffer to write
+    /// @param size the number of characters
+    long write (const char* rbuf, const long size) override;
+
+    /// set the stream serial version
+    /// @param sver the serial version to set
+    void setsver (const long sver) override;
+
+    /// set the stream serial version and length prefix flag
+    /// @param sver the serial version to set
+    /// @param slpf the serial length prefix flag
+    void setsver (const long sver, const bool slpf) override;
+
     /// flush the buffer and set the stream with a new string
     /// @param data the string to set to this stream
     virtual void set (const String& data);
@@ -322,9 +322,7 @@ namespace afnix {
   void Integer::wrstream (OutputStream& os) const {
     rdlock ();
     try {
-      t_byte data[8];
-      c_ohton (d_value, data);
-      os.write ((char*) data, 8);
+      Serial::wrlong (d_value, os);
       unlock ();
     } catch (...) {
       unlock ();
@@ -337,9 +335,7 @@ namespace afnix {
   void Integer::rdstream (InputStream& is) {
     wrlock ();
     try {
-      t_byte data[8];
-      for (long i = 0; i < 8; i++) data[i] = (t_byte) is.read ();
-      d_value = c_ontoh (data);
+      d_value = Serial::rdlong (is);
       unlock ();
     } catch (...) {
       unlock ();
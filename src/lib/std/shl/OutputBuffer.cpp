@@ -128,6 +128,20 @@ namespace afnix {
     }
   }
   
+  // write a character array to the output buffer
+
+  long OutputBuffer::write (const char* rbuf, const long size) {
+    wrlock ();
+    try {
+      long result = d_sbuf.add (rbuf, size);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+  
   // return a buffer copy of the output buffer
 
   Buffer OutputBuffer::tobuffer (void) const {
@@ -65,6 +65,11 @@ namespace afnix {
     /// @param data the data to write  
     long write (const char* data);
 
+    /// write a character array to the output buffer
+    /// @param rbuf the buffer to write
+    /// @param size the number of characters
+    long write (const char* rbuf, const long size);
+
     /// @return a copy of the stream buffer
     Buffer tobuffer (void) const;
     
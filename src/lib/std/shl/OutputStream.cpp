@@ -216,10 +216,7 @@ namespace afnix {
     try {
       // check for byte to byte writing
       if ((d_emod == Encoding::EMOD_BYTE) && (buf.getemod () == d_emod)) {
-	long blen = buf.length ();
-	cbuf = buf.tochar ();
-	long result = write (cbuf, blen);
-	delete [] cbuf;
+	long result = write ((const char*) buf.tobyte (), buf.length ());
 	unlock ();
 	return result;
       }
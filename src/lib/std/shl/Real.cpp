@@ -242,9 +242,7 @@ namespace afnix {
   void Real::wrstream (OutputStream& os) const {
     rdlock ();
     try {
-      t_byte data[8];
-      c_rhton (d_value, data);
-      os.write ((char*) data, 8);
+      Serial::wrreal (d_value, os);
       unlock ();
     } catch (...) {
       unlock ();
@@ -257,9 +255,7 @@ namespace afnix {
   void Real::rdstream (InputStream& is) {
     wrlock ();
     try {
-      t_byte data[8];
-      for (long i = 0; i < 8; i++) data[i] = (t_byte) is.read ();
-      d_value = c_ontor (data);
+      d_value = Serial::rdreal (is);
       unlock ();
     } catch (...) {
       unlock ();
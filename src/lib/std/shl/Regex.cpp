@@ -15,12 +15,15 @@
 // ---------------------------------------------------------------------------
 
 #include "Regex.hpp"
+#include "Regex.hxx"
 #include "Stdsid.hxx"
+#include "Mutex.hpp"
 #include "Vector.hpp"
 #include "Utility.hpp"
 #include "Unicode.hpp"
 #include "Boolean.hpp"
 #include "Integer.hpp"
+#include "Monitor.hpp"
 #include "Evaluable.hpp"
 #include "Unitabler.hpp"
 #include "QuarkZone.hpp"
@@ -390,16 +393,55 @@ namespace afnix {
     s_renode* p_root;
     // the last node
     s_renode* p_last;
+    // the regex automaton
+    struct s_reauto* p_auto;
+    // the automaton full match flag
+    bool d_fflg;
+    // the automaton partial match flag
+    bool d_pflg;
+    // the required literal
+    t_quad* p_rlit;
+    // the required literal length
+    long    d_rlen;
     // the reference count
     long d_rcount;
+    // the reference count monitor
+    Monitor d_rmon;
     // initialize the regex structure
     s_regex (void) {
       p_root = nullptr;
       p_last = nullptr;
+      p_auto = nullptr;
+      d_fflg = false;
+      d_pflg = false;
+      p_rlit = nullptr;
+      d_rlen = 0L;
       d_rcount = 1;
     }
+    // destroy the regex structure
+    ~s_regex (void);
   };
 
+  // increment the regex structure reference count
+  static s_regex* re_iref (s_regex* recni) {
+    recni->d_rmon.enter ();
+    recni->d_rcount++;
+    recni->d_rmon.leave ();
+    return recni;
+  }
+
+  // decrement the regex structure reference count and clean
+  static void re_dref (s_regex* recni) {
+    if (recni == nullptr) return;
+    recni->d_rmon.enter ();
+    if (--recni->d_rcount > 0L) {
+      recni->d_rmon.leave ();
+      return;
+    }
+    recni->d_rmon.leave ();
+    delete recni;
+  }
+
   // read a character in the buffer - possibly escaped
   static t_quad re_escape_char (InputString& buf) {
     // check for escaped
@@ -1018,6 +1060,920 @@ namespace afnix {
     return result;
   }
 
+  // the automaton maximum number of nfa states
+  static const long RE_NFA_SMAX = 4096L;
+  // the automaton maximum number of dfa states
+  static const long RE_DFA_SMAX = 256L;
+  // the dfa transition table size
+  static const long RE_DFA_TSIZ = 128L;
+  // the regex cache size
+  static const long RE_CSH_SIZE = 64L;
+  // the scanner automaton maximum number of dfa states
+  static const long RE_SCN_SMAX = 1024L;
+  // the automaton maximum number of idle scan states
+  static const long RE_RUN_PMAX = 8L;
+
+  // check for a group node in a node chain
+  static bool re_check_group (s_renode* node) {
+    while (node != nullptr) {
+      if ((node->d_type == RE_GMRK) || (node->d_type == RE_GSET)) return true;
+      if ((node->d_type == RE_BLOK) || (node->d_type == RE_OPRD)) {
+	if (re_check_group (node->p_nval) == true) return true;
+      }
+      if ((node->d_type == RE_OPRD) && (node->p_oprd != nullptr)) {
+	if (re_check_group (node->p_oprd) == true) return true;
+      }
+      node = node->p_next;
+    }
+    return false;
+  }
+
+  // compute the width of a node chain - the width is the number of
+  // characters consumed by any path in the chain, or -1 if the paths
+  // do not consume the same number of characters
+  static long re_fixed_chain (s_renode* node);
+
+  // compute the width of a node element without its operator
+  static long re_fixed_elem (s_renode* node) {
+    switch (node->d_type) {
+    case RE_CHAR:
+    case RE_META:
+    case RE_CSET:
+      return 1L;
+    case RE_BLOK:
+      return re_fixed_chain (node->p_nval);
+    case RE_OPRD:
+      if ((node->p_nval == nullptr) || (node->p_oprd == nullptr)) return -1L;
+      if ((node->p_nval->d_oper != RE_NONE) ||
+	  (node->p_oprd->d_oper != RE_NONE)) return -1L;
+      if (re_fixed_elem (node->p_nval) != re_fixed_elem (node->p_oprd)) {
+	return -1L;
+      }
+      return re_fixed_elem (node->p_nval);
+    default:
+      break;
+    }
+    return -1L;
+  }
+
+  // compute the width of a node chain
+  static long re_fixed_chain (s_renode* node) {
+    long result = 0L;
+    while (node != nullptr) {
+      if ((node->d_oper != RE_NONE) && (node->d_oper != RE_ALTN)) return -1L;
+      long width = re_fixed_elem (node);
+      if (width < 0L) return -1L;
+      result += width;
+      node = node->p_next;
+    }
+    return result;
+  }
+
+  // check that the backtracker commits to a path that the automaton
+  // accepts at a node - a block returns its first path only, so a block
+  // must have a fixed width, and with the full flag, the alternate
+  // operands must have the same width
+  static bool re_check_anod (s_renode* node, const bool fflg) {
+    if (node == nullptr) return false;
+    switch (node->d_type) {
+    case RE_CHAR:
+    case RE_META:
+    case RE_CSET:
+      return true;
+    case RE_BLOK:
+      return (re_fixed_chain (node->p_nval) >= 0L);
+    case RE_OPRD:
+      if (fflg == true) return (re_fixed_elem (node) >= 0L);
+      if (re_check_anod (node->p_nval, fflg) == false) return false;
+      return re_check_anod (node->p_oprd, fflg);
+    default:
+      break;
+    }
+    return false;
+  }
+
+  // check a node chain with the automaton commitment rules - a full
+  // match ends with the first path which reaches the end of the chain,
+  // so with the full flag, a repeated element wider than a character
+  // cannot follow another repeated element, since the first path might
+  // stop in the middle of a repetition where another path does not
+  static bool re_check_auto (s_renode* node, const bool fflg) {
+    bool vflg = false;
+    while (node != nullptr) {
+      if (re_check_anod (node, fflg) == false) return false;
+      bool oflg = (node->d_oper != RE_NONE) && (node->d_oper != RE_ALTN);
+      if ((fflg == true) && (vflg == true) && (oflg == true) &&
+	  (re_fixed_elem (node) != 1L)) return false;
+      if (oflg == true) vflg = true;
+      node = node->p_next;
+    }
+    return true;
+  }
+
+  // check a predicate node against a character
+  static inline bool re_check_pred (s_renode* node, const t_quad c) {
+    switch (node->d_type) {
+    case RE_CHAR:
+      return (node->d_cval == c);
+    case RE_META:
+      return re_check_meta (node->d_cval, c);
+    case RE_CSET:
+      return re_check_cset (node->p_cset, c);
+    default:
+      break;
+    }
+    return false;
+  }
+
+  // the nfa state type
+  enum t_restat {
+    RA_PRED, // predicate state
+    RA_SPLT, // split state
+    RA_MTCH  // match state
+  };
+
+  // the nfa state
+  struct s_rastat {
+    // the state type
+    t_restat  d_type;
+    // the predicate node
+    s_renode* p_node;
+    // the first output state
+    long      d_out1;
+    // the second output state
+    long      d_out2;
+    // the match state tag
+    long      d_rtag;
+  };
+
+  // the dfa state
+  struct s_radstat {
+    // the nfa state set
+    long* p_nset;
+    // the nfa set length
+    long  d_nlen;
+    // the nfa set hash
+    long  d_hash;
+    // the match flag
+    bool  d_mflg;
+    // the match tag
+    long  d_mtag;
+    // the end of stream match tag
+    long  d_etag;
+    // the transition table with and without start injection
+    long  d_tran[2][RE_DFA_TSIZ];
+    // create a dfa state by nfa set
+    s_radstat (const long* nset, const long nlen, const long hash) {
+      p_nset = new long[nlen];
+      for (long k = 0L; k < nlen; k++) p_nset[k] = nset[k];
+      d_nlen = nlen;
+      d_hash = hash;
+      d_mflg = false;
+      d_mtag = -1L;
+      d_etag = -2L;
+      for (long k = 0L; k < RE_DFA_TSIZ; k++) {
+	d_tran[0][k] = -1L;
+	d_tran[1][k] = -1L;
+      }
+    }
+    // destroy this dfa state
+    ~s_radstat (void) {
+      delete [] p_nset;
+    }
+  };
+
+  // the regex automaton - the node tree is compiled into a thompson nfa
+  // which is run as a lazy dfa, the dfa states being built on demand and
+  // flushed when the maximum number of states is reached - several node
+  // trees can be combined, each match state being tagged by tree index -
+  // the nfa is not modified once built, the dfa states being kept in scan
+  // states which are taken by each match and given back to a small pool
+  struct s_reauto {
+    // the nfa states
+    s_rastat* p_nfa;
+    // the number of nfa states
+    long d_nlen;
+    // the nfa array size
+    long d_nsiz;
+    // the nfa start state
+    long d_nsid;
+    // the maximum number of dfa states
+    long d_dmax;
+    // the idle scan states
+    struct s_rarun* p_rpol[RE_RUN_PMAX];
+    // the number of idle scan states
+    long  d_plen;
+    // the scan state pool mutex
+    Mutex d_pmtx;
+    // create an empty automaton by maximum number of dfa states
+    s_reauto (const long dmax) {
+      p_nfa  = nullptr;
+      d_nlen = 0L;
+      d_nsiz = 0L;
+      d_nsid = -1L;
+      d_dmax = dmax;
+      d_plen = 0L;
+    }
+    // destroy this automaton
+    ~s_reauto (void);
+    // add a nfa state and return its index
+    long add (const t_restat type, s_renode* node, const long out1,
+	      const long out2) {
+      if (d_nlen >= RE_NFA_SMAX) {
+	throw Exception ("regex-error", "automaton size exceeded");
+      }
+      if (d_nlen == d_nsiz) {
+	long nsiz = (d_nsiz == 0L) ? 64L : 2L * d_nsiz;
+	s_rastat* nfa = new s_rastat[nsiz];
+	for (long k = 0L; k < d_nlen; k++) nfa[k] = p_nfa[k];
+	delete [] p_nfa;
+	p_nfa  = nfa;
+	d_nsiz = nsiz;
+      }
+      p_nfa[d_nlen].d_type = type;
+      p_nfa[d_nlen].p_node = node;
+      p_nfa[d_nlen].d_out1 = out1;
+      p_nfa[d_nlen].d_out2 = out2;
+      p_nfa[d_nlen].d_rtag = -1L;
+      return d_nlen++;
+    }
+    // build a node element - the element next node is ignored
+    long elem (s_renode* node, const long out) {
+      long sidx = -1L;
+      long bidx = -1L;
+      switch (node->d_oper) {
+      case RE_PLUS:
+	sidx = add (RA_SPLT, nullptr, -1L, out);
+	bidx = base (node, sidx);
+	p_nfa[sidx].d_out1 = bidx;
+	return bidx;
+      case RE_MULT:
+	sidx = add (RA_SPLT, nullptr, -1L, out);
+	bidx = base (node, sidx);
+	p_nfa[sidx].d_out1 = bidx;
+	return sidx;
+      case RE_ZONE:
+	bidx = base (node, out);
+	return add (RA_SPLT, nullptr, bidx, out);
+      default:
+	break;
+      }
+      return base (node, out);
+    }
+    // build a node base
+    long base (s_renode* node, const long out) {
+      switch (node->d_type) {
+      case RE_CHAR:
+      case RE_META:
+      case RE_CSET:
+	return add (RA_PRED, node, out, -1L);
+      case RE_BLOK:
+	return chain (node->p_nval, out);
+      case RE_OPRD:
+	return add (RA_SPLT, nullptr, elem (node->p_nval, out),
+		    elem (node->p_oprd, out));
+      default:
+	break;
+      }
+      throw Exception ("regex-error", "internal automaton node error");
+    }
+    // build a node chain
+    long chain (s_renode* node, long out) {
+      // collect the chain nodes
+      long clen = 0L;
+      for (s_renode* cnod = node; cnod != nullptr; cnod = cnod->p_next) clen++;
+      if (clen == 0L) return out;
+      s_renode** cvec = new s_renode*[clen];
+      clen = 0L;
+      for (s_renode* cnod = node; cnod != nullptr; cnod = cnod->p_next) {
+	cvec[clen++] = cnod;
+      }
+      // build the chain from the end
+      try {
+	for (long k = clen - 1L; k >= 0L; k--) out = elem (cvec[k], out);
+	delete [] cvec;
+	return out;
+      } catch (...) {
+	delete [] cvec;
+	throw;
+      }
+    }
+    // build the automaton by root nodes - the start state is a split
+    // fan over the root chains, each chain ending with a tagged match
+    void build (s_renode** root, const long rlen) {
+      for (long k = 0L; k < rlen; k++) {
+	long midx = add (RA_MTCH, nullptr, -1L, -1L);
+	p_nfa[midx].d_rtag = k;
+	long sidx = chain (root[k], midx);
+	d_nsid = (d_nsid == -1L) ? sidx : add (RA_SPLT, nullptr, d_nsid, sidx);
+      }
+      if (d_nsid == -1L) {
+	throw Exception ("regex-error", "empty automaton root set");
+      }
+    }
+    // take a scan state from the pool or create a new one
+    struct s_rarun* take (void);
+    // give back a scan state to the pool
+    void give (struct s_rarun* rrun);
+    // match a whole string
+    bool full (const t_quad* s, const long slen);
+    // check for a match at a start index
+    bool anch (const t_quad* s, const long slen, const long sidx);
+    // find a match in a string
+    bool find (const t_quad* s, const long slen);
+  };
+
+  // the automaton scan state - the scan state holds the dfa states and
+  // the work sets of an automaton and is used by one thread at a time
+  struct s_rarun {
+    // the automaton
+    const s_reauto& d_auto;
+    // the dfa states
+    s_radstat** p_dfa;
+    // the number of dfa states
+    long d_dlen;
+    // the dfa start state
+    long d_dsid;
+    // the dfa flush counter
+    long d_dgen;
+    // the state marks
+    long* p_mark;
+    // the mark generation
+    long  d_mgen;
+    // the closure stack
+    long* p_stck;
+    // the state work set
+    long* p_work;
+    // the work set length
+    long  d_wlen;
+    // create a scan state by automaton
+    s_rarun (const s_reauto& ra) : d_auto (ra) {
+      long nlen = d_auto.d_nlen;
+      p_dfa  = new s_radstat*[d_auto.d_dmax];
+      d_dlen = 0L;
+      d_dsid = -1L;
+      d_dgen = 0L;
+      p_mark = new long[nlen];
+      d_mgen = 0L;
+      p_stck = new long[nlen];
+      p_work = new long[nlen];
+      d_wlen = 0L;
+      for (long k = 0L; k < nlen; k++) p_mark[k] = 0L;
+    }
+    // destroy this scan state
+    ~s_rarun (void) {
+      flush ();
+      delete [] p_dfa;
+      delete [] p_mark;
+      delete [] p_stck;
+      delete [] p_work;
+    }
+    // start a new work set
+    void wnew (void) {
+      d_wlen = 0L;
+      d_mgen++;
+    }
+    // add the closure of a state to the work set
+    void closure (const long sidx) {
+      if (p_mark[sidx] == d_mgen) return;
+      long slen = 0L;
+      p_mark[sidx] = d_mgen;
+      p_stck[slen++] = sidx;
+      while (slen > 0L) {
+	const s_rastat& stat = d_auto.p_nfa[p_stck[--slen]];
+	if (stat.d_type != RA_SPLT) {
+	  p_work[d_wlen++] = p_stck[slen];
+	  continue;
+	}
+	if (p_mark[stat.d_out2] != d_mgen) {
+	  p_mark[stat.d_out2] = d_mgen;
+	  p_stck[slen++] = stat.d_out2;
+	}
+	if (p_mark[stat.d_out1] != d_mgen) {
+	  p_mark[stat.d_out1] = d_mgen;
+	  p_stck[slen++] = stat.d_out1;
+	}
+      }
+    }
+    // flush the dfa states
+    void flush (void) {
+      for (long k = 0L; k < d_dlen; k++) delete p_dfa[k];
+      d_dlen = 0L;
+      d_dsid = -1L;
+      d_dgen++;
+    }
+    // find or create a dfa state with the work set
+    long dfa (void) {
+      // sort the work set
+      for (long i = 1L; i < d_wlen; i++) {
+	long sidx = p_work[i];
+	long j = i;
+	while ((j > 0L) && (p_work[j-1] > sidx)) {
+	  p_work[j] = p_work[j-1];
+	  j--;
+	}
+	p_work[j] = sidx;
+      }
+      // compute the set hash and find the state
+      long hash = d_wlen;
+      for (long k = 0L; k < d_wlen; k++) hash = hash * 31L + p_work[k];
+      for (long k = 0L; k < d_dlen; k++) {
+	s_radstat* dst = p_dfa[k];
+	if ((dst->d_hash != hash) || (dst->d_nlen != d_wlen)) continue;
+	bool same = true;
+	for (long i = 0L; (i < d_wlen) && same; i++) {
+	  if (dst->p_nset[i] != p_work[i]) same = false;
+	}
+	if (same == true) return k;
+      }
+      // eventually flush the states and create a new one
+      if (d_dlen == d_auto.d_dmax) flush ();
+      s_radstat* dst = new s_radstat (p_work, d_wlen, hash);
+      for (long k = 0L; k < d_wlen; k++) {
+	const s_rastat& stat = d_auto.p_nfa[p_work[k]];
+	if (stat.d_type != RA_MTCH) continue;
+	dst->d_mflg = true;
+	if (stat.d_rtag > dst->d_mtag) dst->d_mtag = stat.d_rtag;
+      }
+      p_dfa[d_dlen] = dst;
+      return d_dlen++;
+    }
+    // get the dfa start state
+    long start (void) {
+      if (d_dsid >= 0L) return d_dsid;
+      wnew ();
+      closure (d_auto.d_nsid);
+      long result = dfa ();
+      return (d_dsid = result);
+    }
+    // compute a dfa transition with an optional start injection
+    long next (const long didx, const t_quad c, const bool iflg) {
+      long tidx = iflg ? 1L : 0L;
+      bool tflg = (c < (t_quad) RE_DFA_TSIZ);
+      if ((tflg == true) && (p_dfa[didx]->d_tran[tidx][c] >= 0L)) {
+	return p_dfa[didx]->d_tran[tidx][c];
+      }
+      // compute the next work set
+      s_radstat* dst = p_dfa[didx];
+      wnew ();
+      for (long k = 0L; k < dst->d_nlen; k++) {
+	const s_rastat& stat = d_auto.p_nfa[dst->p_nset[k]];
+	if (stat.d_type != RA_PRED) continue;
+	if (re_check_pred (stat.p_node, c) == true) closure (stat.d_out1);
+      }
+      if (iflg == true) closure (d_auto.d_nsid);
+      // find the next state and cache the transition
+      long dgen = d_dgen;
+      long result = dfa ();
+      if ((tflg == true) && (dgen == d_dgen)) dst->d_tran[tidx][c] = result;
+      return result;
+    }
+    // return the highest match tag of a dfa state at the end of stream,
+    // where the predicates which accept the end of stream character are
+    // passed, or -1 without match
+    long etag (const long didx) {
+      s_radstat* dst = p_dfa[didx];
+      if (dst->d_etag >= -1L) return dst->d_etag;
+      wnew ();
+      for (long k = 0L; k < dst->d_nlen; k++) {
+	p_mark[dst->p_nset[k]] = d_mgen;
+	p_work[d_wlen++] = dst->p_nset[k];
+      }
+      long result = -1L;
+      for (long k = 0L; k < d_wlen; k++) {
+	const s_rastat& stat = d_auto.p_nfa[p_work[k]];
+	if ((stat.d_type == RA_MTCH) && (stat.d_rtag > result)) {
+	  result = stat.d_rtag;
+	}
+	if ((stat.d_type == RA_PRED) && (re_check_pred (stat.p_node, eosc))) {
+	  closure (stat.d_out1);
+	}
+      }
+      dst->d_etag = result;
+      return result;
+    }
+    // return true if a dfa state matches at the end of stream
+    bool eacc (const long didx) {
+      return (etag (didx) >= 0L);
+    }
+    // run a whole string
+    bool rful (const t_quad* s, const long slen) {
+      long didx = start ();
+      for (long k = 0L; k < slen; k++) {
+	didx = next (didx, s[k], false);
+	if (p_dfa[didx]->d_nlen == 0L) return false;
+      }
+      return eacc (didx);
+    }
+    // run a string from a start index
+    bool ranc (const t_quad* s, const long slen, const long sidx) {
+      long didx = start ();
+      if (p_dfa[didx]->d_mflg == true) return true;
+      for (long k = sidx; k < slen; k++) {
+	didx = next (didx, s[k], false);
+	if (p_dfa[didx]->d_mflg == true) return true;
+	if (p_dfa[didx]->d_nlen == 0L) return false;
+      }
+      return eacc (didx);
+    }
+    // run a string with a start at each index - a match can start
+    // before the last character only
+    bool rfnd (const t_quad* s, const long slen) {
+      if (slen == 0L) return false;
+      long didx = start ();
+      if (p_dfa[didx]->d_mflg == true) return true;
+      for (long k = 0L; k < slen; k++) {
+	didx = next (didx, s[k], (k + 1L < slen));
+	if (p_dfa[didx]->d_mflg == true) return true;
+      }
+      return eacc (didx);
+    }
+  };
+
+  // destroy the automaton and its idle scan states
+
+  s_reauto::~s_reauto (void) {
+    for (long k = 0L; k < d_plen; k++) delete p_rpol[k];
+    delete [] p_nfa;
+  }
+
+  // take a scan state from the pool or create a new one - the pool lock
+  // is only held to pick the state so that the matches run in parallel
+
+  s_rarun* s_reauto::take (void) {
+    s_rarun* result = nullptr;
+    d_pmtx.lock ();
+    if (d_plen > 0L) result = p_rpol[--d_plen];
+    d_pmtx.unlock ();
+    return (result == nullptr) ? new s_rarun (*this) : result;
+  }
+
+  // give back a scan state to the pool or delete it if the pool is full
+
+  void s_reauto::give (s_rarun* rrun) {
+    if (rrun == nullptr) return;
+    d_pmtx.lock ();
+    if (d_plen < RE_RUN_PMAX) {
+      p_rpol[d_plen++] = rrun;
+      rrun = nullptr;
+    }
+    d_pmtx.unlock ();
+    delete rrun;
+  }
+
+  // match a whole string
+
+  bool s_reauto::full (const t_quad* s, const long slen) {
+    s_rarun* rrun = take ();
+    try {
+      bool result = rrun->rful (s, slen);
+      give (rrun);
+      return result;
+    } catch (...) {
+      delete rrun;
+      throw;
+    }
+  }
+
+  // check for a match at a start index
+
+  bool s_reauto::anch (const t_quad* s, const long slen, const long sidx) {
+    s_rarun* rrun = take ();
+    try {
+      bool result = rrun->ranc (s, slen, sidx);
+      give (rrun);
+      return result;
+    } catch (...) {
+      delete rrun;
+      throw;
+    }
+  }
+
+  // find a match in a string
+
+  bool s_reauto::find (const t_quad* s, const long slen) {
+    s_rarun* rrun = take ();
+    try {
+      bool result = rrun->rfnd (s, slen);
+      give (rrun);
+      return result;
+    } catch (...) {
+      delete rrun;
+      throw;
+    }
+  }
+
+  // destroy the regex structure
+
+  s_regex::~s_regex (void) {
+    delete p_root;
+    delete p_auto;
+    delete [] p_rlit;
+  }
+
+  // create the regex automaton if the node tree has no group
+  static s_reauto* re_auto_new (s_renode* root) {
+    if (re_check_group (root) == true) return nullptr;
+    s_reauto* result = new s_reauto (RE_DFA_SMAX);
+    try {
+      result->build (&root, 1L);
+      return result;
+    } catch (...) {
+      delete result;
+      return nullptr;
+    }
+  }
+
+  // compute the longest required literal of a root node chain
+  static t_quad* re_rlit_new (s_renode* root, long& rlen) {
+    s_renode* rnod = nullptr;
+    long      rmax = 0L;
+    s_renode* cnod = nullptr;
+    long      clen = 0L;
+    for (s_renode* node = root; node != nullptr; node = node->p_next) {
+      if ((node->d_oper == RE_NONE) && (node->d_type == RE_CHAR)) {
+	if (clen++ == 0L) cnod = node;
+	if (clen > rmax) {
+	  rnod = cnod;
+	  rmax = clen;
+	}
+	continue;
+      }
+      // control nodes do not consume characters
+      if (node->d_oper == RE_CTRL) continue;
+      clen = 0L;
+    }
+    rlen = rmax;
+    if (rmax == 0L) return nullptr;
+    t_quad* result = new t_quad[rmax + 1L];
+    for (long k = 0L; k < rmax; k++) {
+      while (rnod->d_oper == RE_CTRL) rnod = rnod->p_next;
+      result[k] = rnod->d_cval;
+      rnod = rnod->p_next;
+    }
+    result[rmax] = nilq;
+    return result;
+  }
+
+  // check that the required literal is in a string
+  static bool re_rlit_p (const s_regex* recni, const t_quad* s,
+			 const long slen) {
+    const t_quad* rlit = recni->p_rlit;
+    long rlen = recni->d_rlen;
+    if (rlit == nullptr) return true;
+    for (long k = 0L; k + rlen <= slen; k++) {
+      if (s[k] != rlit[0]) continue;
+      long i = 1L;
+      while ((i < rlen) && (s[k+i] == rlit[i])) i++;
+      if (i == rlen) return true;
+    }
+    return false;
+  }
+
+  // the regex string buffer
+  struct s_resbuf {
+    // the string data
+    t_quad* p_sbuf;
+    // the string length
+    long    d_slen;
+    // create a string buffer
+    s_resbuf (const String& s) {
+      p_sbuf = s.toquad ();
+      d_slen = Unicode::strlen (p_sbuf);
+    }
+    // destroy this buffer
+    ~s_resbuf (void) {
+      delete [] p_sbuf;
+    }
+  };
+
+  // the regex cache entry - each entry has its own lock which is only
+  // taken while a regex is compiled, the matches never use the cache
+  struct s_recsh {
+    // the regex string
+    String   d_reval;
+    // the regex structure
+    s_regex* p_recni;
+    // the entry mutex
+    Mutex    d_cmtx;
+    // create an empty entry
+    s_recsh (void) {
+      p_recni = nullptr;
+    }
+  };
+
+  // the regex cache
+  static s_recsh* re_csh_get (void) {
+    static s_recsh csh[RE_CSH_SIZE];
+    return csh;
+  }
+
+  // get the regex cache index
+  static long re_csh_idx (const String& re) {
+    long hid = re.hashid ();
+    if (hid < 0L) hid = -hid;
+    return hid % RE_CSH_SIZE;
+  }
+
+  // find a regex structure in the cache
+  static s_regex* re_csh_find (const String& re) {
+    long cidx = re_csh_idx (re);
+    s_regex* result = nullptr;
+    s_recsh& csh = re_csh_get()[cidx];
+    csh.d_cmtx.lock ();
+    if ((csh.p_recni != nullptr) && (csh.d_reval == re)) {
+      result = re_iref (csh.p_recni);
+    }
+    csh.d_cmtx.unlock ();
+    return result;
+  }
+
+  // add a regex structure in the cache
+  static void re_csh_add (const String& re, s_regex* recni) {
+    long cidx = re_csh_idx (re);
+    s_regex* recno = nullptr;
+    s_recsh& csh = re_csh_get()[cidx];
+    csh.d_cmtx.lock ();
+    recno = csh.p_recni;
+    csh.d_reval = re;
+    csh.p_recni = re_iref (recni);
+    csh.d_cmtx.unlock ();
+    re_dref (recno);
+  }
+
+  // the regex scanner structure
+  struct s_rescan {
+    // the regex structures
+    s_regex** p_rvec;
+    // the regex vector size
+    long      d_rsiz;
+    // the number of regex
+    long      d_rlen;
+    // the combined automaton
+    s_reauto* p_auto;
+    // the automaton scan state
+    s_rarun*  p_rrun;
+    // the build flag
+    bool      d_bflg;
+    // the character buffer
+    t_quad*   p_cbuf;
+    // the character buffer size
+    long      d_csiz;
+    // create an empty scanner structure
+    s_rescan (void) {
+      p_rvec = nullptr;
+      d_rsiz = 0L;
+      d_rlen = 0L;
+      p_auto = nullptr;
+      p_rrun = nullptr;
+      d_bflg = false;
+      p_cbuf = nullptr;
+      d_csiz = 0L;
+    }
+    // destroy this scanner structure
+    ~s_rescan (void) {
+      reset ();
+      delete [] p_rvec;
+      delete [] p_cbuf;
+    }
+    // reset this scanner structure
+    void reset (void) {
+      for (long k = 0L; k < d_rlen; k++) re_dref (p_rvec[k]);
+      d_rlen = 0L;
+      delete p_rrun;
+      p_rrun = nullptr;
+      delete p_auto;
+      p_auto = nullptr;
+      d_bflg = false;
+    }
+    // add a regex structure
+    void add (s_regex* recni) {
+      if (d_rlen == d_rsiz) {
+	long rsiz = (d_rsiz == 0L) ? 8L : 2L * d_rsiz;
+	s_regex** rvec = new s_regex*[rsiz];
+	for (long k = 0L; k < d_rlen; k++) rvec[k] = p_rvec[k];
+	delete [] p_rvec;
+	p_rvec = rvec;
+	d_rsiz = rsiz;
+      }
+      p_rvec[d_rlen++] = re_iref (recni);
+      delete p_rrun;
+      p_rrun = nullptr;
+      delete p_auto;
+      p_auto = nullptr;
+      d_bflg = false;
+    }
+    // build the combined automaton once
+    bool build (void) {
+      if (d_bflg == true) return (p_auto != nullptr);
+      d_bflg = true;
+      if (d_rlen == 0L) return false;
+      // the longest match must be the backtracker path of each regex
+      for (long k = 0L; k < d_rlen; k++) {
+	if (p_rvec[k]->d_fflg == false) return false;
+      }
+      s_renode** root = new s_renode*[d_rlen];
+      for (long k = 0L; k < d_rlen; k++) root[k] = p_rvec[k]->p_root;
+      p_auto = new s_reauto (RE_SCN_SMAX);
+      try {
+	p_auto->build (root, d_rlen);
+	p_rrun = new s_rarun (*p_auto);
+      } catch (...) {
+	delete p_auto;
+	p_auto = nullptr;
+      }
+      delete [] root;
+      return (p_auto != nullptr);
+    }
+    // add a character in the buffer
+    void cadd (const long clen, const t_quad c) {
+      if (clen + 1L >= d_csiz) {
+	long csiz = (d_csiz == 0L) ? 256L : 2L * d_csiz;
+	t_quad* cbuf = new t_quad[csiz];
+	for (long k = 0L; k < clen; k++) cbuf[k] = p_cbuf[k];
+	delete [] p_cbuf;
+	p_cbuf = cbuf;
+	d_csiz = csiz;
+      }
+      p_cbuf[clen] = c;
+    }
+    // match the longest string of an input stream
+    long match (InputStream* is, String& lval) {
+      lval = "";
+      if ((is == nullptr) || (build () == false)) return -1L;
+      // run the automaton until no state is left
+      long clen = 0L;
+      long mlen = 0L;
+      long rtag = -1L;
+      long didx = p_rrun->start ();
+      while (true) {
+	if (is->iseos () == true) {
+	  long etag = p_rrun->etag (didx);
+	  if ((clen > 0L) && (etag >= 0L)) {
+	    rtag = etag;
+	    mlen = clen;
+	  }
+	  break;
+	}
+	t_quad c = is->getu ();
+	cadd (clen++, c);
+	didx = p_rrun->next (didx, c, false);
+	s_radstat* dst = p_rrun->p_dfa[didx];
+	if (dst->d_nlen == 0L) break;
+	if (dst->d_mtag >= 0L) {
+	  rtag = dst->d_mtag;
+	  mlen = clen;
+	}
+      }
+      // push back the characters read after the match
+      cadd (clen, nilq);
+      if (mlen < clen) is->pushback (String (p_cbuf + mlen));
+      p_cbuf[mlen] = nilq;
+      if (rtag >= 0L) lval = p_cbuf;
+      return rtag;
+    }
+  };
+
+  // create a new scanner structure
+  s_rescan* re_scn_new (void) {
+    return new s_rescan;
+  }
+
+  // delete a scanner structure
+  void re_scn_del (s_rescan* rscn) {
+    delete rscn;
+  }
+
+  // reset a scanner structure
+  void re_scn_reset (s_rescan* rscn) {
+    if (rscn != nullptr) rscn->reset ();
+  }
+
+  // get the number of regex of a scanner structure
+  long re_scn_length (const s_rescan* rscn) {
+    return (rscn == nullptr) ? 0L : rscn->d_rlen;
+  }
+
+  // add a regex structure to a scanner structure
+  void re_scn_add (s_rescan* rscn, s_regex* recni) {
+    if ((rscn == nullptr) || (recni == nullptr)) return;
+    rscn->add (recni);
+  }
+
+  // build the combined automaton of a scanner structure
+  bool re_scn_build (s_rescan* rscn) {
+    return (rscn == nullptr) ? false : rscn->build ();
+  }
+
+  // match the longest string of an input stream with a scanner structure
+  long re_scn_match (s_rescan* rscn, InputStream* is, String& lval) {
+    if (rscn == nullptr) {
+      lval = "";
+      return -1L;
+    }
+    return rscn->match (is, lval);
+  }
+
   // -------------------------------------------------------------------------
   // - class section                                                         -
   // -------------------------------------------------------------------------
@@ -1048,8 +2004,7 @@ namespace afnix {
     that.rdlock ();
     try {
       d_reval = that.d_reval;
-      p_recni = that.p_recni;
-      p_recni->d_rcount++;
+      p_recni = re_iref (that.p_recni);
       that.unlock ();
     } catch (...) {
       that.unlock ();
@@ -1060,10 +2015,7 @@ namespace afnix {
   // destroy this regex
 
   Regex::~Regex (void) {
-    if (--p_recni->d_rcount == 0) {
-      delete p_recni->p_root;
-      delete p_recni;
-    }
+    re_dref (p_recni);
   }
 
   // return the class name
@@ -1084,7 +2036,7 @@ namespace afnix {
     wrlock ();
     try {
       d_reval = "";
-      delete p_recni; p_recni = new s_regex;
+      re_dref (p_recni); p_recni = new s_regex;
       unlock ();
     } catch (...) {
       unlock ();
@@ -1174,12 +2126,9 @@ namespace afnix {
       // copy regex value
       d_reval = that.d_reval;
       // reference the regex structure
-      if (--p_recni->d_rcount == 0) {
-	delete p_recni->p_root;
-	delete p_recni;      
-      }
+      re_iref (that.p_recni);
+      re_dref (p_recni);
       p_recni = that.p_recni;
-      p_recni->d_rcount++;
       // unlock everything
       unlock ();
       that.unlock ();
@@ -1219,37 +2168,44 @@ namespace afnix {
     }
   }
 
-  // compile a string as a regex
+  // compile a string as a regex - the compiled regex structures are
+  // shared by regex string in a cache
 
   void Regex::compile (const String& re) {
     wrlock ();
+    s_regex* recni = nullptr;
     try {
-      // clean the old compiled node info
-      if (--p_recni->d_rcount == 0) {
-	delete p_recni->p_root;
-	delete p_recni;
-	p_recni = new s_regex;
-      }
-      // create an input stream
-      InputString is (re);
-      // get the root and last node
-      p_recni->p_root = re_compile   (is, false);
-      p_recni->p_last = re_find_last (p_recni->p_root);
-      // check for consistency
-      if (is.iseos () == false) {
-	delete p_recni->p_root;
-	p_recni->p_root = nullptr;
-	p_recni->p_last = nullptr;
-	throw Exception ("regex-error", "regex syntax error", re);
+      // check the cache first
+      recni = re_csh_find (re);
+      if (recni == nullptr) {
+	recni = new s_regex;
+	// create an input stream
+	InputString is (re);
+	// get the root and last node
+	recni->p_root = re_compile   (is, false);
+	recni->p_last = re_find_last (recni->p_root);
+	// check for consistency
+	if (is.iseos () == false) {
+	  throw Exception ("regex-error", "regex syntax error", re);
+	}
+	// build the automaton and the required literal
+	recni->p_auto = re_auto_new (recni->p_root);
+	recni->d_fflg = re_check_auto (recni->p_root, true);
+	recni->d_pflg = re_check_auto (recni->p_root, false);
+	recni->p_rlit = re_rlit_new (recni->p_root, recni->d_rlen);
+	re_csh_add (re, recni);
       }
+      // bind the regex structure
+      re_dref (p_recni);
+      p_recni = recni;
       // save the string regex
       d_reval = re;
       // unlock the regex
       unlock ();
     } catch (...) {
-      delete p_recni->p_root;
-      p_recni->p_root = nullptr;
-      p_recni->p_last = nullptr;
+      re_dref (recni);
+      re_dref (p_recni);
+      p_recni = new s_regex;
       unlock ();
       throw;
     }
@@ -1266,6 +2222,24 @@ namespace afnix {
       // get the group vector
       grpv = re_get_grpv (d_gmap);
       if (grpv != nullptr) grpv->reset ();
+      // check the required literal and the automaton
+      s_reauto* pa = p_recni->p_auto;
+      if ((pa != nullptr) || (p_recni->p_rlit != nullptr)) {
+	s_resbuf sb (s);
+	if (re_rlit_p (p_recni, sb.p_sbuf, sb.d_slen) == false) {
+	  unlock ();
+	  return false;
+	}
+	// the automaton rejects any string the backtracker rejects
+	if ((pa != nullptr) && (pa->full (sb.p_sbuf, sb.d_slen) == false)) {
+	  unlock ();
+	  return false;
+	}
+	if ((pa != nullptr) && (p_recni->d_fflg == true)) {
+	  unlock ();
+	  return true;
+	}
+      }
       // create a regex context
       s_rectx ctx (s, 0, grpv);
       bool result = re_exec_root (p_recni->p_root, ctx) & ctx.iseos ();
@@ -1288,6 +2262,24 @@ namespace afnix {
     try {
       // get the group vector
       grpv = re_get_grpv (d_gmap);
+      // check the required literal and the automaton
+      s_reauto* pa = p_recni->p_auto;
+      if ((pa != nullptr) || (p_recni->p_rlit != nullptr)) {
+	if (grpv != nullptr) grpv->reset ();
+	s_resbuf sb (s);
+	if (re_rlit_p (p_recni, sb.p_sbuf, sb.d_slen) == false) {
+	  unlock ();
+	  return false;
+	}
+	if ((pa != nullptr) && (pa->find (sb.p_sbuf, sb.d_slen) == false)) {
+	  unlock ();
+	  return false;
+	}
+	if ((pa != nullptr) && (p_recni->d_pflg == true)) {
+	  unlock ();
+	  return true;
+	}
+      }
       // process along the string
       long len = s.length ();
       for (long i = 0; i < len; i++) {
@@ -1385,9 +2377,21 @@ namespace afnix {
     try {
       // get the group vector
       grpv = re_get_grpv (d_gmap);
-      // process along the string
-      long len = s.length ();
+      if (grpv != nullptr) grpv->reset ();
+      // check the required literal
+      s_resbuf  sb (s);
+      if (re_rlit_p (p_recni, sb.p_sbuf, sb.d_slen) == false) {
+	unlock ();
+	return "";
+      }
+      // process along the string - the automaton filters the start index
+      s_reauto* pa = p_recni->p_auto;
+      long len = sb.d_slen;
       for (long i = 0; i < len; i++) {
+	if (pa != nullptr) {
+	  bool status = pa->anch (sb.p_sbuf, len, i);
+	  if (status == false) continue;
+	}
 	// reset the group vector
 	if (grpv != nullptr) grpv->reset ();
 	// create a regex context
@@ -1416,17 +2420,32 @@ namespace afnix {
     try {
       // get the group vector
       grpv = re_get_grpv (d_gmap);
+      // check the required literal
+      s_resbuf sb (s);
+      if (re_rlit_p (p_recni, sb.p_sbuf, sb.d_slen) == false) {
+	if (grpv != nullptr) grpv->reset ();
+	unlock ();
+	return s;
+      }
       // initialize result buffer
       Buffer result (Encoding::EMOD_UTF8);
-      // process along the string
-      long len = s.length ();
+      // process along the string - the automaton filters the start index
+      s_reauto* pa = p_recni->p_auto;
+      long len = sb.d_slen;
       for (long i = 0; i < len; i++) {
+	if (pa != nullptr) {
+	  bool status = pa->anch (sb.p_sbuf, len, i);
+	  if (status == false) {
+	    result.add (sb.p_sbuf[i]);
+	    continue;
+	  }
+	}
 	// reset the group vector
 	if (grpv != nullptr) grpv->reset ();
 	// create a regex context
 	s_rectx ctx (s, i, grpv);
 	if (re_exec_root (p_recni->p_root, ctx) == false) {
-	  result.add (s[i]);
+	  result.add (sb.p_sbuf[i]);
 	  continue;
 	}
 	result.add (val);
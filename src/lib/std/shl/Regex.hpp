@@ -150,6 +150,10 @@ namespace afnix {
     /// @param index the group index
     t_real getreal (const long index) const;
 
+  private:
+    // make the regex scanner a friend
+    friend class Regscan;
+
   public:
     /// create a new object in a generic way
     /// @param argv the argument vector
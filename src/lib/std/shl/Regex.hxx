@@ -0,0 +1,51 @@
+// ---------------------------------------------------------------------------
+// - Regex.hxx                                                               -
+// - standard object library - private regex scanner definitions             -
+// ---------------------------------------------------------------------------
+// - This program is free software;  you can redistribute it  and/or  modify -
+// - it provided that this copyright notice is kept intact.                  -
+// -                                                                         -
+// - This program  is  distributed in  the hope  that it will be useful, but -
+// - without  any  warranty;  without  even   the   implied    warranty   of -
+// - merchantability or fitness for a particular purpose.  In no event shall -
+// - the copyright holder be liable for any  direct, indirect, incidental or -
+// - special damages arising in any way out of the use of this software.     -
+// ---------------------------------------------------------------------------
+// - copyright (c) 1999-2021 amaury darsch                                   -
+// ---------------------------------------------------------------------------
+
+#ifndef  AFNIX_REGEX_HXX
+#define  AFNIX_REGEX_HXX
+
+#ifndef  AFNIX_INPUTSTREAM_HPP
+#include "InputStream.hpp"
+#endif
+
+namespace afnix {
+
+  // the scanner structure is defined with the regex automaton so that
+  // the regex scanner can combine the compiled regex structures
+
+  // create a new scanner structure
+  struct s_rescan* re_scn_new (void);
+
+  // delete a scanner structure
+  void re_scn_del (struct s_rescan* rscn);
+
+  // reset a scanner structure
+  void re_scn_reset (struct s_rescan* rscn);
+
+  // get the number of regex of a scanner structure
+  long re_scn_length (const struct s_rescan* rscn);
+
+  // add a regex structure to a scanner structure
+  void re_scn_add (struct s_rescan* rscn, struct s_regex* recni);
+
+  // build the combined automaton of a scanner structure
+  bool re_scn_build (struct s_rescan* rscn);
+
+  // match the longest string of an input stream with a scanner structure
+  long re_scn_match (struct s_rescan* rscn, InputStream* is, String& lval);
+}
+
+#endif
@@ -0,0 +1,114 @@
+// ---------------------------------------------------------------------------
+// - Regscan.cpp                                                             -
+// - standard object library - regex scanner class implementation            -
+// ---------------------------------------------------------------------------
+// - This program is free software;  you can redistribute it  and/or  modify -
+// - it provided that this copyright notice is kept intact.                  -
+// -                                                                         -
+// - This program  is  distributed in  the hope  that it will be useful, but -
+// - without  any  warranty;  without  even   the   implied    warranty   of -
+// - merchantability or fitness for a particular purpose.  In no event shall -
+// - the copyright holder be liable for any  direct, indirect, incidental or -
+// - special damages arising in any way out of the use of this software.     -
+// ---------------------------------------------------------------------------
+// - copyright (c) 1999-2021 amaury darsch                                   -
+// ---------------------------------------------------------------------------
+
+#include "Regex.hxx"
+#include "Regscan.hpp"
+
+namespace afnix {
+
+  // -------------------------------------------------------------------------
+  // - class section                                                         -
+  // -------------------------------------------------------------------------
+
+  // create an empty regex scanner
+
+  Regscan::Regscan (void) {
+    p_rscn = re_scn_new ();
+  }
+
+  // destroy this regex scanner
+
+  Regscan::~Regscan (void) {
+    re_scn_del (p_rscn);
+  }
+
+  // return the class name
+
+  String Regscan::repr (void) const {
+    return "Regscan";
+  }
+
+  // reset this regex scanner
+
+  void Regscan::reset (void) {
+    wrlock ();
+    try {
+      re_scn_reset (p_rscn);
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // return the number of regex
+
+  long Regscan::length (void) const {
+    rdlock ();
+    try {
+      long result = re_scn_length (p_rscn);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // add a regex to this scanner
+
+  void Regscan::add (const Regex& re) {
+    wrlock ();
+    re.rdlock ();
+    try {
+      re_scn_add (p_rscn, re.p_recni);
+      re.unlock ();
+      unlock ();
+    } catch (...) {
+      re.unlock ();
+      unlock ();
+      throw;
+    }
+  }
+
+  // return true if the combined automaton can be built
+
+  bool Regscan::valid (void) {
+    wrlock ();
+    try {
+      bool result = re_scn_build (p_rscn);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // match the longest string of an input stream
+
+  long Regscan::match (InputStream* is, String& lval) {
+    wrlock ();
+    try {
+      long result = re_scn_match (p_rscn, is, lval);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+}
@@ -0,0 +1,82 @@
+// ---------------------------------------------------------------------------
+// - Regscan.hpp                                                             -
+// - standard object library - regex scanner class definition                -
+// ---------------------------------------------------------------------------
+// - This program is free software;  you can redistribute it  and/or  modify -
+// - it provided that this copyright notice is kept intact.                  -
+// -                                                                         -
+// - This program  is  distributed in  the hope  that it will be useful, but -
+// - without  any  warranty;  without  even   the   implied    warranty   of -
+// - merchantability or fitness for a particular purpose.  In no event shall -
+// - the copyright holder be liable for any  direct, indirect, incidental or -
+// - special damages arising in any way out of the use of this software.     -
+// ---------------------------------------------------------------------------
+// - copyright (c) 1999-2021 amaury darsch                                   -
+// ---------------------------------------------------------------------------
+
+#ifndef  AFNIX_REGSCAN_HPP
+#define  AFNIX_REGSCAN_HPP
+
+#ifndef  AFNIX_REGEX_HPP
+#include "Regex.hpp"
+#endif
+
+#ifndef  AFNIX_INPUTSTREAM_HPP
+#include "InputStream.hpp"
+#endif
+
+namespace afnix {
+
+  /// The Regscan class is a regex scanner which combines several regex
+  /// into a single tagged automaton. The automaton is run once on an
+  /// input stream and the longest string matched by any regex is returned
+  /// with the regex index. When several regex match the longest string,
+  /// the regex with the highest index is selected. A regex with groups,
+  /// or a regex which backtracker path might be shorter than the longest
+  /// match, cannot be combined, in which case the scanner is not valid.
+  /// @author amaury darsch
+
+  class Regscan : public Object {
+  private:
+    /// the scanner structure
+    struct s_rescan* p_rscn;
+
+  public:
+    /// create an empty scanner
+    Regscan (void);
+
+    /// destroy this scanner
+    ~Regscan (void);
+
+    /// @return the class name
+    String repr (void) const override;
+
+    /// reset this scanner
+    virtual void reset (void);
+
+    /// @return the number of regex
+    virtual long length (void) const;
+
+    /// add a regex to this scanner
+    /// @param re the regex to add
+    virtual void add (const Regex& re);
+
+    /// @return true if the combined automaton can be built
+    virtual bool valid (void);
+
+    /// match the longest string of an input stream - the characters read
+    /// after the match are pushed back in the stream
+    /// @param is   the input stream to match
+    /// @param lval the matched string
+    /// @return the matching regex index or -1
+    virtual long match (InputStream* is, String& lval);
+
+  private:
+    // make the copy constructor private
+    Regscan (const Regscan&) =delete;
+    // make the assignment operator private
+    Regscan& operator = (const Regscan&) =delete;
+  };
+}
+
+#endif
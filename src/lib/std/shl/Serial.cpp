@@ -35,6 +35,7 @@
 #include "QuarkZone.hpp"
 #include "PrintTable.hpp"
 #include "InputStream.hpp"
+#include "OutputBuffer.hpp"
 #include "cmem.hpp"
 #include "ccnv.hpp"
 #include "OutputTerm.hpp"
@@ -62,6 +63,14 @@ namespace afnix {
   //   0001 dddd dddd dddd ssss ssss ssss ssss   com
   //   0010 dddd dddd dddd ssss ssss ssss ssss   biz
   //   0011 dddd dddd dddd ssss ssss ssss ssss   usr
+
+  // The version bits select the wire format of the object payload. With
+  // version 00, the integers and reals are written with a fixed width in
+  // network order and the data arrays are written by chunks. With version
+  // 01, the integers are written as LEB128 varints (zigzag for signed
+  // values), the reals in little endian and the data arrays as a single
+  // contiguous block. Version 10 is version 01 with a varint length prefix
+  // written after the did/sid so that a reader can skip the object.
   
   // the default array size
   static const long      SRL_ARRY_SIZ = 1L << 14;
@@ -69,6 +78,14 @@ namespace afnix {
   static const long      SRL_DEOD_MAX = 1L << 14;
   // the dispatch id mask
   static const t_word    SRL_DEOD_MSK = 0xC000U;
+  // the version 2 bits
+  static const t_word    SRL_VERS_SV2 = 0x4000U;
+  // the version 2 with length prefix bits
+  static const t_word    SRL_VERS_SVL = 0x8000U;
+  // the maximum varint size
+  static const long      SRL_VINT_MAX = 10L;
+  // the bulk conversion block size
+  static const long      SRL_CBLK_SIZ = 1024L;
   // the serial dispatcher table
   static Serial::t_deod* SRL_DEOD_TBL = nullptr;
 
@@ -132,6 +149,158 @@ namespace afnix {
     return (deod == nullptr) ? nullptr : deod (sid);
   }
 
+  // get the version bits of an output stream
+  static inline t_word srl_vers_bits (const OutputStream& os) {
+    if (os.getsver () == 1L) return 0x0000U;
+    return (os.getslpf () == true) ? SRL_VERS_SVL : SRL_VERS_SV2;
+  }
+
+  // map the version bits to a serial version
+  static inline long srl_vers_sver (const t_word vbit) {
+    if (vbit == 0x0000U) return 1L;
+    if ((vbit == SRL_VERS_SV2) || (vbit == SRL_VERS_SVL)) return 2L;
+    throw Exception ("serial-error", "invalid serial version bits",
+		     Utility::tohexa (vbit, true, true));
+  }
+  
+  // write a did/sid header to an output stream
+  static inline void srl_wrhdr (const t_word did, const t_word sid,
+				OutputStream& os) {
+    t_byte hbuf[4];
+    c_whton (did, &hbuf[0]);
+    c_whton (sid, &hbuf[2]);
+    os.write ((char*) hbuf, 4);
+  }
+
+  // write an unsigned varint to an output stream
+  static inline void srl_wrvu (const t_octa uval, OutputStream& os) {
+    t_byte vbuf[SRL_VINT_MAX];
+    long   vlen = 0L;
+    t_octa oval = uval;
+    do {
+      t_byte bval = (t_byte) (oval & 0x7FULL);
+      oval >>= 7;
+      if (oval != 0ULL) bval |= 0x80U;
+      vbuf[vlen++] = bval;
+    } while (oval != 0ULL);
+    os.write ((char*) vbuf, vlen);
+  }
+
+  // read an unsigned varint from an input stream
+  static inline t_octa srl_rdvu (InputStream& is) {
+    t_octa result = 0ULL;
+    for (long k = 0L; k < SRL_VINT_MAX; k++) {
+      t_byte bval = (t_byte) is.read ();
+      result |= ((t_octa) (bval & 0x7FU)) << (7 * k);
+      if ((bval & 0x80U) == 0x00U) return result;
+    }
+    throw Exception ("serial-error", "invalid varint encoding");
+  }
+
+  // write a signed varint to an output stream
+  static inline void srl_wrvs (const t_long lval, OutputStream& os) {
+    t_octa uval = (((t_octa) lval) << 1) ^ ((t_octa) (lval >> 63));
+    srl_wrvu (uval, os);
+  }
+
+  // read a signed varint from an input stream
+  static inline t_long srl_rdvs (InputStream& is) {
+    t_octa uval = srl_rdvu (is);
+    return (t_long) ((uval >> 1) ^ (~(uval & 1ULL) + 1ULL));
+  }
+
+  // convert an octa to a little endian byte array
+  static inline void srl_otole (const t_octa oval, t_byte* data) {
+    for (long k = 0L; k < 8L; k++) data[k] = (t_byte) (oval >> (8 * k));
+  }
+
+  // convert a little endian byte array to an octa
+  static inline t_octa srl_letoo (const t_byte* data) {
+    t_octa result = 0ULL;
+    for (long k = 0L; k < 8L; k++) result |= ((t_octa) data[k]) << (8 * k);
+    return result;
+  }
+
+  // convert a real to a little endian byte array
+  static inline void srl_rtole (const t_real rval, t_byte* data) {
+    union { t_real d_rval; t_octa d_oval; } rmap;
+    rmap.d_rval = rval;
+    srl_otole (rmap.d_oval, data);
+  }
+
+  // convert a little endian byte array to a real
+  static inline t_real srl_letor (const t_byte* data) {
+    union { t_real d_rval; t_octa d_oval; } rmap;
+    rmap.d_oval = srl_letoo (data);
+    return rmap.d_rval;
+  }
+
+  // write a bulk block header to an output stream
+  static inline void srl_wrbhd (const t_word sid, const long size,
+				OutputStream& os) {
+    srl_wrhdr (SRL_DEOD_STD | SRL_VERS_SV2, sid, os);
+    srl_wrvu ((t_octa) size, os);
+  }
+
+  // read a bulk block of bytes from an input stream
+  static inline void srl_rdbyte (InputStream& is, t_byte* data,
+				 const long size) {
+    if (size <= 0L) return;
+    if (is.copy ((char*) data, size) != size) {
+      throw Exception ("serial-error", "inconsistent size in bulk block");
+    }
+  }
+
+  // check a serial array header against an array type and return true
+  // if the header is a bulk block header
+  static bool srl_rdahd (InputStream& is, const t_word asid) {
+    // check for eos
+    if (is.iseos () == true) throw Exception ("serial-error", "eos in array");
+    // read the header
+    t_word did = is.readw (false);
+    t_word sid = is.readw (false);
+    if (((did & ~SRL_DEOD_MSK) != SRL_DEOD_STD) || (sid != asid)) {
+      throw Exception ("serial-error", "invalid serial array header",
+		       Utility::tohexa (sid, true, true));
+    }
+    return ((did & SRL_DEOD_MSK) != 0x0000U);
+  }
+
+  // read an object from an input stream with a serial version
+  static void srl_rdstream (Serial* sobj, InputStream& is, const t_word vbit) {
+    // get the stream version
+    long sver = is.getsver ();
+    bool slpf = is.getslpf ();
+    long over = srl_vers_sver (vbit);
+    // read directly with the same version
+    if (over == sver) {
+      sobj->rdstream (is);
+      return;
+    }
+    // read with the object version
+    is.setsver (over);
+    try {
+      sobj->rdstream (is);
+      is.setsver (sver, slpf);
+    } catch (...) {
+      is.setsver (sver, slpf);
+      throw;
+    }
+  }
+
+  // skip a byte block in an input stream
+  static void srl_skip (InputStream& is, const t_octa size) {
+    char   sbuf[SRL_CBLK_SIZ];
+    t_octa ssiz = size;
+    while (ssiz > 0ULL) {
+      long blen = (ssiz < (t_octa) SRL_CBLK_SIZ) ? (long) ssiz : SRL_CBLK_SIZ;
+      if (is.copy (sbuf, blen) != blen) {
+	throw Exception ("serial-error", "eos while skipping object");
+      }
+      ssiz -= blen;
+    }
+  }
+
   // get a array data size by type
   static long srl_arry_dsz (const Serial::Array::t_btyp btyp) {
     long result = 0;
@@ -529,7 +698,8 @@ namespace afnix {
       t_word sid = is.readw (false);
       is.pushback ((char*) &did, sizeof(did));
       is.pushback ((char*) &sid, sizeof(sid));
-      bool result = ((did == SRL_DEOD_DID) && (sid == SRL_NILP_SID));
+      bool result = (((did & ~SRL_DEOD_MSK) == SRL_DEOD_DID) &&
+		     (sid == SRL_NILP_SID));
       is.unlock ();
       return result;
     } catch (...) {
@@ -559,6 +729,17 @@ namespace afnix {
   void Serial::wrbool (const long size, const bool* data, OutputStream& os) {
     // check for nil
     if (size == 0L) return;
+    // write a bulk block
+    if (os.getsver () == 2L) {
+      srl_wrbhd (SRL_BBLK_SID, size, os);
+      t_byte bblk[SRL_CBLK_SIZ];
+      for (long i = 0L; i < size; i += SRL_CBLK_SIZ) {
+	long blen = ((size - i) < SRL_CBLK_SIZ) ? (size - i) : SRL_CBLK_SIZ;
+	for (long k = 0L; k < blen; k++) bblk[k] = data[i+k] ? 0x01U : nilc;
+	os.write ((char*) bblk, blen);
+      }
+      return;
+    }
     // create an operating array
     Serial::Array arry (SRL_ARRY_SIZ, Serial::Array::ATYP_BOOL);
     for (long k = 0L; k < size; k++) {
@@ -588,7 +769,22 @@ namespace afnix {
     try {
       // read the data array
       for (long i = 0; i < size; i++) {
-	Array arry = Serial::rdarry (is);
+	// check for a bulk block
+	if (srl_rdahd (is, SRL_BBLK_SID) == true) {
+	  long blen = (long) srl_rdvu (is);
+	  if ((blen <= 0L) || (blen > (size - i))) {
+	    throw Exception ("serial-error", "inconsistent size in bulk block");
+	  }
+	  t_byte bblk[SRL_CBLK_SIZ];
+	  for (long j = 0L; j < blen; j += SRL_CBLK_SIZ) {
+	    long clen = ((blen - j) < SRL_CBLK_SIZ) ? (blen - j) : SRL_CBLK_SIZ;
+	    srl_rdbyte (is, bblk, clen);
+	    for (long k = 0L; k < clen; k++) result[i+j+k] = (bblk[k] != nilc);
+	  }
+	  i += (blen - 1L);
+	  continue;
+	}
+	Array arry (SRL_BBLK_SID); arry.rdstream (is);
 	long  blen = arry.length ();
 	for (long k = 0; k < blen; k++) result[i+k] = arry.getbool (k);
 	i += (blen - 1L);
@@ -615,8 +811,13 @@ namespace afnix {
   // serialize a character to an output stream
 
   void Serial::wrchar (const t_quad value, class OutputStream& os) {
-    Character cobj (value);
-    cobj.wrstream (os);
+    if (os.getsver () == 2L) {
+      srl_wrvu ((t_octa) value, os);
+    } else {
+      t_byte data[4];
+      c_qhton (value, data);
+      os.write ((char*) data, 4);
+    }
   }
 
   // deserialize a boolean
@@ -625,15 +826,22 @@ namespace afnix {
     // check for eos
     if (is.iseos () == true) throw Exception ("serial-error", "eos in rdchar");
     // read the character
-    Character cobj; cobj.rdstream (is);
-    return cobj.toquad ();
+    if (is.getsver () == 2L) return (t_quad) srl_rdvu (is);
+    t_byte data[4];
+    for (long i = 0; i < 4; i++) data[i] = (t_byte) is.read ();
+    return c_qntoh (data);
   }
  
   // serialize an integer to an output stream
 
   void Serial::wrlong (const t_long value, OutputStream& os) {
-    Integer iobj (value);
-    iobj.wrstream (os);
+    if (os.getsver () == 2L) {
+      srl_wrvs (value, os);
+    } else {
+      t_byte data[8];
+      c_ohton (value, data);
+      os.write ((char*) data, 8);
+    }
   }
 
   // serialize an integer array with a array
@@ -641,6 +849,23 @@ namespace afnix {
   void Serial::wrlong (const long size, const long* data, OutputStream& os) {
     // check for nil
     if (size == 0L) return;
+    // write a bulk block
+    if (os.getsver () == 2L) {
+      srl_wrbhd (SRL_LBLK_SID, size, os);
+      if ((c_isbe () == false) && (sizeof (long) == 8)) {
+	os.write ((const char*) data, size * 8L);
+	return;
+      }
+      t_byte lblk[SRL_CBLK_SIZ * 8L];
+      for (long i = 0L; i < size; i += SRL_CBLK_SIZ) {
+	long blen = ((size - i) < SRL_CBLK_SIZ) ? (size - i) : SRL_CBLK_SIZ;
+	for (long k = 0L; k < blen; k++) {
+	  srl_otole ((t_octa) ((t_long) data[i+k]), &lblk[k*8L]);
+	}
+	os.write ((char*) lblk, blen * 8L);
+      }
+      return;
+    }
     // create an operating array
     Serial::Array arry (SRL_ARRY_SIZ, Serial::Array::ATYP_LONG);
     for (long k = 0L; k < size; k++) {
@@ -658,8 +883,10 @@ namespace afnix {
     // check for eos
     if (is.iseos () == true) throw Exception ("serial-error", "eos in rdlong");
     // read the integer
-    Integer iobj; iobj.rdstream (is);
-    return iobj.tolong ();
+    if (is.getsver () == 2L) return srl_rdvs (is);
+    t_byte data[8];
+    for (long i = 0; i < 8; i++) data[i] = (t_byte) is.read ();
+    return c_ontoh (data);
   }
 
   // deserialize an integer array
@@ -672,7 +899,28 @@ namespace afnix {
     try {
       // read the data array
       for (long i = 0; i < size; i++) {
-	Array arry = Serial::rdarry (is);
+	// check for a bulk block
+	if (srl_rdahd (is, SRL_LBLK_SID) == true) {
+	  long blen = (long) srl_rdvu (is);
+	  if ((blen <= 0L) || (blen > (size - i))) {
+	    throw Exception ("serial-error", "inconsistent size in bulk block");
+	  }
+	  if ((c_isbe () == false) && (sizeof (long) == 8)) {
+	    srl_rdbyte (is, (t_byte*) &result[i], blen * 8L);
+	  } else {
+	    t_byte lblk[SRL_CBLK_SIZ * 8L];
+	    for (long j = 0L; j < blen; j += SRL_CBLK_SIZ) {
+	      long clen = ((blen-j) < SRL_CBLK_SIZ) ? (blen-j) : SRL_CBLK_SIZ;
+	      srl_rdbyte (is, lblk, clen * 8L);
+	      for (long k = 0L; k < clen; k++) {
+		result[i+j+k] = (long) ((t_long) srl_letoo (&lblk[k*8L]));
+	      }
+	    }
+	  }
+	  i += (blen - 1L);
+	  continue;
+	}
+	Array arry (SRL_LBLK_SID); arry.rdstream (is);
 	long  blen = arry.length ();
 	for (long k = 0; k < blen; k++) result[i+k] = arry.getlong (k);
 	i += (blen - 1);
@@ -687,8 +935,13 @@ namespace afnix {
   // serialize a real to an output stream
 
   void Serial::wrreal (const t_real value, OutputStream& os) {
-    Real zobj (value);
-    zobj.wrstream (os);
+    t_byte data[8];
+    if (os.getsver () == 2L) {
+      srl_rtole (value, data);
+    } else {
+      c_rhton (value, data);
+    }
+    os.write ((char*) data, 8);
   }
 
   // serialize a real array with a array
@@ -696,6 +949,21 @@ namespace afnix {
   void Serial::wrreal (const long size, const t_real* data, OutputStream& os) {
     // check for nil
     if (size == 0L) return;
+    // write a bulk block
+    if (os.getsver () == 2L) {
+      srl_wrbhd (SRL_RBLK_SID, size, os);
+      if (c_isbe () == false) {
+	os.write ((const char*) data, size * 8L);
+	return;
+      }
+      t_byte rblk[SRL_CBLK_SIZ * 8L];
+      for (long i = 0L; i < size; i += SRL_CBLK_SIZ) {
+	long blen = ((size - i) < SRL_CBLK_SIZ) ? (size - i) : SRL_CBLK_SIZ;
+	for (long k = 0L; k < blen; k++) srl_rtole (data[i+k], &rblk[k*8L]);
+	os.write ((char*) rblk, blen * 8L);
+      }
+      return;
+    }
     // create an operating array
     Serial::Array arry (SRL_ARRY_SIZ, Serial::Array::ATYP_REAL);
     for (long k = 0L; k < size; k++) {
@@ -713,8 +981,9 @@ namespace afnix {
     // check for eos
     if (is.iseos () == true) throw Exception ("serial-error", "eos in rdreal");
     // read the real
-    Real zobj; zobj.rdstream (is);
-    return zobj.toreal ();
+    t_byte data[8];
+    for (long i = 0; i < 8; i++) data[i] = (t_byte) is.read ();
+    return (is.getsver () == 2L) ? srl_letor (data) : c_ontor (data);
   }
 
   // deserialize a real data array
@@ -727,7 +996,28 @@ namespace afnix {
     try {
       // read the data array
       for (long i = 0; i < size; i++) {
-	Array arry = Serial::rdarry (is);
+	// check for a bulk block
+	if (srl_rdahd (is, SRL_RBLK_SID) == true) {
+	  long blen = (long) srl_rdvu (is);
+	  if ((blen <= 0L) || (blen > (size - i))) {
+	    throw Exception ("serial-error", "inconsistent size in bulk block");
+	  }
+	  if (c_isbe () == false) {
+	    srl_rdbyte (is, (t_byte*) &result[i], blen * 8L);
+	  } else {
+	    t_byte rblk[SRL_CBLK_SIZ * 8L];
+	    for (long j = 0L; j < blen; j += SRL_CBLK_SIZ) {
+	      long clen = ((blen-j) < SRL_CBLK_SIZ) ? (blen-j) : SRL_CBLK_SIZ;
+	      srl_rdbyte (is, rblk, clen * 8L);
+	      for (long k = 0L; k < clen; k++) {
+		result[i+j+k] = srl_letor (&rblk[k*8L]);
+	      }
+	    }
+	  }
+	  i += (blen - 1L);
+	  continue;
+	}
+	Array arry (SRL_RBLK_SID); arry.rdstream (is);
 	long  blen = arry.length ();
 	for (long k = 0; k < blen; k++) result[i+k] = arry.getreal (k);
 	i += (blen - 1);
@@ -778,9 +1068,11 @@ namespace afnix {
       // get a new object by serial id
       t_word   did = is.readw (false);
       t_word   sid = is.readw (false);
-      Serial* sobj = Serial::newso (did, sid);
+      Serial* sobj = Serial::newso (did & ~SRL_DEOD_MSK, sid);
       if (sobj == nullptr) return String();
-      return sobj->repr ();
+      String result = sobj->repr ();
+      Object::cref (sobj);
+      return result;
     } catch (...) {
       return String ();
     }
@@ -794,11 +1086,46 @@ namespace afnix {
     // get a new object by serial id
     t_word   did = is.readw (false);
     t_word   sid = is.readw (false);
-    Serial* sobj = Serial::newso (did, sid);
+    t_word  vbit = did & SRL_DEOD_MSK;
+    Serial* sobj = Serial::newso (did & ~SRL_DEOD_MSK, sid);
+    // skip the length prefix
+    if (vbit == SRL_VERS_SVL) srl_rdvu (is);
     if (sobj == nullptr) return nullptr;
     // read in the object
-    sobj->rdstream (is);
-    return sobj;
+    try {
+      srl_rdstream (sobj, is, vbit);
+      return sobj;
+    } catch (...) {
+      Object::cref (sobj);
+      throw;
+    }
+  }
+
+  // skip an object in an input stream
+
+  bool Serial::skip (InputStream& is) {
+    // check for eos
+    if (is.iseos () == true) return false;
+    // get the did/sid
+    t_word did = is.readw (false);
+    t_word sid = is.readw (false);
+    t_word vbit = did & SRL_DEOD_MSK;
+    // skip by length prefix
+    if (vbit == SRL_VERS_SVL) {
+      srl_skip (is, srl_rdvu (is));
+      return true;
+    }
+    // skip by deserialization
+    Serial* sobj = Serial::newso (did & ~SRL_DEOD_MSK, sid);
+    if (sobj == nullptr) return true;
+    try {
+      srl_rdstream (sobj, is, vbit);
+      Object::cref (sobj);
+      return true;
+    } catch (...) {
+      Object::cref (sobj);
+      throw;
+    }
   }
 
   // -------------------------------------------------------------------------
@@ -847,14 +1174,22 @@ namespace afnix {
   void Serial::serialize (OutputStream& os) const {
     rdlock ();
     try {
-      // get the did/sid
-      t_word did = System::wswap (getdid ());
-      t_word sid = System::wswap (getsid ());
+      // get the version bits
+      t_word vbit = srl_vers_bits (os);
       // write the did/sid
-      os.write ((char*) &did, sizeof(did));
-      os.write ((char*) &sid, sizeof(sid));
+      srl_wrhdr (getdid () | vbit, getsid (), os);
       // serialize the object
-      wrstream (os);
+      if (vbit == SRL_VERS_SVL) {
+	// serialize in a buffer without nested prefix
+	OutputBuffer ob; ob.setsver (2L, false);
+	wrstream (ob);
+	// write the length prefix and the object
+	Buffer sbuf = ob.tobuffer ();
+	srl_wrvu ((t_octa) sbuf.length (), os);
+	os.write ((const char*) sbuf.tobyte (), sbuf.length ());
+      } else {
+	wrstream (os);
+      }
       // unlock done
       unlock ();
     } catch (...) {
@@ -871,14 +1206,17 @@ namespace afnix {
       // get a new object by serial id
       t_word did = is.readw (false);
       t_word sid = is.readw (false);
-      if (did != getdid ()) {
+      t_word vbit = did & SRL_DEOD_MSK;
+      if ((did & ~SRL_DEOD_MSK) != getdid ()) {
 	throw Exception ("serial-error", "invalid did in unserialize");
       }	
       if (sid != getsid ()) {
 	throw Exception ("serial-error", "invalid sid in unserialize");
       }
+      // skip the length prefix
+      if (vbit == SRL_VERS_SVL) srl_rdvu (is);
       // read in the object
-      rdstream (is);
+      srl_rdstream (this, is, vbit);
       // unlock done
       unlock ();
     } catch (...) {
@@ -26,7 +26,11 @@ namespace afnix {
   /// The Serial class is an abstract class that defines the object 
   /// interface for serialization. An object serialization is performed 
   /// with the "wrstream" virtual method. The deserialization is performed
-  /// with the "rdstream" virtual method.
+  /// with the "rdstream" virtual method. The serial format is selected by
+  /// the stream serial version. The version 1 format uses fixed size
+  /// integers while the version 2 format uses varints and bulk data blocks,
+  /// with an optional length prefix that permits to skip an object. The
+  /// version is recorded with each object so that a reader can detect it.
   /// @author amaury darsch
 
   class Serial : public virtual Object {
@@ -276,6 +280,11 @@ namespace afnix {
     /// @return an object by deserialization
     static Object* deserialize (class InputStream& is);
 
+    /// skip an object in an input stream
+    /// @param is the input stream to read
+    /// @return false if the stream is at eos
+    static bool skip (class InputStream& is);
+
   public:
     /// create a default serial object
     Serial (void) =default;
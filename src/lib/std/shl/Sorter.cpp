@@ -14,8 +14,14 @@
 // - copyright (c) 1999-2021 amaury darsch                                   -
 // ---------------------------------------------------------------------------
 
+#include "Real.hpp"
 #include "Sorter.hpp"
 #include "String.hpp"
+#include "Integer.hpp"
+#include "Literal.hpp"
+#include "Unicode.hpp"
+#include "cucd.hpp"
+#include "cthr.hpp"
 
 namespace afnix {
 
@@ -23,59 +29,425 @@ namespace afnix {
   // - private section                                                       -
   // -------------------------------------------------------------------------
 
-  // this function makes a partition of the array and returns the 
-  // pivot index
-  static long qsort_part (Vector* argv, Sorter::t_cmpf cmpf,
-			  const long first, const long last) {
-    // initialize the pivot index, last index and next (unknown) index
-    long pidx = first;
-    long lidx = first;
-    long uidx = lidx + 1;
-    // get the pivot object - and protect it
-    Object* pvt = Object::iref (argv->get (pidx));
-    // swap until we have reached the last element
-    while (uidx <= last) {
-      Object* ref = Object::iref (argv->get (uidx));
-      if (cmpf (ref, pvt) == true) {
-	lidx++;
-	argv->set (uidx, argv->get (lidx));
-	argv->set (lidx, ref);
-      }
-      Object::tref (ref);
-      // the intel is in the other region
-      uidx++;
-    }
-    // place the pivot in proper position
-    argv->set (first, argv->get (lidx));
-    argv->set (lidx,  pvt);
-    Object::tref (pvt);
-    // the pivot index is now the last index
-    return lidx;
-  }
-
-  // this function performs a recursive quick sort
-  static void qsort_vector (Vector* argv, Sorter::t_cmpf cmpf,
-			    const long first, const long last) {
-    if (first >= last) return;
-    long pidx = qsort_part (argv, cmpf, first, last);
-    qsort_vector (argv, cmpf, first, pidx - 1);
-    qsort_vector (argv, cmpf, pidx + 1, last);
+  // the insertion sort maximum size
+  static const long SRT_ISRT_MAX  = 16L;
+  // the maximum number of sorting tasks
+  static const long SRT_TASK_TMAX = 8L;
+  // the minimum number of keys per sorting task
+  static const long SRT_TASK_SMIN = 65536L;
+
+  // this function computes the introsort depth limit
+  static long srt_depth (const long size) {
+    long result = 0L;
+    for (long n = size; n > 1L; n >>= 1) result += 2L;
+    return result;
+  }
+
+  // this function swaps two objects
+  static inline void srt_swap (Object** data, const long i, const long j) {
+    Object* obj = data[i];
+    data[i] = data[j];
+    data[j] = obj;
+  }
+
+  // this function performs an insertion sort in the range [lo, hi)
+  static void srt_isort (Object** data, Sorter::t_cmpf cmpf,
+			 const long lo, const long hi) {
+    for (long i = lo + 1L; i < hi; i++) {
+      Object* obj = data[i];
+      long j = i;
+      while ((j > lo) && (cmpf (obj, data[j-1]) == true)) {
+	data[j] = data[j-1];
+	j--;
+      }
+      data[j] = obj;
+    }
+  }
+
+  // this function sifts down a heap node
+  static void srt_sift (Object** data, Sorter::t_cmpf cmpf, const long lo,
+			long root, const long size) {
+    while (true) {
+      long child = 2L * root + 1L;
+      if (child >= size) break;
+      if ((child + 1L < size) &&
+	  (cmpf (data[lo+child], data[lo+child+1]) == true)) child++;
+      if (cmpf (data[lo+root], data[lo+child]) == false) break;
+      srt_swap (data, lo + root, lo + child);
+      root = child;
+    }
+  }
+
+  // this function performs a heap sort in the range [lo, hi)
+  static void srt_hsort (Object** data, Sorter::t_cmpf cmpf,
+			 const long lo, const long hi) {
+    long size = hi - lo;
+    for (long k = size / 2L - 1L; k >= 0L; k--) srt_sift (data, cmpf, lo, k, size);
+    for (long k = size - 1L; k > 0L; k--) {
+      srt_swap (data, lo, lo + k);
+      srt_sift (data, cmpf, lo, 0L, k);
+    }
+  }
+
+  // this function partitions the range [lo, hi) around a median of three
+  // pivot and returns the pivot index
+  static long srt_part (Object** data, Sorter::t_cmpf cmpf,
+			const long lo, const long hi) {
+    // move the median of three in the first position
+    long mi = lo + (hi - lo) / 2L;
+    long li = hi - 1L;
+    if (cmpf (data[mi], data[lo]) == true) srt_swap (data, mi, lo);
+    if (cmpf (data[li], data[mi]) == true) {
+      srt_swap (data, li, mi);
+      if (cmpf (data[mi], data[lo]) == true) srt_swap (data, mi, lo);
+    }
+    srt_swap (data, lo, mi);
+    // partition around the pivot
+    Object* pvt = data[lo];
+    long i = lo;
+    long j = hi;
+    while (true) {
+      do i++; while ((i < hi) && (cmpf (data[i], pvt) == true));
+      do j--; while ((j > lo) && (cmpf (pvt, data[j]) == true));
+      if (i >= j) break;
+      srt_swap (data, i, j);
+    }
+    srt_swap (data, lo, j);
+    return j;
+  }
+
+  // this function performs an introspective sort in the range [lo, hi)
+  static void srt_intro (Object** data, Sorter::t_cmpf cmpf,
+			 long lo, long hi, long depth) {
+    while (hi - lo > SRT_ISRT_MAX) {
+      if (depth-- == 0L) {
+	srt_hsort (data, cmpf, lo, hi);
+	return;
+      }
+      long pidx = srt_part (data, cmpf, lo, hi);
+      // recurse on the smaller partition
+      if (pidx - lo < hi - pidx) {
+	srt_intro (data, cmpf, lo, pidx, depth);
+	lo = pidx + 1L;
+      } else {
+	srt_intro (data, cmpf, pidx + 1L, hi, depth);
+	hi = pidx;
+      }
+    }
+    srt_isort (data, cmpf, lo, hi);
+  }
+
+  // this function performs a stable merge sort in the range [lo, hi)
+  static void srt_msort (Object** data, Object** tbuf, Sorter::t_cmpf cmpf,
+			 const long lo, const long hi) {
+    if (hi - lo <= SRT_ISRT_MAX) {
+      srt_isort (data, cmpf, lo, hi);
+      return;
+    }
+    long mi = lo + (hi - lo) / 2L;
+    srt_msort (data, tbuf, cmpf, lo, mi);
+    srt_msort (data, tbuf, cmpf, mi, hi);
+    // check for ordered runs
+    if (cmpf (data[mi], data[mi-1]) == false) return;
+    // merge the runs
+    for (long k = lo; k < hi; k++) tbuf[k] = data[k];
+    long i = lo, j = mi, k = lo;
+    while ((i < mi) && (j < hi)) {
+      data[k++] = (cmpf (tbuf[j], tbuf[i]) == true) ? tbuf[j++] : tbuf[i++];
+    }
+    while (i < mi) data[k++] = tbuf[i++];
+    while (j < hi) data[k++] = tbuf[j++];
+  }
+
+  // the sorting key
+  template <typename T> struct s_skey {
+    // the key value
+    T    d_kval;
+    // the object index
+    long d_oidx;
+  };
+
+  // the key comparison functions
+  static inline bool srt_klth (const t_long x, const t_long y) {
+    return x < y;
+  }
+  static inline bool srt_klth (const t_real x, const t_real y) {
+    return x < y;
+  }
+  static inline bool srt_klth (const t_quad* x, const t_quad* y) {
+    while (*x == *y) {
+      if (*x == nilq) return false;
+      x++; y++;
+    }
+    return *x < *y;
+  }
+
+  // this function returns true if a key goes before another one
+  template <typename T>
+  static inline bool srt_kbef (const s_skey<T>& x, const s_skey<T>& y,
+			       const bool asct) {
+    return asct ? srt_klth (x.d_kval, y.d_kval) : srt_klth (y.d_kval, x.d_kval);
+  }
+
+  // this function merges two sorted key runs
+  template <typename T>
+  static void srt_kmerge (s_skey<T>* data, s_skey<T>* tbuf, const long lo,
+			  const long mi, const long hi, const bool asct) {
+    // check for ordered runs
+    if (srt_kbef (data[mi], data[mi-1], asct) == false) return;
+    for (long k = lo; k < hi; k++) tbuf[k] = data[k];
+    long i = lo, j = mi, k = lo;
+    while ((i < mi) && (j < hi)) {
+      data[k++] = srt_kbef (tbuf[j], tbuf[i], asct) ? tbuf[j++] : tbuf[i++];
+    }
+    while (i < mi) data[k++] = tbuf[i++];
+    while (j < hi) data[k++] = tbuf[j++];
+  }
+
+  // this function performs a stable merge sort of the keys in [lo, hi)
+  template <typename T>
+  static void srt_kmsort (s_skey<T>* data, s_skey<T>* tbuf, const long lo,
+			  const long hi, const bool asct) {
+    if (hi - lo <= SRT_ISRT_MAX) {
+      for (long i = lo + 1L; i < hi; i++) {
+	s_skey<T> key = data[i];
+	long j = i;
+	while ((j > lo) && (srt_kbef (key, data[j-1], asct) == true)) {
+	  data[j] = data[j-1];
+	  j--;
+	}
+	data[j] = key;
+      }
+      return;
+    }
+    long mi = lo + (hi - lo) / 2L;
+    srt_kmsort (data, tbuf, lo, mi, asct);
+    srt_kmsort (data, tbuf, mi, hi, asct);
+    srt_kmerge (data, tbuf, lo, mi, hi, asct);
+  }
+
+  // the key sorting task
+  template <typename T> struct s_ktsk {
+    // the key array
+    s_skey<T>* p_data;
+    // the temporary array
+    s_skey<T>* p_tbuf;
+    // the range indexes
+    long d_lo;
+    long d_mi;
+    long d_hi;
+    // the ascending flag
+    bool d_asct;
+    // sort or merge the range
+    void run (void) {
+      if (d_mi < 0L) {
+	srt_kmsort (p_data, p_tbuf, d_lo, d_hi, d_asct);
+      } else {
+	srt_kmerge (p_data, p_tbuf, d_lo, d_mi, d_hi, d_asct);
+      }
+    }
+  };
+
+  // this procedure runs a key sorting task
+  template <typename T> static void* srt_ktask (void* args) {
+    auto ktsk = reinterpret_cast <s_ktsk<T>*> (args);
+    ktsk->run ();
+    return nullptr;
+  }
+
+  // this procedure runs a set of key sorting tasks
+  template <typename T> static void srt_krun (s_ktsk<T>* ktsk,
+					      const long tnum) {
+    void** args = new void*[tnum];
+    for (long t = 0L; t < tnum; t++) args[t] = &ktsk[t];
+    c_tskrun (srt_ktask<T>, args, tnum);
+    delete [] args;
+  }
+
+  // this function sorts the keys - the key ranges are sorted by tasks and
+  // merged by pairs when the number of keys is large
+  template <typename T>
+  static void srt_ksort (s_skey<T>* data, const long size, const bool asct) {
+    s_skey<T>* tbuf = new s_skey<T>[size];
+    long tnum = size / SRT_TASK_SMIN;
+    if (tnum > SRT_TASK_TMAX) tnum = SRT_TASK_TMAX;
+    if (tnum < 2L) {
+      srt_kmsort (data, tbuf, 0L, size, asct);
+      delete [] tbuf;
+      return;
+    }
+    // compute the range bounds
+    long* bnds = new long[tnum + 1L];
+    for (long t = 0L; t <= tnum; t++) bnds[t] = (size * t) / tnum;
+    s_ktsk<T>* ktsk = new s_ktsk<T>[tnum];
+    // sort the ranges
+    for (long t = 0L; t < tnum; t++) {
+      ktsk[t].p_data = data;
+      ktsk[t].p_tbuf = tbuf;
+      ktsk[t].d_lo   = bnds[t];
+      ktsk[t].d_mi   = -1L;
+      ktsk[t].d_hi   = bnds[t+1];
+      ktsk[t].d_asct = asct;
+    }
+    srt_krun (ktsk, tnum);
+    // merge the ranges by pairs
+    for (long w = 1L; w < tnum; w *= 2L) {
+      long mnum = 0L;
+      for (long t = 0L; t + w < tnum; t += 2L * w) {
+	long hi = (t + 2L * w < tnum) ? t + 2L * w : tnum;
+	ktsk[mnum].d_lo = bnds[t];
+	ktsk[mnum].d_mi = bnds[t+w];
+	ktsk[mnum].d_hi = bnds[hi];
+	mnum++;
+      }
+      srt_krun (ktsk, mnum);
+    }
+    delete [] ktsk;
+    delete [] bnds;
+    delete [] tbuf;
+  }
+
+  // this function sorts the objects by keys and the object indexes
+  template <typename T>
+  static void srt_ksort (Object** data, s_skey<T>* keys, const long size,
+			 const bool asct) {
+    srt_ksort (keys, size, asct);
+    Object** objs = new Object*[size];
+    for (long k = 0L; k < size; k++) objs[k] = data[k];
+    for (long k = 0L; k < size; k++) data[k] = objs[keys[k].d_oidx];
+    delete [] objs;
+  }
+
+  // this function sorts the objects by normalized string keys - the keys
+  // are normalized once as the string comparison normalizes its operands
+  static void srt_nsort (Object** data, const long size, const bool asct,
+			 const bool lflg) {
+    t_quad** nval = new t_quad*[size];
+    for (long k = 0L; k < size; k++) nval[k] = nullptr;
+    s_skey<const t_quad*>* keys = new s_skey<const t_quad*>[size];
+    try {
+      for (long k = 0L; k < size; k++) {
+	nval[k] = lflg ?
+	  Sorter::tonkey (dynamic_cast <Literal*> (data[k])->tostring ()) :
+	  Sorter::tonkey (*dynamic_cast <String*> (data[k]));
+	keys[k].d_kval = nval[k];
+	keys[k].d_oidx = k;
+      }
+      srt_ksort (data, keys, size, asct);
+      for (long k = 0L; k < size; k++) delete [] nval[k];
+      delete [] nval;
+      delete [] keys;
+    } catch (...) {
+      for (long k = 0L; k < size; k++) delete [] nval[k];
+      delete [] nval;
+      delete [] keys;
+      throw;
+    }
+  }
+
+  // this function sorts the objects by typed keys and returns false if
+  // the objects cannot be mapped to keys
+  static bool srt_ksort (Object** data, const long size,
+			 const Sorter::t_kmod kmod) {
+    if ((kmod == Sorter::KMOD_NONE) || (size < 2L)) return false;
+    // check for lexical keys
+    if (kmod == Sorter::KMOD_LEXC) {
+      for (long k = 0L; k < size; k++) {
+	if (dynamic_cast <Literal*> (data[k]) == nullptr) return false;
+      }
+      srt_nsort (data, size, true, true);
+      return true;
+    }
+    bool asct = (kmod == Sorter::KMOD_ASCT);
+    // check for integer keys
+    if (dynamic_cast <Integer*> (data[0]) != nullptr) {
+      s_skey<t_long>* keys = new s_skey<t_long>[size];
+      for (long k = 0L; k < size; k++) {
+	Integer* iobj = dynamic_cast <Integer*> (data[k]);
+	if (iobj == nullptr) {
+	  delete [] keys;
+	  return false;
+	}
+	keys[k].d_kval = iobj->tolong ();
+	keys[k].d_oidx = k;
+      }
+      srt_ksort (data, keys, size, asct);
+      delete [] keys;
+      return true;
+    }
+    // check for real keys
+    if (dynamic_cast <Real*> (data[0]) != nullptr) {
+      s_skey<t_real>* keys = new s_skey<t_real>[size];
+      for (long k = 0L; k < size; k++) {
+	Real* robj = dynamic_cast <Real*> (data[k]);
+	if (robj == nullptr) {
+	  delete [] keys;
+	  return false;
+	}
+	keys[k].d_kval = robj->toreal ();
+	keys[k].d_oidx = k;
+      }
+      srt_ksort (data, keys, size, asct);
+      delete [] keys;
+      return true;
+    }
+    // check for string keys
+    if (dynamic_cast <String*> (data[0]) != nullptr) {
+      for (long k = 0L; k < size; k++) {
+	if (dynamic_cast <String*> (data[k]) == nullptr) return false;
+      }
+      srt_nsort (data, size, asct, false);
+      return true;
+    }
+    return false;
   }
 
   // -------------------------------------------------------------------------
   // - class section                                                         -
   // -------------------------------------------------------------------------
 
+  // return a normalized string key
+
+  t_quad* Sorter::tonkey (const String& sval) {
+    t_quad* sbuf = sval.toquad ();
+    // an ascii string is already normalized
+    for (t_quad* sptr = sbuf; *sptr != nilq; sptr++) {
+      if (*sptr < 0x00000080U) continue;
+      t_quad* result = c_ucdnrm (sbuf, Unicode::strlen (sbuf));
+      delete [] sbuf;
+      return result;
+    }
+    return sbuf;
+  }
+
+  // compare two normalized string keys
+
+  bool Sorter::nkeylth (const t_quad* x, const t_quad* y) {
+    return srt_klth (x, y);
+  }
+
   // create a default sorter
 
   Sorter::Sorter (void) {
     p_cmpf = nullptr;
+    d_kmod = KMOD_NONE;
+    d_sflg = false;
   }
 
   // create a sorter with a compare method
 
   Sorter::Sorter (t_cmpf cmpf) {
     p_cmpf = cmpf;
+    d_kmod = KMOD_NONE;
+    d_sflg = false;
+  }
+
+  // create a sorter with a compare method and a key mode
+
+  Sorter::Sorter (t_cmpf cmpf, const t_kmod kmod) {
+    p_cmpf = cmpf;
+    d_kmod = kmod;
+    d_sflg = false;
   }
 
   // return the class name
@@ -92,20 +464,73 @@ namespace afnix {
     unlock ();
   }
 
+  // set the key mode
+
+  void Sorter::setkmod (const t_kmod kmod) {
+    wrlock ();
+    d_kmod = kmod;
+    unlock ();
+  }
+
+  // set the stable flag
+
+  void Sorter::setsflg (const bool sflg) {
+    wrlock ();
+    d_sflg = sflg;
+    unlock ();
+  }
+
   // quick sort method
 
   void Sorter::qsort (Vector* argv) const {
     // check for sorting method
-    if (p_cmpf == nullptr) return;
+    if ((p_cmpf == nullptr) || (argv == nullptr)) return;
     rdlock ();
     // sort the vector in place
     argv->wrlock ();
+    // the key sort does not call the compare function, so the vector
+    // objects are permuted in place
     try {
-      long argc = (argv == nullptr) ? 0 : argv->length ();
-      qsort_vector (argv, p_cmpf, 0, argc - 1);
+      if (srt_ksort (argv->p_vobj, argv->d_vlen, d_kmod) == true) {
+	argv->unlock ();
+	unlock ();
+	return;
+      }
+    } catch (...) {
+      argv->unlock ();
+      unlock ();
+      throw;
+    }
+    long     argc = argv->length ();
+    Object** data = (argc < 2L) ? nullptr : new Object*[argc];
+    Object** tbuf = nullptr;
+    try {
+      // collect and protect the objects
+      for (long k = 0L; k < argc && data != nullptr; k++) {
+	data[k] = Object::iref (argv->get (k));
+      }
+      // sort by compare function
+      if ((data != nullptr) && (d_sflg == true)) {
+	tbuf = new Object*[argc];
+	srt_msort (data, tbuf, p_cmpf, 0L, argc);
+      }
+      if ((data != nullptr) && (d_sflg == false)) {
+	srt_intro (data, p_cmpf, 0L, argc, srt_depth (argc));
+      }
+      // update the vector and release the objects
+      for (long k = 0L; k < argc && data != nullptr; k++) argv->set (k, data[k]);
+      for (long k = 0L; k < argc && data != nullptr; k++) Object::tref (data[k]);
+      delete [] tbuf;
+      delete [] data;
       argv->unlock ();
       unlock ();
     } catch (...) {
+      // the vector is unchanged
+      for (long k = 0L; k < argc && data != nullptr; k++) {
+	Object::tref (argv->get (k));
+      }
+      delete [] tbuf;
+      delete [] data;
       argv->unlock ();
       unlock ();
       throw;
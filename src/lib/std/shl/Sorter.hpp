@@ -27,6 +27,13 @@ namespace afnix {
   /// sort operation. The algorithm operates on an object vector and perform
   /// the sorting operation in place. The compare function that operates
   /// between two objects must be supplied by the user.
+  /// The quick sort is an introspective sort which switches to a heap sort
+  /// when the partition depth grows, so that the worst case is bounded. In
+  /// stable mode, a merge sort is used and the equal objects keep their
+  /// order. When a key mode is set and the vector holds only integers,
+  /// reals or strings, the keys are extracted once and sorted directly,
+  /// with a parallel merge for large vectors. The key mode must match the
+  /// compare function, which is otherwise used.
   /// @author amaury darsch
 
   class Sorter : public Object {
@@ -36,9 +43,32 @@ namespace afnix {
     /// @param slv the slave object
     using t_cmpf = bool (*) (Object* ref, Object* slv);
 
+    /// the key mode
+    enum t_kmod {
+      KMOD_NONE, // no key
+      KMOD_ASCT, // ascending operator order
+      KMOD_DSCT, // descending operator order
+      KMOD_LEXC  // lexicographic order
+    };
+
   private:
     /// the compare function
     t_cmpf p_cmpf;
+    /// the key mode
+    t_kmod d_kmod;
+    /// the stable flag
+    bool   d_sflg;
+
+  public:
+    /// @return a normalized string key which must be deleted by the caller
+    /// @param sval the string to normalize
+    static t_quad* tonkey (const String& sval);
+
+    /// @return true if a normalized string key is lower than another one,
+    ///         a key being lower than the keys it prefixes
+    /// @param x the first normalized key
+    /// @param y the second normalized key
+    static bool nkeylth (const t_quad* x, const t_quad* y);
 
   public:
     /// create a default sorter
@@ -48,6 +78,11 @@ namespace afnix {
     /// @param cmpf the compare function
     Sorter (t_cmpf cmpf);
 
+    /// create a sorter with a compare function and a key mode
+    /// @param cmpf the compare function
+    /// @param kmod the key mode
+    Sorter (t_cmpf cmpf, const t_kmod kmod);
+
     /// @return this class name
     String repr (void) const;
 
@@ -55,6 +90,14 @@ namespace afnix {
     /// @param cmpf the compare function
     void setcmpf (t_cmpf cmpf);
 
+    /// set the key mode
+    /// @param kmod the key mode to set
+    void setkmod (const t_kmod kmod);
+
+    /// set the stable flag
+    /// @param sflg the stable flag to set
+    void setsflg (const bool sflg);
+
     /// sort the object vector argument
     /// @param argv the argulent vector
     void qsort (Vector* argv) const;
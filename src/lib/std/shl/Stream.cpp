@@ -18,6 +18,8 @@
 #include "Stream.hpp"
 #include "Vector.hpp"
 #include "Boolean.hpp"
+#include "Integer.hpp"
+#include "Utility.hpp"
 #include "QuarkZone.hpp"
 #include "Exception.hpp"
 
@@ -31,12 +33,16 @@ namespace afnix {
 
   Stream::Stream (void) {
     d_emod = Encoding::EMOD_BYTE;
+    d_sver = 1L;
+    d_slpf = false;
   }
 
   // create a stream by coding mode
 
   Stream::Stream (const Encoding::t_emod emod) {
     d_emod = emod;
+    d_sver = 1L;
+    d_slpf = false;
   }
 
   // close this stream
@@ -115,6 +121,69 @@ namespace afnix {
     }
   }
 
+  // return the stream serial version
+
+  long Stream::getsver (void) const {
+    rdlock ();
+    try {
+      long result = d_sver;
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // return the stream serial length prefix flag
+
+  bool Stream::getslpf (void) const {
+    rdlock ();
+    try {
+      bool result = d_slpf;
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // set the stream serial version
+
+  void Stream::setsver (const long sver) {
+    wrlock ();
+    try {
+      setsver (sver, false);
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // set the stream serial version and length prefix flag
+
+  void Stream::setsver (const long sver, const bool slpf) {
+    wrlock ();
+    try {
+      if ((sver != 1L) && (sver != 2L)) {
+	throw Exception ("stream-error", "invalid serial version",
+			 Utility::tostring (sver));
+      }
+      if ((sver == 1L) && (slpf == true)) {
+	throw Exception ("stream-error",
+			 "serial length prefix requires version 2");
+      }
+      d_sver = sver;
+      d_slpf = slpf;
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // -------------------------------------------------------------------------
   // - object section                                                        -
   // -------------------------------------------------------------------------
@@ -125,13 +194,15 @@ namespace afnix {
   static const long QUARK_STREAM  = String::intern ("Stream");
 
   // the quark zone
-  static const long QUARK_ZONE_LENGTH = 3;
+  static const long QUARK_ZONE_LENGTH = 5;
   static QuarkZone  zone (QUARK_ZONE_LENGTH);
 
   // the object supported quarks
   static const long QUARK_CLOSE   = zone.intern ("close");
   static const long QUARK_GETEMOD = zone.intern ("get-encoding-mode");
   static const long QUARK_SETEMOD = zone.intern ("set-encoding-mode");
+  static const long QUARK_GETSVER = zone.intern ("get-serial-version");
+  static const long QUARK_SETSVER = zone.intern ("set-serial-version");
 
   // map an enumeration item to a stream coding mode
   static inline Encoding::t_emod item_to_emod (const Item& item) {
@@ -192,6 +263,7 @@ namespace afnix {
     if (argc == 0) {
       if (quark == QUARK_CLOSE) return new Boolean (close ());
       if (quark == QUARK_GETEMOD) return emod_to_item (getemod ());
+      if (quark == QUARK_GETSVER) return new Integer (getsver ());
     }
 
     // dispatch 1 argument
@@ -214,6 +286,20 @@ namespace afnix {
 	throw Exception ("argument-error", 
 			 "invalid arguments with set-coding-mode");
       }
+      if (quark == QUARK_SETSVER) {
+	long sver = argv->getlong (0);
+	setsver (sver);
+	return nullptr;
+      }
+    }
+    // dispatch 2 arguments
+    if (argc == 2) {
+      if (quark == QUARK_SETSVER) {
+	long sver = argv->getlong (0);
+	bool slpf = argv->getbool (1);
+	setsver (sver, slpf);
+	return nullptr;
+      }
     }
     // apply these arguments with the transcoder
     return Transcoder::apply (zobj, nset, quark, argv);
@@ -35,6 +35,10 @@ namespace afnix {
   protected:
     /// the encoding mode
     Encoding::t_emod d_emod;
+    /// the serial version
+    long d_sver;
+    /// the serial length prefix flag
+    bool d_slpf;
 
   public:
     /// create a default byte stream
@@ -61,6 +65,21 @@ namespace afnix {
     /// @param mode the coding mode to set
     virtual void setemod (const String& mode);
 
+    /// @return the stream serial version
+    virtual long getsver (void) const;
+
+    /// @return the stream serial length prefix flag
+    virtual bool getslpf (void) const;
+
+    /// set the stream serial version
+    /// @param sver the serial version to set
+    virtual void setsver (const long sver);
+
+    /// set the stream serial version and length prefix flag
+    /// @param sver the serial version to set
+    /// @param slpf the serial length prefix flag
+    virtual void setsver (const long sver, const bool slpf);
+
   public:
     /// evaluate an object data member
     /// @param zobj  zobj the current evaluable
@@ -187,6 +187,8 @@ namespace afnix {
   private:
     // make the vector iterator a friend
     friend class Vectorit;
+    // make the sorter a friend
+    friend class Sorter;
 
   public:
     /// @return a new iterator for this vector
@@ -112,6 +112,41 @@ int main (int, char**) {
   if (buffer->extract(0L, 5L).tostring () != "hello") return 1;
   if (buffer->collect(7L).tostring () != ":world:") return 1;
   if (buffer->tostring() != "hello") return 1;
+  // test the shared storage with a copy
+  Buffer cbuf = *buffer;
+  if ((cbuf.isshared () == false) || (buffer->isshared () == false)) return 1;
+  cbuf.add (" world");
+  if (cbuf.isshared () == true) return 1;
+  if (cbuf.tostring () != "hello world") return 1;
+  if (buffer->tostring () != "hello") return 1;
+  // test a slice view
+  Buffer sbuf = cbuf.slice (6L, 5L);
+  if (sbuf.isshared () == false) return 1;
+  if (sbuf.tostring () != "world") return 1;
+  if (sbuf.read () != 'w') return 1;
+  if (sbuf.isshared () == false) return 1;
+  if (cbuf.extract (0L, 5L).tostring () != "hello") return 1;
+  cbuf.set (6L, 'W');
+  if (cbuf.tostring () != "hello World") return 1;
+  if (sbuf.tostring () != "orld") return 1;
+  if (sbuf.isshared () == true) return 1;
+  // test a boundary view with a move
+  cbuf.reset ();
+  cbuf.add ("part\r\n--bnds");
+  Buffer* pbuf = cbuf.cpbnds ("--bnds");
+  if (pbuf->rmcrnl () == false) return 1;
+  if (pbuf->tostring () != "part") return 1;
+  if (cbuf.move (2L).tostring () != "--") return 1;
+  if (cbuf.tostring () != "bnds") return 1;
+  delete pbuf;
+  // test a block pushback before the read index and with a resize
+  if (cbuf.pushback ("nd", 2L) != 2L) return 1;
+  if (cbuf.tostring () != "ndbnds") return 1;
+  if (cbuf.pushback ("hello ", 6L) != 6L) return 1;
+  if (cbuf.tostring () != "hello ndbnds") return 1;
+  if (cbuf.read () != 'h') return 1;
+  if (cbuf.pushback ("0123456789abcdef", 16L) != 16L) return 1;
+  if (cbuf.tostring () != "0123456789abcdefello ndbnds") return 1;
   // finally - no failure
   delete bbuf;
   delete buffer;
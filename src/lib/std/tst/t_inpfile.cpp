@@ -28,10 +28,12 @@ int main (int, char**) {
   // loop on character and check count
   long count = 0;
   while (is.iseos () == false) {
+    if (is.tell () != count) return 1;
     is.read ();
     count++;
   }
   if (count != size) return 1;
+  if (is.tell () != size) return 1;
 
   // everything is fine
   return 0;
@@ -15,9 +15,11 @@
 // ---------------------------------------------------------------------------
 
 #include "Regex.hpp"
+#include "Regscan.hpp"
 #include "String.hpp"
 #include "Unicode.hpp"
 #include "InputString.hpp"
+#include "cthr.hpp"
 
 // simple char testing
 static bool re_check_char (void) {
@@ -271,6 +273,128 @@ static bool re_check_is (void) {
   return true;
 }
 
+// check for an automaton match
+static bool re_check_auto (void) {
+  using namespace afnix;
+  // pathological optional sequence
+  String rs = "";
+  String ss = "";
+  for (long k = 0; k < 32; k++) rs = rs + "a?";
+  for (long k = 0; k < 32; k++) rs = rs + 'a';
+  for (long k = 0; k < 31; k++) ss = ss + 'a';
+  if (Regex (rs) == ss)           return false;
+  if (Regex (rs) != (ss + 'a'))   return false;
+  if (Regex (rs) == (ss + 'b'))   return false;
+  if (Regex ("$d*$d*$d*x") < ss)  return false;
+
+  // partial match at the end of string
+  if ((Regex ("c$e") < "abc") == false) return false;
+  if (Regex ("b$e") < "abc")            return false;
+  if (Regex ("$e") < "abc")             return false;
+
+  // required literal
+  if (Regex ("$d+\"px\"") < "width: 100pt")          return false;
+  if ((Regex ("$d+\"px\"") < "width: 100px") == false) return false;
+
+  // match and replace
+  if (Regex ("$d+").match ("abc 2000 def") != "2000")  return false;
+  if (Regex ("$d+").replace ("a1b22c", "#") != "a#b#c") return false;
+  if (Regex ("\"px\"").replace ("1pt", "em") != "1pt")  return false;
+
+  // block commitment - the full match, match and replace agree
+  if (Regex ("[a+]a") == "aaa")                        return false;
+  if (Regex ("[a+]a") < "aaa")                         return false;
+  if (Regex ("[a+]a").match ("aaa") != "")             return false;
+  if (Regex ("[a+]a").replace ("aaa", "#") != "aaa")   return false;
+  if (Regex ("x[a|[ab]]") == "xab")                    return false;
+  if (Regex ("x[a|[ab]]").match ("xab") != "xa")       return false;
+  if (Regex ("a+[ab]?") == "aab")                      return false;
+  if (Regex ("a+[ab]?").replace ("aab", "#") != "#b")  return false;
+  if (Regex ("[ab]+a") != "ababa")                     return false;
+  if (Regex ("[ab]+a").match ("xababa") != "ababa")    return false;
+  if (Regex ("[ab]+a").replace ("xababa", "#") != "x#") return false;
+
+  // shared compiled regex
+  Regex r1 ("$d+");
+  Regex r2 ("$d+");
+  r2 = "$a+";
+  if (r1 != "2000") return false;
+  if (r2 != "a2b0") return false;
+  if (r1 == "a2b0") return false;
+  return true;
+}
+
+// regex scanner test
+static bool re_check_scan (void) {
+  using namespace afnix;
+  // build the regex scanner
+  Regscan rscn;
+  rscn.add ("$l+");
+  rscn.add ("\"if\"");
+  rscn.add ("$d+");
+  rscn.add ("$b+");
+  if (rscn.length () != 4) return false;
+  if (rscn.valid () == false) return false;
+  // scan an input stream
+  InputString is ("if ifx 12#");
+  String lval;
+  if ((rscn.match (&is, lval) != 1) || (lval != "if"))  return false;
+  if ((rscn.match (&is, lval) != 3) || (lval != " "))   return false;
+  if ((rscn.match (&is, lval) != 0) || (lval != "ifx")) return false;
+  if ((rscn.match (&is, lval) != 3) || (lval != " "))   return false;
+  if ((rscn.match (&is, lval) != 2) || (lval != "12"))  return false;
+  if ((rscn.match (&is, lval) != -1) || (lval != ""))   return false;
+  if (is.getu () != '#') return false;
+  // a regex with group is not valid
+  rscn.add ("($d+)");
+  if (rscn.valid () == true) return false;
+  // a regex which block commits to a shorter path is not valid
+  Regscan bscn;
+  bscn.add ("$l[$l$d]*");
+  if (bscn.valid () == false) return false;
+  bscn.add ("[a+]a");
+  if (bscn.valid () == true) return false;
+  return true;
+}
+
+// the regex task arguments
+struct s_retsk {
+  afnix::Regex* p_re;
+  long          d_mcnt;
+};
+
+// match a shared regex in a task
+static void* re_task_run (void* args) {
+  using namespace afnix;
+  s_retsk* rtsk = reinterpret_cast <s_retsk*> (args);
+  for (long k = 0L; k < 256L; k++) {
+    String ss = String ("user") + k + "@host.org";
+    if (*rtsk->p_re == ss) rtsk->d_mcnt++;
+    if (*rtsk->p_re == (ss + '!')) rtsk->d_mcnt--;
+    if ((*rtsk->p_re < (String ("mail: ") + ss)) == true) rtsk->d_mcnt++;
+  }
+  return nullptr;
+}
+
+static bool re_check_thrs (void) {
+  using namespace afnix;
+  // match the same regex in more tasks than idle scan states
+  Regex re ("$l+$d+@$l+\".org\"");
+  const long tnum = 16L;
+  s_retsk tvec[tnum];
+  void*   args[tnum];
+  for (long k = 0L; k < tnum; k++) {
+    tvec[k].p_re   = &re;
+    tvec[k].d_mcnt = 0L;
+    args[k] = &tvec[k];
+  }
+  c_tskrun (re_task_run, args, tnum);
+  for (long k = 0L; k < tnum; k++) {
+    if (tvec[k].d_mcnt != 512L) return false;
+  }
+  return true;
+}
+
 // full blown test
 int main (int, char**) {
   using namespace afnix;
@@ -291,6 +415,9 @@ int main (int, char**) {
     if (re_check_real  () == false) return 1;
     if (re_check_url   () == false) return 1;
     if (re_check_can   () == false) return 1;
+    if (re_check_auto  () == false) return 1;
+    if (re_check_scan  () == false) return 1;
+    if (re_check_thrs  () == false) return 1;
     
     // check input stream
     if (re_check_is    () == false) return 1;
@@ -14,8 +14,11 @@
 // - copyright (c) 1999-2021 amaury darsch                                   -
 // ---------------------------------------------------------------------------
 
+#include "Real.hpp"
 #include "Serial.hpp"
 #include "String.hpp"
+#include "Integer.hpp"
+#include "InputOutput.hpp"
 
 // ---------------------------------------------------------------------------
 // - private section                                                         -
@@ -84,6 +87,63 @@ namespace afnix {
     }
     return true;
   }
+
+  // test a stream serialization by version
+  static bool tst_stream (const long sver, const bool slpf) {
+    // create an input/output stream
+    InputOutput io (true);
+    if (sver == 2L) io.setsver (sver, slpf);
+    // serialize some scalars
+    Serial::wrlong (-1234567890123L, io);
+    Serial::wrreal (3.5, io);
+    Serial::wrchar (0x263AU, io);
+    // serialize the data arrays
+    long   ldat[TST_ARRY_SIZE];
+    t_real rdat[TST_ARRY_SIZE];
+    bool   bdat[TST_ARRY_SIZE];
+    for (long k = 0; k < TST_ARRY_SIZE; k++) {
+      ldat[k] = k - TST_XDIM_SIZE;
+      rdat[k] = (t_real) k / 4.0;
+      bdat[k] = ((k % 3) == 0);
+    }
+    Serial::wrlong (TST_ARRY_SIZE, ldat, io);
+    Serial::wrreal (TST_ARRY_SIZE, rdat, io);
+    Serial::wrbool (TST_ARRY_SIZE, bdat, io);
+    // serialize some objects
+    Integer iobj (-7); iobj.serialize (io);
+    Real    zobj (0.25); zobj.serialize (io);
+    String  sobj ("afnix"); sobj.serialize (io);
+    // check the scalars
+    if (Serial::rdlong (io) != -1234567890123L) return false;
+    if (Serial::rdreal (io) != 3.5) return false;
+    if (Serial::rdchar (io) != 0x263AU) return false;
+    // check the arrays
+    long*   lres = Serial::rdlong (io, TST_ARRY_SIZE);
+    t_real* rres = Serial::rdreal (io, TST_ARRY_SIZE);
+    bool*   bres = Serial::rdbool (io, TST_ARRY_SIZE);
+    bool status = (lres != nullptr) && (rres != nullptr) && (bres != nullptr);
+    for (long k = 0; (k < TST_ARRY_SIZE) && status; k++) {
+      if (lres[k] != ldat[k]) status = false;
+      if (rres[k] != rdat[k]) status = false;
+      if (bres[k] != bdat[k]) status = false;
+    }
+    delete [] lres;
+    delete [] rres;
+    delete [] bres;
+    if (status == false) return false;
+    // skip the integer object
+    if (Serial::skip (io) == false) return false;
+    // check the real object with a version 1 stream
+    io.setsver (1L);
+    Real* robj = dynamic_cast <Real*> (Serial::deserialize (io));
+    if ((robj == nullptr) || (robj->toreal () != 0.25)) return false;
+    delete robj;
+    // check the string object
+    String* sres = dynamic_cast <String*> (Serial::deserialize (io));
+    if ((sres == nullptr) || (*sres != "afnix")) return false;
+    delete sres;
+    return io.iseos ();
+  }
 }
 
 int main (int, char**) {
@@ -98,6 +158,13 @@ int main (int, char**) {
   // test a real point array
   if (tst_array_rpt2 () == false) return 1;
 
+  // test the version 1 stream
+  if (tst_stream (1L, false) == false) return 1;
+  // test the version 2 stream
+  if (tst_stream (2L, false) == false) return 1;
+  // test the version 2 stream with length prefix
+  if (tst_stream (2L, true) == false) return 1;
+
   // ok - everything is fine
   return 0;
 }
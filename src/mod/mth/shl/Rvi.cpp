@@ -111,6 +111,25 @@ namespace afnix {
     try {
       // write the vector size/mode
       Serial::wrlong (d_size, os);
+      // write a dense vector as a bulk block
+      if ((os.getsver () == 2L) && (d_size > 0LL)) {
+	long nnz = 0L;
+	for (long k = 0; k < d_size; k++) if (nlget (k) != 0.0) nnz++;
+	if ((2 * nnz) > d_size) {
+	  t_real* data = new t_real[d_size];
+	  try {
+	    for (long k = 0; k < d_size; k++) data[k] = nlget (k);
+	    Serial::wrlong (-2, os);
+	    Serial::wrreal (d_size, data, os);
+	    delete [] data;
+	  } catch (...) {
+	    delete [] data;
+	    throw;
+	  }
+	  unlock ();
+	  return;
+	}
+      }
       // write the vector data
       for (long k = 0; k < d_size; k++) {
 	// get the vector value
@@ -143,6 +162,17 @@ namespace afnix {
       // get the vector data by position
       for (long k = 0; k < size; k++) {
 	long idx = Serial::rdlong (is);
+	// check for a bulk block
+	if (idx == -2) {
+	  t_real* data = Serial::rdreal (is, size);
+	  if (data == nullptr) {
+	    throw Exception ("rvi-error", "inconsistent serialized vector");
+	  }
+	  for (long i = 0; i < size; i++) nlset (i, data[i]);
+	  delete [] data;
+	  unlock ();
+	  return;
+	}
 	// check for marker
 	if (idx == -1) {
 	  unlock ();
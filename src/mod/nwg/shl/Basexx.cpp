@@ -120,6 +120,55 @@ namespace afnix {
 
   // the standard padding byte
   static t_byte BASE_SPAD_BYTE = '=';
+
+  // the block processing size
+  static const long CDC_BLOK_SIZE = 4096L;
+
+  // the codec output sink
+  struct s_sink {
+    // the output buffer
+    Buffer* p_ob;
+    // the output stream
+    OutputStream* p_os;
+    // create a buffer sink
+    s_sink (Buffer& ob) {
+      p_ob = &ob;
+      p_os = nullptr;
+    }
+    // create a stream sink
+    s_sink (OutputStream& os) {
+      p_ob = nullptr;
+      p_os = &os;
+    }
+    // write a character
+    void write (const char c) {
+      if (p_ob != nullptr) p_ob->add (c); else p_os->write (c);
+    }
+    // write a byte block
+    void write (const t_byte* rbuf, const long size) {
+      if (size <= 0L) return;
+      auto cbuf = reinterpret_cast<const char*>(rbuf);
+      if (p_ob != nullptr) p_ob->add (cbuf, size); else p_os->write (cbuf, size);
+    }
+    // write a byte block with an eventual line split
+    void write (const t_byte* rbuf, const long size,
+		const bool slmd, long& lcnt) {
+      // check for no split
+      if (slmd == false) {
+	write (rbuf, size);
+	return;
+      }
+      // write by line segment
+      long rpos = 0L;
+      while (rpos < size) {
+	long llen = CDC_LINE_LGTH - (lcnt % CDC_LINE_LGTH);
+	long wlen = (size - rpos < llen) ? size - rpos : llen;
+	write (&rbuf[rpos], wlen);
+	rpos += wlen; lcnt += wlen;
+	if ((lcnt % CDC_LINE_LGTH) == 0L) write (eolc);
+      }
+    }
+  };
   
   // the private codec structure
   struct s_codc {
@@ -298,6 +347,168 @@ namespace afnix {
       }
       return result;
     }
+    // encode a byte block by quantum - the residue must be empty and
+    // the block size a multiple of the quantum size
+    long encode (t_byte* dst, const t_byte* src, const long size) const {
+      long result = 0L;
+      // base 64 quantum
+      if (d_csiz == 6L) {
+	for (long k = 0L; k < size; k += 3L) {
+	  t_quad qval = ((t_quad) src[k] << 16) |
+	    ((t_quad) src[k+1] << 8) | (t_quad) src[k+2];
+	  dst[result++] = p_ctbl[(qval >> 18) & 0x3FU];
+	  dst[result++] = p_ctbl[(qval >> 12) & 0x3FU];
+	  dst[result++] = p_ctbl[(qval >> 6)  & 0x3FU];
+	  dst[result++] = p_ctbl[qval & 0x3FU];
+	}
+	return result;
+      }
+      // base 16 quantum
+      if (d_csiz == 4L) {
+	for (long k = 0L; k < size; k++) {
+	  dst[result++] = p_ctbl[src[k] >> 4];
+	  dst[result++] = p_ctbl[src[k] & 0x0FU];
+	}
+	return result;
+      }
+      // generic quantum
+      long blen = d_bsiz / 8L;
+      long clen = d_bsiz / d_csiz;
+      for (long k = 0L; k < size; k += blen) {
+	t_octa qval = nilo;
+	for (long i = 0L; i < blen; i++) {
+	  qval <<= 8; qval |= (t_octa) src[k+i];
+	}
+	for (long i = clen - 1L; i >= 0L; i--) {
+	  dst[result++] = p_ctbl[d_rmsk & (qval >> (i * d_csiz))];
+	}
+      }
+      return result;
+    }
+    // decode a character block by quantum until a non code character is
+    // found - the residue must be empty and the position is updated
+    long decode (t_byte* dst, const t_byte* src, const long size,
+		 long& spos) const {
+      long result = 0L;
+      // base 64 quantum
+      if (d_csiz == 6L) {
+	while (spos + 4L <= size) {
+	  t_quad c0 = p_ctbl[src[spos]];
+	  t_quad c1 = p_ctbl[src[spos+1]];
+	  t_quad c2 = p_ctbl[src[spos+2]];
+	  t_quad c3 = p_ctbl[src[spos+3]];
+	  if (((c0 | c1 | c2 | c3) & 0xC0U) != 0U) break;
+	  t_quad qval = (c0 << 18) | (c1 << 12) | (c2 << 6) | c3;
+	  dst[result++] = (t_byte) (qval >> 16);
+	  dst[result++] = (t_byte) (qval >> 8);
+	  dst[result++] = (t_byte) qval;
+	  spos += 4L;
+	}
+	return result;
+      }
+      // base 16 quantum
+      if (d_csiz == 4L) {
+	while (spos + 2L <= size) {
+	  t_byte c0 = p_ctbl[src[spos]];
+	  t_byte c1 = p_ctbl[src[spos+1]];
+	  if (((c0 | c1) & 0xF0U) != 0U) break;
+	  dst[result++] = (t_byte) ((c0 << 4) | c1);
+	  spos += 2L;
+	}
+	return result;
+      }
+      // generic quantum
+      long clen = d_bsiz / 8L;
+      long blen = (clen * d_csiz) / 8L;
+      while (spos + clen <= size) {
+	t_octa qval = nilo; bool cflg = true;
+	for (long i = 0L; i < clen; i++) {
+	  t_byte cval = p_ctbl[src[spos+i]];
+	  if (cval == 0xFFU) {
+	    cflg = false;
+	    break;
+	  }
+	  qval <<= d_csiz; qval |= (t_octa) cval;
+	}
+	if (cflg == false) break;
+	for (long i = blen - 1L; i >= 0L; i--) {
+	  dst[result++] = (t_byte) (qval >> (i * 8L));
+	}
+	spos += clen;
+      }
+      return result;
+    }
+    // encode a byte array into a sink
+    long encode (s_sink& sink, const t_byte* src, const long size,
+		 const bool slmd, long& lcnt) {
+      // the quantum and block size
+      long blen = d_bsiz / 8L;
+      long bsiz = (CDC_BLOK_SIZE / blen) * blen;
+      // the code buffers
+      t_byte rbuf[8];
+      t_byte cbuf[2L * CDC_BLOK_SIZE];
+      // loop in the byte array
+      long result = 0L;
+      long spos = 0L;
+      while (spos < size) {
+	// encode by block with an empty residue
+	if ((d_rsiz == 0L) && ((size - spos) >= blen)) {
+	  long slen = (size - spos < bsiz) ? size - spos : bsiz;
+	  slen -= slen % blen;
+	  long clen = encode (cbuf, &src[spos], slen);
+	  sink.write (cbuf, clen, slmd, lcnt);
+	  spos += slen; result += clen;
+	  continue;
+	}
+	// push a byte in the residue
+	push (src[spos++]);
+	if (valid (false) == true) {
+	  long rlen = encode (rbuf);
+	  sink.write (rbuf, rlen, slmd, lcnt);
+	  result += rlen;
+	}
+      }
+      return result;
+    }
+    // finalize the residue encoding into a sink
+    long encode (s_sink& sink) {
+      t_byte rbuf[8];
+      long result = encode (rbuf);
+      sink.write (rbuf, result);
+      return result;
+    }
+    // decode a character array into a sink
+    long decode (s_sink& sink, const t_byte* src, const long size) {
+      // the code buffers
+      t_byte rbuf[8];
+      t_byte dbuf[CDC_BLOK_SIZE];
+      // loop in the character array
+      long result = 0L;
+      long spos = 0L;
+      while (spos < size) {
+	// decode by block with an empty residue
+	if (d_rsiz == 0L) {
+	  long epos = (size - spos < CDC_BLOK_SIZE) ? size : spos + CDC_BLOK_SIZE;
+	  long dlen = decode (dbuf, src, epos, spos);
+	  if (dlen > 0L) {
+	    sink.write (dbuf, dlen);
+	    result += dlen;
+	    continue;
+	  }
+	}
+	// get the next byte and eventually remove
+	t_byte bval = src[spos++];
+	if ((bval == '\r') || (bval == '\n')) continue;
+	// push the byte in the residue
+	push (bval);
+	if (valid (true) == true) {
+	  long rlen = decode (rbuf);
+	  sink.write (rbuf, rlen);
+	  result += rlen;
+	}
+      }
+      return result;
+    }
   };
 
   // -------------------------------------------------------------------------
@@ -406,35 +617,15 @@ namespace afnix {
       if (d_rflg == true) {
         throw Exception ("cipher-error", "calling encode in reverse mode");
       }
-      // the residue buffer
-      t_byte rbuf[8];
-      // the result length
-      long result = 0L;
-      // loop in the input buffer
+      // the output sink
+      s_sink sink (ob);
+      // encode directly from the buffer storage
+      const t_byte* src = static_cast<const Buffer&>(ib).tobyte ();
       long lcnt = 0L;
-      while (ib.empty () == false) {
-	// push a byte in the codec
-	p_codc->push (ib.read ());
-	// encode in the residue buffer
-	if (p_codc->valid(d_rflg) == true) {
-	  // encode the residue buffer
-	  long rlen = p_codc->encode(&rbuf[0]);
-	  // push in the output buffer
-	  for (long k = 0L; k < rlen; k++) {
-	    ob.add ((const char) rbuf[k]);
-	    if ((d_slmd == true) &&
-		((++lcnt % CDC_LINE_LGTH) == 0L)) ob.add (eolc);
-	  }
-	  // update result length
-	  result += rlen;
-	}
-      }
-      // finalize the buffer
-      long rlen = p_codc->encode(&rbuf[0]);
-      // push in the output buffer
-      for (long k = 0L; k < rlen; k++) ob.add ((const char) rbuf[k]);
-      // update result length
-      result += rlen;
+      long result = p_codc->encode (sink, src, ib.length (), d_slmd, lcnt);
+      ib.reset ();
+      // finalize the residue
+      result += p_codc->encode (sink);
       d_encs[0] += result; d_encs[1] += result;
       unlock ();
       return result;
@@ -453,35 +644,19 @@ namespace afnix {
       if (d_rflg == true) {
         throw Exception ("cipher-error", "calling encode in reverse mode");
       }
-      // the residue buffer
-      t_byte rbuf[8];
-      // the result length
-      long result = 0L;
-      // loop in the input buffer
+      // the output sink
+      s_sink sink (ob);
+      // encode the stream by block
+      char sbuf[CDC_BLOK_SIZE];
       long lcnt = 0L;
+      long result = 0L;
       while (is.valid () == true) {
-	// push a byte in the codec
-	p_codc->push (is.read ());
-	// encode in the residue buffer
-	if (p_codc->valid(d_rflg) == true) {
-	  // encode the residue buffer
-	  long rlen = p_codc->encode(&rbuf[0]);
-	  // push in the output buffer
-	  for (long k = 0L; k < rlen; k++) {
-	    ob.add ((const char) rbuf[k]);
-	    if ((d_slmd == true) &&
-		((++lcnt % CDC_LINE_LGTH) == 0L)) ob.add (eolc);
-	  }
-	  // update result length
-	  result += rlen;
-	}
+	long slen = is.copy (sbuf, CDC_BLOK_SIZE);
+	auto src = reinterpret_cast<const t_byte*>(sbuf);
+	result += p_codc->encode (sink, src, slen, d_slmd, lcnt);
       }
-      // finalize the buffer
-      long rlen = p_codc->encode(&rbuf[0]);
-      // push in the output buffer
-      for (long k = 0L; k < rlen; k++) ob.add ((const char) rbuf[k]);
-      // update result length
-      result += rlen;
+      // finalize the residue
+      result += p_codc->encode (sink);
       d_encs[0] += result; d_encs[1] += result;
       unlock ();
       return result;
@@ -500,35 +675,19 @@ namespace afnix {
       if (d_rflg == true) {
         throw Exception ("cipher-error", "calling encode in reverse mode");
       }
-      // the residue buffer
-      t_byte rbuf[8];
-      // the result length
-      long result = 0L;
-      // loop in the input buffer
+      // the output sink
+      s_sink sink (os);
+      // encode the stream by block
+      char sbuf[CDC_BLOK_SIZE];
       long lcnt = 0L;
+      long result = 0L;
       while (is.valid () == true) {
-	// push a byte in the codec
-	p_codc->push (is.read ());
-	// encode in the residue buffer
-	if (p_codc->valid(d_rflg) == true) {
-	  // encode the residue buffer
-	  long rlen = p_codc->encode(&rbuf[0]);
-	  // push in the output buffer
-	  for (long k = 0L; k < rlen; k++) {
-	    os.write ((const char) rbuf[k]);
-	    if ((d_slmd == true) &&
-		((++lcnt % CDC_LINE_LGTH) == 0L)) os.write (eolc);
-	  }
-	  // update result length
-	  result += rlen;
-	}
+	long slen = is.copy (sbuf, CDC_BLOK_SIZE);
+	auto src = reinterpret_cast<const t_byte*>(sbuf);
+	result += p_codc->encode (sink, src, slen, d_slmd, lcnt);
       }
-      // finalize the buffer
-      long rlen = p_codc->encode(&rbuf[0]);
-      // push in the output buffer
-      for (long k = 0L; k < rlen; k++) os.write ((const char) rbuf[k]);
-      // update result length
-      result += rlen;
+      // finalize the residue
+      result += p_codc->encode (sink);
       d_encs[0] += result; d_encs[1] += result;
       unlock ();
       return result;
@@ -537,7 +696,7 @@ namespace afnix {
       throw;
     }
   }
-  
+
   // decode an input buffer into an output buffer
 
   long Basexx::decode (Buffer& ob, Buffer& ib) {
@@ -547,27 +706,12 @@ namespace afnix {
       if (d_rflg == false) {
         throw Exception ("cipher-error", "calling decode in non reverse mode");
       }
-      // the residue buffer
-      t_byte rbuf[8];
-      // the result length
-      long result = 0L;
-      // loop in the input buffer
-      while (ib.empty () == false) {
-	// get the next byte and eventually remove
-	t_byte bval = ib.read ();
-	if ((bval == '\r') || (bval == '\n')) continue;
-	// push the byte in the codec
-	p_codc->push (bval);
-	// encode in the residue buffer
-	if (p_codc->valid(d_rflg) == true) {
-	  // decode the residue buffer
-	  long rlen = p_codc->decode(&rbuf[0]);
-	  // push in the output buffer
-	  for (long k = 0L; k < rlen; k++) ob.add ((const char) rbuf[k]);
-	  // update result length
-	  result += rlen;
-	}
-      }
+      // the output sink
+      s_sink sink (ob);
+      // decode directly from the buffer storage
+      const t_byte* src = static_cast<const Buffer&>(ib).tobyte ();
+      long result = p_codc->decode (sink, src, ib.length ());
+      ib.reset ();
       d_decs[0] += result; d_decs[1] += result;
       unlock ();
       return result;
@@ -586,26 +730,15 @@ namespace afnix {
       if (d_rflg == false) {
         throw Exception ("cipher-error", "calling decode in non reverse mode");
       }
-      // the residue buffer
-      t_byte rbuf[8];
-      // the result length
+      // the output sink
+      s_sink sink (ob);
+      // decode the stream by block
+      char sbuf[CDC_BLOK_SIZE];
       long result = 0L;
-      // loop in the input buffer
       while (is.valid () == true) {
-	// get the next byte and eventually remove
-	t_byte bval = is.read ();
-	if ((bval == '\r') || (bval == '\n')) continue;
-	// push the byte in the codec
-	p_codc->push (bval);
-	// encode in the residue buffer
-	if (p_codc->valid(d_rflg) == true) {
-	  // decode the residue buffer
-	  long rlen = p_codc->decode(&rbuf[0]);
-	  // push in the output buffer
-	  for (long k = 0L; k < rlen; k++) ob.add ((const char) rbuf[k]);
-	  // update result length
-	  result += rlen;
-	}
+	long slen = is.copy (sbuf, CDC_BLOK_SIZE);
+	auto src = reinterpret_cast<const t_byte*>(sbuf);
+	result += p_codc->decode (sink, src, slen);
       }
       d_decs[0] += result; d_decs[1] += result;
       unlock ();
@@ -625,26 +758,15 @@ namespace afnix {
       if (d_rflg == false) {
         throw Exception ("cipher-error", "calling decode in non reverse mode");
       }
-      // the residue buffer
-      t_byte rbuf[8];
-      // the result length
+      // the output sink
+      s_sink sink (os);
+      // decode the stream by block
+      char sbuf[CDC_BLOK_SIZE];
       long result = 0L;
-      // loop in the input buffer
       while (is.valid () == true) {
-	// get the next byte and eventually remove
-	t_byte bval = is.read ();
-	if ((bval == '\r') || (bval == '\n')) continue;
-	// push the byte in the codec
-	p_codc->push (bval);
-	// encode in the residue buffer
-	if (p_codc->valid(d_rflg) == true) {
-	  // decode the residue buffer
-	  long rlen = p_codc->decode(&rbuf[0]);
-	  // push in the output buffer
-	  for (long k = 0L; k < rlen; k++) os.write ((const char) rbuf[k]);
-	  // update result length
-	  result += rlen;
-	}
+	long slen = is.copy (sbuf, CDC_BLOK_SIZE);
+	auto src = reinterpret_cast<const t_byte*>(sbuf);
+	result += p_codc->decode (sink, src, slen);
       }
       d_decs[0] += result; d_decs[1] += result;
       unlock ();
@@ -654,7 +776,7 @@ namespace afnix {
       throw;
     }
   }
-  
+
   // preset the stream processing
 
   long Basexx::preset (void) {
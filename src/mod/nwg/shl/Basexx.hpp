@@ -26,7 +26,8 @@ namespace afnix {
   /// The Basexx class is a codec that implements the rfc 4648 for
   /// base 64/32/16 encoding. The operation of the base codec are governed
   /// by the type of encoding selected which is the standard base 64 by
-  /// default.
+  /// default. The codec operates by block directly on the buffer storage
+  /// and falls back to the quantum residue for partial or broken input.
   /// @author amaury darsch
 
   class Basexx : public Codec {
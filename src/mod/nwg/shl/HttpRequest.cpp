@@ -150,7 +150,9 @@ namespace afnix {
 	throw Exception ("http-error", 
 			 "inconsistent content length in request");
       }
-      result = new Buffer (clen, clen, data);
+      result = new Buffer (clen);
+      result->add (data, clen);
+      delete [] data;
       // done
       return result;
     } catch (...) {
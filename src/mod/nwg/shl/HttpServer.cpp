@@ -0,0 +1,1202 @@
+// ---------------------------------------------------------------------------
+// - HttpServer.cpp                                                          -
+// - afnix:nwg module - http server class implementation                     -
+// ---------------------------------------------------------------------------
+// - This program is free software;  you can redistribute it  and/or  modify -
+// - it provided that this copyright notice is kept intact.                  -
+// -                                                                         -
+// - This program  is  distributed in  the hope  that it will be useful, but -
+// - without  any  warranty;  without  even   the   implied    warranty   of -
+// - merchantability or fitness for a particular purpose.  In no event shall -
+// - the copyright holder be liable for any  direct, indirect, incidental or -
+// - special damages arising in any way out of the use of this software.     -
+// ---------------------------------------------------------------------------
+// - copyright (c) 1999-2021 amaury darsch                                   -
+// ---------------------------------------------------------------------------
+
+#include "Cons.hpp"
+#include "Real.hpp"
+#include "Thread.hpp"
+#include "Boolean.hpp"
+#include "Integer.hpp"
+#include "Runnable.hpp"
+#include "QuarkZone.hpp"
+#include "Exception.hpp"
+#include "HttpServer.hpp"
+#include "InputOutput.hpp"
+#include "HttpRequest.hpp"
+#include "HttpResponse.hpp"
+#include "cnet.hpp"
+#include "csio.hpp"
+#include "cerr.hpp"
+#include "cthr.hpp"
+#include "cclk.hpp"
+
+namespace afnix {
+
+  // -------------------------------------------------------------------------
+  // - private section                                                       -
+  // -------------------------------------------------------------------------
+
+  // the default number of workers
+  static const long HSRV_WNUM = 4L;
+  // the default request queue size
+  static const long HSRV_QSIZ = 256L;
+  // the maximum request header size
+  static const long HSRV_HMAX = 65536L;
+  // the maximum request content size
+  static const long HSRV_BMAX = 16777216L;
+  // the minimum read size
+  static const long HSRV_RSIZ = 16384L;
+  // the maximum gathered buffers
+  static const long HSRV_VMAX = 64L;
+  // the number of latency samples
+  static const long HSRV_LNUM = 65536L;
+
+  // the http protocol elements
+  static const String HSRV_VERS_CPT1 = "HTTP/1.1";
+  static const String HSRV_RMTH_HEAD = "HEAD";
+  static const String HSRV_CONN_CLOS = "close";
+  static const String HSRV_CONN_KALV = "keep-alive";
+
+  // the http error status
+  static const long HSRV_STAT_400 = 400; // Bad Request
+  static const long HSRV_STAT_413 = 413; // Request Entity Too Large
+  static const long HSRV_STAT_500 = 500; // Internal Server Error
+  static const long HSRV_STAT_501 = 501; // Not Implemented
+
+  // check if a header line name matches a lower case name
+  static bool hsrv_isname (const char* line, const long llen,
+			   const char* name) {
+    long k = 0L;
+    for (; name[k] != nilc; k++) {
+      if (k >= llen) return false;
+      char c = line[k];
+      if ((c >= 'A') && (c <= 'Z')) c = c - 'A' + 'a';
+      if (c != name[k]) return false;
+    }
+    return (k < llen) && (line[k] == ':');
+  }
+
+  // parse a content length header line value
+  static long hsrv_toclen (const char* line, const long llen) {
+    long k = 0L;
+    while ((k < llen) && (line[k] != ':')) k++;
+    k++;
+    while ((k < llen) && ((line[k] == ' ') || (line[k] == '\t'))) k++;
+    long result = 0L;
+    long dnum   = 0L;
+    for (; k < llen; k++) {
+      char c = line[k];
+      if ((c == ' ') || (c == '\t') || (c == crlc)) break;
+      if ((c < '0') || (c > '9')) return -1L;
+      result = result * 10L + (c - '0');
+      if (result > HSRV_BMAX) return HSRV_BMAX + 1L;
+      dnum++;
+    }
+    return (dnum == 0L) ? -1L : result;
+  }
+
+  // create a response header buffer
+  static Buffer* hsrv_tohbuf (HttpResponse& resp, const long blen,
+			      const bool clos) {
+    resp.hset (HttpProto::HEAD_CLEN, Integer (blen));
+    resp.hset (HttpProto::HEAD_CONN, clos ? HSRV_CONN_CLOS : HSRV_CONN_KALV);
+    Buffer* result = new Buffer;
+    try {
+      resp.write (*result);
+      return result;
+    } catch (...) {
+      delete result;
+      throw;
+    }
+  }
+
+  // create a response content buffer from a handler result
+  static Buffer* hsrv_tobbuf (Object* robj) {
+    // check for nil
+    if (robj == nullptr) return nullptr;
+    // check for a buffer
+    auto bobj = dynamic_cast <Buffer*> (robj);
+    if (bobj != nullptr) return new Buffer (*bobj);
+    // check for a literal
+    auto lobj = dynamic_cast <Literal*> (robj);
+    if (lobj != nullptr) return new Buffer (lobj->tostring ());
+    throw Exception ("type-error", "invalid object as http content",
+		     Object::repr (robj));
+  }
+
+  // select a percentile by partitioning a sample array
+  static t_long hsrv_select (t_long* data, const long size, const long kidx) {
+    long lidx = 0L;
+    long ridx = size - 1L;
+    while (lidx < ridx) {
+      t_long pval = data[(lidx + ridx) / 2L];
+      long i = lidx;
+      long j = ridx;
+      while (i <= j) {
+	while (data[i] < pval) i++;
+	while (data[j] > pval) j--;
+	if (i <= j) {
+	  t_long tval = data[i]; data[i] = data[j]; data[j] = tval;
+	  i++; j--;
+	}
+      }
+      if (kidx <= j) ridx = j; else if (kidx >= i) lidx = i; else break;
+    }
+    return data[kidx];
+  }
+
+  // the connection output buffer
+  struct s_hout {
+    // the output buffer
+    Buffer* p_obuf;
+    // the output offset
+    long    d_ooff;
+    // the latency reference time
+    t_long  d_tref;
+    // the next output buffer
+    s_hout* p_next;
+    // create an output buffer
+    s_hout (Buffer* obuf, const t_long tref) {
+      Object::iref (p_obuf = obuf);
+      d_ooff = 0L;
+      d_tref = tref;
+      p_next = nullptr;
+    }
+    // destroy this output buffer
+    ~s_hout (void) {
+      Object::dref (p_obuf);
+    }
+    // get the remaining data
+    const char* getdata (void) const {
+      const Buffer* obuf = p_obuf;
+      return reinterpret_cast <const char*> (obuf->tobyte ()) + d_ooff;
+    }
+    // get the remaining length
+    long length (void) const {
+      return p_obuf->length () - d_ooff;
+    }
+  };
+
+  // the server connection
+  struct s_hcon {
+    // the connection sid
+    int     d_sid;
+    // the input buffer
+    char*   p_ibuf;
+    // the input buffer size
+    long    d_isiz;
+    // the input length
+    long    d_ilen;
+    // the input offset
+    long    d_ioff;
+    // the header scan offset
+    long    d_iscn;
+    // the complete request length
+    long    d_rlen;
+    // the input registration flag
+    bool    d_ireg;
+    // the output registration flag
+    bool    d_oreg;
+    // the request processing flag
+    bool    d_busy;
+    // the close flag
+    bool    d_clos;
+    // the dead connection flag
+    bool    d_dead;
+    // the waiting flag
+    bool    d_wait;
+    // the end of input flag
+    bool    d_eofs;
+    // the output list
+    s_hout* p_ohed;
+    s_hout* p_otal;
+    // the next waiting connection
+    s_hcon* p_wnxt;
+    // create a connection by sid
+    s_hcon (const int sid) {
+      d_sid  = sid;
+      d_isiz = HSRV_RSIZ;
+      p_ibuf = new char[d_isiz];
+      d_ilen = 0L;
+      d_ioff = 0L;
+      d_iscn = 0L;
+      d_rlen = 0L;
+      d_ireg = false;
+      d_oreg = false;
+      d_busy = false;
+      d_clos = false;
+      d_dead = false;
+      d_wait = false;
+      d_eofs = false;
+      p_ohed = nullptr;
+      p_otal = nullptr;
+      p_wnxt = nullptr;
+    }
+    // destroy this connection
+    ~s_hcon (void) {
+      while (p_ohed != nullptr) {
+	s_hout* hout = p_ohed;
+	p_ohed = hout->p_next;
+	delete hout;
+      }
+      delete [] p_ibuf;
+    }
+    // add an output buffer
+    void addout (Buffer* obuf, const t_long tref) {
+      s_hout* hout = new s_hout (obuf, tref);
+      if (p_otal == nullptr) {
+	p_ohed = p_otal = hout;
+      } else {
+	p_otal->p_next = hout;
+	p_otal = hout;
+      }
+    }
+    // make room for a read
+    void reserve (void) {
+      if ((d_isiz - d_ilen) >= HSRV_RSIZ) return;
+      // compact the input buffer
+      if (d_ioff > 0L) {
+	long ilen = d_ilen - d_ioff;
+	for (long k = 0L; k < ilen; k++) p_ibuf[k] = p_ibuf[d_ioff + k];
+	d_iscn -= d_ioff;
+	d_ilen  = ilen;
+	d_ioff  = 0L;
+	if ((d_isiz - d_ilen) >= HSRV_RSIZ) return;
+      }
+      // grow the input buffer
+      long  isiz = d_isiz * 2L;
+      char* ibuf = new char[isiz];
+      for (long k = 0L; k < d_ilen; k++) ibuf[k] = p_ibuf[k];
+      delete [] p_ibuf;
+      p_ibuf = ibuf;
+      d_isiz = isiz;
+    }
+    // frame a request - the result is 0 for an incomplete request, 1 for
+    // a complete request or a http error status
+    long frame (void) {
+      // check for a known request
+      if (d_rlen > 0L) return ((d_ilen - d_ioff) >= d_rlen) ? 1L : 0L;
+      // skip the empty lines before the request
+      while ((d_ioff < d_ilen) &&
+	     ((p_ibuf[d_ioff] == crlc) || (p_ibuf[d_ioff] == eolc))) {
+	d_ioff++;
+      }
+      if (d_iscn < d_ioff) d_iscn = d_ioff;
+      // look for the header end
+      long hend = -1L;
+      for (long k = d_iscn; k < d_ilen; k++) {
+	if (p_ibuf[k] != eolc) continue;
+	long j = k + 1L;
+	if ((j < d_ilen) && (p_ibuf[j] == crlc)) j++;
+	if ((j < d_ilen) && (p_ibuf[j] == eolc)) {
+	  hend = j + 1L;
+	  break;
+	}
+      }
+      if (hend == -1L) {
+	if ((d_ilen - d_ioff) > HSRV_HMAX) return HSRV_STAT_400;
+	d_iscn = (d_ilen > d_ioff + 2L) ? d_ilen - 2L : d_ioff;
+	return 0L;
+      }
+      if ((hend - d_ioff) > HSRV_HMAX) return HSRV_STAT_400;
+      // look for the content length and transfer encoding
+      long clen = 0L;
+      long lpos = d_ioff;
+      while (lpos < hend) {
+	long lend = lpos;
+	while ((lend < hend) && (p_ibuf[lend] != eolc)) lend++;
+	const char* line = &p_ibuf[lpos];
+	long llen = lend - lpos;
+	if (hsrv_isname (line, llen, "content-length") == true) {
+	  clen = hsrv_toclen (line, llen);
+	  if (clen < 0L) return HSRV_STAT_400;
+	  if (clen > HSRV_BMAX) return HSRV_STAT_413;
+	}
+	if (hsrv_isname (line, llen, "transfer-encoding") == true) {
+	  return HSRV_STAT_501;
+	}
+	lpos = lend + 1L;
+      }
+      d_rlen = (hend - d_ioff) + clen;
+      return ((d_ilen - d_ioff) >= d_rlen) ? 1L : 0L;
+    }
+    // consume a complete request into a buffer
+    Buffer* consume (void) {
+      Buffer* result = new Buffer (d_rlen);
+      result->add (&p_ibuf[d_ioff], d_rlen);
+      d_ioff += d_rlen;
+      d_iscn  = d_ioff;
+      d_rlen  = 0L;
+      if (d_ioff == d_ilen) d_ioff = d_ilen = d_iscn = 0L;
+      return result;
+    }
+  };
+
+  // the server job
+  struct s_hjob {
+    // the job connection
+    s_hcon* p_hcon;
+    // the request buffer
+    Buffer* p_rbuf;
+    // the latency reference time
+    t_long  d_tref;
+    // the response header
+    Buffer* p_hbuf;
+    // the response content
+    Buffer* p_bbuf;
+    // the connection close flag
+    bool    d_clos;
+    // the next job
+    s_hjob* p_next;
+    // create a job by connection and request
+    s_hjob (s_hcon* hcon, Buffer* rbuf) {
+      p_hcon = hcon;
+      Object::iref (p_rbuf = rbuf);
+      d_tref = c_tmus ();
+      p_hbuf = nullptr;
+      p_bbuf = nullptr;
+      d_clos = false;
+      p_next = nullptr;
+    }
+    // destroy this job
+    ~s_hjob (void) {
+      Object::dref (p_rbuf);
+      Object::dref (p_hbuf);
+      Object::dref (p_bbuf);
+    }
+  };
+
+  // the server engine
+  struct s_hsrv {
+    // the server sid
+    int      d_ssid;
+    // the request handler
+    Object*  p_hobj;
+    // the selector handle
+    void*    p_shdl;
+    // the engine mutex
+    void*    p_mtx;
+    // the worker condition
+    void*    p_tcv;
+    // the stop flag
+    bool     d_stop;
+    // the request queue size
+    long     d_qsiz;
+    // the number of dispatched jobs
+    long     d_jcnt;
+    // the pending jobs
+    s_hjob*  p_jhed;
+    s_hjob*  p_jtal;
+    // the completed jobs
+    s_hjob*  p_dhed;
+    s_hjob*  p_dtal;
+    // the connections by sid
+    s_hcon** p_hcon;
+    // the connection array size
+    long     d_hsiz;
+    // the number of connections
+    long     d_ccnt;
+    // the waiting connections
+    s_hcon*  p_whed;
+    s_hcon*  p_wtal;
+    // the number of requests
+    t_long   d_rcnt;
+    // the latency samples
+    t_long*  p_ltcy;
+    // the latency position
+    long     d_lpos;
+    // the number of latency samples
+    long     d_llen;
+    // create a server engine
+    s_hsrv (const int ssid, Object* hobj, const long qsiz) {
+      d_ssid = ssid;
+      Object::iref (p_hobj = hobj);
+      p_shdl = c_shnew (true);
+      p_mtx  = c_mtxcreate ();
+      p_tcv  = c_tcvcreate ();
+      d_stop = false;
+      d_qsiz = qsiz;
+      d_jcnt = 0L;
+      p_jhed = p_jtal = nullptr;
+      p_dhed = p_dtal = nullptr;
+      d_hsiz = 0L;
+      p_hcon = nullptr;
+      d_ccnt = 0L;
+      p_whed = p_wtal = nullptr;
+      d_rcnt = 0LL;
+      p_ltcy = new t_long[HSRV_LNUM];
+      d_lpos = 0L;
+      d_llen = 0L;
+      c_shiadd (p_shdl, d_ssid);
+    }
+    // destroy this engine
+    ~s_hsrv (void) {
+      // clean the jobs
+      while (p_jhed != nullptr) {
+	s_hjob* hjob = p_jhed;
+	p_jhed = hjob->p_next;
+	delete hjob;
+      }
+      while (p_dhed != nullptr) {
+	s_hjob* hjob = p_dhed;
+	p_dhed = hjob->p_next;
+	delete hjob;
+      }
+      // close the connections
+      for (long k = 0L; k < d_hsiz; k++) {
+	if (p_hcon[k] == nullptr) continue;
+	c_close (p_hcon[k]->d_sid);
+	delete p_hcon[k];
+      }
+      delete [] p_hcon;
+      delete [] p_ltcy;
+      c_tcvdestroy (p_tcv);
+      c_mtxdestroy (p_mtx);
+      c_shfree (p_shdl);
+      Object::dref (p_hobj);
+    }
+    // record a latency sample
+    void addltcy (const t_long tref) {
+      t_long ltcy = c_tmus () - tref;
+      c_mtxlock (p_mtx);
+      p_ltcy[d_lpos] = ltcy;
+      d_lpos = (d_lpos + 1L) % HSRV_LNUM;
+      if (d_llen < HSRV_LNUM) d_llen++;
+      d_rcnt++;
+      c_mtxunlock (p_mtx);
+    }
+    // accept a new connection
+    void accept (void) {
+      int sid = c_ipaccept (d_ssid);
+      if (sid < 0) return;
+      c_ipsetopt (sid, SOPT_NDLY, true);
+      // resize the connection array
+      if (sid >= d_hsiz) {
+	long hsiz = (d_hsiz == 0L) ? 64L : d_hsiz;
+	while (hsiz <= sid) hsiz *= 2L;
+	s_hcon** hcon = new s_hcon*[hsiz];
+	for (long k = 0L; k < hsiz; k++) {
+	  hcon[k] = (k < d_hsiz) ? p_hcon[k] : nullptr;
+	}
+	delete [] p_hcon;
+	p_hcon = hcon;
+	d_hsiz = hsiz;
+      }
+      // register the connection
+      s_hcon* hcon = new s_hcon (sid);
+      p_hcon[sid] = hcon;
+      c_mtxlock (p_mtx);
+      d_ccnt++;
+      c_mtxunlock (p_mtx);
+      hcon->d_ireg = true;
+      c_shiadd (p_shdl, sid);
+    }
+    // close a connection
+    void close (s_hcon* hcon) {
+      // a busy connection is closed at the job completion
+      if (hcon->d_busy == true) {
+	hcon->d_dead = true;
+	setireg (hcon, false);
+	return;
+      }
+      // remove from the waiting list
+      if (hcon->d_wait == true) {
+	s_hcon* prev = nullptr;
+	for (s_hcon* node = p_whed; node != nullptr; node = node->p_wnxt) {
+	  if (node != hcon) {
+	    prev = node;
+	    continue;
+	  }
+	  if (prev == nullptr) p_whed = node->p_wnxt;
+	  else prev->p_wnxt = node->p_wnxt;
+	  if (p_wtal == node) p_wtal = prev;
+	  break;
+	}
+      }
+      // unregister and close
+      if (hcon->d_ireg == true) c_shirmv (p_shdl, hcon->d_sid);
+      if (hcon->d_oreg == true) c_shormv (p_shdl, hcon->d_sid);
+      c_close (hcon->d_sid);
+      p_hcon[hcon->d_sid] = nullptr;
+      c_mtxlock (p_mtx);
+      d_ccnt--;
+      c_mtxunlock (p_mtx);
+      delete hcon;
+    }
+    // set the connection input registration
+    void setireg (s_hcon* hcon, const bool ireg) {
+      if (hcon->d_ireg == ireg) return;
+      if (ireg == true) c_shiadd (p_shdl, hcon->d_sid);
+      else c_shirmv (p_shdl, hcon->d_sid);
+      hcon->d_ireg = ireg;
+    }
+    // flush a connection - the result is false if the connection is closed
+    bool flush (s_hcon* hcon) {
+      const char* bufs[HSRV_VMAX];
+      long        blen[HSRV_VMAX];
+      while (hcon->p_ohed != nullptr) {
+	// gather the output buffers
+	long bnum = 0L;
+	s_hout* hout = hcon->p_ohed;
+	for (; (hout != nullptr) && (bnum < HSRV_VMAX); hout = hout->p_next) {
+	  bufs[bnum] = hout->getdata ();
+	  blen[bnum] = hout->length ();
+	  bnum++;
+	}
+	long wlen = c_ipsendv (hcon->d_sid, bufs, blen, bnum);
+	if (wlen == AFNIX_ERR_TOUT) break;
+	if (wlen < 0L) {
+	  hcon->d_clos = true;
+	  close (hcon);
+	  return false;
+	}
+	// consume the written buffers
+	while (hcon->p_ohed != nullptr) {
+	  hout = hcon->p_ohed;
+	  long olen = hout->length ();
+	  if (wlen < olen) {
+	    hout->d_ooff += wlen;
+	    break;
+	  }
+	  wlen -= olen;
+	  if (hout->d_tref >= 0LL) addltcy (hout->d_tref);
+	  hcon->p_ohed = hout->p_next;
+	  if (hcon->p_ohed == nullptr) hcon->p_otal = nullptr;
+	  delete hout;
+	}
+      }
+      // update the output registration
+      bool oreg = (hcon->p_ohed != nullptr);
+      if (hcon->d_oreg != oreg) {
+	if (oreg == true) c_shoadd (p_shdl, hcon->d_sid);
+	else c_shormv (p_shdl, hcon->d_sid);
+	hcon->d_oreg = oreg;
+      }
+      // check for closing
+      if ((oreg == false) && (hcon->d_clos == true) &&
+	  (hcon->d_busy == false)) {
+	close (hcon);
+	return false;
+      }
+      return true;
+    }
+    // reply with an error status and close the connection
+    void reply (s_hcon* hcon, const long code) {
+      HttpResponse resp (code);
+      hcon->addout (hsrv_tohbuf (resp, 0L, true), -1LL);
+      hcon->d_clos = true;
+      setireg (hcon, false);
+      flush (hcon);
+    }
+    // dispatch the next connection request if possible
+    void dispatch (s_hcon* hcon) {
+      if ((hcon->d_busy == true) || (hcon->d_clos == true)) return;
+      if (hcon->d_wait == true) return;
+      // frame the next request
+      long status = hcon->frame ();
+      if (status > 1L) {
+	reply (hcon, status);
+	return;
+      }
+      if (status == 0L) {
+	// without more input, close once the output is flushed
+	if (hcon->d_eofs == true) {
+	  hcon->d_clos = true;
+	  flush (hcon);
+	  return;
+	}
+	setireg (hcon, true);
+	return;
+      }
+      // check the queue capacity
+      if (d_jcnt >= d_qsiz) {
+	hcon->d_wait = true;
+	hcon->p_wnxt = nullptr;
+	if (p_wtal == nullptr) p_whed = p_wtal = hcon;
+	else p_wtal = p_wtal->p_wnxt = hcon;
+	return;
+      }
+      // create and queue a job
+      s_hjob* hjob = new s_hjob (hcon, hcon->consume ());
+      hcon->d_busy = true;
+      d_jcnt++;
+      c_mtxlock (p_mtx);
+      if (p_jtal == nullptr) p_jhed = p_jtal = hjob;
+      else p_jtal = p_jtal->p_next = hjob;
+      c_tcvsignal (p_tcv);
+      c_mtxunlock (p_mtx);
+    }
+    // read a connection input
+    void read (s_hcon* hcon) {
+      hcon->reserve ();
+      long rlen = c_iprecvnb (hcon->d_sid, &hcon->p_ibuf[hcon->d_ilen],
+			      hcon->d_isiz - hcon->d_ilen);
+      if (rlen == AFNIX_ERR_TOUT) return;
+      // check for an error
+      if (rlen < 0L) {
+	hcon->d_clos = true;
+	setireg (hcon, false);
+	close (hcon);
+	return;
+      }
+      // at end of stream, answer the pending requests before closing
+      if (rlen == 0L) {
+	hcon->d_eofs = true;
+	setireg (hcon, false);
+	dispatch (hcon);
+	return;
+      }
+      hcon->d_ilen += rlen;
+      // limit the pipelined input of a busy or waiting connection
+      if ((hcon->d_busy == true) || (hcon->d_wait == true)) {
+	if ((hcon->d_ilen - hcon->d_ioff) >= HSRV_HMAX) setireg (hcon, false);
+	return;
+      }
+      dispatch (hcon);
+    }
+    // complete a job
+    void complete (s_hjob* hjob) {
+      s_hcon* hcon = hjob->p_hcon;
+      hcon->d_busy = false;
+      d_jcnt--;
+      // check for a dead connection
+      if (hcon->d_dead == true) {
+	close (hcon);
+	return;
+      }
+      // add the response
+      if (hjob->p_bbuf == nullptr) {
+	hcon->addout (hjob->p_hbuf, hjob->d_tref);
+      } else {
+	hcon->addout (hjob->p_hbuf, -1LL);
+	hcon->addout (hjob->p_bbuf, hjob->d_tref);
+      }
+      if (hjob->d_clos == true) {
+	hcon->d_clos = true;
+	setireg (hcon, false);
+      }
+      // flush and dispatch the next request
+      if (flush (hcon) == true) dispatch (hcon);
+    }
+    // run the event loop
+    void loop (void) {
+      while (true) {
+	long status = c_shwait (p_shdl, -1);
+	if ((status < 0L) && (status != AFNIX_ERR_INTR)) break;
+	// get the completed jobs
+	c_mtxlock (p_mtx);
+	c_shmtst (p_shdl);
+	s_hjob* hjob = p_dhed;
+	p_dhed = p_dtal = nullptr;
+	bool stop = d_stop;
+	c_mtxunlock (p_mtx);
+	// complete the jobs
+	while (hjob != nullptr) {
+	  s_hjob* next = hjob->p_next;
+	  if (stop == false) complete (hjob);
+	  delete hjob;
+	  hjob = next;
+	}
+	if (stop == true) break;
+	// dispatch the waiting connections
+	while ((p_whed != nullptr) && (d_jcnt < d_qsiz)) {
+	  s_hcon* hcon = p_whed;
+	  p_whed = hcon->p_wnxt;
+	  if (p_whed == nullptr) p_wtal = nullptr;
+	  hcon->d_wait = false;
+	  dispatch (hcon);
+	}
+	// process the ready descriptors
+	long rlen = c_shrlen (p_shdl);
+	for (long k = 0L; k < rlen; k++) {
+	  int sid = c_shrsid (p_shdl, k);
+	  if (sid == d_ssid) {
+	    accept ();
+	    continue;
+	  }
+	  if ((sid < 0) || (sid >= d_hsiz)) continue;
+	  if ((p_hcon[sid] != nullptr) && (c_shotst (p_shdl, sid) == true)) {
+	    flush (p_hcon[sid]);
+	  }
+	  if ((p_hcon[sid] != nullptr) && (c_shitst (p_shdl, sid) == true)) {
+	    read (p_hcon[sid]);
+	  }
+	}
+      }
+    }
+    // process a job in a worker
+    void process (Evaluable* zobj, Nameset* nset, s_hjob* hjob) {
+      HttpRequest*  rqst = nullptr;
+      HttpResponse* resp = nullptr;
+      Object*       robj = nullptr;
+      Cons*         args = nullptr;
+      try {
+	// parse the request
+	try {
+	  InputOutput is (*hjob->p_rbuf);
+	  Object::iref (rqst = new HttpRequest (is));
+	} catch (...) {
+	  HttpResponse eresp (HSRV_STAT_400);
+	  Object::iref (hjob->p_hbuf = hsrv_tohbuf (eresp, 0L, true));
+	  hjob->d_clos = true;
+	  return;
+	}
+	// check the connection mode
+	String conn = rqst->hexists (HttpProto::HEAD_CONN)
+	  ? rqst->hmap (HttpProto::HEAD_CONN).strip().tolower () : "";
+	if (rqst->getvers () == HSRV_VERS_CPT1) {
+	  hjob->d_clos = (conn == HSRV_CONN_CLOS);
+	} else {
+	  hjob->d_clos = (conn != HSRV_CONN_KALV);
+	}
+	// call the handler
+	Object::iref (resp = new HttpResponse (200));
+	try {
+	  args = new Cons (rqst);
+	  args->add (resp);
+	  robj = Object::iref (p_hobj->apply (zobj, nset, args));
+	  Object::iref (hjob->p_bbuf = hsrv_tobbuf (robj));
+	} catch (...) {
+	  Object::dref (hjob->p_bbuf); hjob->p_bbuf = nullptr;
+	  resp->reset ();
+	  resp->setstatus (HSRV_STAT_500);
+	}
+	delete args; args = nullptr;
+	Object::dref (robj); robj = nullptr;
+	// format the response header
+	long blen = (hjob->p_bbuf == nullptr) ? 0L : hjob->p_bbuf->length ();
+	Object::iref (hjob->p_hbuf = hsrv_tohbuf (*resp, blen, hjob->d_clos));
+	// a head request has no content
+	if (rqst->getrmth () == HSRV_RMTH_HEAD) {
+	  Object::dref (hjob->p_bbuf);
+	  hjob->p_bbuf = nullptr;
+	}
+	if (blen == 0L) {
+	  Object::dref (hjob->p_bbuf);
+	  hjob->p_bbuf = nullptr;
+	}
+      } catch (...) {
+	delete args;
+	Object::dref (robj);
+	Object::dref (hjob->p_bbuf); hjob->p_bbuf = nullptr;
+	Object::dref (hjob->p_hbuf); hjob->p_hbuf = nullptr;
+	HttpResponse eresp (HSRV_STAT_500);
+	Object::iref (hjob->p_hbuf = hsrv_tohbuf (eresp, 0L, true));
+	hjob->d_clos = true;
+      }
+      Object::dref (resp);
+      Object::dref (rqst);
+    }
+    // run a worker
+    void work (Evaluable* zobj, Nameset* nset) {
+      while (true) {
+	// get the next job
+	c_mtxlock (p_mtx);
+	while ((p_jhed == nullptr) && (d_stop == false)) {
+	  c_tcvwait (p_tcv, p_mtx);
+	}
+	if (d_stop == true) {
+	  c_mtxunlock (p_mtx);
+	  break;
+	}
+	s_hjob* hjob = p_jhed;
+	p_jhed = hjob->p_next;
+	if (p_jhed == nullptr) p_jtal = nullptr;
+	hjob->p_next = nullptr;
+	c_mtxunlock (p_mtx);
+	// process the job
+	process (zobj, nset, hjob);
+	// post the completed job
+	c_mtxlock (p_mtx);
+	if (p_dtal == nullptr) p_dhed = p_dtal = hjob;
+	else p_dtal = p_dtal->p_next = hjob;
+	c_shmark (p_shdl);
+	c_mtxunlock (p_mtx);
+      }
+    }
+    // stop the engine
+    void stop (void) {
+      c_mtxlock (p_mtx);
+      d_stop = true;
+      c_tcvbdcast (p_tcv);
+      c_shmark (p_shdl);
+      c_mtxunlock (p_mtx);
+    }
+    // get a latency percentile
+    t_long getltcy (const t_real pval) {
+      c_mtxlock (p_mtx);
+      long    llen = d_llen;
+      t_long* data = (llen == 0L) ? nullptr : new t_long[llen];
+      for (long k = 0L; k < llen; k++) data[k] = p_ltcy[k];
+      c_mtxunlock (p_mtx);
+      if (llen == 0L) return 0LL;
+      long kidx = (long) (pval * (t_real) llen / 100.0);
+      if (kidx < 0L) kidx = 0L;
+      if (kidx >= llen) kidx = llen - 1L;
+      t_long result = hsrv_select (data, llen, kidx);
+      delete [] data;
+      return result;
+    }
+  };
+
+  // the server thread form
+  class HttpThread : public Object {
+  private:
+    // the server engine
+    s_hsrv* p_hsrv;
+    // the worker flag
+    bool    d_wflg;
+
+  public:
+    // create a server thread form
+    HttpThread (s_hsrv* hsrv, const bool wflg) {
+      p_hsrv = hsrv;
+      d_wflg = wflg;
+    }
+    // return the class name
+    String repr (void) const {
+      return "HttpThread";
+    }
+    // run the server loop or worker
+    Object* eval (Evaluable* zobj, Nameset* nset) {
+      if (d_wflg == true) p_hsrv->work (zobj, nset); else p_hsrv->loop ();
+      return nullptr;
+    }
+  };
+
+  // -------------------------------------------------------------------------
+  // - class section                                                         -
+  // -------------------------------------------------------------------------
+
+  // create a http server by stream and handler
+
+  HttpServer::HttpServer (InputStream* ssrv, Object* hobj) {
+    Object::iref (p_ssrv = ssrv);
+    Object::iref (p_hobj = hobj);
+    d_wnum = HSRV_WNUM;
+    d_qsiz = HSRV_QSIZ;
+    p_hsrv = nullptr;
+  }
+
+  // create a http server by stream, handler and workers
+
+  HttpServer::HttpServer (InputStream* ssrv, Object* hobj, const long wnum) {
+    Object::iref (p_ssrv = ssrv);
+    Object::iref (p_hobj = hobj);
+    d_wnum = (wnum <= 0L) ? HSRV_WNUM : wnum;
+    d_qsiz = HSRV_QSIZ;
+    p_hsrv = nullptr;
+  }
+
+  // destroy this http server
+
+  HttpServer::~HttpServer (void) {
+    stop ();
+    Object::dref (p_hobj);
+    Object::dref (p_ssrv);
+  }
+
+  // return the class name
+
+  String HttpServer::repr (void) const {
+    return "HttpServer";
+  }
+
+  // set the number of workers
+
+  void HttpServer::setwnum (const long wnum) {
+    wrlock ();
+    try {
+      if (p_hsrv != nullptr) {
+	throw Exception ("http-error", "cannot set workers of a running server");
+      }
+      d_wnum = (wnum <= 0L) ? HSRV_WNUM : wnum;
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // return the number of workers
+
+  long HttpServer::getwnum (void) const {
+    rdlock ();
+    try {
+      long result = d_wnum;
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // set the request queue size
+
+  void HttpServer::setqsiz (const long qsiz) {
+    wrlock ();
+    try {
+      if (p_hsrv != nullptr) {
+	throw Exception ("http-error", "cannot set queue of a running server");
+      }
+      d_qsiz = (qsiz <= 0L) ? HSRV_QSIZ : qsiz;
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // return the request queue size
+
+  long HttpServer::getqsiz (void) const {
+    rdlock ();
+    try {
+      long result = d_qsiz;
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // start the server threads
+
+  void HttpServer::start (Evaluable* zobj) {
+    wrlock ();
+    try {
+      // check the server state
+      if (p_hsrv != nullptr) {
+	throw Exception ("http-error", "http server already started");
+      }
+      int ssid = (p_ssrv == nullptr) ? -1 : p_ssrv->getsid ();
+      if (ssid < 0) {
+	throw Exception ("http-error", "invalid server stream descriptor");
+      }
+      if (p_hobj == nullptr) {
+	throw Exception ("http-error", "invalid nil request handler");
+      }
+      auto robj = dynamic_cast <Runnable*> (zobj);
+      if (robj == nullptr) {
+	throw Exception ("http-error", "invalid object as runnable",
+			 Object::repr (zobj));
+      }
+      // create the engine and launch the threads
+      p_hsrv = new s_hsrv (ssid, p_hobj, d_qsiz);
+      try {
+	d_thrs.add (robj->launch (new HttpThread (p_hsrv, false)));
+	for (long k = 0L; k < d_wnum; k++) {
+	  d_thrs.add (robj->launch (new HttpThread (p_hsrv, true)));
+	}
+      } catch (...) {
+	p_hsrv->stop ();
+	long tlen = d_thrs.length ();
+	for (long k = 0L; k < tlen; k++) {
+	  auto thr = dynamic_cast <Thread*> (d_thrs.get (k));
+	  if (thr != nullptr) thr->wait ();
+	}
+	d_thrs.reset ();
+	delete p_hsrv;
+	p_hsrv = nullptr;
+	throw;
+      }
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // stop the server and wait for the threads
+
+  void HttpServer::stop (void) {
+    wrlock ();
+    try {
+      if (p_hsrv != nullptr) {
+	// stop the engine and wait for the threads
+	p_hsrv->stop ();
+	long tlen = d_thrs.length ();
+	for (long k = 0L; k < tlen; k++) {
+	  auto thr = dynamic_cast <Thread*> (d_thrs.get (k));
+	  if (thr != nullptr) thr->wait ();
+	}
+	d_thrs.reset ();
+	// clean the engine
+	delete p_hsrv;
+	p_hsrv = nullptr;
+      }
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // return true if the server is running
+
+  bool HttpServer::isrun (void) const {
+    rdlock ();
+    try {
+      bool result = (p_hsrv != nullptr);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // return the number of processed requests
+
+  t_long HttpServer::getrcnt (void) const {
+    rdlock ();
+    try {
+      t_long result = 0LL;
+      if (p_hsrv != nullptr) {
+	c_mtxlock (p_hsrv->p_mtx);
+	result = p_hsrv->d_rcnt;
+	c_mtxunlock (p_hsrv->p_mtx);
+      }
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // return the number of open connections
+
+  long HttpServer::getccnt (void) const {
+    rdlock ();
+    try {
+      long result = 0L;
+      if (p_hsrv != nullptr) {
+	c_mtxlock (p_hsrv->p_mtx);
+	result = p_hsrv->d_ccnt;
+	c_mtxunlock (p_hsrv->p_mtx);
+      }
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // return a request latency percentile in microseconds
+
+  t_long HttpServer::getltcy (const t_real pval) const {
+    rdlock ();
+    try {
+      t_long result = (p_hsrv == nullptr) ? 0LL : p_hsrv->getltcy (pval);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // -------------------------------------------------------------------------
+  // - object section                                                        -
+  // -------------------------------------------------------------------------
+
+  // the quark zone
+  static const long QUARK_ZONE_LENGTH = 10;
+  static QuarkZone  zone (QUARK_ZONE_LENGTH);
+
+  // the object supported quarks
+  static const long QUARK_STOP    = zone.intern ("stop");
+  static const long QUARK_START   = zone.intern ("start");
+  static const long QUARK_RUNP    = zone.intern ("running-p");
+  static const long QUARK_GETRCNT = zone.intern ("get-request-count");
+  static const long QUARK_GETCCNT = zone.intern ("get-connection-count");
+  static const long QUARK_GETLTCY = zone.intern ("get-latency");
+  static const long QUARK_SETWNUM = zone.intern ("set-workers");
+  static const long QUARK_GETWNUM = zone.intern ("get-workers");
+  static const long QUARK_SETQSIZ = zone.intern ("set-queue-size");
+  static const long QUARK_GETQSIZ = zone.intern ("get-queue-size");
+
+  // create a new object in a generic way
+
+  Object* HttpServer::mknew (Vector* argv) {
+    long argc = (argv == nullptr) ? 0 : argv->length ();
+    // check for 2 or 3 arguments
+    if ((argc == 2) || (argc == 3)) {
+      Object* obj = argv->get (0);
+      auto   ssrv = dynamic_cast <InputStream*> (obj);
+      if (ssrv == nullptr) {
+	throw Exception ("type-error", "invalid object as server stream",
+			 Object::repr (obj));
+      }
+      Object* hobj = argv->get (1);
+      if (argc == 2) return new HttpServer (ssrv, hobj);
+      long wnum = argv->getlong (2);
+      return new HttpServer (ssrv, hobj, wnum);
+    }
+    throw Exception ("argument-error",
+		     "too many arguments with http server constructor");
+  }
+
+  // return true if the given quark is defined
+
+  bool HttpServer::isquark (const long quark, const bool hflg) const {
+    rdlock ();
+    if (zone.exists (quark) == true) {
+      unlock ();
+      return true;
+    }
+    bool result = hflg ? Object::isquark (quark, hflg) : false;
+    unlock ();
+    return result;
+  }
+
+  // apply this object with a set of arguments and a quark
+
+  Object* HttpServer::apply (Evaluable* zobj, Nameset* nset, const long quark,
+			     Vector* argv) {
+    // get the number of arguments
+    long argc = (argv == nullptr) ? 0 : argv->length ();
+
+    // check for 0 argument
+    if (argc == 0) {
+      if (quark == QUARK_RUNP)    return new Boolean (isrun  ());
+      if (quark == QUARK_GETRCNT) return new Integer (getrcnt ());
+      if (quark == QUARK_GETCCNT) return new Integer (getccnt ());
+      if (quark == QUARK_GETWNUM) return new Integer (getwnum ());
+      if (quark == QUARK_GETQSIZ) return new Integer (getqsiz ());
+      if (quark == QUARK_START) {
+	start (zobj);
+	return nullptr;
+      }
+      if (quark == QUARK_STOP) {
+	stop ();
+	return nullptr;
+      }
+    }
+    // check for 1 argument
+    if (argc == 1) {
+      if (quark == QUARK_GETLTCY) {
+	t_real pval = argv->getrint (0);
+	return new Integer (getltcy (pval));
+      }
+      if (quark == QUARK_SETWNUM) {
+	long wnum = argv->getlong (0);
+	setwnum (wnum);
+	return nullptr;
+      }
+      if (quark == QUARK_SETQSIZ) {
+	long qsiz = argv->getlong (0);
+	setqsiz (qsiz);
+	return nullptr;
+      }
+    }
+    // call the object method
+    return Object::apply (zobj, nset, quark, argv);
+  }
+}
@@ -0,0 +1,133 @@
+// ---------------------------------------------------------------------------
+// - HttpServer.hpp                                                          -
+// - afnix:nwg module - http server class definition                         -
+// ---------------------------------------------------------------------------
+// - This program is free software;  you can redistribute it  and/or  modify -
+// - it provided that this copyright notice is kept intact.                  -
+// -                                                                         -
+// - This program  is  distributed in  the hope  that it will be useful, but -
+// - without  any  warranty;  without  even   the   implied    warranty   of -
+// - merchantability or fitness for a particular purpose.  In no event shall -
+// - the copyright holder be liable for any  direct, indirect, incidental or -
+// - special damages arising in any way out of the use of this software.     -
+// ---------------------------------------------------------------------------
+// - copyright (c) 1999-2021 amaury darsch                                   -
+// ---------------------------------------------------------------------------
+
+#ifndef  AFNIX_HTTPSERVER_HPP
+#define  AFNIX_HTTPSERVER_HPP
+
+#ifndef  AFNIX_VECTOR_HPP
+#include "Vector.hpp"
+#endif
+
+#ifndef  AFNIX_INPUTSTREAM_HPP
+#include "InputStream.hpp"
+#endif
+
+namespace afnix {
+
+  /// The HttpServer class is a http/1.1 server engine bound to a listening
+  /// server stream, normally a tcp server, and a request handler. When
+  /// started, the server runs an event loop which accepts the connections
+  /// and reads the requests incrementally. A complete request is dispatched
+  /// to a bounded pool of worker threads which call the handler with a
+  /// http request and a http response object. The handler returns the
+  /// response content, as a string, a buffer or nil, and the response is
+  /// written with its header in a gathered write. The connections are kept
+  /// alive unless requested otherwise and pipelined requests are processed
+  /// in order. The server must be stopped to terminate its threads.
+  /// @author amaury darsch
+
+  class HttpServer : public virtual Object {
+  private:
+    /// the server stream
+    InputStream* p_ssrv;
+    /// the request handler
+    Object* p_hobj;
+    /// the number of workers
+    long    d_wnum;
+    /// the request queue size
+    long    d_qsiz;
+    /// the server threads
+    Vector  d_thrs;
+    /// the server engine
+    struct s_hsrv* p_hsrv;
+
+  public:
+    /// create a http server by stream and handler
+    /// @param ssrv the server stream
+    /// @param hobj the request handler
+    HttpServer (InputStream* ssrv, Object* hobj);
+
+    /// create a http server by stream, handler and workers
+    /// @param ssrv the server stream
+    /// @param hobj the request handler
+    /// @param wnum the number of workers
+    HttpServer (InputStream* ssrv, Object* hobj, const long wnum);
+
+    /// destroy this http server
+    ~HttpServer (void);
+
+    /// @return the class name
+    String repr (void) const;
+
+    /// set the number of workers
+    /// @param wnum the number of workers
+    virtual void setwnum (const long wnum);
+
+    /// @return the number of workers
+    virtual long getwnum (void) const;
+
+    /// set the request queue size
+    /// @param qsiz the request queue size
+    virtual void setqsiz (const long qsiz);
+
+    /// @return the request queue size
+    virtual long getqsiz (void) const;
+
+    /// start the server threads
+    /// @param zobj the launching evaluable
+    virtual void start (Evaluable* zobj);
+
+    /// stop the server and wait for its threads
+    virtual void stop (void);
+
+    /// @return true if the server is running
+    virtual bool isrun (void) const;
+
+    /// @return the number of processed requests
+    virtual t_long getrcnt (void) const;
+
+    /// @return the number of open connections
+    virtual long getccnt (void) const;
+
+    /// @return a request latency percentile in microseconds
+    /// @param pval the percentile value
+    virtual t_long getltcy (const t_real pval) const;
+
+  private:
+    // make the copy constructor private
+    HttpServer (const HttpServer&) =delete;
+    // make the assignment operator private
+    HttpServer& operator = (const HttpServer&) =delete;
+
+  public:
+    /// create a new object in a generic way
+    /// @param argv the argument vector
+    static Object* mknew (Vector* argv);
+
+    /// @return true if the given quark is defined
+    bool isquark (const long quark, const bool hflg) const;
+
+    /// apply this object with a set of arguments and a quark
+    /// @param zobj  the current evaluable
+    /// @param nset  the current nameset
+    /// @param quark the quark to apply these arguments
+    /// @param argv  the arguments to apply
+    Object* apply (Evaluable* zobj, Nameset* nset, const long quark,
+		   Vector* argv);
+  };
+}
+
+#endif
@@ -19,7 +19,9 @@
 #include "Plist.hpp"
 #include "Vector.hpp"
 #include "Boolean.hpp"
+#include "Unicode.hpp"
 #include "HashTable.hpp"
+#include "JsonObject.hpp"
 #include "QuarkZone.hpp"
 #include "Exception.hpp"
 
@@ -32,8 +34,52 @@ namespace afnix {
   // forward object stringify
   static bool json_stry (Buffer& jbuf, Object* obj);
   
+  // stringify a string into a buffer with the json escapes - the plain
+  // byte runs are added as a block
+  static bool json_stry (Buffer& jbuf, const String& sobj) {
+    static const char* JSON_HEXA = "0123456789abcdef";
+    char* cbuf = Unicode::encode (Encoding::EMOD_UTF8, sobj);
+    try {
+      jbuf.add ('"');
+      long cpos = 0L;
+      long k    = 0L;
+      for (; cbuf[k] != nilc; k++) {
+	t_byte b = (t_byte) cbuf[k];
+	if ((b != '"') && (b != '\\') && (b >= 0x20)) continue;
+	// add the plain run and escape the byte
+	jbuf.add (&cbuf[cpos], k - cpos);
+	cpos = k + 1L;
+	jbuf.add ('\\');
+	switch (b) {
+	case '"':  jbuf.add ('"');  break;
+	case '\\': jbuf.add ('\\'); break;
+	case '\b': jbuf.add ('b');  break;
+	case '\f': jbuf.add ('f');  break;
+	case '\n': jbuf.add ('n');  break;
+	case '\r': jbuf.add ('r');  break;
+	case '\t': jbuf.add ('t');  break;
+	default:
+	  jbuf.add ("u00", 3);
+	  jbuf.add (JSON_HEXA[b >> 4]);
+	  jbuf.add (JSON_HEXA[b & 0x0F]);
+	  break;
+	}
+      }
+      jbuf.add (&cbuf[cpos], k - cpos);
+      jbuf.add ('"');
+      delete [] cbuf;
+      return true;
+    } catch (...) {
+      delete [] cbuf;
+      throw;
+    }
+  }
+
   // stringify a literal into a buffer
   static bool json_stry (Buffer& jbuf, const Literal& lobj) {
+    // check for a string
+    auto sobj = dynamic_cast<const String*>(&lobj);
+    if (sobj != nullptr) return json_stry (jbuf, *sobj);
     jbuf.add(lobj.toliteral());
     return true;
   }
@@ -89,7 +135,7 @@ namespace afnix {
       // add separator
       if (k > 0L) jbuf.add (',');
       // add the key
-      jbuf.add (key.toliteral());
+      json_stry (jbuf, key);
       jbuf.add (':');
       // add the object
       if (json_stry (jbuf, obj) == false) return false;
@@ -99,6 +145,31 @@ namespace afnix {
     return true;
   }
 
+  // stringify a json object into a buffer
+  static bool json_stry (Buffer& jbuf, const JsonObject& jobj) {
+    // initialize the object
+    jbuf.add ('{');
+    // loop in the members
+    long mlen = jobj.length ();
+    for (long k = 0L; k < mlen; k++) {
+      // add separator
+      if (k > 0L) jbuf.add (',');
+      // add the name
+      json_stry (jbuf, jobj.getname (k));
+      jbuf.add (':');
+      // add the member value
+      Object* mobj = jobj.getobj (k);
+      if (mobj == nullptr) {
+	jbuf.add ("null", 4);
+	continue;
+      }
+      if (json_stry (jbuf, mobj) == false) return false;
+    }
+    // finish the object
+    jbuf.add ('}');
+    return true;
+  }
+
   // stringify a plist into a buffer
   static bool json_stry (Buffer& jbuf, const Plist& pobj) {
     // initialize the object
@@ -115,7 +186,7 @@ namespace afnix {
       // add separator
       if (k > 0L) jbuf.add (',');
       // add the name
-      jbuf.add (name.toliteral());
+      json_stry (jbuf, name);
       jbuf.add (':');
       // add the literal
       if (json_stry (jbuf, *lobj) == false) {
@@ -143,7 +214,7 @@ namespace afnix {
       for (long j = 0L; j < cols; j++) {
 	if (j > 0L) jbuf.add(',');
 	String sval = ptbl.get (i, j);
-	jbuf.add (sval.toliteral());
+	json_stry (jbuf, sval);
       }
       jbuf.add(']');
     }
@@ -167,6 +238,9 @@ namespace afnix {
     // check for a hashtable
     auto hobj = dynamic_cast<HashTable*>(obj);
     if (hobj != nullptr) return json_stry (jbuf, *hobj);
+    // check for a json object
+    auto jobj = dynamic_cast<JsonObject*>(obj);
+    if (jobj != nullptr) return json_stry (jbuf, *jobj);
     // check for a plist
     auto pobj = dynamic_cast<Plist*>(obj);
     if (pobj != nullptr) return json_stry (jbuf, *pobj);
@@ -184,6 +258,7 @@ namespace afnix {
   // create a default json
   
   Json::Json (void) {
+    d_jbuf.setemod (Encoding::EMOD_UTF8);
     reset ();
   }
 
@@ -199,6 +274,7 @@ namespace afnix {
     wrlock ();
     try {
       d_jbuf.reset ();
+      unlock ();
     } catch (...) {
       unlock ();
       throw;
@@ -0,0 +1,251 @@
+// ---------------------------------------------------------------------------
+// - JsonObject.cpp                                                          -
+// - afnix:nwg module - json object class implementation                     -
+// ---------------------------------------------------------------------------
+// - This program is free software;  you can redistribute it  and/or  modify -
+// - it provided that this copyright notice is kept intact.                  -
+// -                                                                         -
+// - This program  is  distributed in  the hope  that it will be useful, but -
+// - without  any  warranty;  without  even   the   implied    warranty   of -
+// - merchantability or fitness for a particular purpose.  In no event shall -
+// - the copyright holder be liable for any  direct, indirect, incidental or -
+// - special damages arising in any way out of the use of this software.     -
+// ---------------------------------------------------------------------------
+// - copyright (c) 1999-2021 amaury darsch                                   -
+// ---------------------------------------------------------------------------
+
+#include "Vector.hpp"
+#include "Boolean.hpp"
+#include "Integer.hpp"
+#include "Evaluable.hpp"
+#include "QuarkZone.hpp"
+#include "Exception.hpp"
+#include "JsonObject.hpp"
+
+namespace afnix {
+
+  // -------------------------------------------------------------------------
+  // - class section                                                         -
+  // -------------------------------------------------------------------------
+
+  // create an empty json object
+
+  JsonObject::JsonObject (void) {
+    reset ();
+  }
+
+  // return the class name
+
+  String JsonObject::repr (void) const {
+    return "JsonObject";
+  }
+
+  // reset this json object
+
+  void JsonObject::reset (void) {
+    wrlock ();
+    try {
+      d_mnam.reset ();
+      d_mtbl.reset ();
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // return the number of members
+
+  long JsonObject::length (void) const {
+    rdlock ();
+    try {
+      long result = d_mnam.length ();
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // check if a member exists
+
+  bool JsonObject::exists (const String& name) const {
+    rdlock ();
+    try {
+      bool result = d_mtbl.exists (name);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // add a member by name and value
+
+  void JsonObject::add (const String& name, Object* mobj) {
+    wrlock ();
+    try {
+      if (d_mtbl.exists (name) == false) d_mnam.add (name);
+      d_mtbl.add (name, mobj);
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get a member value by name
+
+  Object* JsonObject::get (const String& name) const {
+    rdlock ();
+    try {
+      Object* result = d_mtbl.get (name);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get a member name by index
+
+  String JsonObject::getname (const long index) const {
+    rdlock ();
+    try {
+      String result = d_mnam.get (index);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get a member value by index
+
+  Object* JsonObject::getobj (const long index) const {
+    rdlock ();
+    try {
+      Object* result = d_mtbl.get (d_mnam.get (index));
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // -------------------------------------------------------------------------
+  // - object section                                                        -
+  // -------------------------------------------------------------------------
+
+  // the quark zone
+  static const long QUARK_ZONE_LENGTH = 7;
+  static QuarkZone  zone (QUARK_ZONE_LENGTH);
+
+  // the object supported quarks
+  static const long QUARK_ADD     = zone.intern ("add");
+  static const long QUARK_GET     = zone.intern ("get");
+  static const long QUARK_RESET   = zone.intern ("reset");
+  static const long QUARK_LENGTH  = zone.intern ("length");
+  static const long QUARK_EXISTP  = zone.intern ("exists-p");
+  static const long QUARK_GETNAME = zone.intern ("get-name");
+  static const long QUARK_GETOBJ  = zone.intern ("get-object");
+
+  // create a new object in a generic way
+
+  Object* JsonObject::mknew (Vector* argv) {
+    long argc = (argv == nullptr) ? 0 : argv->length ();
+
+    // check 0 argument
+    if (argc == 0) return new JsonObject;
+    // invalid arguments
+    throw Exception ("argument-error", "too many argument for json object");
+  }
+
+  // return true if the given quark is defined
+
+  bool JsonObject::isquark (const long quark, const bool hflg) const {
+    rdlock ();
+    try {
+      if (zone.exists (quark) == true) {
+	unlock ();
+	return true;
+      }
+      bool result = hflg ? Object::isquark (quark, hflg) : false;
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // apply this object with a set of arguments and a quark
+
+  Object* JsonObject::apply (Evaluable* zobj, Nameset* nset, const long quark,
+			     Vector* argv) {
+    // get the number of arguments
+    long argc = (argv == nullptr) ? 0 : argv->length ();
+
+    // dispatch 0 argument
+    if (argc == 0) {
+      if (quark == QUARK_LENGTH) return new Integer (length ());
+      if (quark == QUARK_RESET) {
+	reset ();
+	return nullptr;
+      }
+    }
+    // dispatch 1 argument
+    if (argc == 1) {
+      if (quark == QUARK_EXISTP) {
+	String name = argv->getstring (0);
+	return new Boolean (exists (name));
+      }
+      if (quark == QUARK_GETNAME) {
+	long index = argv->getlong (0);
+	return new String (getname (index));
+      }
+      if (quark == QUARK_GET) {
+	String name = argv->getstring (0);
+	rdlock ();
+	try {
+	  Object* result = get (name);
+	  zobj->post (result);
+	  unlock ();
+	  return result;
+	} catch (...) {
+	  unlock ();
+	  throw;
+	}
+      }
+      if (quark == QUARK_GETOBJ) {
+	long index = argv->getlong (0);
+	rdlock ();
+	try {
+	  Object* result = getobj (index);
+	  zobj->post (result);
+	  unlock ();
+	  return result;
+	} catch (...) {
+	  unlock ();
+	  throw;
+	}
+      }
+    }
+    // dispatch 2 arguments
+    if (argc == 2) {
+      if (quark == QUARK_ADD) {
+	String name = argv->getstring (0);
+	Object* mobj = argv->get (1);
+	add (name, mobj);
+	return nullptr;
+      }
+    }
+    // call the object method
+    return Object::apply (zobj, nset, quark, argv);
+  }
+}
@@ -0,0 +1,101 @@
+// ---------------------------------------------------------------------------
+// - JsonObject.hpp                                                          -
+// - afnix:nwg module - json object class definition                         -
+// ---------------------------------------------------------------------------
+// - This program is free software;  you can redistribute it  and/or  modify -
+// - it provided that this copyright notice is kept intact.                  -
+// -                                                                         -
+// - This program  is  distributed in  the hope  that it will be useful, but -
+// - without  any  warranty;  without  even   the   implied    warranty   of -
+// - merchantability or fitness for a particular purpose.  In no event shall -
+// - the copyright holder be liable for any  direct, indirect, incidental or -
+// - special damages arising in any way out of the use of this software.     -
+// ---------------------------------------------------------------------------
+// - copyright (c) 1999-2021 amaury darsch                                   -
+// ---------------------------------------------------------------------------
+
+#ifndef  AFNIX_JSONOBJECT_HPP
+#define  AFNIX_JSONOBJECT_HPP
+
+#ifndef  AFNIX_STRVEC_HPP
+#include "Strvec.hpp"
+#endif
+
+#ifndef  AFNIX_HASHTABLE_HPP
+#include "HashTable.hpp"
+#endif
+
+namespace afnix {
+
+  /// The JsonObject class is an ordered collection of named members which
+  /// maps a json object. The members are kept in their insertion order and
+  /// can be accessed either by name or by index. Adding a member with an
+  /// existing name replaces the member value at its original position.
+  /// @author amaury darsch
+
+  class JsonObject : public Object {
+  private:
+    /// the member names
+    Strvec    d_mnam;
+    /// the member table
+    HashTable d_mtbl;
+
+  public:
+    /// create an empty json object
+    JsonObject (void);
+
+    /// @return the class name
+    String repr (void) const override;
+
+    /// reset this json object
+    virtual void reset (void);
+
+    /// @return the number of members
+    virtual long length (void) const;
+
+    /// @return true if a member exists
+    /// @param name the member name to check
+    virtual bool exists (const String& name) const;
+
+    /// add a member by name and value
+    /// @param name the member name
+    /// @param mobj the member value
+    virtual void add (const String& name, Object* mobj);
+
+    /// @return a member value by name
+    /// @param name the member name
+    virtual Object* get (const String& name) const;
+
+    /// @return a member name by index
+    /// @param index the member index
+    virtual String getname (const long index) const;
+
+    /// @return a member value by index
+    /// @param index the member index
+    virtual Object* getobj (const long index) const;
+
+  private:
+    // make the copy constructor private
+    JsonObject (const JsonObject&) =delete;
+    // make the assignment operator private
+    JsonObject& operator = (const JsonObject&) =delete;
+
+  public:
+    /// create a new object in a generic way
+    /// @param argv the argument vector
+    static Object* mknew (Vector* argv);
+
+    /// @return true if the given quark is defined
+    bool isquark (const long quark, const bool hflg) const override;
+
+    /// apply this object with a set of arguments and a quark
+    /// @param zobj  the current evaluable
+    /// @param nset  the current nameset
+    /// @param quark the quark to apply these arguments
+    /// @param argv  the arguments to apply
+    Object* apply (Evaluable* zobj, Nameset* nset, const long quark,
+		   Vector* argv) override;
+  };
+}
+
+#endif
@@ -0,0 +1,976 @@
+// ---------------------------------------------------------------------------
+// - JsonReader.cpp                                                          -
+// - afnix:nwg module - json reader class implementation                     -
+// ---------------------------------------------------------------------------
+// - This program is free software;  you can redistribute it  and/or  modify -
+// - it provided that this copyright notice is kept intact.                  -
+// -                                                                         -
+// - This program  is  distributed in  the hope  that it will be useful, but -
+// - without  any  warranty;  without  even   the   implied    warranty   of -
+// - merchantability or fitness for a particular purpose.  In no event shall -
+// - the copyright holder be liable for any  direct, indirect, incidental or -
+// - special damages arising in any way out of the use of this software.     -
+// ---------------------------------------------------------------------------
+// - copyright (c) 1999-2021 amaury darsch                                   -
+// ---------------------------------------------------------------------------
+
+#include "Item.hpp"
+#include "Ascii.hpp"
+#include "Real.hpp"
+#include "Vector.hpp"
+#include "Boolean.hpp"
+#include "Integer.hpp"
+#include "Unicode.hpp"
+#include "Evaluable.hpp"
+#include "QuarkZone.hpp"
+#include "Exception.hpp"
+#include "JsonObject.hpp"
+#include "JsonReader.hpp"
+#include "InputString.hpp"
+#include "ccnv.hpp"
+
+namespace afnix {
+
+  // -------------------------------------------------------------------------
+  // - private section                                                       -
+  // -------------------------------------------------------------------------
+
+  // the json byte window minimum size
+  static const long JSON_WBUF_MINS = 256L;
+  // the json byte window maximum size
+  static const long JSON_WBUF_SIZE = 65536L;
+  // the json scratch buffer default size
+  static const long JSON_SBUF_SIZE = 256L;
+  // the json maximum nesting depth
+  static const long JSON_DPTH_MAX  = 1024L;
+
+  // the json lexer - the lexer reads the stream by byte window when the
+  // stream is buffered, or byte per byte otherwise, so that nothing is
+  // read after the json text; the unread window bytes are pushed back
+  // into the stream when the lexer is flushed
+  struct s_jlex {
+    // the input stream
+    InputStream* p_is;
+    // the byte window
+    char* p_wbuf;
+    // the window size
+    long  d_wsiz;
+    // the window maximum size
+    long  d_wmax;
+    // the window position
+    long  d_wpos;
+    // the window length
+    long  d_wlen;
+    // the scratch buffer
+    char* p_sbuf;
+    // the scratch size
+    long  d_ssiz;
+    // the scratch length
+    long  d_slen;
+    // create a lexer by stream
+    s_jlex (InputStream* is) {
+      p_is = is;
+      d_wmax = (dynamic_cast <InputBuffer*> (is) == nullptr) ? 1L :
+	JSON_WBUF_SIZE;
+      p_wbuf = new char[d_wmax];
+      d_wsiz = (d_wmax < JSON_WBUF_MINS) ? d_wmax : JSON_WBUF_MINS;
+      d_wpos = 0L;
+      d_wlen = 0L;
+      p_sbuf = new char[JSON_SBUF_SIZE];
+      d_ssiz = JSON_SBUF_SIZE;
+      d_slen = 0L;
+    }
+    // destroy this lexer
+    ~s_jlex (void) {
+      flush ();
+      delete [] p_wbuf;
+      delete [] p_sbuf;
+    }
+    // flush the byte window into the stream
+    void flush (void) {
+      if (d_wpos < d_wlen) p_is->pushback (&p_wbuf[d_wpos], d_wlen - d_wpos);
+      d_wpos = 0L;
+      d_wlen = 0L;
+    }
+    // fill the byte window - the window grows with the reads so that
+    // a short text does not read ahead too much
+    bool fill (void) {
+      if (d_wpos < d_wlen) return true;
+      d_wpos = 0L;
+      d_wlen = p_is->copy (p_wbuf, d_wsiz);
+      if (d_wsiz < d_wmax) d_wsiz *= 2L;
+      if (d_wlen <= 0L) {
+	d_wlen = 0L;
+	return false;
+      }
+      return true;
+    }
+    // get the next byte without consuming it or -1 at the end
+    int peek (void) {
+      return (fill () == false) ? -1 : (t_byte) p_wbuf[d_wpos];
+    }
+    // get the next byte or -1 at the end
+    int getc (void) {
+      return (fill () == false) ? -1 : (t_byte) p_wbuf[d_wpos++];
+    }
+    // skip the blank bytes and return the next byte or -1 at the end
+    int skip (void) {
+      while (fill () == true) {
+	while (d_wpos < d_wlen) {
+	  char c = p_wbuf[d_wpos];
+	  if ((c != ' ') && (c != '\n') && (c != '\r') && (c != '\t')) {
+	    return (t_byte) c;
+	  }
+	  d_wpos++;
+	}
+      }
+      return -1;
+    }
+    // consume an expected byte
+    void expect (const char c, const char* reason) {
+      if (getc () != (t_byte) c) throw Exception ("json-error", reason);
+    }
+    // add bytes to the scratch buffer
+    void sadd (const char* s, const long size) {
+      if (size <= 0L) return;
+      if (d_slen + size >= d_ssiz) {
+	long ssiz = d_ssiz * 2L;
+	while (d_slen + size >= ssiz) ssiz *= 2L;
+	char* sbuf = new char[ssiz];
+	for (long k = 0L; k < d_slen; k++) sbuf[k] = p_sbuf[k];
+	delete [] p_sbuf;
+	p_sbuf = sbuf;
+	d_ssiz = ssiz;
+      }
+      for (long k = 0L; k < size; k++) p_sbuf[d_slen++] = s[k];
+    }
+    // add a byte to the scratch buffer
+    void sadd (const char c) {
+      if (d_slen + 1L < d_ssiz) p_sbuf[d_slen++] = c; else sadd (&c, 1L);
+    }
+    // map the scratch buffer to a string
+    String tostr (const bool aflg) {
+      p_sbuf[d_slen] = nilc;
+      if (aflg == true) return String (p_sbuf);
+      t_quad* sbuf = Unicode::decode (Encoding::EMOD_UTF8, p_sbuf, d_slen);
+      String result = sbuf;
+      delete [] sbuf;
+      return result;
+    }
+    // read a hexadecimal code point
+    t_quad rdhex (void) {
+      t_quad result = 0x00000000U;
+      for (long k = 0L; k < 4L; k++) {
+	int c = getc ();
+	if ((c >= '0') && (c <= '9')) {
+	  result = (result << 4) + (c - '0');
+	} else if ((c >= 'a') && (c <= 'f')) {
+	  result = (result << 4) + (c - 'a' + 10);
+	} else if ((c >= 'A') && (c <= 'F')) {
+	  result = (result << 4) + (c - 'A' + 10);
+	} else {
+	  throw Exception ("json-error", "invalid json unicode escape");
+	}
+      }
+      return result;
+    }
+    // read a string after the opening quote
+    String rdstr (void) {
+      d_slen = 0L;
+      t_byte amsk = 0x00;
+      while (true) {
+	if (fill () == false) {
+	  throw Exception ("json-error", "unterminated json string");
+	}
+	// copy the plain bytes in the window
+	long wpos = d_wpos;
+	while (wpos < d_wlen) {
+	  t_byte b = (t_byte) p_wbuf[wpos];
+	  if ((b == '"') || (b == '\\') || (b < 0x20)) break;
+	  amsk |= b;
+	  wpos++;
+	}
+	sadd (&p_wbuf[d_wpos], wpos - d_wpos);
+	d_wpos = wpos;
+	if (d_wpos == d_wlen) continue;
+	// check for the end or an escape
+	char c = p_wbuf[d_wpos++];
+	if (c == '"') break;
+	if (c != '\\') {
+	  throw Exception ("json-error", "invalid control character in string");
+	}
+	switch (getc ()) {
+	case '"':  sadd ('"');  break;
+	case '\\': sadd ('\\'); break;
+	case '/':  sadd ('/');  break;
+	case 'b':  sadd ('\b'); break;
+	case 'f':  sadd ('\f'); break;
+	case 'n':  sadd ('\n'); break;
+	case 'r':  sadd ('\r'); break;
+	case 't':  sadd ('\t'); break;
+	case 'u':
+	  {
+	    t_quad code = rdhex ();
+	    // check for a surrogate pair
+	    if ((code >= 0x0000D800U) && (code <= 0x0000DBFFU)) {
+	      expect ('\\', "missing json low surrogate");
+	      expect ('u',  "missing json low surrogate");
+	      t_quad lsur = rdhex ();
+	      if ((lsur < 0x0000DC00U) || (lsur > 0x0000DFFFU)) {
+		throw Exception ("json-error", "invalid json low surrogate");
+	      }
+	      code = 0x00010000U + ((code - 0x0000D800U) << 10) +
+		(lsur - 0x0000DC00U);
+	    } else if ((code >= 0x0000DC00U) && (code <= 0x0000DFFFU)) {
+	      throw Exception ("json-error", "invalid json high surrogate");
+	    }
+	    if (code < 0x00000080U) {
+	      sadd ((char) code);
+	      break;
+	    }
+	    char* cbuf = Unicode::encode (Encoding::EMOD_UTF8, code);
+	    sadd (cbuf, Ascii::strlen (cbuf));
+	    delete [] cbuf;
+	    amsk |= 0x80;
+	  }
+	  break;
+	default:
+	  throw Exception ("json-error", "invalid json string escape");
+	  break;
+	}
+      }
+      return tostr (amsk < 0x80);
+    }
+    // read the digits of a number into the scratch buffer
+    long rddgt (void) {
+      long result = 0L;
+      while (fill () == true) {
+	long wpos = d_wpos;
+	while ((wpos < d_wlen) && (p_wbuf[wpos] >= '0') &&
+	       (p_wbuf[wpos] <= '9')) wpos++;
+	sadd (&p_wbuf[d_wpos], wpos - d_wpos);
+	result += wpos - d_wpos;
+	d_wpos = wpos;
+	if (d_wpos < d_wlen) break;
+      }
+      return result;
+    }
+  };
+
+  // the json literal value
+  struct s_jval {
+    // the value type
+    enum t_jtyp {
+      JTYP_NULL,
+      JTYP_BOOL,
+      JTYP_INTG,
+      JTYP_REAL,
+      JTYP_STRG
+    };
+    // the value type
+    t_jtyp d_type;
+    // the boolean value
+    bool   d_bval;
+    // the integer value
+    t_long d_ival;
+    // the real value
+    t_real d_rval;
+    // the string value
+    String d_sval;
+    // create a null value
+    s_jval (void) {
+      d_type = JTYP_NULL;
+      d_bval = false;
+      d_ival = 0LL;
+      d_rval = 0.0;
+    }
+    // map this value to an object
+    Object* toobject (void) const {
+      switch (d_type) {
+      case JTYP_BOOL:
+	return new Boolean (d_bval);
+      case JTYP_INTG:
+	return new Integer (d_ival);
+      case JTYP_REAL:
+	return new Real (d_rval);
+      case JTYP_STRG:
+	return new String (d_sval);
+      default:
+	break;
+      }
+      return nullptr;
+    }
+  };
+
+  // read a json number - the integer fast path accumulates the digits
+  // and falls back to a real when the value does not fit an integer
+  static void json_rnum (s_jlex& jlex, s_jval& jval) {
+    jlex.d_slen = 0L;
+    bool sflg = (jlex.peek () == '-');
+    if (sflg == true) jlex.sadd ((char) jlex.getc ());
+    // read the integer part
+    int c = jlex.peek ();
+    long ndgt = 0L;
+    if (c == '0') {
+      jlex.sadd ((char) jlex.getc ());
+      ndgt = 1L;
+    } else {
+      ndgt = jlex.rddgt ();
+    }
+    if (ndgt == 0L) throw Exception ("json-error", "invalid json number");
+    // read the fraction and exponent
+    bool rflg = false;
+    if (jlex.peek () == '.') {
+      rflg = true;
+      jlex.sadd ((char) jlex.getc ());
+      if (jlex.rddgt () == 0L) {
+	throw Exception ("json-error", "invalid json number fraction");
+      }
+    }
+    c = jlex.peek ();
+    if ((c == 'e') || (c == 'E')) {
+      rflg = true;
+      jlex.sadd ((char) jlex.getc ());
+      c = jlex.peek ();
+      if ((c == '+') || (c == '-')) jlex.sadd ((char) jlex.getc ());
+      if (jlex.rddgt () == 0L) {
+	throw Exception ("json-error", "invalid json number exponent");
+      }
+    }
+    jlex.p_sbuf[jlex.d_slen] = nilc;
+    // accumulate the integer digits
+    if (rflg == false) {
+      t_octa imax = sflg ? 0x8000000000000000ULL : 0x7FFFFFFFFFFFFFFFULL;
+      t_octa uval = 0ULL;
+      for (long k = sflg ? 1L : 0L; k < jlex.d_slen; k++) {
+	t_octa dval = (t_octa) (jlex.p_sbuf[k] - '0');
+	if (uval > (imax - dval) / 10ULL) {
+	  rflg = true;
+	  break;
+	}
+	uval = uval * 10ULL + dval;
+      }
+      if (rflg == false) {
+	jval.d_type = s_jval::JTYP_INTG;
+	jval.d_ival = sflg ? (t_long) (0ULL - uval) : (t_long) uval;
+	return;
+      }
+    }
+    // convert the real value
+    bool status = false;
+    t_real rval = c_atod (jlex.p_sbuf, status);
+    if (status == false) throw Exception ("json-error", "invalid json number");
+    jval.d_type = s_jval::JTYP_REAL;
+    jval.d_rval = rval;
+  }
+
+  // read a json keyword
+  static void json_rkwd (s_jlex& jlex, const char* kwd) {
+    for (long k = 0L; kwd[k] != nilc; k++) {
+      if (jlex.getc () != (t_byte) kwd[k]) {
+	throw Exception ("json-error", "invalid json literal");
+      }
+    }
+  }
+
+  // read a json literal value by first byte
+  static void json_rlit (s_jlex& jlex, s_jval& jval, const int c) {
+    switch (c) {
+    case '"':
+      jlex.getc ();
+      jval.d_type = s_jval::JTYP_STRG;
+      jval.d_sval = jlex.rdstr ();
+      break;
+    case 't':
+      json_rkwd (jlex, "true");
+      jval.d_type = s_jval::JTYP_BOOL;
+      jval.d_bval = true;
+      break;
+    case 'f':
+      json_rkwd (jlex, "false");
+      jval.d_type = s_jval::JTYP_BOOL;
+      jval.d_bval = false;
+      break;
+    case 'n':
+      json_rkwd (jlex, "null");
+      jval.d_type = s_jval::JTYP_NULL;
+      break;
+    case -1:
+      throw Exception ("json-error", "unexpected end of json text");
+      break;
+    default:
+      if ((c == '-') || ((c >= '0') && (c <= '9'))) {
+	json_rnum (jlex, jval);
+	break;
+      }
+      throw Exception ("json-error", "invalid json character",
+		       String ((char) c));
+      break;
+    }
+  }
+
+  // forward value reader
+  static Object* json_rval (s_jlex& jlex, const long dpth);
+
+  // read a json object after the opening brace - the members are added
+  // in order to a json object
+  static Object* json_robj (s_jlex& jlex, const long dpth) {
+    JsonObject* result = new JsonObject;
+    try {
+      int c = jlex.skip ();
+      if (c == '}') {
+	jlex.getc ();
+	return result;
+      }
+      while (true) {
+	// read the member name
+	if (c != '"') throw Exception ("json-error", "missing json member name");
+	jlex.getc ();
+	String name = jlex.rdstr ();
+	if (jlex.skip () != ':') {
+	  throw Exception ("json-error", "missing json member separator");
+	}
+	jlex.getc ();
+	// read the member value
+	result->add (name, json_rval (jlex, dpth + 1L));
+	// check for the next member
+	c = jlex.skip ();
+	jlex.getc ();
+	if (c == '}') break;
+	if (c != ',') {
+	  throw Exception ("json-error", "missing json object separator");
+	}
+	c = jlex.skip ();
+      }
+      return result;
+    } catch (...) {
+      delete result;
+      throw;
+    }
+  }
+
+  // read a json array after the opening bracket
+  static Vector* json_rarr (s_jlex& jlex, const long dpth) {
+    Vector* result = new Vector;
+    try {
+      if (jlex.skip () == ']') {
+	jlex.getc ();
+	return result;
+      }
+      while (true) {
+	result->add (json_rval (jlex, dpth + 1L));
+	int c = jlex.skip ();
+	jlex.getc ();
+	if (c == ']') break;
+	if (c != ',') {
+	  throw Exception ("json-error", "missing json array separator");
+	}
+      }
+      return result;
+    } catch (...) {
+      delete result;
+      throw;
+    }
+  }
+
+  // read a json value
+  static Object* json_rval (s_jlex& jlex, const long dpth) {
+    if (dpth > JSON_DPTH_MAX) {
+      throw Exception ("json-error", "json nesting is too deep");
+    }
+    int c = jlex.skip ();
+    if (c == '{') {
+      jlex.getc ();
+      return json_robj (jlex, dpth);
+    }
+    if (c == '[') {
+      jlex.getc ();
+      return json_rarr (jlex, dpth);
+    }
+    s_jval jval;
+    json_rlit (jlex, jval, c);
+    return jval.toobject ();
+  }
+
+  // the json pull state
+  struct s_jpul {
+    // the input stream
+    InputStream* p_is;
+    // the json lexer
+    s_jlex*      p_jlex;
+    // the container stack
+    char*        p_cstk;
+    // the container depth
+    long         d_dpth;
+    // the current event
+    JsonReader::t_jevt d_jevt;
+    // the current event value
+    Object*      p_jval;
+    // the first element flag
+    bool         d_frst;
+    // the member value flag
+    bool         d_xval;
+    // create a pull state by stream
+    s_jpul (InputStream* is) {
+      Object::iref (p_is = is);
+      p_jlex = new s_jlex (is);
+      p_cstk = new char[JSON_DPTH_MAX];
+      d_dpth = 0L;
+      d_jevt = JsonReader::JEVT_NONE;
+      p_jval = nullptr;
+      d_frst = false;
+      d_xval = false;
+    }
+    // destroy this pull state
+    ~s_jpul (void) {
+      Object::dref (p_jval);
+      delete [] p_cstk;
+      delete p_jlex;
+      Object::dref (p_is);
+    }
+    // set the current event value
+    void setjval (Object* jval) {
+      Object::iref (jval);
+      Object::dref (p_jval);
+      p_jval = jval;
+    }
+    // open a container
+    void push (const char c) {
+      if (d_dpth >= JSON_DPTH_MAX) {
+	throw Exception ("json-error", "json nesting is too deep");
+      }
+      p_cstk[d_dpth++] = c;
+      d_frst = true;
+      d_xval = false;
+      d_jevt = (c == '{') ? JsonReader::JEVT_BOBJ : JsonReader::JEVT_BARR;
+    }
+    // close a container
+    void pop (void) {
+      char c = p_cstk[--d_dpth];
+      d_frst = false;
+      d_xval = false;
+      d_jevt = (c == '{') ? JsonReader::JEVT_EOBJ : JsonReader::JEVT_EARR;
+    }
+    // read a value event by first byte
+    bool rdval (const int c) {
+      if ((c == '{') || (c == '[')) {
+	jlex ().getc ();
+	push ((char) c);
+	return true;
+      }
+      s_jval jval;
+      json_rlit (jlex (), jval, c);
+      setjval (jval.toobject ());
+      d_jevt = JsonReader::JEVT_VALU;
+      return true;
+    }
+    // get the lexer
+    s_jlex& jlex (void) {
+      return *p_jlex;
+    }
+    // pull the next event
+    bool next (void) {
+      setjval (nullptr);
+      int c = p_jlex->skip ();
+      // check for a top level value
+      if (d_dpth == 0L) {
+	if (c == -1) {
+	  d_jevt = JsonReader::JEVT_NONE;
+	  return false;
+	}
+	return rdval (c);
+      }
+      // check for an object member
+      if (p_cstk[d_dpth-1] == '{') {
+	if (d_xval == true) {
+	  if (c != ':') {
+	    throw Exception ("json-error", "missing json member separator");
+	  }
+	  p_jlex->getc ();
+	  d_xval = false;
+	  return rdval (p_jlex->skip ());
+	}
+	if (c == '}') {
+	  p_jlex->getc ();
+	  pop ();
+	  return true;
+	}
+	if (d_frst == false) {
+	  if (c != ',') {
+	    throw Exception ("json-error", "missing json object separator");
+	  }
+	  p_jlex->getc ();
+	  c = p_jlex->skip ();
+	}
+	if (c != '"') throw Exception ("json-error", "missing json member name");
+	p_jlex->getc ();
+	setjval (new String (p_jlex->rdstr ()));
+	d_frst = false;
+	d_xval = true;
+	d_jevt = JsonReader::JEVT_NAME;
+	return true;
+      }
+      // check for an array element
+      if (c == ']') {
+	p_jlex->getc ();
+	pop ();
+	return true;
+      }
+      if (d_frst == false) {
+	if (c != ',') {
+	  throw Exception ("json-error", "missing json array separator");
+	}
+	p_jlex->getc ();
+	c = p_jlex->skip ();
+      }
+      d_frst = false;
+      return rdval (c);
+    }
+    // build the current event value
+    Object* materialize (void) {
+      if (d_jevt == JsonReader::JEVT_VALU) return p_jval;
+      Object* result = nullptr;
+      if (d_jevt == JsonReader::JEVT_BOBJ) {
+	result = json_robj (*p_jlex, d_dpth);
+      } else if (d_jevt == JsonReader::JEVT_BARR) {
+	result = json_rarr (*p_jlex, d_dpth);
+      } else {
+	return nullptr;
+      }
+      pop ();
+      return result;
+    }
+  };
+
+  // -------------------------------------------------------------------------
+  // - class section                                                         -
+  // -------------------------------------------------------------------------
+
+  // create a default reader
+
+  JsonReader::JsonReader (void) {
+    p_jpul = nullptr;
+  }
+
+  // destroy this reader
+
+  JsonReader::~JsonReader (void) {
+    delete p_jpul;
+  }
+
+  // return the class name
+
+  String JsonReader::repr (void) const {
+    return "JsonReader";
+  }
+
+  // reset this reader
+
+  void JsonReader::reset (void) {
+    wrlock ();
+    try {
+      delete p_jpul;
+      p_jpul = nullptr;
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // parse an input stream
+
+  Object* JsonReader::parse (InputStream* is) {
+    // check for nil
+    if (is == nullptr) return nullptr;
+    // lock and parse
+    wrlock ();
+    try {
+      s_jlex jlex (is);
+      Object* result = json_rval (jlex, 0L);
+      jlex.flush ();
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // parse a string
+
+  Object* JsonReader::parse (const String& value) {
+    wrlock ();
+    Object* result = nullptr;
+    try {
+      InputString is (value);
+      s_jlex jlex (&is);
+      result = json_rval (jlex, 0L);
+      if (jlex.skip () != -1) {
+	throw Exception ("json-error", "trailing characters after json text");
+      }
+      unlock ();
+      return result;
+    } catch (...) {
+      delete result;
+      unlock ();
+      throw;
+    }
+  }
+
+  // set the pull mode input stream
+
+  void JsonReader::setis (InputStream* is) {
+    wrlock ();
+    try {
+      delete p_jpul;
+      p_jpul = (is == nullptr) ? nullptr : new s_jpul (is);
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // set the pull mode input stream by string
+
+  void JsonReader::setis (const String& value) {
+    wrlock ();
+    try {
+      setis (new InputString (value));
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // pull the next event
+
+  bool JsonReader::next (void) {
+    wrlock ();
+    try {
+      bool result = (p_jpul == nullptr) ? false : p_jpul->next ();
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get the current pull event
+
+  JsonReader::t_jevt JsonReader::getjevt (void) const {
+    rdlock ();
+    try {
+      t_jevt result = (p_jpul == nullptr) ? JEVT_NONE : p_jpul->d_jevt;
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get the current pull event value
+
+  Object* JsonReader::getjval (void) const {
+    rdlock ();
+    try {
+      Object* result = (p_jpul == nullptr) ? nullptr : p_jpul->p_jval;
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get the current pull depth
+
+  long JsonReader::getdpth (void) const {
+    rdlock ();
+    try {
+      long result = (p_jpul == nullptr) ? 0L : p_jpul->d_dpth;
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // build the value of the current event
+
+  Object* JsonReader::materialize (void) {
+    wrlock ();
+    try {
+      Object* result = (p_jpul == nullptr) ? nullptr : p_jpul->materialize ();
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // -------------------------------------------------------------------------
+  // - object section                                                        -
+  // -------------------------------------------------------------------------
+
+  // the object eval quarks
+  static const long QUARK_JSONREADER = String::intern ("JsonReader");
+  static const long QUARK_JEVTNONE   = String::intern ("NONE");
+  static const long QUARK_JEVTBOBJ   = String::intern ("BEGIN-OBJECT");
+  static const long QUARK_JEVTEOBJ   = String::intern ("END-OBJECT");
+  static const long QUARK_JEVTBARR   = String::intern ("BEGIN-ARRAY");
+  static const long QUARK_JEVTEARR   = String::intern ("END-ARRAY");
+  static const long QUARK_JEVTNAME   = String::intern ("NAME");
+  static const long QUARK_JEVTVALU   = String::intern ("VALUE");
+
+  // the quark zone
+  static const long QUARK_ZONE_LENGTH = 8;
+  static QuarkZone  zone (QUARK_ZONE_LENGTH);
+
+  // the object supported quarks
+  static const long QUARK_NEXT    = zone.intern ("next");
+  static const long QUARK_RESET   = zone.intern ("reset");
+  static const long QUARK_PARSE   = zone.intern ("parse");
+  static const long QUARK_SETIS   = zone.intern ("set-input-stream");
+  static const long QUARK_GETJEVT = zone.intern ("get-event");
+  static const long QUARK_GETJVAL = zone.intern ("get-value");
+  static const long QUARK_GETDPTH = zone.intern ("get-depth");
+  static const long QUARK_MTRLZ   = zone.intern ("materialize");
+
+  // map a pull event to an item
+  static inline Item* jevt_to_item (const JsonReader::t_jevt jevt) {
+    switch (jevt) {
+    case JsonReader::JEVT_NONE:
+      return new Item (QUARK_JSONREADER, QUARK_JEVTNONE);
+    case JsonReader::JEVT_BOBJ:
+      return new Item (QUARK_JSONREADER, QUARK_JEVTBOBJ);
+    case JsonReader::JEVT_EOBJ:
+      return new Item (QUARK_JSONREADER, QUARK_JEVTEOBJ);
+    case JsonReader::JEVT_BARR:
+      return new Item (QUARK_JSONREADER, QUARK_JEVTBARR);
+    case JsonReader::JEVT_EARR:
+      return new Item (QUARK_JSONREADER, QUARK_JEVTEARR);
+    case JsonReader::JEVT_NAME:
+      return new Item (QUARK_JSONREADER, QUARK_JEVTNAME);
+    case JsonReader::JEVT_VALU:
+      return new Item (QUARK_JSONREADER, QUARK_JEVTVALU);
+    }
+    return nullptr;
+  }
+
+  // evaluate an object data member
+
+  Object* JsonReader::meval (Evaluable* zobj, Nameset* nset,
+			     const long quark) {
+    if (quark == QUARK_JEVTNONE) return jevt_to_item (JEVT_NONE);
+    if (quark == QUARK_JEVTBOBJ) return jevt_to_item (JEVT_BOBJ);
+    if (quark == QUARK_JEVTEOBJ) return jevt_to_item (JEVT_EOBJ);
+    if (quark == QUARK_JEVTBARR) return jevt_to_item (JEVT_BARR);
+    if (quark == QUARK_JEVTEARR) return jevt_to_item (JEVT_EARR);
+    if (quark == QUARK_JEVTNAME) return jevt_to_item (JEVT_NAME);
+    if (quark == QUARK_JEVTVALU) return jevt_to_item (JEVT_VALU);
+    throw Exception ("eval-error", "cannot evaluate member",
+                     String::qmap (quark));
+  }
+
+  // create a new object in a generic way
+
+  Object* JsonReader::mknew (Vector* argv) {
+    long argc = (argv == nullptr) ? 0 : argv->length ();
+    // create a default reader object
+    if (argc == 0) return new JsonReader;
+    // argument error
+    throw Exception ("argument-error",
+                     "too many argument with json reader constructor");
+  }
+
+  // return true if the given quark is defined
+
+  bool JsonReader::isquark (const long quark, const bool hflg) const {
+    rdlock ();
+    try {
+      if (zone.exists (quark) == true) {
+	unlock ();
+	return true;
+      }
+      bool result = hflg ? Object::isquark (quark, hflg) : false;
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // apply this object with a set of arguments and a quark
+
+  Object* JsonReader::apply (Evaluable* zobj, Nameset* nset, const long quark,
+			     Vector* argv) {
+    // get the number of arguments
+    long argc = (argv == nullptr) ? 0 : argv->length ();
+
+    // check for 0 argument
+    if (argc == 0) {
+      if (quark == QUARK_NEXT)    return new Boolean (next ());
+      if (quark == QUARK_GETDPTH) return new Integer (getdpth ());
+      if (quark == QUARK_GETJEVT) return jevt_to_item (getjevt ());
+      if (quark == QUARK_RESET) {
+	reset ();
+	return nullptr;
+      }
+      if ((quark == QUARK_GETJVAL) || (quark == QUARK_MTRLZ)) {
+	wrlock ();
+	try {
+	  Object* result = (quark == QUARK_GETJVAL) ? getjval () :
+	    materialize ();
+	  zobj->post (result);
+	  unlock ();
+	  return result;
+	} catch (...) {
+	  unlock ();
+	  throw;
+	}
+      }
+    }
+    // check for 1 argument
+    if (argc == 1) {
+      if (quark == QUARK_PARSE) {
+	Object* obj = argv->get (0);
+	if (obj == nullptr) return nullptr;
+	// check for an input stream
+	InputStream* is = dynamic_cast <InputStream*> (obj);
+	if (is != nullptr) return parse (is);
+	// check for a string
+	String* sobj = dynamic_cast <String*> (obj);
+	if (sobj != nullptr) return parse (*sobj);
+	throw Exception ("type-error", "invalid object with parse",
+			 Object::repr (obj));
+      }
+      if (quark == QUARK_SETIS) {
+	Object* obj = argv->get (0);
+	// check for an input stream
+	InputStream* is = dynamic_cast <InputStream*> (obj);
+	if ((obj == nullptr) || (is != nullptr)) {
+	  setis (is);
+	  return nullptr;
+	}
+	// check for a string
+	String* sobj = dynamic_cast <String*> (obj);
+	if (sobj != nullptr) {
+	  setis (*sobj);
+	  return nullptr;
+	}
+	throw Exception ("type-error", "invalid object with set-input-stream",
+			 Object::repr (obj));
+      }
+    }
+    // call the object method
+    return Object::apply (zobj, nset, quark, argv);
+  }
+}
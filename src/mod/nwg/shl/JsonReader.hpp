@@ -0,0 +1,134 @@
+// ---------------------------------------------------------------------------
+// - JsonReader.hpp                                                          -
+// - afnix:nwg module - json reader class definition                         -
+// ---------------------------------------------------------------------------
+// - This program is free software;  you can redistribute it  and/or  modify -
+// - it provided that this copyright notice is kept intact.                  -
+// -                                                                         -
+// - This program  is  distributed in  the hope  that it will be useful, but -
+// - without  any  warranty;  without  even   the   implied    warranty   of -
+// - merchantability or fitness for a particular purpose.  In no event shall -
+// - the copyright holder be liable for any  direct, indirect, incidental or -
+// - special damages arising in any way out of the use of this software.     -
+// ---------------------------------------------------------------------------
+// - copyright (c) 1999-2021 amaury darsch                                   -
+// ---------------------------------------------------------------------------
+
+#ifndef  AFNIX_JSONREADER_HPP
+#define  AFNIX_JSONREADER_HPP
+
+#ifndef  AFNIX_INPUTSTREAM_HPP
+#include "InputStream.hpp"
+#endif
+
+namespace afnix {
+
+  /// The JsonReader class is a json parser which builds objects from a
+  /// json text. A json object is mapped to a json object which keeps its
+  /// members in order. A json array is mapped to a vector, a string to a
+  /// string, a number to an integer or a real, a boolean to a boolean and
+  /// a null value to nil.
+  /// The reader can also operate in pull mode. In this mode, an input
+  /// stream is bound to the reader and the json text is returned one token
+  /// at a time in the form of events (begin object, end object, begin
+  /// array, end array, member name or value). Only the current event value
+  /// and the open container types are kept by the reader. The value of a
+  /// begin event can be optionally built with the materialize method. A
+  /// sequence of json texts is accepted in pull mode.
+  /// @author amaury darsch
+
+  class JsonReader : public Object {
+  public:
+    /// the pull event type
+    enum t_jevt {
+      JEVT_NONE, // no event
+      JEVT_BOBJ, // begin object
+      JEVT_EOBJ, // end object
+      JEVT_BARR, // begin array
+      JEVT_EARR, // end array
+      JEVT_NAME, // member name
+      JEVT_VALU  // literal value
+    };
+
+  private:
+    /// the pull state
+    struct s_jpul* p_jpul;
+
+  public:
+    /// create a default reader
+    JsonReader (void);
+
+    /// destroy this reader
+    ~JsonReader (void);
+
+    /// @return the class name
+    String repr (void) const override;
+
+    /// reset this reader
+    virtual void reset (void);
+
+    /// parse an input stream - the stream is left after the json text
+    /// @param is the input stream to parse
+    virtual Object* parse (InputStream* is);
+
+    /// parse a string
+    /// @param value the string to parse
+    virtual Object* parse (const String& value);
+
+    /// set the pull mode input stream
+    /// @param is the input stream to bind
+    virtual void setis (InputStream* is);
+
+    /// set the pull mode input stream by string
+    /// @param value the string to parse
+    virtual void setis (const String& value);
+
+    /// pull the next event
+    /// @return false at the end of stream
+    virtual bool next (void);
+
+    /// @return the current pull event
+    virtual t_jevt getjevt (void) const;
+
+    /// @return the current pull event value
+    virtual Object* getjval (void) const;
+
+    /// @return the current pull depth
+    virtual long getdpth (void) const;
+
+    /// build the value of the current event - for a begin event, the
+    /// reader is left on the matching end event
+    /// @return the current event value
+    virtual Object* materialize (void);
+
+  private:
+    // make the copy constructor private
+    JsonReader (const JsonReader&) =delete;
+    // make the assignment operator private
+    JsonReader& operator = (const JsonReader&) =delete;
+
+  public:
+    /// create a new object in a generic way
+    /// @param argv the argument vector
+    static Object* mknew (Vector* argv);
+
+    /// evaluate an object data member
+    /// @param zobj  the current evaluable
+    /// @param nset  the current nameset
+    /// @param quark the quark to evaluate
+    static Object* meval (Evaluable* zobj, Nameset* nset, const long quark);
+
+    /// @return true if the given quark is defined
+    bool isquark (const long quark, const bool hflg) const override;
+
+    /// apply this object with a set of arguments and a quark
+    /// @param zobj  the current evaluable
+    /// @param nset  the current nameset
+    /// @param quark the quark to apply these arguments
+    /// @param argv  the arguments to apply
+    Object* apply (Evaluable* zobj, Nameset* nset, const long quark,
+                   Vector* argv) override;
+  };
+}
+
+#endif
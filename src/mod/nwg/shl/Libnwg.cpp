@@ -26,8 +26,11 @@
 #include "NwgCalls.hpp"
 #include "Function.hpp"
 #include "Hyperlink.hpp"
+#include "JsonObject.hpp"
+#include "JsonReader.hpp"
 #include "HttpStream.hpp"
 #include "HttpRequest.hpp"
+#include "HttpServer.hpp"
 #include "HttpResponse.hpp"
 
 namespace afnix {
@@ -53,11 +56,15 @@ namespace afnix {
     gset->symcst ("Basexx",             new Meta (Basexx::meval,
 						  Basexx::mknew));
     gset->symcst ("UriPath",            new Meta (UriPath::mknew));
+    gset->symcst ("JsonReader",         new Meta (JsonReader::meval,
+						  JsonReader::mknew));
     gset->symcst ("UriQuery",           new Meta (UriQuery::mknew));
+    gset->symcst ("JsonObject",         new Meta (JsonObject::mknew));
     gset->symcst ("Hyperlink",          new Meta (Hyperlink::mknew));
     gset->symcst ("CookieJar",          new Meta (CookieJar::mknew));
     gset->symcst ("HttpStream",         new Meta (HttpStream::mknew));
     gset->symcst ("HttpRequest",        new Meta (HttpRequest::mknew));
+    gset->symcst ("HttpServer",         new Meta (HttpServer::mknew));
     gset->symcst ("HttpResponse",       new Meta (HttpResponse::mknew));
 
     // bind the predicates
@@ -67,6 +74,8 @@ namespace afnix {
     gset->symcst ("json-p",             new Function (nwg_jsonp));
     gset->symcst ("cookie-p",           new Function (nwg_cookp));
     gset->symcst ("basexx-p",           new Function (nwg_bsxxp));
+    gset->symcst ("json-reader-p",      new Function (nwg_jsrdp));
+    gset->symcst ("json-object-p",      new Function (nwg_jsobp));
     gset->symcst ("uri-path-p",         new Function (nwg_uripp));
     gset->symcst ("uri-query-p",        new Function (nwg_uriqp));
     gset->symcst ("hyperlink-p",        new Function (nwg_hlnkp));
@@ -76,6 +85,7 @@ namespace afnix {
     gset->symcst ("http-proto-p",       new Function (nwg_protop));
     gset->symcst ("http-stream-p",      new Function (nwg_hstrmp));
     gset->symcst ("http-request-p",     new Function (nwg_hrqstp));
+    gset->symcst ("http-server-p",      new Function (nwg_hsrvp));
     gset->symcst ("http-response-p",    new Function (nwg_hrespp));
     gset->symcst ("mime-extension-p",   new Function (nwg_mextp));
     
@@ -25,8 +25,11 @@
 #include "UriQuery.hpp"
 #include "Hyperlink.hpp"
 #include "Exception.hpp"
+#include "JsonObject.hpp"
+#include "JsonReader.hpp"
 #include "HttpStream.hpp"
 #include "HttpRequest.hpp"
+#include "HttpServer.hpp"
 #include "HttpResponse.hpp"
 
 namespace afnix {
@@ -124,6 +127,15 @@ namespace afnix {
     return new Boolean (result);
   }
 
+  // hsrvp: http server object predicate
+
+  Object* nwg_hsrvp (Evaluable* zobj, Nameset* nset, Cons* args) {
+    Object* obj = get_obj (zobj, nset, args, "http-server-p");
+    bool result = (dynamic_cast <HttpServer*> (obj) == nullptr) ? false : true;
+    Object::cref (obj);
+    return new Boolean (result);
+  }
+
   // hstrmp: http stream object predicate
 
   Object* nwg_hstrmp (Evaluable* zobj, Nameset* nset, Cons* args) {
@@ -168,4 +180,22 @@ namespace afnix {
     Object::cref (obj);
     return new Boolean (result);
   }
+
+  // jsrdp: json reader object predicate
+
+  Object* nwg_jsrdp (Evaluable* zobj, Nameset* nset, Cons* args) {
+    Object* obj = get_obj (zobj, nset, args, "json-reader-p");
+    bool result = (dynamic_cast <JsonReader*> (obj) == nullptr) ? false : true;
+    Object::cref (obj);
+    return new Boolean (result);
+  }
+
+  // jsobp: json object predicate
+
+  Object* nwg_jsobp (Evaluable* zobj, Nameset* nset, Cons* args) {
+    Object* obj = get_obj (zobj, nset, args, "json-object-p");
+    bool result = (dynamic_cast <JsonObject*> (obj) == nullptr) ? false : true;
+    Object::cref (obj);
+    return new Boolean (result);
+  }
 }
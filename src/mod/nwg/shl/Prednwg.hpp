@@ -81,6 +81,12 @@ namespace afnix {
   /// @param args the arguments list
   Object* nwg_hrespp (Evaluable* zobj, Nameset* nset, Cons* args);
 
+  /// the http server object predicate
+  /// @param zobj the current evaluable
+  /// @param nset the current nameset
+  /// @param args the arguments list
+  Object* nwg_hsrvp (Evaluable* zobj, Nameset* nset, Cons* args);
+
   /// the http stream object predicate
   /// @param zobj the current evaluable
   /// @param nset the current nameset
@@ -110,6 +116,18 @@ namespace afnix {
   /// @param nset the current nameset
   /// @param args the arguments list
   Object* nwg_jsonp (Evaluable* zobj, Nameset* nset, Cons* args);
+
+  /// the json reader object predicate
+  /// @param zobj the current evaluable
+  /// @param nset the current nameset
+  /// @param args the arguments list
+  Object* nwg_jsrdp (Evaluable* zobj, Nameset* nset, Cons* args);
+
+  /// the json object container predicate
+  /// @param zobj the current evaluable
+  /// @param nset the current nameset
+  /// @param args the arguments list
+  Object* nwg_jsobp (Evaluable* zobj, Nameset* nset, Cons* args);
 }
 
 #endif
@@ -22,9 +22,65 @@
 #include "Hashable.hpp"
 #include "QuarkZone.hpp"
 #include "Exception.hpp"
+#include "cmem.hpp"
+#include "csio.hpp"
 
 namespace afnix {
 
+  // -------------------------------------------------------------------------
+  // - private section                                                       -
+  // -------------------------------------------------------------------------
+
+  // the file read block size
+  static const long HSH_FBLK_SIZE = 1048576L;
+
+  // this procedure process a file by mapping it or by reading large blocks
+  static void hsh_process_file (Hashable& hobj, const String& name) {
+    // check the file name
+    if (name.isnil () == true) {
+      throw Exception ("name-error", "nil hashable file name");
+    }
+    // try to open the file
+    char* fname = name.tochar ();
+    int sid     = c_openr (fname);
+    delete [] fname;
+    if (sid < 0) {
+      throw Exception ("open-error", "cannot open hashable file", name);
+    }
+    // get the file size and try to map it
+    t_long size = c_fsize (sid);
+    void*  mbuf = (size > 0LL) ? c_mmap (sid, size, 0L) : nullptr;
+    if (mbuf != nullptr) {
+      c_close (sid);
+      try {
+	hobj.process ((const t_byte*) mbuf, size);
+	c_munmap (mbuf, size);
+      } catch (...) {
+	c_munmap (mbuf, size);
+	throw;
+      }
+      return;
+    }
+    // the file cannot be mapped - read it by block
+    t_byte* rbuf = new t_byte[HSH_FBLK_SIZE];
+    try {
+      while (true) {
+	t_long rlen = c_read (sid, (char*) rbuf, HSH_FBLK_SIZE);
+	if (rlen < 0LL) {
+	  throw Exception ("read-error", "cannot read hashable file", name);
+	}
+	if (rlen == 0LL) break;
+	hobj.process (rbuf, rlen);
+      }
+      delete [] rbuf;
+      c_close (sid);
+    } catch (...) {
+      delete [] rbuf;
+      c_close (sid);
+      throw;
+    }
+  }
+
   // -------------------------------------------------------------------------
   // - class section                                                         -
   // -------------------------------------------------------------------------
@@ -126,6 +182,23 @@ namespace afnix {
     }
   }
 
+  // compute a message from a file by name
+
+  String Hashable::hashf (const String& name) {
+    wrlock ();
+    try {
+      reset   ();
+      hsh_process_file (*this, name);
+      finish  ();
+      String result = format ();
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // push the hasher result into a buffer
 
   long Hashable::pushb (Buffer& buf) {
@@ -164,7 +237,7 @@ namespace afnix {
   // -------------------------------------------------------------------------
 
   // the quark zone
-  static const long QUARK_ZONE_LENGTH = 9;
+  static const long QUARK_ZONE_LENGTH = 10;
   static QuarkZone  zone (QUARK_ZONE_LENGTH);
 
   // the supported quarks
@@ -172,6 +245,7 @@ namespace afnix {
   static const long QUARK_FORMAT  = zone.intern ("format");
   static const long QUARK_DERIVE  = zone.intern ("derive");
   static const long QUARK_COMPUTE = zone.intern ("compute");
+  static const long QUARK_HASHF   = zone.intern ("hash-file");
   static const long QUARK_GETBYTE = zone.intern ("get-byte");
   static const long QUARK_GETHLEN = zone.intern ("get-hash-length");
   static const long QUARK_GETHVAL = zone.intern ("get-hash-value");
@@ -225,6 +299,10 @@ namespace afnix {
 	String s = argv->getstring (0);
 	return new String (derive (s));
       }
+      if (quark == QUARK_HASHF) {
+	String name = argv->getstring (0);
+	return new String (hashf (name));
+      }
       if (quark == QUARK_COMPUTE) {
 	Object* obj = argv->get (0);
 	// check for a literal
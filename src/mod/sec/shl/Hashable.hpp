@@ -102,6 +102,10 @@ namespace afnix {
     /// @param is the input stream
     virtual String compute (InputStream& is); 
 
+    /// compute a message from a file by name
+    /// @param name the file name to map
+    virtual String hashf (const String& name);
+
     /// push the hash value into a buffer
     /// @param buf the buffer to fill
     virtual long pushb (Buffer& buf);
@@ -25,6 +25,13 @@
 
 namespace afnix {
 
+  // -------------------------------------------------------------------------
+  // - private section                                                       -
+  // -------------------------------------------------------------------------
+
+  // the input stream read block size
+  static const long HSH_RBLK_SIZE = 65536L;
+
   // -------------------------------------------------------------------------
   // - class section                                                         -
   // -------------------------------------------------------------------------
@@ -79,6 +86,38 @@ namespace afnix {
     }
   }
 
+  // set the hasher state from another hasher
+
+  void Hasher::setsts (const Hasher& hobj) {
+    if (this == &hobj) return;
+    wrlock ();
+    hobj.rdlock ();
+    try {
+      // check for consistent sizes
+      if ((d_size != hobj.d_size) || (d_hlen != hobj.d_hlen)) {
+	throw Exception ("hasher-error", "inconsistent hasher state size");
+      }
+      // copy the pending block data
+      unshare ();
+      for (long i = 0; i < hobj.d_blen; i++) {
+	p_data[i] = hobj.p_data[hobj.d_ridx + i];
+      }
+      d_blen = hobj.d_blen;
+      d_ridx = 0L;
+      // copy the block counters
+      d_rcnt = hobj.d_rcnt;
+      d_wcnt = hobj.d_wcnt;
+      // copy the hash result
+      for (long i = 0; i < d_hlen; i++) p_hash[i] = hobj.p_hash[i];
+      unlock ();
+      hobj.unlock ();
+    } catch (...) {
+      unlock ();
+      hobj.unlock ();
+      throw;
+    }
+  }
+
   // return the hash value length
 
   long Hasher::gethlen (void) const {
@@ -173,6 +212,16 @@ namespace afnix {
     try {
       long blen = size;
       while (blen != 0) {
+	// clear the last processed block
+	if (full () == true) Buffer::reset ();
+	// process directly the full blocks
+	if ((empty () == true) && (blen >= d_size)) {
+	  update (msg);
+	  d_wcnt += d_size;
+	  msg    += d_size;
+	  blen   -= d_size;
+	  continue;
+	}
 	long step = copy ((char*) msg, blen);
 	if (full () == true) update ();
 	msg  += step;
@@ -205,13 +254,16 @@ namespace afnix {
 
   void Hasher::process (InputStream& is) {
     wrlock ();
+    t_byte* rbuf = new t_byte[HSH_RBLK_SIZE];
     try {
       while (is.valid () == true) {
-	copy (is);
-	if (full () == true) update ();
+	long rlen = is.copy ((char*) rbuf, HSH_RBLK_SIZE);
+	if (rlen > 0L) process (rbuf, rlen);
       }
+      delete [] rbuf;
       unlock ();
     } catch (...) {
+      delete [] rbuf;
       unlock ();
       throw;
     }
@@ -231,6 +283,30 @@ namespace afnix {
     }
   }
 
+  // -------------------------------------------------------------------------
+  // - protected section                                                     -
+  // -------------------------------------------------------------------------
+
+  // update the hasher state with the buffer data
+
+  bool Hasher::update (void) {
+    wrlock ();
+    try {
+      // make sure the buffer is full
+      if (length () != d_size) {
+	unlock ();
+	return false;
+      }
+      // update with the buffer block
+      bool result = update ((const t_byte*) p_data);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // -------------------------------------------------------------------------
   // - object section                                                        -
   // -------------------------------------------------------------------------
@@ -101,9 +101,17 @@ namespace afnix {
     /// @param s the string to check
     virtual bool ishash (const String& s) const;
 
+    /// set the hasher state from another hasher
+    /// @param hobj the hasher to copy
+    virtual void setsts (const Hasher& hobj);
+
   protected:
     /// update the hasher state with the buffer data
-    virtual bool update (void) =0;
+    virtual bool update (void);
+
+    /// update the hasher state with a block of data
+    /// @param data the block data to process
+    virtual bool update (const t_byte* data) =0;
 
   private:
     // make the copy constructor private
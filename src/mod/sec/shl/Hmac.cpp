@@ -78,45 +78,61 @@ namespace afnix {
     return xbuf;
   }
 
-  // this procedure initialize a hasher object from a key
-  static void hmac_init (Hasher* hash, const Key& mkey) {
+  // this procedure creates a keyed hasher state from a key
+  static Hasher* hmac_mkstate (Hasher* hash,
+			       const Key& mkey, const t_byte bpad) {
     // do nothing without a hasher
-    if (hash == nullptr) return;
+    if (hash == nullptr) return nullptr;
     // initialize the hasher key
     long    hsiz = hash->getsize ();
-    t_byte* kbuf = hmac_init_mkey (hash, mkey, HMAC_IPAD_XVAL);
-    // process the key buffer
-    hash->process (kbuf, hsiz);
-    // done
-    delete [] kbuf;
+    t_byte* kbuf = hmac_init_mkey (hash, mkey, bpad);
+    // process the key buffer and save the state
+    Hasher* result = nullptr;
+    try {
+      hash->process (kbuf, hsiz);
+      result = dynamic_cast <Hasher*> (hash->clone ());
+      if (result == nullptr) {
+	throw Exception ("hmac-error", "cannot clone hasher state",
+			 Object::repr (hash));
+      }
+      Object::iref (result);
+      hash->reset ();
+      delete [] kbuf;
+      return result;
+    } catch (...) {
+      Object::dref (result);
+      delete [] kbuf;
+      throw;
+    }
   }
 
-  // this procedure complete the hasher object from a key
-  static void hmac_finish (Hasher* hash, const Key& mkey) {
+  // this procedure initialize a hasher object from a keyed state
+  static void hmac_init (Hasher* hash, const Hasher* ihsh) {
     // do nothing without a hasher
-    if (hash == nullptr) return;
-    // get the hasher info
-    long hsiz = hash->getsize ();
-    long hlen = hash->gethlen ();
-    long xlen = hsiz + hlen;
-    // create a working buffer
-    t_byte* xbuf = new t_byte[xlen];
-    // update the working buffer
+    if ((hash == nullptr) || (ihsh == nullptr)) return;
+    // restore the inner keyed state
+    hash->setsts (*ihsh);
+  }
+
+  // this procedure complete the hasher object from a keyed state
+  static void hmac_finish (Hasher* hash, const Hasher* ohsh) {
+    // do nothing without a hasher
+    if ((hash == nullptr) || (ohsh == nullptr)) return;
+    // get the inner hash
+    long    hlen = hash->gethlen ();
+    t_byte* xbuf = new t_byte[hlen];
     hash->finish ();
-    for (long i = hsiz, j = 0; i < xlen; i++, j++) {
-      xbuf[i] = hash->getbyte (j);
+    for (long i = 0; i < hlen; i++) xbuf[i] = hash->getbyte (i);
+    // restore the outer keyed state and process the inner hash
+    try {
+      hash->setsts (*ohsh);
+      hash->process (xbuf, hlen);
+      hash->finish ();
+      delete [] xbuf;
+    } catch (...) {
+      delete [] xbuf;
+      throw;
     }
-    // initialize the hasher key
-    t_byte* kbuf = hmac_init_mkey (hash, mkey, HMAC_OPAD_XVAL);
-    // update the working buffer
-    for (long i = 0; i < hsiz; i++) xbuf[i] = kbuf[i];
-    // process the buffer
-    hash->process (xbuf, xlen);
-    // finish processing
-    hash->finish ();
-    // done
-    delete [] kbuf;
-    delete [] xbuf;
   }
 
   // -------------------------------------------------------------------------
@@ -127,6 +143,9 @@ namespace afnix {
 
   Hmac::Hmac (const Key& mkey) : Mac (HMAC_ALGO_NAME, mkey) {
     Object::iref (p_hash = new Sha1);
+    p_ihsh = hmac_mkstate (p_hash, d_mkey, HMAC_IPAD_XVAL);
+    p_ohsh = hmac_mkstate (p_hash, d_mkey, HMAC_OPAD_XVAL);
+    hmac_init (p_hash, p_ihsh);
   }
 
   // create a hmac by key and hasher
@@ -134,12 +153,17 @@ namespace afnix {
   Hmac::Hmac (const Key& mkey, Hasher* hash) : Mac (HMAC_ALGO_NAME, mkey) {
     p_hash = (hash == nullptr) ? new Sha1 : hash;
     Object::iref (p_hash);
+    p_ihsh = hmac_mkstate (p_hash, d_mkey, HMAC_IPAD_XVAL);
+    p_ohsh = hmac_mkstate (p_hash, d_mkey, HMAC_OPAD_XVAL);
+    hmac_init (p_hash, p_ihsh);
   }
 
   // destroy this hmac
 
   Hmac::~Hmac (void) {
     Object::dref (p_hash);
+    Object::dref (p_ihsh);
+    Object::dref (p_ohsh);
   }
 
   // return the class name
@@ -153,7 +177,7 @@ namespace afnix {
   void Hmac::reset (void) {
     wrlock ();
     try {
-      hmac_init (p_hash, d_mkey);
+      hmac_init (p_hash, p_ihsh);
       unlock ();
     } catch (...) {
       unlock ();
@@ -289,7 +313,7 @@ namespace afnix {
   void Hmac::finish (void) {
     wrlock ();
     try {
-      hmac_finish (p_hash, d_mkey);
+      hmac_finish (p_hash, p_ohsh);
       unlock ();
     } catch (...) {
       reset ();
@@ -38,6 +38,10 @@ namespace afnix {
   protected:
     /// the hasher object
     Hasher* p_hash;
+    /// the inner keyed hasher state
+    Hasher* p_ihsh;
+    /// the outer keyed hasher state
+    Hasher* p_ohsh;
     
   public:
     /// create default hmac by key
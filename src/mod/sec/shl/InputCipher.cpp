@@ -17,6 +17,7 @@
 #include "Vector.hpp"
 #include "QuarkZone.hpp"
 #include "InputCipher.hpp"
+#include "InputMapped.hpp"
 
 namespace afnix {
 
@@ -59,6 +60,13 @@ namespace afnix {
     Object::iref (p_is = is);
   }
 
+  // create a new input cipher by mapped file and cipher
+
+  InputCipher::InputCipher (const String& name, Cipher* sc) {
+    Object::iref (p_sc = sc);
+    Object::iref (p_is = new InputMapped (name));
+  }
+
   // destroy this input cipher
 
   InputCipher::~InputCipher (void) {
@@ -313,6 +321,17 @@ namespace afnix {
     // check for 2 arguments
     if (argc == 2) {
       Object* obj = argv->get (0);
+      // check for a file name
+      String* name = dynamic_cast <String*> (obj);
+      if (name != nullptr) {
+	obj = argv->get (1);
+	Cipher* cobj = dynamic_cast <Cipher*> (obj);
+	if (cobj == nullptr) {
+	  throw Exception ("type-error", "invalid object with input cipher",
+			   Object::repr (obj));
+	}
+	return new InputCipher (*name, cobj);
+      }
       // check for an input stream
       InputStream* sobj = dynamic_cast <InputStream*> (obj);
       if (sobj == nullptr) {
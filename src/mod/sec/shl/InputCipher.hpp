@@ -58,6 +58,11 @@ namespace afnix {
     /// @param sc the stream cipher
     InputCipher (InputStream* is, Cipher* sc);
 
+    /// create an input cipher by mapped file
+    /// @param name the file name to map
+    /// @param sc   the stream cipher
+    InputCipher (const String& name, Cipher* sc);
+
     /// destroy this input cipher
     ~InputCipher (void);
 
@@ -112,6 +112,20 @@ namespace afnix {
       long kbsz = argv->getlong (1);
       return new Kdf2 (hobj, kbsz);
     }
+    // check for 3 arguments
+    if (argc == 3) {
+      // get the hashable object
+      Object*  obj = argv->get (0);
+      Hashable* hobj = dynamic_cast <Hashable*> (obj);
+      if (hobj == nullptr) {
+	throw Exception ("type-error", "invalid object with KDF2 constructor",
+			 Object::repr (obj));
+      }
+      // get the key size and iteration number
+      long kbsz = argv->getlong (1);
+      long inum = argv->getlong (2);
+      return new Kdf2 (hobj, kbsz, inum);
+    }
     // invalid arguments
     throw Exception ("argument-error", "too many arguments for KDF2");
   }
@@ -128,6 +128,21 @@ namespace afnix {
     return "Md2";
   }
 
+  // clone this hasher
+
+  Object* Md2::clone (void) const {
+    rdlock ();
+    try {
+      Md2* result = new Md2 (d_rlen);
+      result->setsts (*this);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // reset this MD2 object
 
   void Md2::reset (void) {
@@ -140,21 +155,38 @@ namespace afnix {
     unlock ();
   }
 
-  // update the hasher state with the buffer data
-  
-  bool Md2::update (void) {
+  // set the hasher state from another hasher
+
+  void Md2::setsts (const Hasher& hobj) {
     wrlock ();
     try {
-      // make sure the buffer is full
-      if (length () != MD2_BMSG_LENGTH) {
-	unlock ();
-	return false;
+      // check for a consistent hasher
+      auto sobj = dynamic_cast <const Md2*> (&hobj);
+      if (sobj == nullptr) {
+	throw Exception ("hasher-error", "inconsistent hasher state object",
+			 hobj.repr ());
       }
+      // copy the base and local state
+      Hasher::setsts (hobj);
+      for (long k = 0L; k < 16L; k++) d_state[k] = sobj->d_state[k];
+      for (long k = 0L; k < 16L; k++) d_cksum[k] = sobj->d_cksum[k];
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // update the hasher state with a block of data
+  
+  bool Md2::update (const t_byte* data) {
+    wrlock ();
+    try {
       // initialize working buffer
       t_byte x[48];
       for (long i = 0; i < 16; i++) x[i]    = d_state[i];
-      for (long i = 0; i < 16; i++) x[i+16] = p_data[i];
-      for (long i = 0; i < 16; i++) x[i+32] = d_state[i] ^ p_data[i];
+      for (long i = 0; i < 16; i++) x[i+16] = data[i];
+      for (long i = 0; i < 16; i++) x[i+32] = d_state[i] ^ data[i];
       
       // block update - 18 rounds
       t_byte t = nilc;
@@ -169,7 +201,7 @@ namespace afnix {
       // checksum update
       t = d_cksum[15];
       for (long i = 0; i < 16; i++) 
-	t = d_cksum[i] ^= PIC[p_data[i] ^ t];
+	t = d_cksum[i] ^= PIC[data[i] ^ t];
       
       // clear the buffer count to indicate processing
       unlock ();
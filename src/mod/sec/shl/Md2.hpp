@@ -46,12 +46,20 @@ namespace afnix {
     /// @return the class name
     String repr (void) const;
 
+    /// @return a clone of this hasher
+    Object* clone (void) const;
+
     /// reset this hasher
     void reset (void);
+
+    /// set the hasher state from another hasher
+    /// @param hobj the hasher to copy
+    void setsts (const Hasher& hobj);
  
-    /// update the hasher state with the buffer data
-    /// @return true if the buffer was processed
-    bool update (void);
+    /// update the hasher state with a block of data
+    /// @param data the block data to process
+    /// @return true if the block was processed
+    bool update (const t_byte* data);
 
     /// finish processing by padding the data
     void finish (void);
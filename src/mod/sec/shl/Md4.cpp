@@ -109,6 +109,21 @@ namespace afnix {
     return "Md4";
   }
 
+  // clone this hasher
+
+  Object* Md4::clone (void) const {
+    rdlock ();
+    try {
+      Md4* result = new Md4 (d_rlen);
+      result->setsts (*this);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // reset this MD4 object
 
   void Md4::reset (void) {
@@ -121,23 +136,39 @@ namespace afnix {
     unlock ();
   }
 
-  // update the hasher state with the buffer data
-  
-  bool Md4::update (void) {
+  // set the hasher state from another hasher
+
+  void Md4::setsts (const Hasher& hobj) {
     wrlock ();
     try {
-      // make sure the buffer is full
-      if (length () != MD4_BMSG_LENGTH) {
-	unlock ();
-	return false;
+      // check for a consistent hasher
+      auto sobj = dynamic_cast <const Md4*> (&hobj);
+      if (sobj == nullptr) {
+	throw Exception ("hasher-error", "inconsistent hasher state object",
+			 hobj.repr ());
       }
+      // copy the base and local state
+      Hasher::setsts (hobj);
+      for (long k = 0L; k < 4L; k++) d_state[k] = sobj->d_state[k];
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // update the hasher state with a block of data
+  
+  bool Md4::update (const t_byte* data) {
+    wrlock ();
+    try {
       // initialize state values
       t_quad a = d_state[0];
       t_quad b = d_state[1];
       t_quad c = d_state[2];
       t_quad d = d_state[3];
       // decode a block in 16 quads
-      t_quad x[16]; lebtoq (x, (t_byte*) p_data, MD4_BMSG_LENGTH);
+      t_quad x[16]; lebtoq (x, data, MD4_BMSG_LENGTH);
       // round 1
       FF (a, b, c, d, x[ 0], S11);
       FF (d, a, b, c, x[ 1], S12);
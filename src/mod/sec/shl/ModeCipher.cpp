@@ -381,9 +381,8 @@ namespace afnix {
       t_byte bt[d_cbsz];
       // initialize the input buffer
       long cc = 0;
-      for (long i = 0; i < d_cbsz; i++) {
-	if (is.valid () == false) break;
-	bi[cc++] = is.read ();
+      while ((cc < d_cbsz) && (is.valid () == true)) {
+	cc += is.copy ((char*) &bi[cc], d_cbsz - cc);
       }
       // fill in the last byte
       for (long i = cc; i < d_cbsz; i++) bi[i] = nilc;
@@ -453,9 +452,8 @@ namespace afnix {
       t_byte bt[d_cbsz];
       // initialize the input buffer
       long cc = 0;
-      for (long i = 0; i < d_cbsz; i++) {
-	if (is.valid () == false) break;
-	bi[cc++] = is.read ();
+      while ((cc < d_cbsz) && (is.valid () == true)) {
+	cc += is.copy ((char*) &bi[cc], d_cbsz - cc);
       }
       // fill in the last byte
       for (long i = cc; i < d_cbsz; i++) bi[i] = nilc;
@@ -571,9 +569,8 @@ namespace afnix {
       t_byte bt[d_cbsz];
       // initialize the input buffer
       long cc = 0L;
-      for (long i = 0; i < d_cbsz; i++) {
-	if (is.valid () == false) break;
-	bi[cc++] = is.read ();
+      while ((cc < d_cbsz) && (is.valid () == true)) {
+	cc += is.copy ((char*) &bi[cc], d_cbsz - cc);
       }
       // check the block size
       if (cc != d_cbsz) {
@@ -627,9 +624,8 @@ namespace afnix {
       t_byte bt[d_cbsz];
       // initialize the input buffer
       long cc = 0L;
-      for (long i = 0; i < d_cbsz; i++) {
-	if (is.valid () == false) break;
-	bi[cc++] = is.read ();
+      while ((cc < d_cbsz) && (is.valid () == true)) {
+	cc += is.copy ((char*) &bi[cc], d_cbsz - cc);
       }
       // check the block size
       if (cc != d_cbsz) {
@@ -15,7 +15,6 @@
 // ---------------------------------------------------------------------------
 
 #include "Hmac.hpp"
-#include "Kdf2.hpp"
 #include "Vector.hpp"
 #include "Pbkdf2.hpp"
 #include "Crypto.hpp"
@@ -23,6 +22,7 @@
 #include "Utility.hpp"
 #include "QuarkZone.hpp"
 #include "Exception.hpp"
+#include "cthr.hpp"
 
 namespace afnix {
 
@@ -32,6 +32,154 @@ namespace afnix {
 
   // the default hasher
   static const String KDF_HASH_NAME = "SHA2-256";
+  // the maximum number of derivation tasks
+  static const long   KDF_TASK_TMAX = 8L;
+
+  // the pbkdf2 block structure
+  struct s_pblk {
+    // the block hmac
+    Hmac*   p_hmac;
+    // the salt data
+    const t_byte* p_salt;
+    // the salt length
+    long    d_slen;
+    // the iteration number
+    long    d_inum;
+    // the first block index
+    long    d_bidx;
+    // the block index step
+    long    d_bstp;
+    // the number of blocks
+    long    d_cmax;
+    // the derived blocks
+    t_byte* p_kbuf;
+    // the error flag
+    bool    d_eflg;
+    // create a block derivation by key and hasher
+    s_pblk (const Key& key, Hasher* hobj) {
+      // clone the hasher for this block
+      auto hash = dynamic_cast <Hasher*> (hobj->clone ());
+      if (hash == nullptr) {
+	throw Exception ("pbkdf2-error", "cannot clone hasher object",
+			 Object::repr (hobj));
+      }
+      Object::iref (p_hmac = new Hmac (key, hash));
+      p_salt = nullptr;
+      d_slen = 0L;
+      d_inum = 1L;
+      d_bidx = 0L;
+      d_bstp = 1L;
+      d_cmax = 0L;
+      p_kbuf = nullptr;
+      d_eflg = false;
+    }
+    // destroy this block derivation
+    ~s_pblk (void) {
+      Object::dref (p_hmac);
+    }
+    // derive a block by index - T_i = U_1 ^ ... ^ U_c
+    void derive (const long i) {
+      // the hmac length
+      long    hlen = p_hmac->gethlen ();
+      t_byte* tbuf = &p_kbuf[i * hlen];
+      t_byte* ubuf = new t_byte[hlen];
+      // generate the block counter
+      long    bcnt = i + 1L;
+      t_byte  bbuf[4];
+      bbuf[0] = (t_byte) ((bcnt >> 24) & 0x000000FF);
+      bbuf[1] = (t_byte) ((bcnt >> 16) & 0x000000FF);
+      bbuf[2] = (t_byte) ((bcnt >> 8)  & 0x000000FF);
+      bbuf[3] = (t_byte) (bcnt & 0x000000FF);
+      // U_1 = PRF (P, S || INT (i))
+      p_hmac->reset   ();
+      p_hmac->process (p_salt, d_slen);
+      p_hmac->process (bbuf, 4);
+      p_hmac->finish  ();
+      for (long k = 0; k < hlen; k++) tbuf[k] = ubuf[k] = p_hmac->getbyte (k);
+      // U_j = PRF (P, U_{j-1})
+      for (long j = 1; j < d_inum; j++) {
+	p_hmac->reset   ();
+	p_hmac->process (ubuf, hlen);
+	p_hmac->finish  ();
+	for (long k = 0; k < hlen; k++) tbuf[k] ^= ubuf[k] = p_hmac->getbyte (k);
+      }
+      delete [] ubuf;
+    }
+    // derive all blocks by index step
+    void derive (void) {
+      try {
+	for (long i = d_bidx; i < d_cmax; i += d_bstp) derive (i);
+      } catch (...) {
+	d_eflg = true;
+      }
+    }
+  };
+
+  // this procedure runs a block derivation task
+  static void* pbkdf2_task (void* args) {
+    auto pblk = reinterpret_cast <s_pblk*> (args);
+    pblk->derive ();
+    return nullptr;
+  }
+
+  // this procedure derives a key by hmac key - the blocks are distributed
+  // over several tasks when the key size exceeds the hash length
+  static Buffer pbkdf2_derive (const Key& key, Hasher* hobj,
+			       const t_byte* salt, const long slen,
+			       const long kbsz, const long inum) {
+    // check for a valid hasher
+    if (hobj == nullptr) {
+      throw Exception ("pbkdf2-error", "invalid nil hasher for derivation");
+    }
+    Buffer result;
+    if (kbsz <= 0L) return result;
+    // compute the number of blocks and tasks
+    long hlen = hobj->gethlen ();
+    long cmax = (kbsz + hlen - 1L) / hlen;
+    long tnum = (cmax < KDF_TASK_TMAX) ? cmax : KDF_TASK_TMAX;
+    // allocate the derivation blocks
+    t_byte*  kbuf = new t_byte[cmax * hlen];
+    s_pblk** pblk = new s_pblk*[tnum];
+    void**   args = new void*[tnum];
+    for (long t = 0; t < tnum; t++) pblk[t] = nullptr;
+    try {
+      // create the block derivations
+      for (long t = 0; t < tnum; t++) {
+	pblk[t] = new s_pblk (key, hobj);
+	pblk[t]->p_salt = salt;
+	pblk[t]->d_slen = slen;
+	pblk[t]->d_inum = inum;
+	pblk[t]->d_bidx = t;
+	pblk[t]->d_bstp = tnum;
+	pblk[t]->d_cmax = cmax;
+	pblk[t]->p_kbuf = kbuf;
+	args[t] = pblk[t];
+      }
+      // derive the blocks by tasks and check the status
+      c_tskrun (pbkdf2_task, args, tnum);
+      bool eflg = false;
+      for (long t = 0; t < tnum; t++) {
+	if (pblk[t]->d_eflg == true) eflg = true;
+      }
+      if (eflg == true) {
+	throw Exception ("pbkdf2-error", "cannot derive key block");
+      }
+      // collect the result
+      result.add (reinterpret_cast<char*>(kbuf), kbsz);
+      // clean and return
+      for (long t = 0; t < tnum; t++) delete pblk[t];
+      delete [] args;
+      delete [] pblk;
+      delete [] kbuf;
+      return result;
+    } catch (...) {
+      for (long t = 0; t < tnum; t++) delete pblk[t];
+      delete [] args;
+      delete [] pblk;
+      delete [] kbuf;
+      throw;
+    }
+  }
 
   // -------------------------------------------------------------------------
   // - class section                                                         -
@@ -181,7 +329,7 @@ namespace afnix {
   void Pbkdf2::setinum (const long inum) {
     wrlock ();
     try {
-      d_kbsz = (inum <= 0L) ? 1L : inum;
+      d_inum = (inum <= 0L) ? 1L : inum;
       unlock ();
     } catch (...) {
       unlock ();
@@ -196,17 +344,9 @@ namespace afnix {
     try {
       // create a hmac key
       Key key (Key::CKEY_KMAC, ostr);
-      // create a hmac by key and hash
-      Hmac* mac = new Hmac (key, p_hobj);
-      // create a key derivation function
-      Kdf2 kdf (mac, d_kbsz, d_inum);
-      // process with the salt
-      kdf.derive (p_salt, d_slen);
-      // get the buffer result
-      Buffer result = kdf.getkbuf ();
-      if (result.length () != d_kbsz) {
-	throw Exception ("pbkdf2-error", "inconsistent key derivation size");
-      }
+      // derive the key blocks
+      Buffer result = pbkdf2_derive (key, p_hobj, p_salt, d_slen,
+				     d_kbsz, d_inum);
       unlock ();
       return result;
     } catch (...) {
@@ -221,16 +361,10 @@ namespace afnix {
     rdlock ();
     try {
       // create a hmac key
-      Key (Key::CKEY_KMAC, size, ostr);
-      // create a key derivation function
-      Kdf2 kdf (p_hobj, d_kbsz, d_inum);
-      // process with the salt
-      kdf.derive (p_salt, d_slen);
-      // get the buffer result
-      Buffer result = kdf.getkbuf ();
-      if (result.length () != d_kbsz) {
-	throw Exception ("pbkdf2-error", "inconsistent key derivation size");
-      }
+      Key key (Key::CKEY_KMAC, size, ostr);
+      // derive the key blocks
+      Buffer result = pbkdf2_derive (key, p_hobj, p_salt, d_slen,
+				     d_kbsz, d_inum);
       unlock ();
       return result;
     } catch (...) {
@@ -101,6 +101,21 @@ namespace afnix {
     return "Sha1";
   }
 
+  // clone this hasher
+
+  Object* Sha1::clone (void) const {
+    rdlock ();
+    try {
+      Sha1* result = new Sha1 (d_rlen);
+      result->setsts (*this);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // reset this SHA-1 object
 
   void Sha1::reset (void) {
@@ -114,18 +129,34 @@ namespace afnix {
     unlock ();
   }
 
-  // update the hasher state with the buffer data
-  
-  bool Sha1::update (void) {
+  // set the hasher state from another hasher
+
+  void Sha1::setsts (const Hasher& hobj) {
     wrlock ();
     try {
-      // make sure the buffer is full
-      if (length () != SHA1_BMSG_LENGTH) {
-	unlock ();
-	return false;
+      // check for a consistent hasher
+      auto sobj = dynamic_cast <const Sha1*> (&hobj);
+      if (sobj == nullptr) {
+	throw Exception ("hasher-error", "inconsistent hasher state object",
+			 hobj.repr ());
       }
+      // copy the base and local state
+      Hasher::setsts (hobj);
+      for (long k = 0L; k < 5L; k++) d_state[k] = sobj->d_state[k];
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // update the hasher state with a block of data
+  
+  bool Sha1::update (const t_byte* data) {
+    wrlock ();
+    try {
       // decode a block in 16 quads
-      t_quad x[16]; bebtoq (x, (t_byte*) p_data, SHA1_BMSG_LENGTH);
+      t_quad x[16]; bebtoq (x, data, SHA1_BMSG_LENGTH);
       // prepare a message schedule
       t_quad W[80];
       for (long i = 0; i < 16; i++) W[i] = x[i];
@@ -124,6 +124,21 @@ namespace afnix {
     return "Sha224";
   }
 
+  // clone this hasher
+
+  Object* Sha224::clone (void) const {
+    rdlock ();
+    try {
+      Sha224* result = new Sha224 (d_rlen);
+      result->setsts (*this);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // reset this SHA-224 object
 
   void Sha224::reset (void) {
@@ -140,18 +155,34 @@ namespace afnix {
     unlock ();
   }
 
-  // update the hasher state with the buffer data
-  
-  bool Sha224::update (void) {
+  // set the hasher state from another hasher
+
+  void Sha224::setsts (const Hasher& hobj) {
     wrlock ();
     try {
-      // make sure the buffer is full
-      if (length () != SHA224_BMSG_LENGTH) {
-	unlock ();
-	return false;
+      // check for a consistent hasher
+      auto sobj = dynamic_cast <const Sha224*> (&hobj);
+      if (sobj == nullptr) {
+	throw Exception ("hasher-error", "inconsistent hasher state object",
+			 hobj.repr ());
       }
+      // copy the base and local state
+      Hasher::setsts (hobj);
+      for (long k = 0L; k < 8L; k++) d_state[k] = sobj->d_state[k];
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // update the hasher state with a block of data
+  
+  bool Sha224::update (const t_byte* data) {
+    wrlock ();
+    try {
       // decode a block in 16 quads
-      t_quad M[16]; bebtoq (M, (t_byte*) p_data, SHA224_BMSG_LENGTH);
+      t_quad M[16]; bebtoq (M, data, SHA224_BMSG_LENGTH);
       // prepare a message schedule
       t_quad W[64];
       for (long i = 0; i < 16; i++) W[i] = M[i];
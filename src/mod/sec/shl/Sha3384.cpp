@@ -58,6 +58,21 @@ namespace afnix {
   String Sha3384::repr (void) const {
     return "Sha3384";
   }
+
+  // clone this hasher
+
+  Object* Sha3384::clone (void) const {
+    rdlock ();
+    try {
+      Sha3384* result = new Sha3384 (d_rlen);
+      result->setsts (*this);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
   
   // reset this SHA-3-384 object
 
@@ -73,22 +88,38 @@ namespace afnix {
     }
   }
 
-  // update the hasher state with the buffer data
-  
-  bool Sha3384::update (void) {
+  // set the hasher state from another hasher
+
+  void Sha3384::setsts (const Hasher& hobj) {
     wrlock ();
     try {
-      // make sure the buffer is full
-      if (length () != SHA3384_BMSG_BSIZ) {
-	unlock ();
-	return false;
+      // check for a consistent hasher
+      auto sobj = dynamic_cast <const Sha3384*> (&hobj);
+      if (sobj == nullptr) {
+	throw Exception ("hasher-error", "inconsistent hasher state object",
+			 hobj.repr ());
       }
+      // copy the base and local state
+      Hasher::setsts (hobj);
+      for (long k = 0L; k < 25L; k++) d_hsts[k] = sobj->d_hsts[k];
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // update the hasher state with a block of data
+  
+  bool Sha3384::update (const t_byte* data) {
+    wrlock ();
+    try {
       // prepare a message in the buffer
       t_octa M[SHA3384_BMSG_OSIZ];
       if (System::isbe () == true) {
-	bebtoo (M, (t_byte*) p_data, SHA3384_BMSG_BSIZ);
+	bebtoo (M, data, SHA3384_BMSG_BSIZ);
       } else {
-	lebtoo (M, (t_byte*) p_data, SHA3384_BMSG_BSIZ);
+	lebtoo (M, data, SHA3384_BMSG_BSIZ);
       }
       // initialize the keccak loop
       kcak_ini_loop (d_hsts, M, SHA3384_BMSG_OSIZ);
@@ -108,11 +139,10 @@ namespace afnix {
     wrlock ();
     try {
       // compute the amount of padding
-      long wcnt = getwcnt ();
-      if (wcnt >= SHA3384_BMSG_BSIZ) {
-	throw Exception ("sha3384-error", "invalid buffer size in finish");
-      }
+      long wcnt = getwcnt () % SHA3384_BMSG_BSIZ;
       long plen = SHA3384_BMSG_BSIZ - wcnt;
+      // clear the last processed block
+      if (full () == true) Buffer::reset ();
       // add padding data as needed
       if (plen == 1L) add (0x86U);
       else if (plen == 2L) {
@@ -124,7 +154,7 @@ namespace afnix {
 	add (0x80U);	
       }
       // now update the state
-      if (update () == false) {
+      if (Hasher::update () == false) {
 	throw Exception ("sha3384-error", "invalid finish state");
       }
       // update the result array
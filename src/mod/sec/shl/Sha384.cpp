@@ -156,6 +156,21 @@ namespace afnix {
     return "Sha384";
   }
 
+  // clone this hasher
+
+  Object* Sha384::clone (void) const {
+    rdlock ();
+    try {
+      Sha384* result = new Sha384 (d_rlen);
+      result->setsts (*this);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // reset this SHA-384 object
 
   void Sha384::reset (void) {
@@ -172,18 +187,34 @@ namespace afnix {
     unlock ();
   }
 
-  // update the SHA-384 state with the buffer data
-  
-  bool Sha384::update (void) {
+  // set the hasher state from another hasher
+
+  void Sha384::setsts (const Hasher& hobj) {
     wrlock ();
     try {
-      // make sure the buffer is full
-      if (length () != SHA384_BMSG_LENGTH) {
-	unlock ();
-	return false;
+      // check for a consistent hasher
+      auto sobj = dynamic_cast <const Sha384*> (&hobj);
+      if (sobj == nullptr) {
+	throw Exception ("hasher-error", "inconsistent hasher state object",
+			 hobj.repr ());
       }
+      // copy the base and local state
+      Hasher::setsts (hobj);
+      for (long k = 0L; k < 8L; k++) d_state[k] = sobj->d_state[k];
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // update the SHA-384 state with a block of data
+  
+  bool Sha384::update (const t_byte* data) {
+    wrlock ();
+    try {
       // decode a block in 16 quads
-      t_octa M[16]; bebtoo (M, (t_byte*) p_data, SHA384_BMSG_LENGTH);
+      t_octa M[16]; bebtoo (M, data, SHA384_BMSG_LENGTH);
       // prepare a message schedule
       t_octa W[80];
       for (long i = 0; i < 16; i++) W[i] = M[i];
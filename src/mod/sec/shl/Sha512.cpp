@@ -161,6 +161,7 @@ namespace afnix {
 
   Sha512::Sha512 (void) : Hasher (SHA512_ALGO_NAME, SHA512_BMSG_LENGTH,
 				  SHA512_HASH_LENGTH) {
+    d_sflg = false;
     reset ();
   }
 
@@ -169,6 +170,7 @@ namespace afnix {
   Sha512::Sha512 (const long rlen) : Hasher (SHA512_ALGO_NAME, 
 					     SHA512_BMSG_LENGTH, 
 					     SHA512_HASH_LENGTH, rlen) {
+    d_sflg = false;
     reset ();
   }
   
@@ -193,6 +195,22 @@ namespace afnix {
   String Sha512::repr (void) const {
     return "Sha512";
   }
+
+  // clone this hasher
+
+  Object* Sha512::clone (void) const {
+    rdlock ();
+    try {
+      Sha512* result =
+	d_sflg ? new Sha512 (d_rlen, d_sflg) : new Sha512 (d_rlen);
+      result->setsts (*this);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
   
   // reset this SHA-512 object
 
@@ -230,18 +248,34 @@ namespace afnix {
     unlock ();
   }
 
-  // update the hasher state with the buffer data
-  
-  bool Sha512::update (void) {
+  // set the hasher state from another hasher
+
+  void Sha512::setsts (const Hasher& hobj) {
     wrlock ();
     try {
-      // make sure the buffer is full
-      if (length () != SHA512_BMSG_LENGTH) {
-	unlock ();
-	return false;
+      // check for a consistent hasher
+      auto sobj = dynamic_cast <const Sha512*> (&hobj);
+      if (sobj == nullptr) {
+	throw Exception ("hasher-error", "inconsistent hasher state object",
+			 hobj.repr ());
       }
+      // copy the base and local state
+      Hasher::setsts (hobj);
+      for (long k = 0L; k < 8L; k++) d_state[k] = sobj->d_state[k];
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // update the hasher state with a block of data
+  
+  bool Sha512::update (const t_byte* data) {
+    wrlock ();
+    try {
       // decode a block in 16 quads
-      t_octa M[16]; bebtoo (M, (t_byte*) p_data, SHA512_BMSG_LENGTH);
+      t_octa M[16]; bebtoo (M, data, SHA512_BMSG_LENGTH);
       // prepare a message schedule
       t_octa W[80];
       for (long i = 0; i < 16; i++) W[i] = M[i];
@@ -25,6 +25,39 @@
 
 namespace afnix {
 
+  // -------------------------------------------------------------------------
+  // - private section                                                       -
+  // -------------------------------------------------------------------------
+
+  // keep the input streams which have buffered data
+  static void sel_isbuf (Vector& isb) {
+    long len = isb.length ();
+    if (len == 0L) return;
+    Vector ibuf;
+    for (long i = 0; i < len; i++) {
+      InputStream* is = dynamic_cast <InputStream*> (isb.get (i));
+      if ((is != nullptr) && (is->buflen () != 0)) ibuf.add (is);
+    }
+    isb = ibuf;
+  }
+
+  // collect the ready streams after a wait
+  static void sel_ready (void* handle, const QuarkTable& ist,
+			 const QuarkTable& ost, Vector& ivec, Vector& ovec) {
+    long rlen = c_shrlen (handle);
+    for (long i = 0; i < rlen; i++) {
+      int sid = c_shrsid (handle, i);
+      if (c_shitst (handle, sid) == true) {
+	Object* obj = ist.get (sid);
+	if (obj != nullptr) ivec.add (obj);
+      }
+      if (c_shotst (handle, sid) == true) {
+	Object* obj = ost.get (sid);
+	if (obj != nullptr) ovec.add (obj);
+      }
+    }
+  }
+
   // -------------------------------------------------------------------------
   // - class section                                                         -
   // -------------------------------------------------------------------------
@@ -32,12 +65,14 @@ namespace afnix {
   // create an empty selector
 
   Selector::Selector (void) {
+    d_eflg   = false;
     p_handle = c_shnew (false);
   }
 
   // create a selector by mode
 
   Selector::Selector (const bool mflg) {
+    d_eflg   = false;
     p_handle = c_shnew (mflg);
   }
 
@@ -59,9 +94,17 @@ namespace afnix {
     if (is == nullptr) return;
     wrlock ();
     try {
-      if (d_isv.exists (is) == false) {
+      int     sid = is->getsid ();
+      Object* obj = (sid < 0) ? nullptr : d_ist.get (sid);
+      bool   hflg = (obj == is);
+      if ((hflg == false) && ((obj != nullptr) || (sid < 0))) {
+	hflg = d_isv.exists (is);
+      }
+      if (hflg == false) {
 	d_isv.add (is);
-	c_shiadd  (p_handle, is->getsid ());
+	if ((sid >= 0) && (obj == nullptr)) d_ist.add (sid, is);
+	c_shiadd  (p_handle, sid);
+	if (is->buflen () != 0) d_isb.add (is);
       }
       unlock ();
     } catch (...) {
@@ -76,10 +119,103 @@ namespace afnix {
     if (os == nullptr) return;
     wrlock ();
     try {
-      if (d_osv.exists (os) == false) {
+      int     sid = os->getsid ();
+      Object* obj = (sid < 0) ? nullptr : d_ost.get (sid);
+      bool   hflg = (obj == os);
+      if ((hflg == false) && ((obj != nullptr) || (sid < 0))) {
+	hflg = d_osv.exists (os);
+      }
+      if (hflg == false) {
 	d_osv.add (os);
-	c_shoadd  (p_handle, os->getsid ());
+	if ((sid >= 0) && (obj == nullptr)) d_ost.add (sid, os);
+	c_shoadd  (p_handle, sid);
+      }
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // remove an input stream
+
+  void Selector::remove (InputStream* is) {
+    if (is == nullptr) return;
+    wrlock ();
+    try {
+      long index = d_isv.find (is);
+      if (index != -1) {
+	// protect the stream while removing it
+	Object::iref (is);
+	int sid = is->getsid ();
+	d_isv.remove (index);
+	d_isb.remove (is);
+	d_ipnd.remove (is);
+	if ((sid >= 0) && (d_ist.get (sid) == is)) {
+	  d_ist.remove (sid);
+	  // look for another stream with the same descriptor
+	  InputStream* ns = nullptr;
+	  long len = d_isv.length ();
+	  for (long i = 0; i < len; i++) {
+	    ns = dynamic_cast <InputStream*> (d_isv.get (i));
+	    if ((ns != nullptr) && (ns->getsid () == sid)) break;
+	    ns = nullptr;
+	  }
+	  if (ns == nullptr) c_shirmv (p_handle, sid); else d_ist.add (sid, ns);
+	}
+	Object::dref (is);
+      }
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // remove an output stream
+
+  void Selector::remove (OutputStream* os) {
+    if (os == nullptr) return;
+    wrlock ();
+    try {
+      long index = d_osv.find (os);
+      if (index != -1) {
+	// protect the stream while removing it
+	Object::iref (os);
+	int sid = os->getsid ();
+	d_osv.remove (index);
+	d_opnd.remove (os);
+	if ((sid >= 0) && (d_ost.get (sid) == os)) {
+	  d_ost.remove (sid);
+	  // look for another stream with the same descriptor
+	  OutputStream* ns = nullptr;
+	  long len = d_osv.length ();
+	  for (long i = 0; i < len; i++) {
+	    ns = dynamic_cast <OutputStream*> (d_osv.get (i));
+	    if ((ns != nullptr) && (ns->getsid () == sid)) break;
+	    ns = nullptr;
+	  }
+	  if (ns == nullptr) c_shormv (p_handle, sid); else d_ost.add (sid, ns);
+	}
+	Object::dref (os);
+      }
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // set the edge triggered mode
+
+  void Selector::setedge (const bool eflg) {
+    wrlock ();
+    try {
+      if (c_shsete (p_handle, eflg) == false) {
+	throw Exception ("selector-error",
+			 "edge triggered mode not supported");
       }
+      d_eflg = eflg;
       unlock ();
     } catch (...) {
       unlock ();
@@ -87,6 +223,20 @@ namespace afnix {
     }
   }
 
+  // return true if the selector is edge triggered
+
+  bool Selector::getedge (void) const {
+    rdlock ();
+    try {
+      bool result = d_eflg;
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // return the number of input streams
 
   long Selector::ilength (void) const {
@@ -148,41 +298,39 @@ namespace afnix {
   Stream* Selector::wait (const long tout) const {
     wrlock ();
     try {
-      // look into the input pushback buffer
-      long len = d_isv.length ();
-      for (long i = 0; i < len; i++) {
-	InputStream* is = dynamic_cast <InputStream*> (d_isv.get (i));
-	if (is == nullptr) continue;
-	if (is->buflen () != 0) {
-	  unlock ();
-	  return is;
-	}
+      // look into the input stream buffers
+      sel_isbuf (d_isb);
+      if (d_isb.length () != 0) {
+	Stream* result = dynamic_cast <Stream*> (d_isb.get (0));
+	unlock ();
+	return result;
       }
-      // now wait for a descriptor to be ready
-      long nsid = c_shwait (p_handle, tout);
-      // check for error first
-      if (nsid < 0) throw Error ("selector-error", c_errmsg (nsid), nsid);
-      // check the input descriptors first
-      for (long i = 0; i < len; i++) {
-	InputStream* is = dynamic_cast <InputStream*> (d_isv.get (i));
-	if (is == nullptr) continue;
-	if (c_shitst (p_handle, is->getsid ()) == true) {
-	  unlock ();
-	  return is;
-	}
+      // wait for the descriptors unless some ready streams are pending
+      if ((d_ipnd.length () == 0) && (d_opnd.length () == 0)) {
+	long nsid = c_shwait (p_handle, tout);
+	// check for error first
+	if (nsid < 0) throw Error ("selector-error", c_errmsg (nsid), nsid);
+	// collect the ready streams
+	sel_ready (p_handle, d_ist, d_ost, d_ipnd, d_opnd);
       }
-      // check the output descriptors
-      len = d_osv.length ();
-      for (long i = 0; i < len; i++) {
-	OutputStream* os = dynamic_cast <OutputStream*> (d_osv.get (i));
-	if (os == nullptr) continue;
-	if (c_shotst (p_handle, os->getsid ()) == true) {
-	  unlock ();
-	  return os;
-	}
+      // get the first ready input stream or output stream
+      Stream* result = nullptr;
+      if (d_ipnd.length () != 0) {
+	InputStream* is = dynamic_cast <InputStream*> (d_ipnd.get (0));
+	d_isb.add (is);
+	d_ipnd.remove (0L);
+	result = is;
+      } else if (d_opnd.length () != 0) {
+	result = dynamic_cast <OutputStream*> (d_opnd.get (0));
+	d_opnd.remove (0L);
+      }
+      // in level triggered mode, the other streams are reported again
+      if (d_eflg == false) {
+	d_ipnd.reset ();
+	d_opnd.reset ();
       }
       unlock ();
-      return nullptr;
+      return result;
     } catch (...) {
       unlock ();
       throw;
@@ -197,35 +345,30 @@ namespace afnix {
     // lock and test
     wrlock ();
     try {
-      // look into the input pushback buffer
-      long len = d_isv.length ();
-      for (long i = 0; i < len; i++) {
-	InputStream* is = dynamic_cast <InputStream*> (d_isv.get (i));
-	if (is == nullptr) continue;
-	if (is->buflen () != 0) result->add (is);
-      }
+      // look into the input stream buffers
+      sel_isbuf (d_isb);
       // if we have something we unlock and return
-      if (result->length () != 0) {
+      if (d_isb.length () != 0) {
+	*result = d_isb;
 	unlock ();
 	return result;
       }
-      // now wait for a descriptor to be ready
-      long nsid = c_shwait (p_handle, tout);
-      // check for error first
-      if (nsid < 0) throw Error ("selector-error", c_errmsg (nsid), nsid);
-      // check the input descriptors first
-      for (long i = 0; i < len; i++) {
-	InputStream* is = dynamic_cast <InputStream*> (d_isv.get (i));
-	if (is == nullptr) continue;
-	if (c_shitst (p_handle, is->getsid ()) == true) result->add (is);
-      }
-      // check the output descriptors
-      len = d_osv.length ();
-      for (long i = 0; i < len; i++) {
-	OutputStream* os = dynamic_cast <OutputStream*> (d_osv.get (i));
-	if (os == nullptr) continue;
-	if (c_shotst (p_handle, os->getsid ()) == true) result->add (os);
+      // wait for the descriptors unless some ready streams are pending
+      if ((d_ipnd.length () == 0) && (d_opnd.length () == 0)) {
+	long nsid = c_shwait (p_handle, tout);
+	// check for error first
+	if (nsid < 0) throw Error ("selector-error", c_errmsg (nsid), nsid);
+	// collect the ready streams
+	sel_ready (p_handle, d_ist, d_ost, d_ipnd, d_opnd);
       }
+      // the input streams first, then the output streams
+      long ilen = d_ipnd.length ();
+      for (long i = 0; i < ilen; i++) result->add (d_ipnd.get (i));
+      long olen = d_opnd.length ();
+      for (long i = 0; i < olen; i++) result->add (d_opnd.get (i));
+      d_isb = d_ipnd;
+      d_ipnd.reset ();
+      d_opnd.reset ();
       unlock ();
       return result;
     } catch (...) {
@@ -267,7 +410,7 @@ namespace afnix {
   // -------------------------------------------------------------------------
 
   // the quark zone
-  static const long QUARK_ZONE_LENGTH = 11;
+  static const long QUARK_ZONE_LENGTH = 16;
   static QuarkZone  zone (QUARK_ZONE_LENGTH);
 
   // the object supported quarks
@@ -282,6 +425,11 @@ namespace afnix {
   static const long QUARK_ILENGTH = zone.intern ("input-length");
   static const long QUARK_OLENGTH = zone.intern ("output-length");
   static const long QUARK_WAITALL = zone.intern ("wait-all");
+  static const long QUARK_REMOVE  = zone.intern ("remove");
+  static const long QUARK_IREMOVE = zone.intern ("input-remove");
+  static const long QUARK_OREMOVE = zone.intern ("output-remove");
+  static const long QUARK_SETEDGE = zone.intern ("set-edge-triggered");
+  static const long QUARK_GETEDGE = zone.intern ("edge-triggered-p");
 
   // create a new object in a generic way
 
@@ -348,6 +496,7 @@ namespace afnix {
       if (quark == QUARK_ILENGTH) return new Integer (ilength  ());
       if (quark == QUARK_OLENGTH) return new Integer (olength  ());
       if (quark == QUARK_MARKEDP) return new Boolean (ismarked ());
+      if (quark == QUARK_GETEDGE) return new Boolean (getedge  ());
       if (quark == QUARK_MARK) {
 	mark ();
 	return nullptr;
@@ -420,6 +569,43 @@ namespace afnix {
 	}
 	throw Exception ("type-error", "input or output stream expected");
       }
+      if (quark == QUARK_REMOVE) {
+	Object* obj = argv->get (0);
+	InputStream* is  = dynamic_cast <InputStream*> (obj);
+	if (is != nullptr) {
+	  remove (is);
+	  return nullptr;
+	}
+	OutputStream* os = dynamic_cast <OutputStream*> (obj);
+	if (os != nullptr) {
+	  remove (os);
+	  return nullptr;
+	}
+	throw Exception ("type-error", "input or output stream expected");
+      }
+      if (quark == QUARK_IREMOVE) {
+	Object* obj = argv->get (0);
+	InputStream* is  = dynamic_cast <InputStream*> (obj);
+	if (is == nullptr) {
+	  throw Exception ("type-error", "input stream expected");
+	}
+	remove (is);
+	return nullptr;
+      }
+      if (quark == QUARK_OREMOVE) {
+	Object* obj = argv->get (0);
+	OutputStream* os = dynamic_cast <OutputStream*> (obj);
+	if (os == nullptr) {
+	  throw Exception ("type-error", "output stream expected");
+	}
+	remove (os);
+	return nullptr;
+      }
+      if (quark == QUARK_SETEDGE) {
+	bool eflg = argv->getbool (0);
+	setedge (eflg);
+	return nullptr;
+      }
       if (quark == QUARK_IADD) {
 	Object* obj = argv->get (0);
 	InputStream* is  = dynamic_cast <InputStream*> (obj);
@@ -21,6 +21,10 @@
 #include "Vector.hpp"
 #endif
 
+#ifndef  AFNIX_QUARKTABLE_HPP
+#include "QuarkTable.hpp"
+#endif
+
 #ifndef  AFNIX_MONITOR_HPP
 #include "Monitor.hpp"
 #endif
@@ -47,6 +51,15 @@ namespace afnix {
   /// usefull mechanism which can be used to cancel a select loop. The 'mark'
   /// method is designed to mark the selector while the 'ismarked' method
   /// returns true if the stream has been marked.
+  /// On linux, the selector is built with epoll and the streams are
+  /// registered once, so that a wait only scans the ready streams. A
+  /// stream can be removed from the selector and the selector can be
+  /// placed in edge triggered mode, where a stream is reported only when
+  /// its status changes. In this mode, the streams reported by a single
+  /// wait are kept and returned by the next calls. The buffered data are
+  /// only checked for the streams returned by the selector or added with
+  /// buffered data. Other platforms use a select based selector which does
+  /// not support the edge triggered mode.
   /// @author amaury darsch
 
   class Selector : public Object {
@@ -55,6 +68,18 @@ namespace afnix {
     Vector  d_isv;
     /// the output streams vector
     Vector  d_osv;
+    /// the input streams by descriptor
+    QuarkTable d_ist;
+    /// the output streams by descriptor
+    QuarkTable d_ost;
+    /// the input streams to check for buffered data
+    mutable Vector d_isb;
+    /// the pending ready input streams
+    mutable Vector d_ipnd;
+    /// the pending ready output streams
+    mutable Vector d_opnd;
+    /// the edge triggered flag
+    bool    d_eflg;
     /// the private handle
     void*   p_handle;
     /// the marking monitor
@@ -82,6 +107,21 @@ namespace afnix {
     /// @param is the input stream to add
     void add (OutputStream* os);
 
+    /// remove an input stream from the select list
+    /// @param is the input stream to remove
+    void remove (InputStream* is);
+
+    /// remove an output stream from the select list
+    /// @param os the output stream to remove
+    void remove (OutputStream* os);
+
+    /// set the edge triggered mode
+    /// @param eflg the edge triggered flag
+    void setedge (const bool eflg);
+
+    /// @return true if the selector is edge triggered
+    bool getedge (void) const;
+
     /// @return the number of input streams
     long ilength (void) const;
 
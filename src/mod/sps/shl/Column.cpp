@@ -0,0 +1,580 @@
+// ---------------------------------------------------------------------------
+// - Column.cpp                                                              -
+// - afnix:sps module - mapped column class implementation                   -
+// ---------------------------------------------------------------------------
+// - This program is free software;  you can redistribute it  and/or  modify -
+// - it provided that this copyright notice is kept intact.                  -
+// -                                                                         -
+// - This program  is  distributed in  the hope  that it will be useful, but -
+// - without  any  warranty;  without  even   the   implied    warranty   of -
+// - merchantability or fitness for a particular purpose.  In no event shall -
+// - the copyright holder be liable for any  direct, indirect, incidental or -
+// - special damages arising in any way out of the use of this software.     -
+// ---------------------------------------------------------------------------
+// - copyright (c) 1999-2021 amaury darsch                                   -
+// ---------------------------------------------------------------------------
+
+#include "Real.hpp"
+#include "Ascii.hpp"
+#include "Sheet.hpp"
+#include "Column.hpp"
+#include "Boolean.hpp"
+#include "Integer.hpp"
+#include "Unicode.hpp"
+#include "Evaluable.hpp"
+#include "HashTable.hpp"
+#include "QuarkZone.hpp"
+#include "Exception.hpp"
+#include "OutputFile.hpp"
+#include "InputMapped.hpp"
+#include "OutputBuffer.hpp"
+#include "cmem.hpp"
+#include "csio.hpp"
+
+namespace afnix {
+
+  // -------------------------------------------------------------------------
+  // - private section                                                       -
+  // -------------------------------------------------------------------------
+
+  // the column magic number
+  static const long   COL_MSIZE   = 4;
+  static const char   COL_MAGIC[] = {'\177', 'S', 'P', 'C'};
+  // the column version
+  static const t_byte COL_VERSION = 0x01;
+  // the column byte order marker
+  static const t_octa COL_BOMARK  = 0x0102030405060708ULL;
+  // the column header size
+  static const long   COL_HSIZE   = 32L;
+  // the boolean flags
+  static const t_byte COL_BFALSE  = 0x00;
+  static const t_byte COL_BVTRUE  = 0x01;
+  static const t_byte COL_BNILLF  = 0x02;
+
+  // the column header
+  struct s_chdr {
+    // the magic number
+    char   d_magic[COL_MSIZE];
+    // the version
+    t_byte d_vers;
+    // the column type
+    t_byte d_ctyp;
+    // the padding bytes
+    t_byte d_pads[2];
+    // the byte order marker
+    t_octa d_bomk;
+    // the number of rows
+    t_long d_rows;
+    // the dictionary length
+    t_long d_dlen;
+  };
+
+  // this function aligns a size on a long
+  static inline long col_align (const long size) {
+    long amod = size % (long) sizeof (t_long);
+    return (amod == 0L) ? size : size + (long) sizeof (t_long) - amod;
+  }
+
+  // this function writes some padding bytes
+  static void col_wrpad (OutputStream& os, const long size) {
+    long plen = col_align (size) - size;
+    for (long k = 0L; k < plen; k++) os.write (nilc);
+  }
+
+  // this function detects the column type of a literal vector
+  static Column::t_ctyp col_totype (Literal** lvec, const long rows) {
+    Column::t_ctyp result = Column::CTYP_NILL;
+    for (long k = 0L; k < rows; k++) {
+      Literal* lobj = lvec[k];
+      if (lobj == nullptr) continue;
+      Column::t_ctyp ctyp = Column::CTYP_OTHR;
+      if (dynamic_cast <Boolean*> (lobj) != nullptr) ctyp = Column::CTYP_BOOL;
+      if (dynamic_cast <Integer*> (lobj) != nullptr) ctyp = Column::CTYP_INTG;
+      if (dynamic_cast <Real*>    (lobj) != nullptr) ctyp = Column::CTYP_REAL;
+      if (dynamic_cast <String*>  (lobj) != nullptr) ctyp = Column::CTYP_STRG;
+      if ((ctyp == Column::CTYP_OTHR) ||
+	  ((result != Column::CTYP_NILL) && (result != ctyp))) {
+	return Column::CTYP_OTHR;
+      }
+      result = ctyp;
+    }
+    return result;
+  }
+
+  // this function writes a flag array
+  static void col_wrflgs (OutputStream& os, Literal** lvec, const long rows,
+			  const bool bflg) {
+    t_byte* flgs = new t_byte[rows];
+    for (long k = 0L; k < rows; k++) {
+      Boolean* bobj = bflg ? dynamic_cast <Boolean*> (lvec[k]) : nullptr;
+      if (lvec[k] == nullptr) {
+	flgs[k] = COL_BNILLF;
+      } else if (bobj != nullptr) {
+	flgs[k] = bobj->tobool () ? COL_BVTRUE : COL_BFALSE;
+      } else {
+	flgs[k] = COL_BVTRUE;
+      }
+    }
+    try {
+      os.write ((const char*) flgs, rows);
+      col_wrpad (os, rows);
+      delete [] flgs;
+    } catch (...) {
+      delete [] flgs;
+      throw;
+    }
+  }
+
+  // this function writes a long array
+  static void col_wrlong (OutputStream& os, const t_long* data,
+			  const long size) {
+    os.write ((const char*) data, size * (long) sizeof (t_long));
+  }
+
+  // this function writes the column data
+  static void col_wrdata (OutputStream& os, Literal** lvec, const long rows,
+			  const Column::t_ctyp ctyp) {
+    // write the boolean and numerical columns
+    if (ctyp == Column::CTYP_BOOL) {
+      col_wrflgs (os, lvec, rows, true);
+      return;
+    }
+    if ((ctyp == Column::CTYP_INTG) || (ctyp == Column::CTYP_REAL)) {
+      col_wrflgs (os, lvec, rows, false);
+      t_long* ival = new t_long[rows];
+      t_real* rval = reinterpret_cast <t_real*> (ival);
+      for (long k = 0L; k < rows; k++) {
+	Integer* iobj = dynamic_cast <Integer*> (lvec[k]);
+	Real*    robj = dynamic_cast <Real*>    (lvec[k]);
+	if (ctyp == Column::CTYP_INTG) {
+	  ival[k] = (iobj == nullptr) ? 0LL : iobj->tolong ();
+	} else {
+	  rval[k] = (robj == nullptr) ? 0.0 : robj->toreal ();
+	}
+      }
+      try {
+	col_wrlong (os, ival, rows);
+	delete [] ival;
+      } catch (...) {
+	delete [] ival;
+	throw;
+      }
+      return;
+    }
+    // write the string and other columns
+    if ((ctyp == Column::CTYP_STRG) || (ctyp == Column::CTYP_OTHR)) {
+      bool      sflg = (ctyp == Column::CTYP_STRG);
+      long      clen = sflg ? rows : rows + 1L;
+      t_long*   code = new t_long[clen];
+      t_long*   doff = nullptr;
+      HashTable dict;
+      OutputBuffer blob;
+      try {
+	Vector dvec;
+	for (long k = 0L; k < rows; k++) {
+	  Literal* lobj = lvec[k];
+	  if (sflg == false) {
+	    code[k] = blob.length ();
+	    if (lobj != nullptr) lobj->serialize (blob);
+	    continue;
+	  }
+	  if (lobj == nullptr) {
+	    code[k] = -1LL;
+	    continue;
+	  }
+	  String sval = lobj->tostring ();
+	  Integer* iobj = dynamic_cast <Integer*> (dict.get (sval));
+	  if (iobj == nullptr) {
+	    iobj = new Integer (dvec.length ());
+	    dict.add (sval, iobj);
+	    dvec.add (new String (sval));
+	  }
+	  code[k] = iobj->tolong ();
+	}
+	// write the dictionary
+	if (sflg == true) {
+	  long dlen = dvec.length ();
+	  doff = new t_long[dlen + 1L];
+	  for (long k = 0L; k < dlen; k++) {
+	    doff[k] = blob.length ();
+	    String* sobj = dynamic_cast <String*> (dvec.get (k));
+	    char*   sbuf = Unicode::encode (Encoding::EMOD_UTF8, *sobj);
+	    blob.write (sbuf, Ascii::strlen (sbuf));
+	    delete [] sbuf;
+	  }
+	  doff[dlen] = blob.length ();
+	  col_wrlong (os, code, rows);
+	  col_wrlong (os, doff, dlen + 1L);
+	} else {
+	  code[rows] = blob.length ();
+	  col_wrlong (os, code, rows + 1L);
+	}
+	os.write (blob.tobuffer ());
+	delete [] code;
+	delete [] doff;
+      } catch (...) {
+	delete [] code;
+	delete [] doff;
+	throw;
+      }
+    }
+  }
+
+  // this function returns the dictionary length of a string column
+  static long col_todlen (Literal** lvec, const long rows) {
+    HashTable dict;
+    for (long k = 0L; k < rows; k++) {
+      if (lvec[k] == nullptr) continue;
+      String sval = lvec[k]->tostring ();
+      if (dict.exists (sval) == false) dict.add (sval, nullptr);
+    }
+    return dict.length ();
+  }
+
+  // this function checks that a mapped array fits in the mapped size - the
+  // check is done by division so that a large count cannot overflow
+  static void col_chksiz (const long size, const long boff, const t_long cnum,
+			  const long esiz, const String& name) {
+    if ((boff < 0L) || (boff > size) || (cnum < 0LL) ||
+	(cnum > (t_long) ((size - boff) / esiz))) {
+      throw Exception ("column-error", "invalid column file size", name);
+    }
+  }
+
+  // -------------------------------------------------------------------------
+  // - class section                                                         -
+  // -------------------------------------------------------------------------
+
+  // write a sheet column file
+
+  void Column::write (const String& name, const Sheet& sht, const long col) {
+    sht.rdlock ();
+    long      rows = sht.length ();
+    Literal** lvec = new Literal*[rows];
+    try {
+      // collect the column literals
+      for (long k = 0L; k < rows; k++) lvec[k] = sht.map (k, col);
+      t_ctyp ctyp = col_totype (lvec, rows);
+      // prepare the header
+      s_chdr chdr;
+      for (long k = 0L; k < COL_MSIZE; k++) chdr.d_magic[k] = COL_MAGIC[k];
+      chdr.d_vers = COL_VERSION;
+      chdr.d_ctyp = (t_byte) ctyp;
+      chdr.d_pads[0] = nilc;
+      chdr.d_pads[1] = nilc;
+      chdr.d_bomk = COL_BOMARK;
+      chdr.d_rows = rows;
+      chdr.d_dlen = (ctyp == CTYP_STRG) ? col_todlen (lvec, rows) : 0L;
+      // write the column file
+      OutputFile os (name);
+      os.write ((const char*) &chdr, COL_HSIZE);
+      col_wrdata (os, lvec, rows, ctyp);
+      os.close ();
+      delete [] lvec;
+      sht.unlock ();
+    } catch (...) {
+      delete [] lvec;
+      sht.unlock ();
+      throw;
+    }
+  }
+
+  // map a column file by name
+
+  Column::Column (const String& name) {
+    // initialize the column
+    d_ctyp = CTYP_NILL;
+    d_rows = 0L;
+    d_msiz = 0L;
+    p_mbuf = nullptr;
+    p_flgs = nullptr;
+    p_ival = nullptr;
+    p_rval = nullptr;
+    p_code = nullptr;
+    d_dlen = 0L;
+    p_doff = nullptr;
+    p_blob = nullptr;
+    d_bsiz = 0L;
+    // open and map the file
+    char* fname = name.tochar ();
+    int   sid   = c_openr (fname);
+    delete [] fname;
+    if (sid < 0) {
+      throw Exception ("open-error", "cannot open column file", name);
+    }
+    d_msiz = c_fsize (sid);
+    p_mbuf = (d_msiz < COL_HSIZE) ? nullptr : (char*) c_mmap (sid, d_msiz, 0);
+    c_close (sid);
+    if (p_mbuf == nullptr) {
+      throw Exception ("column-error", "cannot map column file", name);
+    }
+    try {
+      // check the header
+      const s_chdr* chdr = reinterpret_cast <const s_chdr*> (p_mbuf);
+      for (long k = 0L; k < COL_MSIZE; k++) {
+	if (chdr->d_magic[k] != COL_MAGIC[k]) {
+	  throw Exception ("column-error", "invalid column file header", name);
+	}
+      }
+      if ((chdr->d_vers != COL_VERSION) || (chdr->d_bomk != COL_BOMARK) ||
+	  (chdr->d_ctyp > CTYP_OTHR) || (chdr->d_rows < 0LL) ||
+	  (chdr->d_dlen < 0LL)) {
+	throw Exception ("column-error", "invalid column file header", name);
+      }
+      d_ctyp = (t_ctyp) chdr->d_ctyp;
+      d_rows = chdr->d_rows;
+      // bind the column arrays
+      long boff = COL_HSIZE;
+      long lsiz = (long) sizeof (t_long);
+      if ((d_ctyp == CTYP_BOOL) || (d_ctyp == CTYP_INTG) ||
+	  (d_ctyp == CTYP_REAL)) {
+	col_chksiz (d_msiz, boff, d_rows, 1L, name);
+	p_flgs = reinterpret_cast <const t_byte*> (p_mbuf + boff);
+	boff += col_align (d_rows);
+      }
+      if (d_ctyp == CTYP_INTG) {
+	col_chksiz (d_msiz, boff, d_rows, lsiz, name);
+	p_ival = reinterpret_cast <const t_long*> (p_mbuf + boff);
+      }
+      if (d_ctyp == CTYP_REAL) {
+	col_chksiz (d_msiz, boff, d_rows, lsiz, name);
+	p_rval = reinterpret_cast <const t_real*> (p_mbuf + boff);
+      }
+      if (d_ctyp == CTYP_STRG) {
+	d_dlen = chdr->d_dlen;
+	col_chksiz (d_msiz, boff, d_rows, lsiz, name);
+	p_code = reinterpret_cast <const t_long*> (p_mbuf + boff);
+	boff  += d_rows * lsiz;
+	col_chksiz (d_msiz, boff, d_dlen, lsiz, name);
+	col_chksiz (d_msiz, boff + d_dlen * lsiz, 1LL, lsiz, name);
+	p_doff = reinterpret_cast <const t_long*> (p_mbuf + boff);
+	boff  += (d_dlen + 1L) * lsiz;
+	d_bsiz = p_doff[d_dlen];
+      }
+      if (d_ctyp == CTYP_OTHR) {
+	col_chksiz (d_msiz, boff, d_rows, lsiz, name);
+	col_chksiz (d_msiz, boff + d_rows * lsiz, 1LL, lsiz, name);
+	p_code = reinterpret_cast <const t_long*> (p_mbuf + boff);
+	boff  += (d_rows + 1L) * lsiz;
+	d_bsiz = p_code[d_rows];
+      }
+      if ((d_ctyp == CTYP_STRG) || (d_ctyp == CTYP_OTHR)) {
+	col_chksiz (d_msiz, boff, d_bsiz, 1L, name);
+	p_blob = p_mbuf + boff;
+      }
+    } catch (...) {
+      c_munmap (p_mbuf, d_msiz);
+      throw;
+    }
+  }
+
+  // destroy this column
+
+  Column::~Column (void) {
+    if (p_mbuf != nullptr) c_munmap (p_mbuf, d_msiz);
+  }
+
+  // return the class name
+
+  String Column::repr (void) const {
+    return "Column";
+  }
+
+  // return the column type
+
+  Column::t_ctyp Column::gettype (void) const {
+    return d_ctyp;
+  }
+
+  // return the number of rows
+
+  long Column::length (void) const {
+    return d_rows;
+  }
+
+  // return true if a row is nil
+
+  bool Column::isnil (const long row) const {
+    if ((row < 0L) || (row >= d_rows)) {
+      throw Exception ("index-error", "invalid column row index");
+    }
+    switch (d_ctyp) {
+    case CTYP_NILL:
+      return true;
+    case CTYP_BOOL:
+    case CTYP_INTG:
+    case CTYP_REAL:
+      return p_flgs[row] == COL_BNILLF;
+    case CTYP_STRG:
+      return p_code[row] < 0LL;
+    case CTYP_OTHR:
+      return p_code[row] == p_code[row+1];
+    }
+    return true;
+  }
+
+  // return a boolean row value
+
+  bool Column::getbool (const long row) const {
+    if (d_ctyp != CTYP_BOOL) {
+      throw Exception ("type-error", "invalid column type for boolean");
+    }
+    if (isnil (row) == true) {
+      throw Exception ("column-error", "nil boolean column value");
+    }
+    return p_flgs[row] == COL_BVTRUE;
+  }
+
+  // return an integer row value
+
+  t_long Column::getlong (const long row) const {
+    if (d_ctyp != CTYP_INTG) {
+      throw Exception ("type-error", "invalid column type for integer");
+    }
+    if (isnil (row) == true) {
+      throw Exception ("column-error", "nil integer column value");
+    }
+    return p_ival[row];
+  }
+
+  // return a real row value
+
+  t_real Column::getreal (const long row) const {
+    if (d_ctyp != CTYP_REAL) {
+      throw Exception ("type-error", "invalid column type for real");
+    }
+    if (isnil (row) == true) {
+      throw Exception ("column-error", "nil real column value");
+    }
+    return p_rval[row];
+  }
+
+  // return a new literal by row
+
+  Literal* Column::get (const long row) const {
+    if (isnil (row) == true) return nullptr;
+    switch (d_ctyp) {
+    case CTYP_NILL:
+      break;
+    case CTYP_BOOL:
+      return new Boolean (p_flgs[row] == COL_BVTRUE);
+    case CTYP_INTG:
+      return new Integer (p_ival[row]);
+    case CTYP_REAL:
+      return new Real (p_rval[row]);
+    case CTYP_STRG: {
+      t_long code = p_code[row];
+      if ((code < 0LL) || (code >= d_dlen)) {
+	throw Exception ("column-error", "invalid string column code");
+      }
+      t_long soff = p_doff[code];
+      t_long slen = p_doff[code+1] - soff;
+      if ((soff < 0LL) || (slen < 0LL) || (soff + slen > d_bsiz)) {
+	throw Exception ("column-error", "invalid string column offset");
+      }
+      t_quad* sbuf = Unicode::decode (Encoding::EMOD_UTF8, &p_blob[soff], slen);
+      String* result = new String (sbuf);
+      delete [] sbuf;
+      return result;
+    }
+    case CTYP_OTHR: {
+      t_long soff = p_code[row];
+      t_long slen = p_code[row+1] - soff;
+      if ((soff < 0LL) || (slen < 0LL) || (soff + slen > d_bsiz)) {
+	throw Exception ("column-error", "invalid column literal offset");
+      }
+      Buffer buf;
+      buf.add (&p_blob[soff], slen);
+      InputMapped is (buf);
+      Object*  obj = Serial::deserialize (is);
+      Literal* result = dynamic_cast <Literal*> (obj);
+      if ((obj != nullptr) && (result == nullptr)) {
+	Object::cref (obj);
+	throw Exception ("column-error", "invalid column literal object");
+      }
+      return result;
+    }
+    }
+    return nullptr;
+  }
+
+  // -------------------------------------------------------------------------
+  // - object section                                                        -
+  // -------------------------------------------------------------------------
+
+  // the quark zone
+  static const long QUARK_ZONE_LENGTH = 6;
+  static QuarkZone  zone (QUARK_ZONE_LENGTH);
+
+  // the object supported quarks
+  static const long QUARK_GET     = zone.intern ("get");
+  static const long QUARK_NILP    = zone.intern ("nil-p");
+  static const long QUARK_LENGTH  = zone.intern ("length");
+  static const long QUARK_GETBOOL = zone.intern ("get-boolean");
+  static const long QUARK_GETLONG = zone.intern ("get-integer");
+  static const long QUARK_GETREAL = zone.intern ("get-real");
+
+  // create a new object in a generic way
+
+  Object* Column::mknew (Vector* argv) {
+    // get number of arguments
+    long argc = (argv == nullptr) ? 0 : argv->length ();
+    // check for 1 argument
+    if (argc == 1) {
+      String name = argv->getstring (0);
+      return new Column (name);
+    }
+    throw Exception ("argument-error", "invalid arguments with column");
+  }
+
+  // return true if the given quark is defined
+
+  bool Column::isquark (const long quark, const bool hflg) const {
+    rdlock ();
+    if (zone.exists (quark) == true) {
+      unlock ();
+      return true;
+    }
+    bool result = hflg ? Object::isquark (quark, hflg) : false;
+    unlock ();
+    return result;
+  }
+
+  // apply this object with a set of arguments and a quark
+
+  Object* Column::apply (Evaluable* zobj, Nameset* nset, const long quark,
+			 Vector* argv) {
+    // get the number of arguments
+    long argc = (argv == nullptr) ? 0 : argv->length ();
+
+    // dispatch 0 argument
+    if (argc == 0) {
+      if (quark == QUARK_LENGTH) return new Integer (length ());
+    }
+    // dispatch 1 argument
+    if (argc == 1) {
+      if (quark == QUARK_GET) {
+	long row = argv->getlong (0);
+	return get (row);
+      }
+      if (quark == QUARK_NILP) {
+	long row = argv->getlong (0);
+	return new Boolean (isnil (row));
+      }
+      if (quark == QUARK_GETBOOL) {
+	long row = argv->getlong (0);
+	return new Boolean (getbool (row));
+      }
+      if (quark == QUARK_GETLONG) {
+	long row = argv->getlong (0);
+	return new Integer (getlong (row));
+      }
+      if (quark == QUARK_GETREAL) {
+	long row = argv->getlong (0);
+	return new Real (getreal (row));
+      }
+    }
+    // call the object method
+    return Object::apply (zobj, nset, quark, argv);
+  }
+}
@@ -0,0 +1,142 @@
+// ---------------------------------------------------------------------------
+// - Column.hpp                                                              -
+// - afnix:sps module - mapped column class definition                       -
+// ---------------------------------------------------------------------------
+// - This program is free software;  you can redistribute it  and/or  modify -
+// - it provided that this copyright notice is kept intact.                  -
+// -                                                                         -
+// - This program  is  distributed in  the hope  that it will be useful, but -
+// - without  any  warranty;  without  even   the   implied    warranty   of -
+// - merchantability or fitness for a particular purpose.  In no event shall -
+// - the copyright holder be liable for any  direct, indirect, incidental or -
+// - special damages arising in any way out of the use of this software.     -
+// ---------------------------------------------------------------------------
+// - copyright (c) 1999-2021 amaury darsch                                   -
+// ---------------------------------------------------------------------------
+
+#ifndef  AFNIX_COLUMN_HPP
+#define  AFNIX_COLUMN_HPP
+
+#ifndef  AFNIX_LITERAL_HPP
+#include "Literal.hpp"
+#endif
+
+namespace afnix {
+
+  /// The Column class is a memory mapped sheet column. A column file holds
+  /// the literals of a sheet column as a typed array, namely a boolean, an
+  /// integer, a real or a dictionary encoded string array. A column with
+  /// other or mixed literals holds the serialized literals. The column
+  /// file is mapped in memory and a literal is only built when requested,
+  /// while the typed accessors read directly the mapped array. The column
+  /// files are written with the native byte order and a column is
+  /// immutable once mapped.
+  /// @author amaury darsch
+
+  class Column : public virtual Object {
+  public:
+    /// the column type
+    enum t_ctyp {
+      CTYP_NILL, // nil column
+      CTYP_BOOL, // boolean column
+      CTYP_INTG, // integer column
+      CTYP_REAL, // real column
+      CTYP_STRG, // string column
+      CTYP_OTHR  // other column
+    };
+
+  private:
+    /// the column type
+    t_ctyp d_ctyp;
+    /// the number of rows
+    long   d_rows;
+    /// the mapped size
+    long   d_msiz;
+    /// the mapped buffer
+    char*  p_mbuf;
+    /// the flag array
+    const t_byte* p_flgs;
+    /// the integer array
+    const t_long* p_ival;
+    /// the real array
+    const t_real* p_rval;
+    /// the code or offset array
+    const t_long* p_code;
+    /// the dictionary length
+    long   d_dlen;
+    /// the dictionary offsets
+    const t_long* p_doff;
+    /// the data blob
+    const char*   p_blob;
+    /// the data blob size
+    long   d_bsiz;
+
+  public:
+    /// map a column file by name
+    /// @param name the column file name
+    Column (const String& name);
+
+    /// destroy this column
+    ~Column (void);
+
+    /// @return the class name
+    String repr (void) const;
+
+    /// @return the column type
+    t_ctyp gettype (void) const;
+
+    /// @return the number of rows
+    long length (void) const;
+
+    /// @return true if a row is nil
+    /// @param row the row to check
+    bool isnil (const long row) const;
+
+    /// @return a boolean row value
+    /// @param row the row to read
+    bool getbool (const long row) const;
+
+    /// @return an integer row value
+    /// @param row the row to read
+    t_long getlong (const long row) const;
+
+    /// @return a real row value
+    /// @param row the row to read
+    t_real getreal (const long row) const;
+
+    /// @return a new literal by row or nil
+    /// @param row the row to read
+    Literal* get (const long row) const;
+
+    /// write a sheet column file
+    /// @param name the column file name
+    /// @param sht  the sheet to write
+    /// @param col  the sheet column to write
+    static void write (const String& name, const class Sheet& sht,
+		       const long col);
+
+  private:
+    // make the copy constructor private
+    Column (const Column&) =delete;
+    // make the assignment operator private
+    Column& operator = (const Column&) =delete;
+
+  public:
+    /// create a new object in a generic way
+    /// @param argv the argument vector
+    static Object* mknew (Vector* argv);
+
+    /// @return true if the given quark is defined
+    bool isquark (const long quark, const bool hflg) const;
+
+    /// apply this object with a set of arguments and a quark
+    /// @param zobj  the current evaluable
+    /// @param nset  the current nameset
+    /// @param quark the quark to apply these arguments
+    /// @param argv  the arguments to apply
+    Object* apply (Evaluable* zobj, Nameset* nset, const long quark,
+		   Vector* argv);
+  };
+}
+
+#endif
@@ -15,14 +15,17 @@
 // ---------------------------------------------------------------------------
 
 #include "Csv.hpp"
+#include "Real.hpp"
+#include "Sheet.hpp"
 #include "Lexer.hpp"
 #include "Locale.hpp"
-#include "Strvec.hpp"
 #include "Boolean.hpp"
 #include "Integer.hpp"
+#include "Unicode.hpp"
 #include "InputFile.hpp"
 #include "QuarkZone.hpp"
 #include "Exception.hpp"
+#include "ccnv.hpp"
 
 namespace afnix {
 
@@ -34,6 +37,25 @@ namespace afnix {
   static const long   CSV_LNUM_DEF = 0L;
   // default break sequence
   static const String CSV_SBRK_DEF = ",;\t";
+  // the csv byte window minimum size
+  static const long   CSV_WBUF_MINS = 256L;
+  // the csv byte window maximum size
+  static const long   CSV_WBUF_SIZE = 65536L;
+  // the csv record buffer default size
+  static const long   CSV_RBUF_SIZE = 256L;
+  // the csv field array default size
+  static const long   CSV_FLDS_SIZE = 16L;
+  // the maximum number of digits for a fast integer
+  static const long   CSV_IDIG_MAX  = 18L;
+
+  // the csv field type
+  enum t_ctyp {
+    CTYP_NILL, // nil field
+    CTYP_BOOL, // boolean field
+    CTYP_INTG, // integer field
+    CTYP_REAL, // real field
+    CTYP_OTHR  // other field
+  };
 
   // this procedure create a lexical object from a string
   static Object* csv_new_lobj (const String& lval) {
@@ -51,7 +73,12 @@ namespace afnix {
       // check for full parsing
       Token ntok = lexr.get ();
       if (ntok.gettid () == Token::EOS) {
-	return tokn.getobj ();
+	// reduce the token constant to its literal
+	Object* cobj = tokn.getobj ();
+	Object* lobj = (cobj == nullptr) ? nullptr : cobj->reduce ();
+	Object* result = (lobj == nullptr) ? nullptr : lobj->clone ();
+	Object::cref (cobj);
+	return result;
       } else {
 	return new String (lval);
       }
@@ -59,59 +86,539 @@ namespace afnix {
     return new String (lval);
   }
 
-  // this procedure creates a lexical vector a string vector
-  static Vector* csv_new_lvec (const Strvec& sv, const Vector& lv) {
-    // get length and and form
-    long vlen = sv.length ();
-    if (vlen == 0L) return nullptr;
-    // extract the locale length
-    long llen = lv.length ();
-    // loop for vector building
-    Vector* lvec = new Vector;
-    for (long k = 0L; k < vlen; k++) {
-      String lval = sv.get(k).strip ();
-      if (lval.isnil () == true) {
-	lvec->add (nullptr);
-	continue;
-      }
-      // eventually get the locale
-      Locale* lo = dynamic_cast <Locale*> ((k < llen) ? lv.get (k) : nullptr);
-      // the literal object to add
-      Object* lobj = (lo == nullptr) ?
-	csv_new_lobj (lval) : lo->toobject (lval);
-      // add the object to the vector
-      lvec->add (lobj);
-    }
-    return lvec;
+  // this procedure returns true if a byte can start a lexical literal
+  static inline bool csv_is_lbyt (const char c) {
+    return ((c >= '0') && (c <= '9')) || (c == '+') || (c == '-') ||
+      (c == '.') || (c == '\'');
   }
-  
-  // this procedure creates a form from a string vector
-  static Form* csv_new_form (const Strvec& sv, const Vector& lv) {
-    // get length and and form
-    long vlen = sv.length ();
-    if (vlen == 0L) return nullptr;
-    // extract the locale length
-    long llen = lv.length ();
-    // loop for form building
-    Form* form = nullptr;
-    for (long k = 0L; k < vlen; k++) {
-      String lval = sv.get(k).strip ();
-      if (lval.isnil () == true) continue;
-      // eventually get the locale
-      Locale* lo = dynamic_cast <Locale*> ((k < llen) ? lv.get (k) : nullptr);
-      // the literal object to add
-      Object* lobj = (lo == nullptr) ?
-	csv_new_lobj (lval) : lo->toobject (lval);
-      if (lobj == nullptr) continue;
-      // add the object to the form
-      if (form == nullptr) {
-	form = new Form (lobj);
+
+  // this procedure returns true if a byte is a field blank
+  static inline bool csv_is_blnk (const char c) {
+    return (c == ' ') || (c == '\t') || (c == crlc);
+  }
+
+  // the csv field descriptor
+  struct s_cfld {
+    // the field offset
+    long d_foff;
+    // the field length
+    long d_flen;
+    // the quoted flag
+    bool d_qflg;
+    // the ascii flag
+    bool d_aflg;
+  };
+
+  // the csv tokenizer - the tokenizer reads the stream by byte window
+  // when the stream is buffered, or byte per byte otherwise, and splits
+  // the records according to the rfc 4180 rules; the record fields are
+  // stored as nil terminated bytes in a record buffer
+  struct s_clex {
+    // the input stream
+    InputStream* p_is;
+    // the separator table
+    bool d_stbl[256];
+    // the byte window
+    char* p_wbuf;
+    // the window size
+    long  d_wsiz;
+    // the window maximum size
+    long  d_wmax;
+    // the window position
+    long  d_wpos;
+    // the window length
+    long  d_wlen;
+    // the record buffer
+    char* p_rbuf;
+    // the record buffer size
+    long  d_rsiz;
+    // the record buffer length
+    long  d_rlen;
+    // the field array
+    s_cfld* p_flds;
+    // the field array size
+    long  d_fsiz;
+    // the number of fields
+    long  d_flen;
+    // the number of read lines
+    long  d_lnum;
+    // the record line number
+    long  d_rnum;
+    // create a tokenizer by stream and break sequence
+    s_clex (InputStream* is, const String& sbrk) {
+      p_is = is;
+      d_wmax = (dynamic_cast <InputBuffer*> (is) == nullptr) ? 1L :
+	CSV_WBUF_SIZE;
+      p_wbuf = new char[d_wmax];
+      d_wsiz = (d_wmax < CSV_WBUF_MINS) ? d_wmax : CSV_WBUF_MINS;
+      d_wpos = 0L;
+      d_wlen = 0L;
+      p_rbuf = new char[CSV_RBUF_SIZE];
+      d_rsiz = CSV_RBUF_SIZE;
+      d_rlen = 0L;
+      p_flds = new s_cfld[CSV_FLDS_SIZE];
+      d_fsiz = CSV_FLDS_SIZE;
+      d_flen = 0L;
+      d_lnum = 0L;
+      d_rnum = 0L;
+      setsbrk (sbrk);
+    }
+    // destroy this tokenizer
+    ~s_clex (void) {
+      flush ();
+      delete [] p_wbuf;
+      delete [] p_rbuf;
+      delete [] p_flds;
+    }
+    // set the separator table
+    void setsbrk (const String& sbrk) {
+      for (long k = 0L; k < 256L; k++) d_stbl[k] = false;
+      long slen = sbrk.length ();
+      for (long k = 0L; k < slen; k++) {
+	t_quad c = sbrk[k];
+	if ((c >= 0x00000080U) || (c == '"') || (c == eolq)) {
+	  throw Exception ("csv-error", "invalid csv break sequence", sbrk);
+	}
+	d_stbl[c] = true;
+      }
+    }
+    // flush the byte window into the stream
+    void flush (void) {
+      if (d_wpos < d_wlen) p_is->pushback (&p_wbuf[d_wpos], d_wlen - d_wpos);
+      d_wpos = 0L;
+      d_wlen = 0L;
+    }
+    // fill the byte window
+    bool fill (void) {
+      if (d_wpos < d_wlen) return true;
+      d_wpos = 0L;
+      d_wlen = p_is->copy (p_wbuf, d_wsiz);
+      if (d_wsiz < d_wmax) d_wsiz *= 2L;
+      if (d_wlen <= 0L) {
+	d_wlen = 0L;
+	return false;
+      }
+      return true;
+    }
+    // @return true if the tokenizer is valid
+    bool valid (void) {
+      return (d_wpos < d_wlen) || p_is->valid ();
+    }
+    // get the next byte without consuming it or -1 at the end
+    int peek (void) {
+      return (fill () == false) ? -1 : (t_byte) p_wbuf[d_wpos];
+    }
+    // get the next byte or -1 at the end
+    int getc (void) {
+      return (fill () == false) ? -1 : (t_byte) p_wbuf[d_wpos++];
+    }
+    // add a byte to the record buffer
+    void radd (const char c) {
+      if (d_rlen + 1L >= d_rsiz) {
+	long rsiz = d_rsiz * 2L;
+	char* rbuf = new char[rsiz];
+	for (long k = 0L; k < d_rlen; k++) rbuf[k] = p_rbuf[k];
+	delete [] p_rbuf;
+	p_rbuf = rbuf;
+	d_rsiz = rsiz;
+      }
+      p_rbuf[d_rlen++] = c;
+    }
+    // open a new field
+    s_cfld& open (const bool qflg) {
+      if (d_flen >= d_fsiz) {
+	long fsiz = d_fsiz * 2L;
+	s_cfld* flds = new s_cfld[fsiz];
+	for (long k = 0L; k < d_flen; k++) flds[k] = p_flds[k];
+	delete [] p_flds;
+	p_flds = flds;
+	d_fsiz = fsiz;
+      }
+      s_cfld& fld = p_flds[d_flen++];
+      fld.d_foff = d_rlen;
+      fld.d_flen = 0L;
+      fld.d_qflg = qflg;
+      fld.d_aflg = true;
+      return fld;
+    }
+    // close a field - the unquoted field is stripped
+    void close (s_cfld& fld) {
+      if (fld.d_qflg == false) {
+	while ((d_rlen > fld.d_foff) && csv_is_blnk (p_rbuf[d_rlen-1])) d_rlen--;
+      }
+      fld.d_flen = d_rlen - fld.d_foff;
+      for (long k = fld.d_foff; k < d_rlen; k++) {
+	if ((t_byte) p_rbuf[k] >= 0x80) {
+	  fld.d_aflg = false;
+	  break;
+	}
+      }
+      radd (nilc);
+    }
+    // read the rest of a quoted field
+    void rdqf (void) {
+      while (true) {
+	int c = getc ();
+	if (c == -1) {
+	  throw Exception ("csv-error", "unterminated quoted field");
+	}
+	if (c == '"') {
+	  if (peek () != '"') break;
+	  getc ();
+	}
+	if (c == eolc) d_lnum++;
+	radd ((char) c);
+      }
+    }
+    // read a field and return true at the end of the record
+    bool rdfld (void) {
+      // skip the leading blanks
+      int c = getc ();
+      while ((c != -1) && (d_stbl[c] == false) && csv_is_blnk (c)) c = getc ();
+      // check for a quoted field
+      bool qflg = (c == '"');
+      s_cfld& fld = open (qflg);
+      if (qflg == true) {
+	rdqf ();
+	c = getc ();
+      }
+      // read until the end of field
+      while (true) {
+	if (c == -1) {
+	  close (fld);
+	  return true;
+	}
+	if (c == eolc) {
+	  d_lnum++;
+	  close (fld);
+	  return true;
+	}
+	if (d_stbl[c] == true) {
+	  close (fld);
+	  return false;
+	}
+	if ((qflg == false) || (csv_is_blnk (c) == false)) radd ((char) c);
+	// scan the window bytes
+	while (d_wpos < d_wlen) {
+	  char b = p_wbuf[d_wpos];
+	  if ((b == eolc) || (d_stbl[(t_byte) b] == true)) break;
+	  if ((qflg == false) || (csv_is_blnk (b) == false)) radd (b);
+	  d_wpos++;
+	}
+	c = getc ();
+      }
+    }
+    // read the next record - the blank records are skipped
+    bool next (void) {
+      while (true) {
+	d_rlen = 0L;
+	d_flen = 0L;
+	d_rnum = d_lnum + 1L;
+	if (peek () == -1) return false;
+	// read the record fields
+	while (rdfld () == false);
+	// remove the empty trailing fields
+	while ((d_flen > 0L) && (p_flds[d_flen-1].d_flen == 0L) &&
+	       (p_flds[d_flen-1].d_qflg == false)) d_flen--;
+	if (d_flen > 0L) return true;
+      }
+    }
+    // @return true if a field is nil
+    bool isnil (const long fidx) const {
+      const s_cfld& fld = p_flds[fidx];
+      return (fld.d_flen == 0L) && (fld.d_qflg == false);
+    }
+    // map a field to a string
+    String tostr (const long fidx) const {
+      const s_cfld& fld = p_flds[fidx];
+      const char* s = &p_rbuf[fld.d_foff];
+      if (fld.d_aflg == true) return String (s);
+      t_quad* sbuf = (p_is->getemod () == Encoding::EMOD_UTF8) ?
+	Unicode::decode (Encoding::EMOD_UTF8, s, fld.d_flen) :
+	p_is->encode (s, fld.d_flen);
+      String result = sbuf;
+      delete [] sbuf;
+      return result;
+    }
+    // get a field type with its fast value
+    t_ctyp totype (const long fidx, bool& bval, long& ival,
+		   t_real& rval) const {
+      const s_cfld& fld = p_flds[fidx];
+      if (fld.d_qflg == true) return CTYP_OTHR;
+      long flen = fld.d_flen;
+      if (flen == 0L) return CTYP_NILL;
+      const char* s = &p_rbuf[fld.d_foff];
+      // check for a boolean
+      if ((flen == 4L) && (s[0] == 't') && (s[1] == 'r') && (s[2] == 'u') &&
+	  (s[3] == 'e')) {
+	bval = true;
+	return CTYP_BOOL;
+      }
+      if ((flen == 5L) && (s[0] == 'f') && (s[1] == 'a') && (s[2] == 'l') &&
+	  (s[3] == 's') && (s[4] == 'e')) {
+	bval = false;
+	return CTYP_BOOL;
+      }
+      // check for an integer
+      long i = ((s[0] == '+') || (s[0] == '-')) ? 1L : 0L;
+      long dpos = i;
+      while ((i < flen) && (s[i] >= '0') && (s[i] <= '9')) i++;
+      long ndig = i - dpos;
+      if (ndig == 0L) return CTYP_OTHR;
+      if (i == flen) {
+	if (ndig > CSV_IDIG_MAX) return CTYP_OTHR;
+	long lval = 0L;
+	for (long k = dpos; k < flen; k++) lval = lval * 10L + (s[k] - '0');
+	ival = (s[0] == '-') ? -lval : lval;
+	return CTYP_INTG;
+      }
+      // check for a real
+      if (s[i++] != '.') return CTYP_OTHR;
+      long fpos = i;
+      while ((i < flen) && (s[i] >= '0') && (s[i] <= '9')) i++;
+      if (i == fpos) return CTYP_OTHR;
+      if ((i < flen) && ((s[i] == 'e') || (s[i] == 'E'))) {
+	i++;
+	if ((i < flen) && ((s[i] == '+') || (s[i] == '-'))) i++;
+	long epos = i;
+	while ((i < flen) && (s[i] >= '0') && (s[i] <= '9')) i++;
+	if (i == epos) return CTYP_OTHR;
+      }
+      if (i != flen) return CTYP_OTHR;
+      bool status = false;
+      rval = c_atod (s, status);
+      return (status == true) ? CTYP_REAL : CTYP_OTHR;
+    }
+    // map a field to an object
+    Object* toobject (const long fidx, const Vector& locv) const {
+      // check for a locale
+      long llen = locv.length ();
+      Locale* lo = dynamic_cast <Locale*> ((fidx < llen) ? locv.get (fidx) :
+					   nullptr);
+      if (lo != nullptr) {
+	return isnil (fidx) ? nullptr : lo->toobject (tostr (fidx));
+      }
+      // check for a fast literal
+      bool bval = false; long ival = 0L; t_real rval = 0.0;
+      switch (totype (fidx, bval, ival, rval)) {
+      case CTYP_NILL:
+	return nullptr;
+      case CTYP_BOOL:
+	return new Boolean (bval);
+      case CTYP_INTG:
+	return new Integer (ival);
+      case CTYP_REAL:
+	return new Real (rval);
+      default:
+	break;
+      }
+      // check for another literal
+      const s_cfld& fld = p_flds[fidx];
+      if ((fld.d_qflg == false) && csv_is_lbyt (p_rbuf[fld.d_foff])) {
+	return csv_new_lobj (tostr (fidx));
+      }
+      return new String (tostr (fidx));
+    }
+  };
+
+  // the csv column - a column is a typed bundle as long as it holds
+  // booleans, integers or reals of the same type, or a vector of literals
+  struct s_ccol {
+    // the column type
+    t_ctyp  d_ctyp;
+    // the column bundle
+    Bundle* p_bndl;
+    // the column vector
+    Vector* p_cvec;
+    // the column length
+    long    d_clen;
+    // the number of literals
+    long    d_llen;
+    // create an empty column
+    s_ccol (void) {
+      d_ctyp = CTYP_NILL;
+      p_bndl = nullptr;
+      p_cvec = nullptr;
+      d_clen = 0L;
+      d_llen = 0L;
+    }
+    // destroy this column
+    ~s_ccol (void) {
+      Object::dref (p_bndl);
+      Object::dref (p_cvec);
+    }
+    // convert this column to a vector
+    void tovec (void) {
+      if (p_cvec != nullptr) return;
+      Object::iref (p_cvec = new Vector);
+      for (long k = 0L; k < d_clen; k++) p_cvec->add (p_bndl->get (k));
+      Object::dref (p_bndl); p_bndl = nullptr;
+      d_ctyp = CTYP_OTHR;
+    }
+    // check for a typed column
+    bool istyped (const t_ctyp ctyp) {
+      if (p_cvec != nullptr) return false;
+      if (d_clen == 0L) {
+	d_ctyp = ctyp;
+	Object::iref (p_bndl = new Bundle);
+	return true;
+      }
+      if (d_ctyp == ctyp) return true;
+      tovec ();
+      return false;
+    }
+    // pad this column with nil
+    void pad (const long rows) {
+      if (d_clen >= rows) return;
+      tovec ();
+      while (d_clen < rows) {
+	p_cvec->add (nullptr);
+	d_clen++;
+      }
+    }
+    // add a boolean to this column
+    void add (const bool bval) {
+      if (istyped (CTYP_BOOL) == true) {
+	p_bndl->add (bval);
       } else {
-	form->add (lobj);
+	p_cvec->add (new Boolean (bval));
       }
+      d_clen++; d_llen++;
     }
-    return form;
-  }
+    // add an integer to this column
+    void add (const long ival) {
+      if (istyped (CTYP_INTG) == true) {
+	p_bndl->add (ival);
+      } else {
+	p_cvec->add (new Integer (ival));
+      }
+      d_clen++; d_llen++;
+    }
+    // add a real to this column
+    void add (const t_real rval) {
+      if (istyped (CTYP_REAL) == true) {
+	p_bndl->add (rval);
+      } else {
+	p_cvec->add (new Real (rval));
+      }
+      d_clen++; d_llen++;
+    }
+    // add an object to this column
+    void add (Object* obj) {
+      // check for a typed literal
+      Boolean* bobj = dynamic_cast <Boolean*> (obj);
+      if (bobj != nullptr) {
+	bool bval = bobj->tobool ();
+	Object::cref (obj);
+	add (bval);
+	return;
+      }
+      Integer* iobj = dynamic_cast <Integer*> (obj);
+      if (iobj != nullptr) {
+	long ival = iobj->tolong ();
+	Object::cref (obj);
+	add (ival);
+	return;
+      }
+      Real* zobj = dynamic_cast <Real*> (obj);
+      if (zobj != nullptr) {
+	t_real rval = zobj->toreal ();
+	Object::cref (obj);
+	add (rval);
+	return;
+      }
+      // add the object to the vector
+      tovec ();
+      p_cvec->add (obj);
+      d_clen++;
+      if (obj != nullptr) d_llen++;
+    }
+    // add a field to this column
+    void add (const s_clex& clex, const long fidx, const Vector& locv) {
+      // check for a locale
+      if (fidx < locv.length ()) {
+	add (clex.toobject (fidx, locv));
+	return;
+      }
+      // check for a fast literal
+      bool bval = false; long ival = 0L; t_real rval = 0.0;
+      switch (clex.totype (fidx, bval, ival, rval)) {
+      case CTYP_NILL:
+	add ((Object*) nullptr);
+	break;
+      case CTYP_BOOL:
+	add (bval);
+	break;
+      case CTYP_INTG:
+	add (ival);
+	break;
+      case CTYP_REAL:
+	add (rval);
+	break;
+      default:
+	add (clex.toobject (fidx, locv));
+	break;
+      }
+    }
+    // @return the column object
+    Object* getcol (void) const {
+      if (p_bndl != nullptr) return p_bndl;
+      return p_cvec;
+    }
+  };
+
+  // the csv column table
+  struct s_ctbl {
+    // the column array
+    s_ccol** p_cols;
+    // the column array size
+    long     d_csiz;
+    // the number of columns
+    long     d_clen;
+    // create an empty table
+    s_ctbl (void) {
+      p_cols = nullptr;
+      d_csiz = 0L;
+      d_clen = 0L;
+    }
+    // destroy this table
+    ~s_ctbl (void) {
+      for (long k = 0L; k < d_clen; k++) delete p_cols[k];
+      delete [] p_cols;
+    }
+    // add a row from a tokenizer
+    void add (const s_clex& clex, const long rows, const Vector& locv) {
+      // add the new columns
+      long flen = clex.d_flen;
+      if (flen > d_csiz) {
+	long csiz = (d_csiz == 0L) ? CSV_FLDS_SIZE : d_csiz * 2L;
+	while (flen > csiz) csiz *= 2L;
+	s_ccol** cols = new s_ccol*[csiz];
+	for (long k = 0L; k < d_clen; k++) cols[k] = p_cols[k];
+	delete [] p_cols;
+	p_cols = cols;
+	d_csiz = csiz;
+      }
+      while (d_clen < flen) {
+	s_ccol* col = new s_ccol;
+	col->pad (rows);
+	p_cols[d_clen++] = col;
+      }
+      // add the fields and pad the short row
+      for (long k = 0L; k < flen; k++) p_cols[k]->add (clex, k, locv);
+      for (long k = flen; k < d_clen; k++) p_cols[k]->pad (rows + 1L);
+    }
+    // @return the column vector
+    Vector* tovec (void) const {
+      // remove the trailing nil columns
+      long clen = d_clen;
+      while ((clen > 0L) && (p_cols[clen-1]->d_llen == 0L)) clen--;
+      // collect the columns
+      Vector* result = new Vector;
+      for (long k = 0L; k < clen; k++) result->add (p_cols[k]->getcol ());
+      return result;
+    }
+  };
 
   // -------------------------------------------------------------------------
   // - object section                                                        -
@@ -123,6 +630,7 @@ namespace afnix {
     p_is   = nullptr;
     d_lnum = CSV_LNUM_DEF;    
     d_sbrk = CSV_SBRK_DEF;
+    p_clex = nullptr;
   }
 
   // create a csv reader by stream
@@ -131,6 +639,7 @@ namespace afnix {
     Object::iref (p_is = is);
     d_lnum = CSV_LNUM_DEF;    
     d_sbrk = CSV_SBRK_DEF;
+    p_clex = nullptr;
   }
   
   // create a csv reader by stream name
@@ -140,6 +649,7 @@ namespace afnix {
     d_name = name;
     d_lnum = CSV_LNUM_DEF;
     d_sbrk = CSV_SBRK_DEF;
+    p_clex = nullptr;
   }
 
   // create a csv reader by stream and break sequence
@@ -148,6 +658,7 @@ namespace afnix {
     Object::iref (p_is = is);
     d_lnum = CSV_LNUM_DEF;    
     d_sbrk = sbrk;
+    p_clex = nullptr;
   }
 
   // create a csv reader by stream, break sequence and locale
@@ -157,6 +668,7 @@ namespace afnix {
     d_lnum = CSV_LNUM_DEF;    
     d_sbrk = sbrk;
     d_locv = locv;
+    p_clex = nullptr;
   }
 
   // create a csv reader by name and break sequence
@@ -166,11 +678,13 @@ namespace afnix {
     d_name = name;
     d_lnum = CSV_LNUM_DEF;
     d_sbrk = sbrk;
+    p_clex = nullptr;
   }
   
   // destroy this csv reader
 
   Csv::~Csv (void) {
+    delete p_clex;
     Object::dref (p_is);
   }
 
@@ -185,7 +699,8 @@ namespace afnix {
   bool Csv::valid (void) const {
     wrlock ();
     try {
-      bool result = (p_is == nullptr) ? false : p_is->valid ();
+      bool result = (p_is == nullptr) ? false :
+	(p_clex == nullptr) ? p_is->valid () : p_clex->valid ();
       unlock ();
       return result;
     } catch (...) {
@@ -200,17 +715,21 @@ namespace afnix {
     wrlock ();
     Vector* lvec = nullptr;
     try {
-      // read a line from the stream
-      String line = (p_is == nullptr) ? "" : p_is->readln ();
-      if (line.isnil () == true) {
+      // read the next record
+      if (p_is == nullptr) {
 	unlock ();
 	return nullptr;
       }
-      d_lnum++;
-      // split and parse
-      Strvec sv = Strvec::split (line, d_sbrk);
-      // create the form 
-      lvec = csv_new_lvec (sv, d_locv);
+      if (p_clex == nullptr) p_clex = new s_clex (p_is, d_sbrk);
+      if (p_clex->next () == false) {
+	unlock ();
+	return nullptr;
+      }
+      d_lnum = p_clex->d_rnum;
+      // create the literal vector
+      lvec = new Vector;
+      long flen = p_clex->d_flen;
+      for (long k = 0L; k < flen; k++) lvec->add (p_clex->toobject (k, d_locv));
       unlock ();
       return lvec;
     } catch (...) {
@@ -226,17 +745,29 @@ namespace afnix {
     wrlock ();
     Form* form = nullptr;
     try {
-      // read a line from the stream
-      String line = (p_is == nullptr) ? "" : p_is->readln ();
-      if (line.isnil () == true) {
+      // read the next record
+      if (p_is == nullptr) {
 	unlock ();
 	return nullptr;
       }
-      d_lnum++;
-      // split and parse
-      Strvec sv = Strvec::split (line, d_sbrk);
-      // create the form 
-      form = csv_new_form (sv, d_locv); form->setlnum (d_lnum);
+      if (p_clex == nullptr) p_clex = new s_clex (p_is, d_sbrk);
+      if (p_clex->next () == false) {
+	unlock ();
+	return nullptr;
+      }
+      d_lnum = p_clex->d_rnum;
+      // create the form with the non nil fields
+      long flen = p_clex->d_flen;
+      for (long k = 0L; k < flen; k++) {
+	Object* lobj = p_clex->toobject (k, d_locv);
+	if (lobj == nullptr) continue;
+	if (form == nullptr) {
+	  form = new Form (lobj);
+	} else {
+	  form->add (lobj);
+	}
+      }
+      form->setlnum (d_lnum);
       unlock ();
       return form;
     } catch (...) {
@@ -245,6 +776,46 @@ namespace afnix {
       throw;
     }
   }
+
+  // import the remaining rows into a sheet by columns
+
+  long Csv::import (Sheet* sht, const bool hflg) {
+    wrlock ();
+    Vector* cols = nullptr;
+    try {
+      // check for a valid stream and sheet
+      if ((p_is == nullptr) || (sht == nullptr)) {
+	unlock ();
+	return 0L;
+      }
+      if (p_clex == nullptr) p_clex = new s_clex (p_is, d_sbrk);
+      // eventually import the header
+      if ((hflg == true) && (p_clex->next () == true)) {
+	d_lnum = p_clex->d_rnum;
+	long flen = p_clex->d_flen;
+	for (long k = 0L; k < flen; k++) {
+	  sht->addhead (p_clex->toobject (k, d_locv));
+	}
+      }
+      // fill the columns by rows
+      s_ctbl ctbl;
+      long rows = 0L;
+      while (p_clex->next () == true) {
+	d_lnum = p_clex->d_rnum;
+	ctbl.add (*p_clex, rows++, d_locv);
+      }
+      // add the columns to the sheet
+      Object::iref (cols = ctbl.tovec ());
+      sht->addcols (*cols, rows);
+      Object::dref (cols);
+      unlock ();
+      return rows;
+    } catch (...) {
+      Object::dref (cols);
+      unlock ();
+      throw;
+    }
+  }
   
   // get the reader line number
 
@@ -279,6 +850,7 @@ namespace afnix {
   void Csv::setsbrk (const String& sbrk) {
     wrlock ();
     try {
+      if (p_clex != nullptr) p_clex->setsbrk (sbrk);
       d_sbrk = sbrk;
       unlock ();
     } catch (...) {
@@ -319,11 +891,12 @@ namespace afnix {
   // -------------------------------------------------------------------------
 
   // the quark zone
-  static const long QUARK_ZONE_LENGTH = 4;
+  static const long QUARK_ZONE_LENGTH = 5;
   static QuarkZone  zone (QUARK_ZONE_LENGTH);
 
   // the object supported quarks
   static const long QUARK_SPLIT    = zone.intern ("split");
+  static const long QUARK_IMPORT   = zone.intern ("import");
   static const long QUARK_VALIDP   = zone.intern ("valid-p");
   static const long QUARK_SETSBRK  = zone.intern ("set-break-sequence");
   static const long QUARK_GETSBRK  = zone.intern ("get-break-sequence");
@@ -401,12 +974,34 @@ namespace afnix {
     }    
     // dispatch 1 argument
     if (argc == 1) {
+      if (quark == QUARK_IMPORT) {
+	Object* obj = argv->get (0);
+	Sheet*  sht = dynamic_cast <Sheet*> (obj);
+	if (sht == nullptr) {
+	  throw Exception ("type-error", "invalid object with import",
+			   Object::repr (obj));
+	}
+	return new Integer (import (sht, false));
+      }
       if (quark == QUARK_SETSBRK) {
 	String sbrk = argv->getstring (0);
 	setsbrk (sbrk);
 	return nullptr;
       }
     }
+    // dispatch 2 arguments
+    if (argc == 2) {
+      if (quark == QUARK_IMPORT) {
+	Object* obj = argv->get (0);
+	Sheet*  sht = dynamic_cast <Sheet*> (obj);
+	if (sht == nullptr) {
+	  throw Exception ("type-error", "invalid object with import",
+			   Object::repr (obj));
+	}
+	bool hflg = argv->getbool (1);
+	return new Integer (import (sht, hflg));
+      }
+    }
     // check the nameable class
     if (Nameable::isquark (quark, true) == true) {
       return Nameable::apply (zobj, nset, quark, argv);
@@ -37,6 +37,13 @@ namespace afnix {
   /// and tab character. When importing data, a form is returned for each
   /// row in the file. The reading process can start at a certain row and
   /// at another one.
+  /// The reader operates with a byte tokenizer which follows the rfc 4180
+  /// quoting rules. A quoted field can contain separators and line breaks
+  /// and is always mapped to a string. An unquoted field is stripped and
+  /// mapped to a boolean, an integer or a real when possible. The import
+  /// method fills a sheet by columns, with a typed bundle for each column
+  /// of booleans, integers or reals. The first row can be optionally
+  /// imported as the sheet header.
   /// @author amaury darsch
   
   class Csv : public Former, public Nameable {
@@ -51,8 +58,9 @@ namespace afnix {
     String d_name;
     /// the input stream
     InputStream* p_is;
+    /// the csv tokenizer
+    struct s_clex* p_clex;
 
-    
   public:
     /// create a default reader
     Csv (void);
@@ -96,6 +104,12 @@ namespace afnix {
     /// @return a form from this reader
     Form* parse (void);
 
+    /// import the remaining rows into a sheet by columns
+    /// @param sht  the sheet to fill
+    /// @param hflg the header row flag
+    /// @return the number of imported rows
+    long import (class Sheet* sht, const bool hflg);
+
     /// @return an approximate line number
     long getlnum (void) const;
 
@@ -15,11 +15,14 @@
 // ---------------------------------------------------------------------------
 
 #include "Folio.hpp"
+#include "System.hpp"
 #include "Boolean.hpp"
 #include "Integer.hpp"
+#include "InputFile.hpp"
 #include "Evaluable.hpp"
 #include "QuarkZone.hpp"
 #include "Exception.hpp"
+#include "OutputFile.hpp"
 #include "InputStream.hpp"
 #include "OutputStream.hpp"
 
@@ -54,6 +57,16 @@ namespace afnix {
     return true;
   }
 
+  // the folio manifest name
+  static const String SPS_MNAME  = "manifest";
+
+  // this function returns a sheet directory name by index
+  static String folio_sname (const String& path, const long sidx) {
+    String name = "s";
+    name += sidx;
+    return System::join (path, name);
+  }
+
   // -------------------------------------------------------------------------
   // - class section                                                         -
   // -------------------------------------------------------------------------
@@ -175,6 +188,67 @@ namespace afnix {
     }
   }
 
+  // write this folio in a column directory
+
+  void Folio::wrcols (const String& path) const {
+    rdlock ();
+    try {
+      // create the directory
+      if ((System::isdir (path) == false) && (System::mkdir (path) == false)) {
+	throw Exception ("folio-error", "cannot create column directory", path);
+      }
+      // write the manifest
+      OutputFile os (System::join (path, SPS_MNAME));
+      write_folio_magic (os);
+      Saveas::wrstream (os);
+      d_prop.wrstream (os);
+      long slen = length ();
+      Serial::wrlong (slen, os);
+      os.close ();
+      // write the sheet directories
+      for (long k = 0L; k < slen; k++) {
+	Sheet* sheet = get (k);
+	if (sheet == nullptr) {
+	  throw Exception ("folio-error", "invalid nil sheet to write");
+	}
+	sheet->wrcols (folio_sname (path, k));
+      }
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // read a column directory into this folio
+
+  void Folio::rdcols (const String& path) {
+    wrlock ();
+    try {
+      // reset the folio
+      reset ();
+      // read the manifest
+      InputFile is (System::join (path, SPS_MNAME));
+      if (check_folio_magic (&is) == false) {
+	throw Exception ("folio-error", "invalid folio manifest", path);
+      }
+      Saveas::rdstream (is);
+      d_prop.rdstream (is);
+      long slen = Serial::rdlong (is);
+      is.close ();
+      // read the sheet directories
+      for (long k = 0L; k < slen; k++) {
+	Sheet* sheet = new Sheet;
+	d_vsht.add (sheet);
+	sheet->rdcols (folio_sname (path, k));
+      }
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // return the folio property list
 
   Plist Folio::getplist (void) const {
@@ -413,6 +487,29 @@ namespace afnix {
     }
   }
 
+  // get a cell index by column and literal
+
+  Index* Folio::getsidx (const long col, const Literal& lobj) const {
+    Index* indx= new Index;
+    rdlock ();
+    try {
+      // get the folio length and iterate
+      long len = length ();
+      for (long i = 0; i < len; i++) {
+	Sheet* sheet = get (i);
+	if (sheet == nullptr) continue;
+	long ridx = sheet->rfind (col, lobj);
+	if (ridx != -1L) indx->add (col, ridx, i);
+      }
+      unlock ();
+      return indx;
+    } catch (...) {
+      delete indx;
+      unlock ();
+      throw;
+    }
+  }
+
   // find a sheet by tag - the first found is returned
 
   Sheet* Folio::find (const String& tag) const {
@@ -635,7 +732,7 @@ namespace afnix {
   // -------------------------------------------------------------------------
   
   // the quark zone
-  static const long QUARK_ZONE_LENGTH = 21;
+  static const long QUARK_ZONE_LENGTH = 23;
   static QuarkZone  zone (QUARK_ZONE_LENGTH);
 
   // the object supported quarks
@@ -660,6 +757,8 @@ namespace afnix {
   static const long QUARK_LOKPROP = zone.intern ("lookup-property");
   static const long QUARK_GETINDX = zone.intern ("get-index");
   static const long QUARK_GETXREF = zone.intern ("get-xref");
+  static const long QUARK_WRCOLS  = zone.intern ("write-columns");
+  static const long QUARK_RDCOLS  = zone.intern ("read-columns");
 
   // create a new object in a generic way
 
@@ -864,6 +963,16 @@ namespace afnix {
 	throw Exception ("type-error", "invalid object with get-xref",
 			 Object::repr (obj));
       }
+      if (quark == QUARK_WRCOLS) {
+	String path = argv->getstring (0);
+	wrcols (path);
+	return nullptr;
+      }
+      if (quark == QUARK_RDCOLS) {
+	String path = argv->getstring (0);
+	rdcols (path);
+	return nullptr;
+      }
       if (quark == QUARK_WRITE) {
 	Object* obj = argv->get (0);
 	OutputStream* os = dynamic_cast <OutputStream*> (obj);
@@ -877,6 +986,16 @@ namespace afnix {
     }
     // dispatch 2 argument
     if (argc == 2) {
+      if (quark == QUARK_GETINDX) {
+	long      col = argv->getlong (0);
+	Object*   obj = argv->get (1);
+	Literal* lobj = dynamic_cast <Literal*> (obj);
+	if (lobj == nullptr) {
+	  throw Exception ("type-error", "invalid object with get-index",
+			   Object::repr (obj));
+	}
+	return getsidx (col, *lobj);
+      }
       if (quark == QUARK_ADDPROP) {
         String   name = argv->getstring (0);
         Object*   obj = argv->get (1);
@@ -34,6 +34,9 @@ namespace afnix {
   /// The Folio class is a folio of sheets. Because of the sheet format, 
   /// a folio look like a 3-dimensional array of cells. Like the 
   /// sheet, the folio is defined with a name and a vector of sheets.
+  /// A folio can be written in a column directory, with a manifest file
+  /// and one sheet column directory per sheet. When the directory is read,
+  /// the sheet columns are mapped and the records are built on access.
   /// @author amaury darsch
 
   class Folio : public Saveas {
@@ -78,6 +81,14 @@ namespace afnix {
     /// @param is the input stream
     void rdstream (InputStream& os);
 
+    /// write this folio in a column directory
+    /// @param path the directory path
+    void wrcols (const String& path) const;
+
+    /// read a column directory into this folio
+    /// @param path the directory path
+    void rdcols (const String& path);
+
     /// @return the folio property list
     Plist getplist (void) const;
 
@@ -134,6 +145,12 @@ namespace afnix {
     /// @return the sheet index by tag
     Index* getsidx (const String& tag) const;
 
+    /// @return the cell index by column and literal - the first matching
+    /// row of each sheet is returned with the sheet column indexes
+    /// @param col  the column to check
+    /// @param lobj the literal to find
+    Index* getsidx (const long col, const Literal& lobj) const;
+
     /// find a sheet by tag - the first sheet found is returned
     /// @param tag the sheet tag used for filtering
     Sheet* find (const String& tag) const;
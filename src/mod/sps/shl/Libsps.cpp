@@ -16,6 +16,7 @@
 
 #include "Csv.hpp"
 #include "Meta.hpp"
+#include "Column.hpp"
 #include "Spssrl.hxx"
 #include "Libsps.hpp"
 #include "Predsps.hpp"
@@ -45,6 +46,7 @@ namespace afnix {
     nset->symcst ("Sheet",             new Meta (Sheet::mknew));
     nset->symcst ("Folio",             new Meta (Folio::mknew));
     nset->symcst ("Bundle",            new Meta (Bundle::mknew));
+    nset->symcst ("Column",            new Meta (Column::mknew));
     nset->symcst ("Record",            new Meta (Record::mknew));
     nset->symcst ("SpsTransit",        new Meta (SpsTransit::mknew));
 
@@ -56,6 +58,7 @@ namespace afnix {
     nset->symcst ("sheet-p",           new Function (sps_shtp));
     nset->symcst ("folio-p",           new Function (sps_folp));
     nset->symcst ("bundle-p",          new Function (sps_bndp));
+    nset->symcst ("column-p",          new Function (sps_colp));
     nset->symcst ("record-p",          new Function (sps_rcdp));
     nset->symcst ("transit-p",         new Function (sps_tsit));
        
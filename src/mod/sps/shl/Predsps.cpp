@@ -16,6 +16,7 @@
 
 #include "Csv.hpp"
 #include "Cons.hpp"
+#include "Column.hpp"
 #include "Predsps.hpp"
 #include "Boolean.hpp"
 #include "Exception.hpp"
@@ -44,6 +45,15 @@ namespace afnix {
     return new Boolean (result);
   }
 
+  // colp: column object predicate
+
+  Object* sps_colp  (Evaluable* zobj, Nameset* nset, Cons* args) {
+    Object* obj = get_obj (zobj, nset, args, "column-p");
+    bool result =  (dynamic_cast <Column*> (obj) == nullptr) ? false : true;
+    Object::cref (obj);
+    return new Boolean (result);
+  }
+
   // celp: cell object predicate
 
   Object* sps_celp  (Evaluable* zobj, Nameset* nset, Cons* args) {
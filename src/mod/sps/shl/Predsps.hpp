@@ -33,6 +33,12 @@ namespace afnix {
   /// @param args the arguments list
   Object* sps_bndp (Evaluable* zobj, Nameset* nset, Cons* args);
 
+  /// the column object predicate
+  /// @param zobj the current evaluable
+  /// @param nset the current nameset
+  /// @param args the arguments list
+  Object* sps_colp (Evaluable* zobj, Nameset* nset, Cons* args);
+
   /// the cell object predicate
   /// @param zobj the current evaluable
   /// @param nset the current nameset
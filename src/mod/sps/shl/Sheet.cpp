@@ -14,13 +14,20 @@
 // - copyright (c) 1999-2021 amaury darsch                                   -
 // ---------------------------------------------------------------------------
 
+#include "Real.hpp"
 #include "Sheet.hpp"
+#include "Column.hpp"
+#include "Sorter.hpp"
+#include "System.hpp"
 #include "Spssid.hxx"
 #include "Boolean.hpp"
 #include "Integer.hpp"
+#include "InputFile.hpp"
+#include "HashTable.hpp"
 #include "Evaluable.hpp"
 #include "QuarkZone.hpp"
 #include "Exception.hpp"
+#include "OutputFile.hpp"
 #include "InputStream.hpp"
 #include "OutputStream.hpp"
 
@@ -30,141 +37,328 @@ namespace afnix {
   // - private section                                                       -
   // -------------------------------------------------------------------------
 
-  class SheetSorter {
-  private:
-    // the column index
-    long d_col;
+  // the sheet manifest magic number
+  static const long   SHT_MSIZE   = 4;
+  static const char   SHT_MAGIC[] = {'\177', 'S', 'P', 'M'};
+  // the sheet manifest name
+  static const String SHT_MNAME   = "manifest";
+
+  // this function returns a column file name by index
+  static String sht_cname (const String& path, const long col) {
+    String name = "c";
+    name += col;
+    name += ".col";
+    return System::join (path, name);
+  }
+
+  // this function computes the maximum between two numbers
+  static inline long max (const long x, const long y) {
+    return (x < y) ? y : x;
+  }
+
+  // the sort key type
+  enum t_skey {
+    SKEY_NONE, // no key
+    SKEY_INTG, // integer key
+    SKEY_REAL, // real key
+    SKEY_STRG, // string key
+    SKEY_OBJT  // object key
+  };
+
+  // the typed sort keys - the column keys are extracted once and the row
+  // indexes are sorted by stable merge with a nil key as the lowest key,
+  // the string keys are normalized and compared in the sorter key order,
+  // a column with mixed key types is compared with the literal operator
+  struct s_skey {
+    // the key type
+    t_skey   d_styp;
     // the sorting mode
-    bool d_mode;
-
-    // compare two objects for ascending order
-    bool cmplth (Object* ref, Object* slv) const {
-      // check that we have a object records
-      Record* rref = dynamic_cast <Record*> (ref);
-      Record* rslv = dynamic_cast <Record*> (slv);
-      // map the cell to their object
-      Object* zobj = nullptr;
-      try {
-	zobj = (rref == nullptr) ? nullptr : rref->map (d_col);
-      } catch (...) {
-	zobj = nullptr;
+    bool     d_mode;
+    // the number of keys
+    long     d_klen;
+    // the nil key flags
+    bool*    p_nkey;
+    // the integer keys
+    t_long*  p_ikey;
+    // the real keys
+    t_real*  p_rkey;
+    // the normalized string keys
+    t_quad** p_skey;
+    // the object keys
+    Literal** p_okey;
+    // the sorted row indexes
+    long*    p_ridx;
+    // create the sort keys by record vector and column
+    s_skey (const Vector& body, const long col, const bool mode) {
+      d_styp = SKEY_NONE;
+      d_mode = mode;
+      d_klen = body.length ();
+      p_nkey = new bool[d_klen];
+      p_ikey = nullptr;
+      p_rkey = nullptr;
+      p_skey = nullptr;
+      p_okey = nullptr;
+      p_ridx = nullptr;
+      // detect the key type
+      Literal** lkey = new Literal*[d_klen];
+      for (long k = 0L; k < d_klen; k++) {
+	Record* rcd = dynamic_cast <Record*> (body.get (k));
+	lkey[k] = ((rcd == nullptr) || (col < 0L)) ? nullptr : rcd->map (col);
+	p_nkey[k] = (lkey[k] == nullptr);
+	if (p_nkey[k] == true) continue;
+	t_skey styp = SKEY_NONE;
+	if (dynamic_cast <Integer*> (lkey[k]) != nullptr) styp = SKEY_INTG;
+	if (dynamic_cast <Real*>    (lkey[k]) != nullptr) styp = SKEY_REAL;
+	if (dynamic_cast <String*>  (lkey[k]) != nullptr) styp = SKEY_STRG;
+	if ((styp == SKEY_NONE) || ((d_styp != SKEY_NONE) && (styp != d_styp))) {
+	  d_styp = SKEY_OBJT;
+	  break;
+	}
+	d_styp = styp;
       }
-      Object* sobj = nullptr;
-      try {
-	sobj = (rslv == nullptr) ? nullptr : rslv->map (d_col);
-      } catch (...) {
-	sobj = nullptr;
+      // keep the literals as object keys
+      if (d_styp == SKEY_OBJT) {
+	for (long k = 0L; k < d_klen; k++) {
+	  Record* rcd = dynamic_cast <Record*> (body.get (k));
+	  lkey[k] = ((rcd == nullptr) || (col < 0L)) ? nullptr : rcd->map (col);
+	  p_nkey[k] = (lkey[k] == nullptr);
+	}
+	p_okey = lkey;
+	return;
+      }
+      // extract the typed keys
+      if (d_styp == SKEY_INTG) p_ikey = new t_long[d_klen];
+      if (d_styp == SKEY_REAL) p_rkey = new t_real[d_klen];
+      if (d_styp == SKEY_STRG) {
+	p_skey = new t_quad*[d_klen];
+	for (long k = 0L; k < d_klen; k++) p_skey[k] = nullptr;
+      }
+      for (long k = 0L; k < d_klen; k++) {
+	if (p_nkey[k] == true) continue;
+	if (p_ikey != nullptr) p_ikey[k] = dynamic_cast<Integer*>(lkey[k])->tolong ();
+	if (p_rkey != nullptr) p_rkey[k] = dynamic_cast<Real*>(lkey[k])->toreal ();
+	if (p_skey != nullptr) {
+	  p_skey[k] = Sorter::tonkey (*dynamic_cast<String*>(lkey[k]));
+	}
+      }
+      delete [] lkey;
+    }
+    // destroy the sort keys
+    ~s_skey (void) {
+      delete [] p_nkey;
+      delete [] p_ikey;
+      delete [] p_rkey;
+      if (p_skey != nullptr) {
+	for (long k = 0L; k < d_klen; k++) delete [] p_skey[k];
       }
-      // compare with operator
-      if (zobj == nullptr) return true;
-      Object*   obj = zobj->oper (Object::OPER_LTH, sobj);
+      delete [] p_skey;
+      delete [] p_okey;
+      delete [] p_ridx;
+    }
+    // @return true if a key is strictly lower than another one
+    bool lth (const long x, const long y) const {
+      if (p_nkey[y] == true) return false;
+      if (p_nkey[x] == true) return true;
+      if (p_ikey != nullptr) return p_ikey[x] < p_ikey[y];
+      if (p_rkey != nullptr) return p_rkey[x] < p_rkey[y];
+      if (p_skey != nullptr) return Sorter::nkeylth (p_skey[x], p_skey[y]);
+      Object*  obj = p_okey[x]->oper (Object::OPER_LTH, p_okey[y]);
       Boolean* bobj = dynamic_cast <Boolean*> (obj);
-      bool result   = (bobj == nullptr) ? false : bobj->tobool ();
+      bool result = (bobj == nullptr) ? false : bobj->tobool ();
       Object::cref (obj);
       return result;
     }
-
-    // compare two objects for descending order
-    bool cmpgth (Object* ref, Object* slv) const {
-      // check that we have a object records
-      Record* rref = dynamic_cast <Record*> (ref);
-      Record* rslv = dynamic_cast <Record*> (slv);
-      // map the cell to their object
-      Object* zobj = nullptr;
-      try {
-	zobj = (rref == nullptr) ? nullptr : rref->map (d_col);
-      } catch (...) {
-	zobj = nullptr;
-      }
-      Object* sobj = nullptr;
+    // @return true if a row goes strictly before another one
+    bool before (const long x, const long y) const {
+      return d_mode ? lth (x, y) : lth (y, x);
+    }
+    // sort the row indexes
+    void sort (void) {
+      p_ridx = new long[d_klen];
+      long* rbuf = new long[d_klen];
+      for (long k = 0L; k < d_klen; k++) p_ridx[k] = k;
       try {
-	sobj = (rslv == nullptr) ? nullptr : rslv->map (d_col);
+	// merge the runs by increasing width
+	for (long w = 1L; w < d_klen; w *= 2L) {
+	  for (long lo = 0L; lo < d_klen; lo += 2L * w) {
+	    long mi = (lo + w < d_klen) ? lo + w : d_klen;
+	    long hi = (lo + 2L * w < d_klen) ? lo + 2L * w : d_klen;
+	    long i = lo, j = mi, k = lo;
+	    while ((i < mi) && (j < hi)) {
+	      rbuf[k++] = before (p_ridx[j], p_ridx[i]) ? p_ridx[j++] : p_ridx[i++];
+	    }
+	    while (i < mi) rbuf[k++] = p_ridx[i++];
+	    while (j < hi) rbuf[k++] = p_ridx[j++];
+	  }
+	  long* t = p_ridx; p_ridx = rbuf; rbuf = t;
+	}
+	delete [] rbuf;
       } catch (...) {
-	sobj = nullptr;
+	delete [] rbuf;
+	throw;
       }
-      // compare with operator
-      if ((zobj == nullptr) && (sobj == nullptr)) return true;
-      if ((zobj == nullptr) && (sobj != nullptr)) return false;
-      Object*   obj = zobj->oper (Object::OPER_GTH, sobj);
-      Boolean* bobj = dynamic_cast <Boolean*> (obj);
-      bool result   = (bobj == nullptr) ? false : bobj->tobool ();
-      Object::cref (obj);
-      return result;
     }
+  };
 
-    // partition the vector and returns the pivot index
-
-    long partition (Vector& argv, const long first, const long last) const {
-      // initialize the pivot index, last index and next (unknown) index
-      long pidx = first;
-      long lidx = first;
-      long uidx = lidx + 1;
-      // get the pivot object - and protect it
-      Object* pvt = Object::iref (argv.get (pidx));
-      // swap until we have reached the last element
-      while (uidx <= last) {
-	Object* ref = Object::iref (argv.get (uidx));
-	bool   cflg = d_mode ? cmplth (ref, pvt) : cmpgth (ref, pvt);
-	if (cflg == true) {
-	  lidx++;
-	  argv.set (uidx, argv.get (lidx));
-	  argv.set (lidx, ref);
+  // the sheet column index - the index maps a cell literal string to the
+  // rows of the column where the literal string is found, in ascending
+  // order, so that the literals with the same string are kept apart
+  struct s_cidx {
+    // the indexed column
+    long    d_col;
+    // the valid flag
+    bool    d_vflg;
+    // the literal table
+    HashTable d_ltbl;
+    // the next index
+    s_cidx* p_next;
+    // create a column index
+    s_cidx (const long col, s_cidx* next) {
+      d_col  = col;
+      d_vflg = false;
+      p_next = next;
+    }
+    // destroy this index
+    ~s_cidx (void) {
+      delete p_next;
+    }
+    // invalidate this index
+    void reset (void) {
+      d_ltbl.reset ();
+      d_vflg = false;
+    }
+    // @return the position of a row in a row vector or -1
+    static long rpos (const Vector* rvec, const long row) {
+      long rlen = (rvec == nullptr) ? 0L : rvec->length ();
+      for (long k = 0L; k < rlen; k++) {
+	if (rvec->getlong (k) == row) return k;
+      }
+      return -1L;
+    }
+    // index a record by row
+    void add (const Record* rcd, const long row) {
+      if (d_vflg == false) return;
+      Literal* lobj = (rcd == nullptr) ? nullptr : rcd->map (d_col);
+      if (lobj == nullptr) return;
+      String key = lobj->tostring ();
+      Vector* rvec = dynamic_cast <Vector*> (d_ltbl.get (key));
+      if (rvec == nullptr) {
+	d_ltbl.add (key, rvec = new Vector);
+      }
+      if (rpos (rvec, row) != -1L) return;
+      // insert the row in order
+      long rlen = rvec->length ();
+      long rins = rlen;
+      while ((rins > 0L) && (rvec->getlong (rins - 1L) > row)) rins--;
+      if (rins == rlen) {
+	rvec->add (new Integer (row));
+      } else {
+	rvec->add (rins, new Integer (row));
+      }
+    }
+    // remove a record literal by row
+    void remove (const Literal* lobj, const long row) {
+      if ((d_vflg == false) || (lobj == nullptr)) return;
+      Vector* rvec = dynamic_cast <Vector*> (d_ltbl.get (lobj->tostring ()));
+      if (rpos (rvec, row) != -1L) reset ();
+    }
+    // remove a row and shift the following ones
+    void remove (const long row) {
+      if (d_vflg == false) return;
+      long tlen = d_ltbl.length ();
+      for (long k = 0L; k < tlen; k++) {
+	Vector* rvec = dynamic_cast <Vector*> (d_ltbl.getobj (k));
+	long rlen = (rvec == nullptr) ? 0L : rvec->length ();
+	for (long i = 0L; i < rlen; i++) {
+	  Integer* iobj = dynamic_cast <Integer*> (rvec->get (i));
+	  if (iobj == nullptr) continue;
+	  long ridx = iobj->tolong ();
+	  if (ridx == row) {
+	    reset ();
+	    return;
+	  }
+	  if (ridx > row) *iobj = ridx - 1L;
 	}
-	Object::tref (ref);
-	// the intel is in the other region
-	uidx++;
       }
-      // place the pivot in proper position
-      argv.set (first, argv.get (lidx));
-      argv.set (lidx,  pvt);
-      Object::tref (pvt);
-      // the pivot index is now the last index
-      return lidx;
     }
-    
-    // this function performs a recursive quick sort
-
-    void quicksort (Vector& argv, const long first, const long last) const {
-      if (first >= last) return;
-      long pidx = partition (argv, first, last);
-      quicksort (argv, first, pidx - 1);
-      quicksort (argv, pidx + 1, last);
+    // build this index with a sheet
+    void build (const Sheet& sht) {
+      d_ltbl.reset ();
+      d_vflg = true;
+      long slen = sht.length ();
+      for (long row = 0L; row < slen; row++) add (sht.get (row), row);
+    }
+    // find a row by literal among the indexed rows - the stale flag is
+    // set if an indexed row does not hold the literal string anymore
+    long rfind (const Sheet& sht, const Literal& lobj, const String& key,
+		bool& sflg) const {
+      sflg = false;
+      Vector* rvec = dynamic_cast <Vector*> (d_ltbl.get (key));
+      long rlen = (rvec == nullptr) ? 0L : rvec->length ();
+      for (long k = 0L; k < rlen; k++) {
+	long row = rvec->getlong (k);
+	Record* rcd = sht.get (row);
+	if ((rcd != nullptr) && (rcd->isequal (d_col, lobj) == true)) {
+	  return row;
+	}
+	// a literal with the same string is a collision, not a stale row
+	Literal* cobj = (rcd == nullptr) ? nullptr : rcd->map (d_col);
+	if ((cobj == nullptr) || (cobj->tostring () != key)) sflg = true;
+      }
+      return -1L;
+    }
+    // find a row by literal
+    long find (const Sheet& sht, const Literal& lobj) {
+      if (d_vflg == false) build (sht);
+      String key = lobj.tostring ();
+      bool  sflg = false;
+      long result = rfind (sht, lobj, key, sflg);
+      if (sflg == false) return result;
+      // rebuild a stale index and check the rows again
+      build (sht);
+      return rfind (sht, lobj, key, sflg);
+    }
+    // invalidate all indexes
+    void rstall (void) {
+      for (s_cidx* cidx = this; cidx != nullptr; cidx = cidx->p_next) {
+	cidx->reset ();
+      }
     }
-
-  public:
-    // create a default sheet sorter
-    SheetSorter (void) {
-      d_col  = 0;
-      d_mode = false;
+    // index a record by row in all indexes
+    void addall (const Record* rcd, const long row) {
+      for (s_cidx* cidx = this; cidx != nullptr; cidx = cidx->p_next) {
+	cidx->add (rcd, row);
+      }
     }
-
-    // create a sorting object by index
-    SheetSorter (const long col, const bool mode) {
-      d_col  = col;
-      d_mode = mode;
+    // remove a row in all indexes
+    void rmall (const long row) {
+      for (s_cidx* cidx = this; cidx != nullptr; cidx = cidx->p_next) {
+	cidx->remove (row);
+      }
     }
-
-    // sort a vector
-
-    void qsort (Vector& argv) const {
-      // sort the vector in place
-      argv.wrlock ();
-      try {
-	long argc = argv.length ();
-	quicksort (argv, 0, argc - 1);
-	argv.unlock ();
-      } catch (...) {
-	argv.unlock ();
-	throw;
+    // remove a record by row in all indexes
+    void rmall (const Record* rcd, const long row) {
+      if (rcd == nullptr) return;
+      for (s_cidx* cidx = this; cidx != nullptr; cidx = cidx->p_next) {
+	cidx->remove (rcd->map (cidx->d_col), row);
       }
     }
+    // copy the index columns
+    s_cidx* copy (void) const {
+      s_cidx* next = (p_next == nullptr) ? nullptr : p_next->copy ();
+      return new s_cidx (d_col, next);
+    }
+    // get an index by column
+    s_cidx* get (const long col) {
+      s_cidx* cidx = this;
+      while (cidx != nullptr) {
+	if (cidx->d_col == col) return cidx;
+	cidx = cidx->p_next;
+      }
+      return nullptr;
+    }
   };
 
-  // this function computes the maximum between two numbers
-  static inline long max (const long x, const long y) {
-    return (x < y) ? y : x;
-  }
-
   // -------------------------------------------------------------------------
   // - class section                                                         -
   // -------------------------------------------------------------------------
@@ -172,26 +366,34 @@ namespace afnix {
   // create a nil sheet
 
   Sheet::Sheet (void) {
+    p_cidx = nullptr;
     reset ();
   }
 
   // create a new sheet by name
 
   Sheet::Sheet (const String& name) : Saveas (name) {
+    p_cidx = nullptr;
     reset ();
   }
 
   // create a new sheet by name and info
 
   Sheet::Sheet (const String& name, const String& info) : Saveas (name, info) {
+    p_cidx = nullptr;
     reset ();
   }
 
   // copy construct this sheet
 
   Sheet::Sheet (const Sheet& that) {
+    d_poff = 0L;
+    d_plen = 0L;
+    p_cidx = nullptr;
     that.rdlock ();
     try {
+      // copy the index columns
+      if (that.p_cidx != nullptr) p_cidx = that.p_cidx->copy ();
       // copy the base taggable
       Saveas::operator = (that);
       // copy locally
@@ -218,6 +420,12 @@ namespace afnix {
     }
   }
 
+  // destroy this sheet
+
+  Sheet::~Sheet (void) {
+    delete p_cidx;
+  }
+
   // return the object name
 
   String Sheet::repr (void) const {
@@ -261,7 +469,8 @@ namespace afnix {
       d_head.wrstream (os);
       // save the footer
       d_foot.wrstream (os);
-      // save the vector
+      // build the packed records and save the vector
+      unpack ();
       d_body.wrstream (os);
       unlock ();
     } catch (...) {
@@ -290,7 +499,11 @@ namespace afnix {
       // get the footer
       d_foot.rdstream (is);
       // get the vector
+      d_cols.reset ();
+      d_poff = 0L;
+      d_plen = 0L;
       d_body.rdstream (is);
+      if (p_cidx != nullptr) p_cidx->rstall ();
       unlock ();
     } catch (...) {
       unlock ();
@@ -308,6 +521,9 @@ namespace afnix {
     that.rdlock ();
     try {
       reset ();
+      // assign the index columns
+      delete p_cidx;
+      p_cidx = (that.p_cidx == nullptr) ? nullptr : that.p_cidx->copy ();
       // assign base object
       Saveas::operator = (that);
       // assign locally
@@ -348,6 +564,10 @@ namespace afnix {
       d_head.reset ();
       d_foot.reset ();
       d_body.reset ();
+      d_cols.reset ();
+      d_poff = 0L;
+      d_plen = 0L;
+      if (p_cidx != nullptr) p_cidx->rstall ();
       unlock ();
     } catch (...) {
       unlock ();
@@ -362,11 +582,13 @@ namespace afnix {
     try {
       d_sign = "";
       d_mark.clear ();
+      unpack ();
       long blen = d_body.length ();
       for (long k = 0L; k < blen; k++) {
 	Record* rcd = get (k);
 	if (rcd != nullptr) rcd->clear ();
       }
+      if (p_cidx != nullptr) p_cidx->rstall ();
       unlock ();
     } catch (...) {
       unlock ();
@@ -796,10 +1018,10 @@ namespace afnix {
     try {
       // get the sheet length
       long tlen = length ();
-      // compute the maximum columns
-      long result = 0;
+      // compute the maximum columns - without building the packed records
+      long result = (d_plen == 0L) ? 0L : d_cols.length ();
       for (long i = 0; i < tlen; i++) {
-	Record* rcd = get (i);
+	Record* rcd = dynamic_cast <Record*> (d_body.get (i));
 	if (rcd == nullptr) continue;
 	result = max (result, rcd->length ());
       }
@@ -817,7 +1039,9 @@ namespace afnix {
     if (rcd == nullptr) return;
     wrlock ();
     try {
+      long row = d_body.length ();
       d_body.add (rcd);
+      if (p_cidx != nullptr) p_cidx->addall (rcd, row);
       unlock ();
     } catch (...) {
       unlock ();
@@ -830,7 +1054,7 @@ namespace afnix {
   Record* Sheet::get (const long index) const {
     rdlock ();
     try {
-      Record* result = dynamic_cast <Record*> (d_body.get (index));
+      Record* result = unpack (index);
       unlock ();
       return result;
     } catch (...) {
@@ -880,7 +1104,9 @@ namespace afnix {
   void Sheet::set (const long index, Record* rcd) {
     wrlock ();
     try {
+      if (p_cidx != nullptr) p_cidx->rmall (get (index), index);
       d_body.set (index, rcd);
+      if (p_cidx != nullptr) p_cidx->addall (rcd, index);
       unlock ();
     } catch (...) {
       unlock ();
@@ -900,8 +1126,12 @@ namespace afnix {
       }
       // get the record
       Record* rcd = get (row);
+      // update the column index
+      s_cidx* cidx = (p_cidx == nullptr) ? nullptr : p_cidx->get (col);
+      if (cidx != nullptr) cidx->remove (rcd->map (col), row);
       // set the cell
       Cell* cell = rcd->set (col, object);
+      if (cidx != nullptr) cidx->add (rcd, row);
       unlock ();
       return cell;
     } catch (...) {
@@ -919,7 +1149,9 @@ namespace afnix {
     Record* rcd = new Record;
     try {
       for (long i = 0; i < argc; i++) rcd->add (argv->get (i));
+      long row = d_body.length ();
       d_body.add (rcd);
+      if (p_cidx != nullptr) p_cidx->addall (rcd, row);
       unlock ();
     } catch (...) {
       Object::cref (rcd);
@@ -928,12 +1160,36 @@ namespace afnix {
     }
   }
 
+  // add a vector of packed columns
+
+  void Sheet::addcols (const Vector& cols, const long rows) {
+    if (rows <= 0L) return;
+    wrlock ();
+    try {
+      // build the previous packed records
+      unpack ();
+      // bind the columns and reserve the rows
+      d_cols = cols;
+      d_poff = d_body.length ();
+      d_plen = rows;
+      for (long k = 0L; k < rows; k++) d_body.add (nullptr);
+      if (p_cidx != nullptr) p_cidx->rstall ();
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // remove a record by index
 
   void Sheet::remove (const long index) {
     wrlock ();
     try {
+      unpack ();
       d_body.remove (index);
+      if (p_cidx != nullptr) p_cidx->rmall (index);
+      unlock ();
     } catch (...) {
       unlock ();
       throw;
@@ -1031,10 +1287,17 @@ namespace afnix {
   void Sheet::sort (const long col, const bool mode) {
     wrlock ();
     try {
-      // build the sorter object
-      SheetSorter sorter (col, mode);
-      // sort the vector
-      sorter.qsort (d_body);
+      // build the packed records
+      unpack ();
+      // sort the row indexes by column keys
+      s_skey skey (d_body, col, mode);
+      skey.sort ();
+      Vector body;
+      for (long k = 0L; k < skey.d_klen; k++) {
+	body.add (d_body.get (skey.p_ridx[k]));
+      }
+      d_body = body;
+      if (p_cidx != nullptr) p_cidx->rstall ();
       unlock ();
     } catch (...) {
       unlock ();
@@ -1071,19 +1334,7 @@ namespace afnix {
   bool Sheet::isrow (const long col, const Literal& lobj) const {
     rdlock ();
     try {
-      // get the number of rows
-      long rows = length ();
-      // initialize result
-      bool result = false;
-      // loop in the sheet and check
-      for (long row = 0; row < rows; row++) {
-	Record* rcd = get (row);
-	if (rcd == nullptr) continue;
-	if (rcd->isequal (col, lobj) == true) {
-	  result = true;
-	  break;
-	}
-      }
+      bool result = (rfind (col, lobj) != -1L);
       unlock ();
       return result;
     } catch (...) {
@@ -1097,6 +1348,20 @@ namespace afnix {
   long Sheet::rfind (const long col, const Literal& lobj) const {
     rdlock ();
     try {
+      // check for a column index
+      s_cidx* cidx = (p_cidx == nullptr) ? nullptr : p_cidx->get (col);
+      if (cidx != nullptr) {
+	d_pmon.enter ();
+	try {
+	  long result = cidx->find (*this, lobj);
+	  d_pmon.leave ();
+	  unlock ();
+	  return result;
+	} catch (...) {
+	  d_pmon.leave ();
+	  throw;
+	}
+      }
       // get the number of rows
       long rows = length ();
       // initialize result
@@ -1136,12 +1401,237 @@ namespace afnix {
     }
   }
 
+  // add a column index
+
+  void Sheet::addcidx (const long col) {
+    wrlock ();
+    try {
+      if (col < 0L) {
+	throw Exception ("index-error", "invalid column index to add");
+      }
+      if ((p_cidx == nullptr) || (p_cidx->get (col) == nullptr)) {
+	p_cidx = new s_cidx (col, p_cidx);
+      }
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // return true if a column is indexed
+
+  bool Sheet::iscidx (const long col) const {
+    rdlock ();
+    try {
+      bool result = (p_cidx != nullptr) && (p_cidx->get (col) != nullptr);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // reset the column indexes
+
+  void Sheet::rstcidx (void) {
+    wrlock ();
+    try {
+      if (p_cidx != nullptr) p_cidx->rstall ();
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // write this sheet in a column directory
+
+  void Sheet::wrcols (const String& path) const {
+    rdlock ();
+    try {
+      // build the packed records and release the mapped columns
+      unpack ();
+      // create the directory
+      if ((System::isdir (path) == false) && (System::mkdir (path) == false)) {
+	throw Exception ("sheet-error", "cannot create column directory", path);
+      }
+      // write the manifest
+      OutputFile os (System::join (path, SHT_MNAME));
+      for (long k = 0L; k < SHT_MSIZE; k++) os.write (SHT_MAGIC[k]);
+      Saveas::wrstream (os);
+      d_tags.wrstream (os);
+      d_sign.wrstream (os);
+      d_hstl.wrstream (os);
+      d_mark.wrstream (os);
+      d_head.wrstream (os);
+      d_foot.wrstream (os);
+      long rows = length ();
+      long cols = getcols ();
+      Serial::wrlong (rows, os);
+      Serial::wrlong (cols, os);
+      os.close ();
+      // write the column files
+      for (long k = 0L; k < cols; k++) {
+	Column::write (sht_cname (path, k), *this, k);
+      }
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // read a column directory into this sheet
+
+  void Sheet::rdcols (const String& path) {
+    wrlock ();
+    try {
+      // reset the sheet
+      reset ();
+      // read the manifest
+      InputFile is (System::join (path, SHT_MNAME));
+      for (long k = 0L; k < SHT_MSIZE; k++) {
+	if (is.read () != SHT_MAGIC[k]) {
+	  throw Exception ("sheet-error", "invalid sheet manifest", path);
+	}
+      }
+      Saveas::rdstream (is);
+      d_tags.rdstream (is);
+      d_sign.rdstream (is);
+      d_hstl.rdstream (is);
+      d_mark.rdstream (is);
+      d_head.rdstream (is);
+      d_foot.rdstream (is);
+      long rows = Serial::rdlong (is);
+      long cols = Serial::rdlong (is);
+      is.close ();
+      // map the column files
+      Vector mcol;
+      for (long k = 0L; k < cols; k++) {
+	Column* col = new Column (sht_cname (path, k));
+	mcol.add (col);
+	if (col->length () != rows) {
+	  throw Exception ("sheet-error", "inconsistent column file length",
+			   sht_cname (path, k));
+	}
+      }
+      // bind the columns
+      if (cols > 0L) {
+	addcols (mcol, rows);
+      } else {
+	for (long k = 0L; k < rows; k++) d_body.add (new Record);
+      }
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get the mapped column of a packed row
+
+  Column* Sheet::getpcol (const long row, const long col, long& prow) const {
+    rdlock ();
+    try {
+      Column* result = nullptr;
+      if ((row >= d_poff) && (row < d_poff + d_plen) && (col >= 0L) &&
+	  (col < d_cols.length ()) && (d_body.get (row) == nullptr)) {
+	Object::iref (result = dynamic_cast <Column*> (d_cols.get (col)));
+	prow = row - d_poff;
+      }
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // build all the packed records
+
+  void Sheet::unpack (void) const {
+    if (d_plen == 0L) return;
+    d_pmon.enter ();
+    try {
+      for (long k = 0L; k < d_plen; k++) unpack (d_poff + k);
+      d_cols.reset ();
+      d_poff = 0L;
+      d_plen = 0L;
+      d_pmon.leave ();
+    } catch (...) {
+      d_pmon.leave ();
+      throw;
+    }
+  }
+
+  // get a record by index with a packed record built
+
+  Record* Sheet::unpack (const long row) const {
+    // check for a packed row
+    Record* result = dynamic_cast <Record*> (d_body.get (row));
+    if ((result != nullptr) || (row < d_poff) || (row >= d_poff + d_plen)) {
+      return result;
+    }
+    d_pmon.enter ();
+    Literal** cobj = nullptr;
+    Record*   rcd  = nullptr;
+    try {
+      // check if the record has been built meanwhile
+      result = dynamic_cast <Record*> (d_body.get (row));
+      if (result == nullptr) {
+	// collect the column literals
+	long cidx = row - d_poff;
+	long clen = d_cols.length ();
+	long rlen = 0L;
+	cobj = new Literal*[clen];
+	for (long k = 0L; k < clen; k++) cobj[k] = nullptr;
+	for (long k = 0L; k < clen; k++) {
+	  Object*  col = d_cols.get (k);
+	  Bundle* bcol = dynamic_cast <Bundle*> (col);
+	  Column* mcol = dynamic_cast <Column*> (col);
+	  Vector* vcol = dynamic_cast <Vector*> (col);
+	  if (bcol != nullptr) {
+	    cobj[k] = (cidx < bcol->length ()) ? bcol->get (cidx) : nullptr;
+	  } else if (mcol != nullptr) {
+	    cobj[k] = (cidx < mcol->length ()) ? mcol->get (cidx) : nullptr;
+	  } else if (vcol != nullptr) {
+	    cobj[k] = (cidx < vcol->length ()) ?
+	      dynamic_cast <Literal*> (vcol->get (cidx)) : nullptr;
+	  }
+	  Object::iref (cobj[k]);
+	  if (cobj[k] != nullptr) rlen = k + 1L;
+	}
+	// build the record without the trailing nil cells
+	Object::iref (rcd = new Record);
+	for (long k = 0L; k < rlen; k++) rcd->add (cobj[k]);
+	d_body.set (row, rcd);
+	Object::tref (rcd);
+	result = rcd;
+	for (long k = 0L; k < clen; k++) Object::dref (cobj[k]);
+	delete [] cobj;
+      }
+      d_pmon.leave ();
+      return result;
+    } catch (...) {
+      if (cobj != nullptr) {
+	long clen = d_cols.length ();
+	for (long k = 0L; k < clen; k++) Object::dref (cobj[k]);
+      }
+      delete [] cobj;
+      Object::dref (rcd);
+      d_pmon.leave ();
+      throw;
+    }
+  }
+
   // -------------------------------------------------------------------------
   // - object section                                                        -
   // -------------------------------------------------------------------------
 
   // the quark zone
-  static const long QUARK_ZONE_LENGTH = 34;
+  static const long QUARK_ZONE_LENGTH = 39;
   static QuarkZone  zone (QUARK_ZONE_LENGTH);
 
   // the sheet supported quarks
@@ -1179,6 +1669,11 @@ namespace afnix {
   static const long QUARK_ADDDATA = zone.intern ("add-data");
   static const long QUARK_LINKCOL = zone.intern ("link-column");
   static const long QUARK_RLOOKUP = zone.intern ("lookup-row");
+  static const long QUARK_ADDCIDX = zone.intern ("add-column-index");
+  static const long QUARK_ISCIDXP = zone.intern ("column-index-p");
+  static const long QUARK_RSTCIDX = zone.intern ("reset-column-index");
+  static const long QUARK_WRCOLS  = zone.intern ("write-columns");
+  static const long QUARK_RDCOLS  = zone.intern ("read-columns");
 
   // create a new object in a generic way
 
@@ -1264,10 +1759,33 @@ namespace afnix {
 	sort (0, true);
 	return nullptr;
       }
+      if (quark == QUARK_RSTCIDX) {
+	rstcidx ();
+	return nullptr;
+      }
     }
 
     // dispatch 1 argument
     if (argc == 1) {
+      if (quark == QUARK_ISCIDXP) {
+	long col = argv->getlong (0);
+	return new Boolean (iscidx (col));
+      }
+      if (quark == QUARK_ADDCIDX) {
+	long col = argv->getlong (0);
+	addcidx (col);
+	return nullptr;
+      }
+      if (quark == QUARK_WRCOLS) {
+	String path = argv->getstring (0);
+	wrcols (path);
+	return nullptr;
+      }
+      if (quark == QUARK_RDCOLS) {
+	String path = argv->getstring (0);
+	rdcols (path);
+	return nullptr;
+      }
       if (quark == QUARK_ADDMARK) {
 	Object*   obj = argv->get (0);
 	Literal* lobj = dynamic_cast <Literal*> (obj);
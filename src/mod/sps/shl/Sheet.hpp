@@ -25,6 +25,10 @@
 #include "Bundle.hpp"
 #endif
 
+#ifndef  AFNIX_MONITOR_HPP
+#include "Monitor.hpp"
+#endif
+
 #ifndef  AFNIX_RECORD_HPP
 #include "Record.hpp"
 #endif
@@ -40,6 +44,17 @@ namespace afnix {
   /// record, the sheet is defined with a name and a vector of records.
   /// For format purpose, the sheet has also three record fields, namelly,
   /// the info, head, and foot record.
+  /// A sheet can also be filled by columns. In this case, the columns are
+  /// stored as typed bundles or vectors of literals and a record is built
+  /// from the columns when it is accessed for the first time.
+  /// A sheet can be written in a column directory, with a manifest file and
+  /// one mapped column file per sheet column. When the directory is read,
+  /// the column files are mapped and the records are built on access. Only
+  /// the cell literals are kept in the column files.
+  /// A column can be indexed for the row lookup. The column index maps a
+  /// cell literal to its first row. The index is built on demand and
+  /// maintained when a record is added, set or removed. A record which is
+  /// modified directly requires the sheet index to be reset.
   /// @author amaury darsch
 
   class Sheet : public Saveas {
@@ -57,7 +72,17 @@ namespace afnix {
     /// the record footer
     Record   d_foot;
     /// the record body
-    Vector   d_body;
+    mutable Vector  d_body;
+    /// the packed columns
+    mutable Vector  d_cols;
+    /// the packed row offset
+    mutable long    d_poff;
+    /// the packed row length
+    mutable long    d_plen;
+    /// the packed row and index monitor
+    mutable Monitor d_pmon;
+    /// the column indexes
+    struct s_cidx*  p_cidx;
     
   public:
     /// create an empty sheet
@@ -76,6 +101,9 @@ namespace afnix {
     /// @param that the sheet to copy
     Sheet (const Sheet& that);
 
+    /// destroy this sheet
+    ~Sheet (void);
+
     /// @return the object name
     String repr (void) const;
 
@@ -245,6 +273,12 @@ namespace afnix {
     /// @param argv the vector to add
     void adddata (const Vector* argv);
 
+    /// add a vector of packed columns - a column is a bundle, a mapped
+    /// column or a vector of literals
+    /// @param cols the columns to add
+    /// @param rows the number of rows
+    void addcols (const Vector& cols, const long rows);
+
     /// remove a record by index
     /// @param index the record index to remove
     void remove (const long index);
@@ -280,6 +314,40 @@ namespace afnix {
     /// @param lobj the literal to check
     long rlookup (const long col, const Literal& lobj) const;
 
+    /// add a column index
+    /// @param col the column to index
+    void addcidx (const long col);
+
+    /// @return true if a column is indexed
+    /// @param col the column to check
+    bool iscidx (const long col) const;
+
+    /// reset the column indexes
+    void rstcidx (void);
+
+    /// write this sheet in a column directory
+    /// @param path the directory path
+    void wrcols (const String& path) const;
+
+    /// read a column directory into this sheet
+    /// @param path the directory path
+    void rdcols (const String& path);
+
+    /// @return the mapped column of a packed row or nil - the column
+    /// is returned referenced and must be released by the caller
+    /// @param row  the sheet row
+    /// @param col  the sheet column
+    /// @param prow the column row
+    class Column* getpcol (const long row, const long col, long& prow) const;
+
+  private:
+    /// build all the packed records
+    void unpack (void) const;
+
+    /// @return a record by index with a packed record built
+    /// @param row the record index
+    Record* unpack (const long row) const;
+
   public:
     /// create a new object in a generic way
     /// @param argv the argument vector
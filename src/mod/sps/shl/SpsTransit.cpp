@@ -301,18 +301,26 @@ namespace afnix {
 	rd = new Csv (is, d_sbrk, d_locv);
 	break;
       }
-      // parse with the reader
-      while (true) {
-	form = rd->parse ();
-	if (form == nullptr) break;
-	import (form);
-	Object::cref (form); form = nullptr;
+      // import by columns with a csv reader
+      Csv* csv = dynamic_cast <Csv*> (rd);
+      if (csv != nullptr) {
+	if (p_tsht == nullptr) Object::iref (p_tsht = new Sheet);
+	csv->import (p_tsht, false);
+      } else {
+	// parse with the reader
+	while (true) {
+	  form = rd->parse ();
+	  if (form == nullptr) break;
+	  import (form);
+	  Object::cref (form); form = nullptr;
+	}
       }
       delete rd;
       Object::tref (is);
+      unlock ();
     } catch (Exception& e) {
       if (form == nullptr) {
-	e.setlnum (rd->getlnum ());
+	if (rd != nullptr) e.setlnum (rd->getlnum ());
       } else {
 	e.setlnum (form->getlnum ());
 	Object::cref (form);
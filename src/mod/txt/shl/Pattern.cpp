@@ -218,6 +218,7 @@ namespace afnix {
     d_name  = "";
     d_rtag  = -1;
     d_escc  = nilq;
+    d_snum  = 0L;
   }
 
   // create a regex pattern by string
@@ -230,6 +231,7 @@ namespace afnix {
     d_name  = "";
     d_rtag  = -1;
     d_escc  = nilq;
+    d_snum  = 0L;
   }
 
   // create a regex pattern by name and string
@@ -242,6 +244,7 @@ namespace afnix {
     d_name  = name;
     d_rtag  = -1;
     d_escc  = nilq;
+    d_snum  = 0L;
   }
 
   // create a pattern by name and regex
@@ -254,6 +257,7 @@ namespace afnix {
     d_name  = name;
     d_rtag  = -1;
     d_escc  = nilq;
+    d_snum  = 0L;
   }
 
   // create a balanced pattern by name, control string and escape character
@@ -265,6 +269,7 @@ namespace afnix {
     d_name  = name;
     d_rtag  = -1;
     d_escc  = escc;
+    d_snum  = 0L;
   }
 
   // create a balanced pattern by name, control strings and escape character
@@ -277,6 +282,7 @@ namespace afnix {
     d_name  = name;
     d_rtag  = -1;
     d_escc  = escc;
+    d_snum  = 0L;
   }
 
   // create a balanced pattern by name and control strings
@@ -288,6 +294,7 @@ namespace afnix {
     d_name  = name;
     d_rtag  = -1;
     d_escc  = nilq;
+    d_snum  = 0L;
   }
 
   // create a pattern by name, control strings and flags
@@ -300,6 +307,7 @@ namespace afnix {
     d_name  = name;
     d_rtag  = -1;
     d_escc  = nilq;
+    d_snum  = 0L;
   }
 
   // copy construct this regex element
@@ -314,6 +322,7 @@ namespace afnix {
       d_name  = that.d_name;
       d_rtag  = that.d_rtag;
       d_escc  = that.d_escc;
+      d_snum  = 0L;
       that.unlock ();
     } catch (...) {
       that.unlock ();
@@ -350,6 +359,7 @@ namespace afnix {
       d_name  = that.d_name;
       d_rtag  = that.d_rtag;
       d_escc  = that.d_escc;
+      d_snum++;
       // unlock everything
       unlock ();
       that.unlock ();
@@ -370,6 +380,7 @@ namespace afnix {
       d_regex = re;
       d_sbs   = "";
       d_ebs   = "";
+      d_snum++;
       unlock ();
     } catch (...) {
       unlock ();
@@ -386,6 +397,7 @@ namespace afnix {
       d_regex = re;
       d_sbs   = "";
       d_ebs   = "";
+      d_snum++;
       unlock ();
     } catch (...) {
       unlock ();
@@ -402,6 +414,7 @@ namespace afnix {
       d_regex = "";
       d_sbs   = sbs;
       d_ebs   = sbs;
+      d_snum++;
       unlock ();
     } catch (...) {
       unlock ();
@@ -490,6 +503,35 @@ namespace afnix {
     }
   }
 
+  // get the pattern serial number
+
+  long Pattern::getsnum (void) const {
+    rdlock ();
+    try {
+      long result = d_snum;
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // add the pattern regex to a regex scanner
+
+  bool Pattern::addscan (Regscan& rscn) const {
+    rdlock ();
+    try {
+      bool result = (d_mode == REGEX);
+      if (result == true) rscn.add (d_regex);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // check a string with this pattern
 
   bool Pattern::check (const String& s) const {
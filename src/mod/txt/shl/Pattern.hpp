@@ -21,6 +21,10 @@
 #include "Regex.hpp"
 #endif
 
+#ifndef  AFNIX_REGSCAN_HPP
+#include "Regscan.hpp"
+#endif
+
 #ifndef  AFNIX_INPUTSTREAM_HPP
 #include "InputStream.hpp"
 #endif
@@ -59,6 +63,8 @@ namespace afnix {
     long    d_rtag;
     /// the escape character
     t_quad  d_escc;
+    /// the serial number
+    long    d_snum;
 
   public:
     /// create an empty  pattern
@@ -154,6 +160,14 @@ namespace afnix {
     /// @return the element tag
     long gettag (void) const;
 
+    /// @return the serial number changed with the pattern mode or regex
+    long getsnum (void) const;
+
+    /// add the pattern regex to a regex scanner
+    /// @param rscn the regex scanner to update
+    /// @return false if the pattern is not in regex mode
+    bool addscan (Regscan& rscn) const;
+
     /// check this pattern against a string
     /// @param s the string to check
     bool check (const String& s) const;
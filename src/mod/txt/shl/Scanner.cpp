@@ -67,6 +67,13 @@ namespace afnix {
 
   Scanner::Scanner (void) {
     d_mmin = false;
+    p_snum = nullptr;
+  }
+
+  // destroy this scanner
+
+  Scanner::~Scanner (void) {
+    delete [] p_snum;
   }
 
   // return the class name
@@ -100,6 +107,8 @@ namespace afnix {
       pat->settag (index);
       // add it into the scanner
       d_vpat.add (pat);
+      delete [] p_snum;
+      p_snum = nullptr;
       unlock ();
     } catch (...) {
       unlock ();
@@ -158,6 +167,15 @@ namespace afnix {
 	unlock ();
 	return nullptr;
       }
+      // scan with the regex scanner
+      if ((d_mmin == false) && (isscan () == true)) {
+	String lval;
+	long   lidx = d_rscn.match (&is, lval);
+	Lexeme* lexm = (lidx == -1L) ? nullptr :
+	  new Lexeme (lval, get(lidx)->gettag ());
+	unlock ();
+	return lexm;
+      }
       // create a scanner context
       s_sctx* sctx = new s_sctx[slen];
       try {
@@ -197,6 +215,45 @@ namespace afnix {
     }
   }
 
+  // check and bind the patterns to the regex scanner - the scanner is
+  // rebuilt when a pattern serial number has changed
+
+  bool Scanner::isscan (void) const {
+    wrlock ();
+    try {
+      // check the pattern serial numbers
+      long slen = d_vpat.length ();
+      bool sflg = (p_snum != nullptr);
+      for (long k = 0L; (k < slen) && (sflg == true); k++) {
+	Pattern* pat = dynamic_cast <Pattern*> (d_vpat.get (k));
+	if ((pat == nullptr) || (pat->getsnum () != p_snum[k])) sflg = false;
+      }
+      // rebind the patterns regex
+      if (sflg == false) {
+	delete [] p_snum;
+	p_snum = new long[slen];
+	d_rscn.reset ();
+	for (long k = 0L; k < slen; k++) {
+	  Pattern* pat = get (k);
+	  p_snum[k] = (pat == nullptr) ? -1L : pat->getsnum ();
+	}
+	for (long k = 0L; k < slen; k++) {
+	  Pattern* pat = get (k);
+	  if ((pat == nullptr) || (pat->addscan (d_rscn) == false)) {
+	    d_rscn.reset ();
+	    break;
+	  }
+	}
+      }
+      bool result = d_rscn.valid ();
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // -------------------------------------------------------------------------
   // - object section                                                        -
   // -------------------------------------------------------------------------
@@ -40,7 +40,11 @@ namespace afnix {
   /// by adding patterns to the scanner object. With an input stream, the 
   /// scanner object attempts to build a buffer that match at least one 
   /// pattern. When such matching occurs, a lexeme is built. When building 
-  /// a lexeme, the pattern tag is used to mark the lexeme.
+  /// a lexeme, the pattern tag is used to mark the lexeme. When all the
+  /// patterns are regex patterns which can be combined by a regex scanner,
+  /// a single automaton reads the input stream once and returns the
+  /// longest lexeme. When two patterns match the same lexeme, the last
+  /// added pattern wins.
   /// @author amaury darsch
 
   class Scanner : public Object {
@@ -49,11 +53,19 @@ namespace afnix {
     Vector  d_vpat;
     /// the minimum mode flag
     bool    d_mmin;
+    /// the regex scanner cache - the cache is rebuilt by the const scan
+    /// method under the write lock when a pattern has changed
+    mutable Regscan d_rscn;
+    /// the pattern serial numbers of the regex scanner cache
+    mutable long*   p_snum;
 
   public:
     /// create a default scanner
     Scanner (void);
 
+    /// destroy this scanner
+    ~Scanner (void);
+
     /// @return the class name
     String repr (void) const;
 
@@ -76,6 +88,8 @@ namespace afnix {
     Lexeme* scan (InputStream& is) const;
 
   private:
+    // check and bind the patterns to the regex scanner
+    bool isscan (void) const;
     // make the copy constructor private
     Scanner (const Scanner&);
     // make the assignement operator private
@@ -66,6 +66,38 @@ namespace afnix {
     return rstr < sstr;
   }
 
+  // sort a vector argument with an optional stable flag
+
+  static Object* txt_qsort (Evaluable* zobj, Nameset* nset, Cons* args,
+			    Sorter::t_cmpf cmpf, const Sorter::t_kmod kmod,
+			    const String& name) {
+    // evaluate the arguments
+    Vector* argv = Vector::eval (zobj, nset, args);
+    long argc = (argv == nullptr) ? 0 : argv->length ();
+    if ((argc != 1) && (argc != 2)) {
+      delete argv;
+      throw Exception ("argument-error",
+		       String ("invalid arguments with ") + name);
+    }
+    // get the argument vector
+    Vector* vobj = dynamic_cast <Vector*> (argv->get (0));
+    if (vobj == nullptr) {
+      delete argv;
+      throw Exception ("type-error", String ("invalid object with ") + name);
+    }
+    // build the sorter object and sort the vector
+    Sorter sorter (cmpf, kmod);
+    try {
+      if (argc == 2) sorter.setsflg (argv->getbool (1));
+      sorter.qsort (vobj);
+      delete argv;
+      return nullptr;
+    } catch (...) {
+      delete argv;
+      throw;
+    }
+  }
+
   // -------------------------------------------------------------------------
   // - public section                                                        -
   // -------------------------------------------------------------------------
@@ -95,89 +127,21 @@ namespace afnix {
   // quick sort ascending function
 
   Object* txt_qslth (Evaluable* zobj, Nameset* nset, Cons* args) {
-    // evaluate the arguments
-    Vector* argv = Vector::eval (zobj, nset, args);
-    long argc = (argv == nullptr) ? 0 : argv->length ();
-    if (argc != 1) {
-      delete argv;
-      throw Exception ("argument-error", "invalid arguments with sort-ascent");
-    }
-    // get the argument vector
-    Vector* vobj = dynamic_cast <Vector*> (argv->get (0));
-    if (vobj == nullptr) {
-      delete argv;
-      throw Exception ("type-error", "invalid object with sort-ascent");
-    }
-    // build the sorter object
-    Sorter sorter (qsort_cmplth);
-    // sort the vector
-    try {
-      sorter.qsort (vobj);
-      delete argv;
-      return nullptr;
-    } catch (...) {
-      delete argv;
-      throw;
-    }
+    return txt_qsort (zobj, nset, args, qsort_cmplth, Sorter::KMOD_ASCT,
+		      "sort-ascent");
   }
 
-  // quick sort ascending function
+  // quick sort descending function
 
   Object* txt_qsgth (Evaluable* zobj, Nameset* nset, Cons* args) {
-    // evaluate the arguments
-    Vector* argv = Vector::eval (zobj, nset, args);
-    long argc = (argv == nullptr) ? 0 : argv->length ();
-    if (argc != 1) {
-      delete argv;
-      throw Exception ("argument-error", 
-		       "invalid arguments with sort-descent");
-    }
-    // get the argument vector
-    Vector* vobj = dynamic_cast <Vector*> (argv->get (0));
-    if (vobj == nullptr) {
-      delete argv;
-      throw Exception ("type-error", "invalid object with sort-descent");
-    }
-    // build the sorter object
-    Sorter sorter (qsort_cmpgth);
-    // sort the vector
-    try {
-      sorter.qsort (vobj);
-      delete argv;
-      return nullptr;
-    } catch (...) {
-      delete argv;
-      throw;
-    }
+    return txt_qsort (zobj, nset, args, qsort_cmpgth, Sorter::KMOD_DSCT,
+		      "sort-descent");
   }
 
   // quick sort lexicographic function
 
   Object* txt_qslex (Evaluable* zobj, Nameset* nset, Cons* args) {
-    // evaluate the arguments
-    Vector* argv = Vector::eval (zobj, nset, args);
-    long argc = (argv == nullptr) ? 0 : argv->length ();
-    if (argc != 1) {
-      delete argv;
-      throw Exception ("argument-error", 
-		       "invalid arguments with sort-lexical");
-    }
-    // get the argument vector
-    Vector* vobj = dynamic_cast <Vector*> (argv->get (0));
-    if (vobj == nullptr) {
-      delete argv;
-      throw Exception ("type-error", "invalid object with sort-lexical");
-    }
-    // build the sorter object
-    Sorter sorter (qsort_cmplex);
-    // sort the vector
-    try {
-      sorter.qsort (vobj);
-      delete argv;
-      return nullptr;
-    } catch (...) {
-      delete argv;
-      throw;
-    }
+    return txt_qsort (zobj, nset, args, qsort_cmplex, Sorter::KMOD_LEXC,
+		      "sort-lexical");
   }
 }
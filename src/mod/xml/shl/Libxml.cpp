@@ -63,7 +63,8 @@ namespace afnix {
     gset->symcst ("XmlCref",        new Meta (XmlCref::mknew));
     gset->symcst ("XmlEref",        new Meta (XmlEref::mknew));
     gset->symcst ("XmlDecl",        new Meta (XmlDecl::mknew));
-    gset->symcst ("XmlReader",      new Meta (XmlReader::mknew));
+    gset->symcst ("XmlReader",      new Meta (XmlReader::meval,
+						  XmlReader::mknew));
     gset->symcst ("XmlTexter",      new Meta (XmlTexter::mknew));
     gset->symcst ("XmlComment",     new Meta (XmlComment::mknew));
     gset->symcst ("XmlDoctype",     new Meta (XmlDoctype::mknew));
@@ -14,6 +14,7 @@
 // - copyright (c) 1999-2021 amaury darsch                                   -
 // ---------------------------------------------------------------------------
 
+#include "Boolean.hpp"
 #include "Evaluable.hpp"
 #include "InputFile.hpp"
 #include "QuarkZone.hpp"
@@ -111,12 +112,14 @@ namespace afnix {
 
   XmlDocument::XmlDocument (void) {
     p_root = nullptr;
+    d_xidx = false;
   }
 
   // create a document by name
 
   XmlDocument::XmlDocument (const String& name) {
     p_root = nullptr;
+    d_xidx = false;
     setroot (name);
   }
 
@@ -124,6 +127,7 @@ namespace afnix {
 
   XmlDocument::XmlDocument (const String& name, const Buffer& sbuf) {
     p_root = nullptr;
+    d_xidx = false;
     setroot (name, sbuf);
   }
 
@@ -131,6 +135,7 @@ namespace afnix {
 
   XmlDocument::XmlDocument (const String& name, InputStream* is) {
     p_root = nullptr;
+    d_xidx = false;
     setroot (name, is);
   }
 
@@ -138,6 +143,7 @@ namespace afnix {
 
   XmlDocument::XmlDocument (const String& name, XmlRoot* root) {
     p_root = nullptr;
+    d_xidx = false;
     setroot (name, root);
   }
 
@@ -147,10 +153,12 @@ namespace afnix {
     that.rdlock ();
     try {
       d_name = that.d_name;
+      d_xidx = that.d_xidx;
       if (that.p_root == nullptr) {
 	p_root = nullptr;
       } else {
 	Object::iref(p_root = dynamic_cast <XmlRoot*> (that.p_root->copy ()));
+	if ((d_xidx == true) && (p_root != nullptr)) p_root->setxidx (true);
       }
       that.unlock ();
     } catch (...) {
@@ -193,13 +201,15 @@ namespace afnix {
       if (p_root != nullptr) p_root->release ();
       // eventually clean the root node
       Object::dref (p_root);
-      // copy the document name
+      // copy the document name and index flag
       d_name = that.d_name;
+      d_xidx = that.d_xidx;
       // copy the root node
       if (that.p_root == nullptr) {
 	p_root = nullptr;
       } else {
 	Object::iref (p_root = dynamic_cast <XmlRoot*> (that.p_root->copy ()));
+	if ((d_xidx == true) && (p_root != nullptr)) p_root->setxidx (true);
       }
       unlock ();
       that.unlock ();
@@ -247,6 +257,7 @@ namespace afnix {
       p_root = nullptr;
       d_name = name;
       Object::iref (p_root = get_root_node (name));
+      if ((d_xidx == true) && (p_root != nullptr)) p_root->setxidx (true);
       unlock ();
     } catch (...) {
       unlock ();
@@ -263,6 +274,7 @@ namespace afnix {
       p_root = nullptr;
       d_name = name;
       Object::iref (p_root = get_root_node (sbuf));
+      if ((d_xidx == true) && (p_root != nullptr)) p_root->setxidx (true);
       unlock ();
     } catch (...) {
       unlock ();
@@ -279,6 +291,7 @@ namespace afnix {
       p_root = nullptr;
       d_name = name;
       Object::iref (p_root = get_root_node (is));
+      if ((d_xidx == true) && (p_root != nullptr)) p_root->setxidx (true);
       unlock ();
     } catch (...) {
       unlock ();
@@ -295,6 +308,7 @@ namespace afnix {
     try {
       d_name = name;
       Object::iref (p_root = root);
+      if ((d_xidx == true) && (p_root != nullptr)) p_root->setxidx (true);
       unlock ();
     } catch (...) {
       unlock ();
@@ -316,6 +330,7 @@ namespace afnix {
       // bind the tree by name
       d_name = name;
       Object::iref (p_root = get_rtxt_node (name));
+      if ((d_xidx == true) && (p_root != nullptr)) p_root->setxidx (true);
       unlock ();
     } catch (...) {
       unlock ();
@@ -332,6 +347,7 @@ namespace afnix {
     try {
       d_name = name;
       Object::iref (p_root = get_rtxt_node (is));
+      if ((d_xidx == true) && (p_root != nullptr)) p_root->setxidx (true);
       unlock ();
     } catch (...) {
       unlock ();
@@ -345,6 +361,7 @@ namespace afnix {
     wrlock ();
     try {
       if (p_root == nullptr) Object::iref (p_root = new XmlRoot (dflg));
+      if ((d_xidx == true) && (p_root != nullptr)) p_root->setxidx (true);
       XmlRoot* result = p_root;
       unlock ();
       return result;
@@ -382,12 +399,54 @@ namespace afnix {
     }
   }
 
+  // set the document index flag
+
+  void XmlDocument::setxidx (const bool xflg) {
+    wrlock ();
+    try {
+      d_xidx = xflg;
+      if (p_root != nullptr) p_root->setxidx (xflg);
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // return true if the document is indexed
+
+  bool XmlDocument::isxidx (void) const {
+    rdlock ();
+    try {
+      bool result = d_xidx;
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get a document node by id
+
+  XmlNode* XmlDocument::getid (const String& id) const {
+    rdlock ();
+    try {
+      XmlNode* result = (p_root == nullptr) ? nullptr : p_root->getid (id);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // -------------------------------------------------------------------------
   // - object section                                                        -
   // -------------------------------------------------------------------------
 
   // the quark zone
-  static const long QUARK_ZONE_LENGTH = 6;
+  static const long QUARK_ZONE_LENGTH = 9;
   static QuarkZone  zone (QUARK_ZONE_LENGTH);
 
   // the object supported quarks
@@ -397,6 +456,9 @@ namespace afnix {
   static const long QUARK_NEWROOT = zone.intern ("new-root");
   static const long QUARK_GETROOT = zone.intern ("get-root");
   static const long QUARK_GETBODY = zone.intern ("get-body");
+  static const long QUARK_SETXIDX = zone.intern ("set-index");
+  static const long QUARK_XIDXP   = zone.intern ("index-p");
+  static const long QUARK_GETID   = zone.intern ("get-id-node");
 
   // create a new object in a generic way
 
@@ -457,8 +519,9 @@ namespace afnix {
 
     // check for 0 argument
     if (argc == 0) {
+      if (quark == QUARK_XIDXP) return new Boolean (isxidx ());
       if (quark == QUARK_NEWROOT) {
-	rdlock ();
+	wrlock ();
 	try {
 	  Object* result = newroot (false);
 	  zobj->post (result);
@@ -496,8 +559,26 @@ namespace afnix {
     }
     // check for 1 argument
     if (argc == 1) {
-      if (quark == QUARK_NEWROOT) {
+      if (quark == QUARK_SETXIDX) {
+	bool xflg = argv->getbool (0);
+	setxidx (xflg);
+	return nullptr;
+      }
+      if (quark == QUARK_GETID) {
+	String id = argv->getstring (0);
 	rdlock ();
+	try {
+	  Object* result = getid (id);
+	  zobj->post (result);
+	  unlock ();
+	  return result;
+	} catch (...) {
+	  unlock ();
+	  throw;
+	}
+      }
+      if (quark == QUARK_NEWROOT) {
+	wrlock ();
 	try {
 	  bool dflg = argv->getbool (0);
 	  Object* result = newroot (dflg);
@@ -37,6 +37,8 @@ namespace afnix {
   /// a name and a buffer or an input stream that is used for parsing the
   /// input data. The document can also be designed by constructing manually
   /// the document tree. In that case, the document name must be set.
+  /// The document tree can also be indexed by tag name and attribute, in
+  /// which case the index is maintained when the tree is changed.
   /// @author amaury darsch
 
   class XmlDocument : public Nameable {
@@ -45,6 +47,8 @@ namespace afnix {
     String   d_name;
     /// the root node
     XmlRoot* p_root;
+    /// the index flag
+    bool     d_xidx;
 
   public:
     /// create a default document
@@ -131,6 +135,17 @@ namespace afnix {
     /// @return the document root node without the declaration
     virtual XmlRoot* getbody (void) const;
 
+    /// set the document index flag
+    /// @param xflg the index flag to set
+    virtual void setxidx (const bool xflg);
+
+    /// @return true if the document is indexed
+    virtual bool isxidx (void) const;
+
+    /// @return a document node by id or nil
+    /// @param id the node id to find
+    virtual XmlNode* getid (const String& id) const;
+
   public:
     /// create an object in a generic way
     /// @param argv the argument vector
@@ -0,0 +1,317 @@
+// ---------------------------------------------------------------------------
+// - XmlIndex.cpp                                                            -
+// - afnix:xml module - xml tree index class implementation                  -
+// ---------------------------------------------------------------------------
+// - This program is free software;  you can redistribute it  and/or  modify -
+// - it provided that this copyright notice is kept intact.                  -
+// -                                                                         -
+// - This program  is  distributed in  the hope  that it will be useful, but -
+// - without  any  warranty;  without  even   the   implied    warranty   of -
+// - merchantability or fitness for a particular purpose.  In no event shall -
+// - the copyright holder be liable for any  direct, indirect, incidental or -
+// - special damages arising in any way out of the use of this software.     -
+// ---------------------------------------------------------------------------
+// - copyright (c) 1999-2021 amaury darsch                                   -
+// ---------------------------------------------------------------------------
+
+#include "XmlTag.hpp"
+#include "XmlIndex.hpp"
+#include "Exception.hpp"
+
+namespace afnix {
+
+  // -------------------------------------------------------------------------
+  // - private section                                                       -
+  // -------------------------------------------------------------------------
+
+  // the xml id attribute name
+  static const String XML_ID_ATTR = "id";
+
+  // this procedure returns an attribute key by name and value
+  static String xidx_akey (const String& name, const String& pval) {
+    String result = name;
+    result += '=';
+    result += pval;
+    return result;
+  }
+
+  // this procedure adds a node to a table by key and returns false if
+  // the node cannot be assumed to be in the document order
+  static bool xidx_add (HashTable& htbl, const String& key, XmlNode* node) {
+    Vector* nvec = dynamic_cast <Vector*> (htbl.get (key));
+    if (nvec == nullptr) {
+      htbl.add (key, (nvec = new Vector));
+      nvec->add (node);
+      return true;
+    }
+    nvec->add (node);
+    return false;
+  }
+
+  // this procedure removes a node from a table by key
+  static void xidx_rm (HashTable& htbl, const String& key, XmlNode* node) {
+    Vector* nvec = dynamic_cast <Vector*> (htbl.get (key));
+    if (nvec == nullptr) return;
+    nvec->remove (node);
+    if (nvec->length () == 0L) htbl.remove (key);
+  }
+
+  // -------------------------------------------------------------------------
+  // - class section                                                         -
+  // -------------------------------------------------------------------------
+
+  // create an index by root node
+
+  XmlIndex::XmlIndex (XmlNode* root) {
+    p_root = root;
+    d_sord = true;
+  }
+
+  // return the class name
+
+  String XmlIndex::repr (void) const {
+    return "XmlIndex";
+  }
+
+  // reset this index and index the root tree
+
+  void XmlIndex::reset (void) {
+    wrlock ();
+    try {
+      d_tags.reset ();
+      d_attr.reset ();
+      addtree (p_root);
+      d_sord = true;
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // index a node tree
+
+  void XmlIndex::addtree (XmlNode* node) {
+    // check for nil
+    if (node == nullptr) return;
+    // lock and index
+    wrlock ();
+    try {
+      // index the tag name and attributes
+      XmlTag* tag = dynamic_cast <XmlTag*> (node);
+      if (tag != nullptr) {
+	addname (tag, tag->getname ());
+	addattr (tag);
+      }
+      // index the children
+      long clen = node->lenchild ();
+      for (long k = 0L; k < clen; k++) addtree (node->getchild (k));
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // remove a node tree from the index
+
+  void XmlIndex::rmtree (XmlNode* node) {
+    // check for nil
+    if (node == nullptr) return;
+    // lock and remove
+    wrlock ();
+    try {
+      // remove the tag name and attributes
+      XmlTag* tag = dynamic_cast <XmlTag*> (node);
+      if (tag != nullptr) {
+	rmname (tag, tag->getname ());
+	rmattr (tag);
+      }
+      // remove the children
+      long clen = node->lenchild ();
+      for (long k = 0L; k < clen; k++) rmtree (node->getchild (k));
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // index a node by name
+
+  void XmlIndex::addname (XmlNode* node, const String& name) {
+    if (node == nullptr) return;
+    wrlock ();
+    try {
+      if (xidx_add (d_tags, name, node) == false) d_sord = false;
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // remove a node name from the index
+
+  void XmlIndex::rmname (XmlNode* node, const String& name) {
+    if (node == nullptr) return;
+    wrlock ();
+    try {
+      xidx_rm (d_tags, name, node);
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // index a node by attribute
+
+  void XmlIndex::addattr (XmlNode* node, const String& name,
+			  const String& pval) {
+    if (node == nullptr) return;
+    wrlock ();
+    try {
+      String akey = xidx_akey (name, pval);
+      if (xidx_add (d_attr, akey, node) == false) d_sord = false;
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // remove a node attribute from the index
+
+  void XmlIndex::rmattr (XmlNode* node, const String& name,
+			 const String& pval) {
+    if (node == nullptr) return;
+    wrlock ();
+    try {
+      xidx_rm (d_attr, xidx_akey (name, pval), node);
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // index all the attributes of a node
+
+  void XmlIndex::addattr (XmlNode* node) {
+    XmlTag* tag = dynamic_cast <XmlTag*> (node);
+    if (tag == nullptr) return;
+    wrlock ();
+    try {
+      long alen = tag->lenattr ();
+      for (long k = 0L; k < alen; k++) {
+	Property* prop = tag->getattr (k);
+	if (prop == nullptr) continue;
+	addattr (tag, prop->getname (), prop->getpval ());
+      }
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // remove all the attributes of a node from the index
+
+  void XmlIndex::rmattr (XmlNode* node) {
+    XmlTag* tag = dynamic_cast <XmlTag*> (node);
+    if (tag == nullptr) return;
+    wrlock ();
+    try {
+      long alen = tag->lenattr ();
+      for (long k = 0L; k < alen; k++) {
+	Property* prop = tag->getattr (k);
+	if (prop == nullptr) continue;
+	rmattr (tag, prop->getname (), prop->getpval ());
+      }
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get the tag nodes by name
+
+  Vector* XmlIndex::getname (const String& name) {
+    wrlock ();
+    Vector* result = new Vector;
+    try {
+      // get the node vector and restore the document order
+      Vector* nvec = dynamic_cast <Vector*> (d_tags.get (name));
+      if ((nvec != nullptr) && (nvec->length () > 1L) && (d_sord == false)) {
+	reset ();
+	nvec = dynamic_cast <Vector*> (d_tags.get (name));
+      }
+      // collect the attached nodes
+      long nlen = (nvec == nullptr) ? 0L : nvec->length ();
+      for (long k = 0L; k < nlen; k++) {
+	XmlNode* node = dynamic_cast <XmlNode*> (nvec->get (k));
+	if ((node == nullptr) || (node->getxidx () != this)) continue;
+	if (node->isname (name) == true) result->add (node);
+      }
+      unlock ();
+      return result;
+    } catch (...) {
+      delete result;
+      unlock ();
+      throw;
+    }
+  }
+
+  // get the tag nodes by attribute name and value
+
+  Vector* XmlIndex::getattr (const String& name, const String& pval) {
+    wrlock ();
+    Vector* result = new Vector;
+    try {
+      // get the node vector and restore the document order
+      String  akey = xidx_akey (name, pval);
+      Vector* nvec = dynamic_cast <Vector*> (d_attr.get (akey));
+      if ((nvec != nullptr) && (nvec->length () > 1L) && (d_sord == false)) {
+	reset ();
+	nvec = dynamic_cast <Vector*> (d_attr.get (akey));
+      }
+      // collect the attached nodes
+      long nlen = (nvec == nullptr) ? 0L : nvec->length ();
+      for (long k = 0L; k < nlen; k++) {
+	XmlNode* node = dynamic_cast <XmlNode*> (nvec->get (k));
+	if ((node == nullptr) || (node->getxidx () != this)) continue;
+	if (node->isattr (name, pval) == true) result->add (node);
+      }
+      unlock ();
+      return result;
+    } catch (...) {
+      delete result;
+      unlock ();
+      throw;
+    }
+  }
+
+  // get the first tag node by id
+
+  XmlNode* XmlIndex::getid (const String& id) {
+    wrlock ();
+    Vector* nvec = nullptr;
+    try {
+      nvec = getattr (XML_ID_ATTR, id);
+      XmlNode* result = (nvec->length () == 0L) ? nullptr :
+	dynamic_cast <XmlNode*> (nvec->get (0));
+      // protect the result while cleaning the vector
+      Object::iref (result);
+      delete nvec;
+      Object::tref (result);
+      unlock ();
+      return result;
+    } catch (...) {
+      delete nvec;
+      unlock ();
+      throw;
+    }
+  }
+}
@@ -0,0 +1,119 @@
+// ---------------------------------------------------------------------------
+// - XmlIndex.hpp                                                            -
+// - afnix:xml module - xml tree index class definition                      -
+// ---------------------------------------------------------------------------
+// - This program is free software;  you can redistribute it  and/or  modify -
+// - it provided that this copyright notice is kept intact.                  -
+// -                                                                         -
+// - This program  is  distributed in  the hope  that it will be useful, but -
+// - without  any  warranty;  without  even   the   implied    warranty   of -
+// - merchantability or fitness for a particular purpose.  In no event shall -
+// - the copyright holder be liable for any  direct, indirect, incidental or -
+// - special damages arising in any way out of the use of this software.     -
+// ---------------------------------------------------------------------------
+// - copyright (c) 1999-2021 amaury darsch                                   -
+// ---------------------------------------------------------------------------
+
+#ifndef  AFNIX_XMLINDEX_HPP
+#define  AFNIX_XMLINDEX_HPP
+
+#ifndef  AFNIX_XMLNODE_HPP
+#include "XmlNode.hpp"
+#endif
+
+#ifndef  AFNIX_HASHTABLE_HPP
+#include "HashTable.hpp"
+#endif
+
+namespace afnix {
+
+  /// The XmlIndex class is a tree index class which maps the tag names
+  /// and the tag attributes of a tree to their nodes. The index is bound
+  /// to a root node which owns it and is updated by the tree nodes when
+  /// a child is added or removed, or when a tag name or attribute is
+  /// changed. The index lookups only return the nodes which are still
+  /// attached to the root node, in the document order.
+  /// @author amaury darsch
+
+  class XmlIndex : public Object {
+  private:
+    /// the indexed root node
+    XmlNode*  p_root;
+    /// the tag name table
+    HashTable d_tags;
+    /// the attribute table
+    HashTable d_attr;
+    /// the document order flag
+    bool      d_sord;
+
+  public:
+    /// create an index by root node
+    /// @param root the root node to index
+    XmlIndex (XmlNode* root);
+
+    /// @return the class name
+    String repr (void) const;
+
+    /// reset this index and index the root tree
+    void reset (void);
+
+    /// index a node tree
+    /// @param node the node tree to index
+    void addtree (XmlNode* node);
+
+    /// remove a node tree from the index
+    /// @param node the node tree to remove
+    void rmtree (XmlNode* node);
+
+    /// index a node by name
+    /// @param node the node to index
+    /// @param name the node name
+    void addname (XmlNode* node, const String& name);
+
+    /// remove a node name from the index
+    /// @param node the node to remove
+    /// @param name the node name
+    void rmname (XmlNode* node, const String& name);
+
+    /// index a node by attribute
+    /// @param node the node to index
+    /// @param name the attribute name
+    /// @param pval the attribute value
+    void addattr (XmlNode* node, const String& name, const String& pval);
+
+    /// remove a node attribute from the index
+    /// @param node the node to remove
+    /// @param name the attribute name
+    /// @param pval the attribute value
+    void rmattr (XmlNode* node, const String& name, const String& pval);
+
+    /// index all the attributes of a node
+    /// @param node the node to index
+    void addattr (XmlNode* node);
+
+    /// remove all the attributes of a node from the index
+    /// @param node the node to remove
+    void rmattr (XmlNode* node);
+
+    /// @return the tag nodes by name
+    /// @param name the tag name to find
+    Vector* getname (const String& name);
+
+    /// @return the tag nodes by attribute name and value
+    /// @param name the attribute name
+    /// @param pval the attribute value
+    Vector* getattr (const String& name, const String& pval);
+
+    /// @return the first tag node by id or nil
+    /// @param id the node id to find
+    XmlNode* getid (const String& id);
+
+  private:
+    // make the copy constructor private
+    XmlIndex (const XmlIndex&) =delete;
+    // make the assignment operator private
+    XmlIndex& operator = (const XmlIndex&) =delete;
+  };
+}
+
+#endif
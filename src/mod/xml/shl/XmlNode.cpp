@@ -16,6 +16,7 @@
 
 #include "XmlNode.hpp"
 #include "Integer.hpp"
+#include "XmlIndex.hpp"
 #include "Boolean.hpp"
 #include "Loopable.hpp"
 #include "XmlSystem.hpp"
@@ -254,6 +255,20 @@ namespace afnix {
     }
   }
 
+  // get the tree index from the parent node
+
+  XmlIndex* XmlNode::getxidx (void) const {
+    rdlock ();
+    try {
+      XmlIndex* result = (p_pnod == nullptr) ? nullptr : p_pnod->getxidx ();
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
 
   // get a copy of the node tree
 
@@ -453,10 +468,16 @@ namespace afnix {
       if (d_eflg == true) {
 	throw Exception ("xml-error", "trying to add node in empty node");
       }
+      // remove the node from its tree index
+      XmlIndex* oidx = node->getxidx ();
+      if (oidx != nullptr) oidx->rmtree (node);
       // set the parent node
       node->setparent (this);
       // add the node
       d_chld.add (node);
+      // index the node tree
+      XmlIndex* xidx = getxidx ();
+      if (xidx != nullptr) xidx->addtree (node);
       unlock ();
     } catch (...) {
       unlock();
@@ -475,10 +496,16 @@ namespace afnix {
       if (d_eflg == true) {
 	throw Exception ("xml-error", "trying to add node in empty node");
       }
+      // remove the node from its tree index
+      XmlIndex* oidx = node->getxidx ();
+      if (oidx != nullptr) oidx->rmtree (node);
       // set the parent node
       node->setparent (this);
       // add the node
       d_chld.add (nidx, node);
+      // index the node tree
+      XmlIndex* xidx = getxidx ();
+      if (xidx != nullptr) xidx->addtree (node);
       unlock ();
     } catch (...) {
       unlock();
@@ -497,10 +524,22 @@ namespace afnix {
       if (d_eflg == true) {
 	throw Exception ("xml-error", "trying to add node in empty node");
       }
+      // remove the node from its tree index
+      XmlIndex* oidx = node->getxidx ();
+      if (oidx != nullptr) oidx->rmtree (node);
+      // detach the old node
+      XmlIndex* xidx = getxidx ();
+      XmlNode*  onod = getchild (nidx);
+      if ((onod != nullptr) && (onod != node)) {
+	if (xidx != nullptr) xidx->rmtree (onod);
+	if (onod->p_pnod == this) onod->setparent (nullptr);
+      }
       // set the parent node
       node->setparent (this);
       // add the node
       d_chld.set (nidx, node);
+      // index the node tree
+      if (xidx != nullptr) xidx->addtree (node);
       unlock ();
     } catch (...) {
       unlock();
@@ -568,9 +607,17 @@ namespace afnix {
     try {
       // protect us
       Object::iref (this);
+      // remove the node from the tree index and detach it
+      XmlNode* node = getchild (nidx);
+      if (node != nullptr) {
+	XmlIndex* xidx = getxidx ();
+	if (xidx != nullptr) xidx->rmtree (node);
+	if (node->p_pnod == this) node->setparent (nullptr);
+      }
       d_chld.remove (nidx);
       // update self reference
       Object::tref (this);
+      unlock ();
     } catch (...) {
       unlock ();
       throw;
@@ -699,6 +746,15 @@ namespace afnix {
     // protect us
     Object::iref (this);
     try {
+      // remove the children from the tree index and detach them
+      XmlIndex* xidx = getxidx ();
+      long      clen = lenchild ();
+      for (long k = 0L; k < clen; k++) {
+	XmlNode* node = getchild (k);
+	if (node == nullptr) continue;
+	if (xidx != nullptr) xidx->rmtree (node);
+	if (node->p_pnod == this) node->setparent (nullptr);
+      }
       // clear child list
       d_chld.reset ();
       // update self
@@ -113,6 +113,9 @@ namespace afnix {
     /// @param node the parent node to set
     virtual void setparent (XmlNode* node);
 
+    /// @return the tree index or nil
+    virtual class XmlIndex* getxidx (void) const;
+
     /// @return a copy of the node tree
     virtual XmlNode* copy (void) const;
 
@@ -14,6 +14,7 @@
 // - copyright (c) 1999-2021 amaury darsch                                   -
 // ---------------------------------------------------------------------------
 
+#include "Item.hpp"
 #include "XmlPe.hpp"
 #include "XmlGe.hpp"
 #include "XmlTag.hpp"
@@ -23,6 +24,8 @@
 #include "XmlData.hpp"
 #include "XmlCref.hpp"
 #include "XmlEref.hpp"
+#include "Boolean.hpp"
+#include "Integer.hpp"
 #include "Unicode.hpp"
 #include "Nameable.hpp"
 #include "Evaluable.hpp"
@@ -702,6 +705,7 @@ namespace afnix {
     // state: s_text
     // read some text and accumulate
   s_text:
+    xis.scan (xbuf, "<");
     c = xis.getu ();
     switch (c) {
     case XML_CHAR_AM:
@@ -737,6 +741,7 @@ namespace afnix {
     // state: s_ntag
     // read a normal tag
   s_ntag:
+    xis.scan (xbuf, "/>");
     c = xis.getu ();
     switch (c) {
     case XML_CHAR_SL:
@@ -853,6 +858,7 @@ namespace afnix {
     // state: s_ctag
     // read a comment node
   s_ctag:
+    xis.scan (xbuf, "-");
     c = xis.getu ();
     switch (c) {
     case XML_CHAR_MN:
@@ -918,6 +924,7 @@ namespace afnix {
     // state: s_rdcd
     // read cdata characters
   s_rdcd:
+    xis.scan (xbuf, "]");
     c = xis.getu ();
     switch (c) {
     case XML_CHAR_RB:
@@ -1074,18 +1081,17 @@ namespace afnix {
   }
 
   // this function parse a xml tree - be carefull in this code as
-  // the top stack node is always popped and sometime pushed-back
-  static void parse_xml_tree (XsoStream& xis, XmlRoot* root) {
+  // the top stack node is always popped and sometime pushed-back - the
+  // parsing stops when the top node is closed by its end tag
+  static bool parse_xml_tree (XsoStream& xis, XmlBuffer& xbuf, XmlNode* root) {
     // do nothing without a root node
-    if (root == nullptr) return;
-    // create a xml buffer
-    XmlBuffer xbuf;
+    if (root == nullptr) return false;
     // create a vector stack and push the root node
     Vector stk;
     stk.add (root);
     try {
-      // loop as long as we have a valid stream
-      while (xis.valid () == true) { 
+      // loop as long as we have a valid stream and an open node
+      while ((xis.valid () == true) && (stk.empty () == false)) {
 	// get the next available node
 	XmlNode* node = parse_xml_node (xis, xbuf);
 	if (node== nullptr) break;
@@ -1122,6 +1128,8 @@ namespace afnix {
 	stk.add (pnod);
 	stk.add (node);
       }
+      // check if the top node is closed
+      return stk.empty ();
     } catch (Exception& e) {
       e.updlnum (xbuf.getlnum ());
       throw e;
@@ -1130,6 +1138,146 @@ namespace afnix {
     }
   }
 
+  // this function parse a xml tree from a root node
+  static void parse_xml_tree (XsoStream& xis, XmlRoot* root) {
+    // create a xml buffer
+    XmlBuffer xbuf;
+    // parse the tree
+    parse_xml_tree (xis, xbuf, root);
+  }
+
+  // this function maps a node to a pull event
+  static XmlReader::t_xevt node_to_xevt (XmlNode* node) {
+    if (node == nullptr) return XmlReader::XEVT_NONE;
+    if (dynamic_cast <XmlTag*> (node) != nullptr) return XmlReader::XEVT_STAG;
+    if (dynamic_cast <XmlEnd*> (node) != nullptr) return XmlReader::XEVT_ETAG;
+    if (dynamic_cast <XmlText*> (node) != nullptr) return XmlReader::XEVT_TEXT;
+    if (dynamic_cast <XmlData*> (node) != nullptr) return XmlReader::XEVT_TEXT;
+    if (dynamic_cast <XmlRef*>  (node) != nullptr) return XmlReader::XEVT_XREF;
+    if (dynamic_cast <XmlPi*>   (node) != nullptr) return XmlReader::XEVT_PI;
+    if (dynamic_cast <XmlComment*> (node) != nullptr) {
+      return XmlReader::XEVT_COMT;
+    }
+    return XmlReader::XEVT_DECL;
+  }
+
+  // the reader pull state
+  struct s_xpul {
+    // the input stream
+    InputStream* p_is;
+    // the xml stream
+    XsoStream* p_xis;
+    // the xml buffer
+    XmlBuffer  d_xbuf;
+    // the open tag names
+    Strvec     d_stk;
+    // the current event
+    XmlReader::t_xevt d_xevt;
+    // the current event node
+    XmlNode*   p_xnod;
+    // the pending end tag flag
+    bool       d_pend;
+    // create a pull state by stream
+    s_xpul (InputStream* is) {
+      Object::iref (p_is = is);
+      p_xis  = new XsoStream (is);
+      d_xevt = XmlReader::XEVT_NONE;
+      p_xnod = nullptr;
+      d_pend = false;
+    }
+    // destroy this pull state
+    ~s_xpul (void) {
+      Object::dref (p_xnod);
+      delete p_xis;
+      Object::dref (p_is);
+    }
+    // set the current event node
+    void setxnod (XmlNode* node) {
+      Object::iref (node);
+      Object::dref (p_xnod);
+      p_xnod = node;
+      d_xevt = node_to_xevt (node);
+    }
+    // pull the next event
+    bool next (void) {
+      // check for a pending end tag
+      if (d_pend == true) {
+	d_pend = false;
+	XmlNode* node = new XmlEnd (d_stk.rml ());
+	node->setlnum (p_xnod->getlnum ());
+	setxnod (node);
+	return true;
+      }
+      // get the next node
+      XmlNode* node = p_xis->valid () ? parse_xml_node (*p_xis, d_xbuf) : nullptr;
+      setxnod (node);
+      // check for unclosed tags at the end of the stream
+      if (node == nullptr) {
+	if (d_stk.empty () == false) {
+	  throw Exception ("xml-error", "unterminated tag at end of stream",
+			   d_stk.last ());
+	}
+	return false;
+      }
+      // check for a start tag
+      if (d_xevt == XmlReader::XEVT_STAG) {
+	XmlTag* tag = dynamic_cast <XmlTag*> (node);
+	d_stk.add (tag->getname ());
+	d_pend = tag->geteflg ();
+	return true;
+      }
+      // check for an end tag
+      if (d_xevt == XmlReader::XEVT_ETAG) {
+	XmlEnd* etag = dynamic_cast <XmlEnd*> (node);
+	String name = etag->getname ();
+	if ((d_stk.empty () == true) || (d_stk.last () != name)) {
+	  throw Exception ("xml-error", "end tag name mismatch", name);
+	}
+	d_stk.rml ();
+	return true;
+      }
+      // check for a declaration which might change the version as well
+      // as the encoding
+      XmlDecl* decl = dynamic_cast <XmlDecl*> (node);
+      if (decl != nullptr) {
+	p_xis->setemod  (decl->getemod ());
+	d_xbuf.setxmlv (decl->getxvid ());
+      }
+      return true;
+    }
+    // build the subtree of the current start tag
+    XmlNode* materialize (void) {
+      // check for a start tag
+      if (d_xevt != XmlReader::XEVT_STAG) {
+	throw Exception ("xml-error", "materialize without a start tag event");
+      }
+      XmlNode* node = p_xnod;
+      Object::iref (node);
+      try {
+	// an empty tag is complete
+	if (d_pend == true) {
+	  next ();
+	  Object::tref (node);
+	  return node;
+	}
+	// parse the subtree until the tag is closed
+	if (parse_xml_tree (*p_xis, d_xbuf, node) == false) {
+	  throw Exception ("xml-error", "unterminated tag in materialize",
+			   d_stk.last ());
+	}
+	// move to the end tag
+	XmlNode* etag = new XmlEnd (d_stk.rml ());
+	etag->setlnum (d_xbuf.getlnum ());
+	setxnod (etag);
+	Object::tref (node);
+	return node;
+      } catch (...) {
+	Object::dref (node);
+	throw;
+      }
+    }
+  };
+
   // -------------------------------------------------------------------------
   // - class section                                                         -
   // -------------------------------------------------------------------------
@@ -1139,6 +1287,7 @@ namespace afnix {
   XmlReader::XmlReader (void) {
     d_xvid = XmlSystem::getxvid ();
     p_root = nullptr;
+    p_xpul = nullptr;
     reset ();
   }
 
@@ -1150,6 +1299,7 @@ namespace afnix {
     }
     d_xvid = xvid;
     p_root = nullptr;
+    p_xpul = nullptr;
     reset ();
   }
   
@@ -1158,6 +1308,7 @@ namespace afnix {
   XmlReader::~XmlReader (void) {
     reset ();
     Object::dref (p_root);
+    delete p_xpul;
   }
 
   // return the document class name
@@ -1173,6 +1324,8 @@ namespace afnix {
     try {
       Object::dref (p_root);
       p_root = nullptr;
+      delete p_xpul;
+      p_xpul = nullptr;
       unlock ();
     } catch (...) {
       unlock ();
@@ -1286,19 +1439,178 @@ namespace afnix {
     }
   }
 
+  // set the pull mode input stream
+
+  void XmlReader::setis (InputStream* is) {
+    wrlock ();
+    try {
+      delete p_xpul;
+      p_xpul = (is == nullptr) ? nullptr : new s_xpul (is);
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // set the pull mode input stream by string
+
+  void XmlReader::setis (const String& value) {
+    wrlock ();
+    try {
+      setis (new InputString (value));
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // pull the next event
+
+  bool XmlReader::next (void) {
+    wrlock ();
+    try {
+      bool result = (p_xpul == nullptr) ? false : p_xpul->next ();
+      unlock ();
+      return result;
+    } catch (Exception& e) {
+      e.updlnum (p_xpul->d_xbuf.getlnum ());
+      unlock ();
+      throw e;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get the current pull event
+
+  XmlReader::t_xevt XmlReader::getxevt (void) const {
+    rdlock ();
+    try {
+      t_xevt result = (p_xpul == nullptr) ? XEVT_NONE : p_xpul->d_xevt;
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get the current pull event node
+
+  XmlNode* XmlReader::getxnod (void) const {
+    rdlock ();
+    try {
+      XmlNode* result = (p_xpul == nullptr) ? nullptr : p_xpul->p_xnod;
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get the current pull depth
+
+  long XmlReader::getdpth (void) const {
+    rdlock ();
+    try {
+      long result = (p_xpul == nullptr) ? 0L : p_xpul->d_stk.length ();
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // build the subtree of the current start tag event
+
+  XmlNode* XmlReader::materialize (void) {
+    wrlock ();
+    try {
+      if (p_xpul == nullptr) {
+	throw Exception ("xml-error", "materialize without an input stream");
+      }
+      XmlNode* result = p_xpul->materialize ();
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // -------------------------------------------------------------------------
   // - object section                                                        -
   // -------------------------------------------------------------------------
 
+  // the object eval quarks
+  static const long QUARK_XMLREADER = String::intern ("XmlReader");
+  static const long QUARK_XEVTNONE  = String::intern ("NONE");
+  static const long QUARK_XEVTSTAG  = String::intern ("START");
+  static const long QUARK_XEVTETAG  = String::intern ("END");
+  static const long QUARK_XEVTTEXT  = String::intern ("TEXT");
+  static const long QUARK_XEVTXREF  = String::intern ("REFERENCE");
+  static const long QUARK_XEVTPI    = String::intern ("PI");
+  static const long QUARK_XEVTCOMT  = String::intern ("COMMENT");
+  static const long QUARK_XEVTDECL  = String::intern ("DECLARATION");
+
   // the quark zone
-  static const long QUARK_ZONE_LENGTH = 4;
+  static const long QUARK_ZONE_LENGTH = 11;
   static QuarkZone  zone (QUARK_ZONE_LENGTH);
 
   // the object supported quarks
+  static const long QUARK_NEXT    = zone.intern ("next");
   static const long QUARK_RESET   = zone.intern ("reset");
   static const long QUARK_PARSE   = zone.intern ("parse");
+  static const long QUARK_SETIS   = zone.intern ("set-input-stream");
   static const long QUARK_GETROOT = zone.intern ("get-root");
   static const long QUARK_GETNODE = zone.intern ("get-node");
+  static const long QUARK_GETXEVT = zone.intern ("get-event");
+  static const long QUARK_GETXNOD = zone.intern ("get-event-node");
+  static const long QUARK_GETDPTH = zone.intern ("get-depth");
+  static const long QUARK_MTRLZ   = zone.intern ("materialize");
+
+  // map a pull event to an item
+  static inline Item* xevt_to_item (const XmlReader::t_xevt xevt) {
+    switch (xevt) {
+    case XmlReader::XEVT_NONE:
+      return new Item (QUARK_XMLREADER, QUARK_XEVTNONE);
+    case XmlReader::XEVT_STAG:
+      return new Item (QUARK_XMLREADER, QUARK_XEVTSTAG);
+    case XmlReader::XEVT_ETAG:
+      return new Item (QUARK_XMLREADER, QUARK_XEVTETAG);
+    case XmlReader::XEVT_TEXT:
+      return new Item (QUARK_XMLREADER, QUARK_XEVTTEXT);
+    case XmlReader::XEVT_XREF:
+      return new Item (QUARK_XMLREADER, QUARK_XEVTXREF);
+    case XmlReader::XEVT_PI:
+      return new Item (QUARK_XMLREADER, QUARK_XEVTPI);
+    case XmlReader::XEVT_COMT:
+      return new Item (QUARK_XMLREADER, QUARK_XEVTCOMT);
+    case XmlReader::XEVT_DECL:
+      return new Item (QUARK_XMLREADER, QUARK_XEVTDECL);
+    }
+    return nullptr;
+  }
+
+  // evaluate an object data member
+
+  Object* XmlReader::meval (Evaluable* zobj, Nameset* nset, const long quark) {
+    if (quark == QUARK_XEVTNONE) return xevt_to_item (XEVT_NONE);
+    if (quark == QUARK_XEVTSTAG) return xevt_to_item (XEVT_STAG);
+    if (quark == QUARK_XEVTETAG) return xevt_to_item (XEVT_ETAG);
+    if (quark == QUARK_XEVTTEXT) return xevt_to_item (XEVT_TEXT);
+    if (quark == QUARK_XEVTXREF) return xevt_to_item (XEVT_XREF);
+    if (quark == QUARK_XEVTPI)   return xevt_to_item (XEVT_PI);
+    if (quark == QUARK_XEVTCOMT) return xevt_to_item (XEVT_COMT);
+    if (quark == QUARK_XEVTDECL) return xevt_to_item (XEVT_DECL);
+    throw Exception ("eval-error", "cannot evaluate member",
+                     String::qmap (quark));
+  }
 
   // create a new object in a generic way
 
@@ -1333,10 +1645,26 @@ namespace afnix {
 
     // check for 0 argument
     if (argc == 0) {
+      if (quark == QUARK_NEXT)    return new Boolean (next ());
+      if (quark == QUARK_GETDPTH) return new Integer (getdpth ());
+      if (quark == QUARK_GETXEVT) return xevt_to_item (getxevt ());
       if (quark == QUARK_RESET) {
 	reset ();
 	return nullptr;
       }
+      if (quark == QUARK_GETXNOD) {
+	rdlock ();
+	try {
+	  Object* result = getxnod ();
+	  zobj->post (result);
+	  unlock ();
+	  return result;
+	} catch (...) {
+	  unlock ();
+	  throw;
+	}
+      }
+      if (quark == QUARK_MTRLZ) return materialize ();
       if (quark == QUARK_GETROOT) {
 	rdlock ();
 	Object* result = getroot ();
@@ -1365,6 +1693,23 @@ namespace afnix {
 	throw Exception ("type-error", "invalid object with parse",
 			 Object::repr (obj));
       }
+      if (quark == QUARK_SETIS) {
+	Object* obj = argv->get (0);
+	// check for an input stream
+	InputStream* is = dynamic_cast <InputStream*> (obj);
+	if ((obj == nullptr) || (is != nullptr)) {
+	  setis (is);
+	  return nullptr;
+	}
+	// check for a string
+	String* sobj = dynamic_cast <String*> (obj);
+	if (sobj != nullptr) {
+	  setis (*sobj);
+	  return nullptr;
+	}
+	throw Exception ("type-error", "invalid object with set-input-stream",
+			 Object::repr (obj));
+      }
       if (quark == QUARK_GETNODE) {
 	Object* obj = argv->get (0);
 	if (obj == nullptr) return nullptr;
@@ -33,15 +33,39 @@ namespace afnix {
   /// Multiple read can be done sequentially. If the reset method is not 
   /// called between multiple read passes, the reader will accumulate the
   /// nodes in the current tree.
+  /// The reader can also operate in pull mode. In this mode, an input stream
+  /// is bound to the reader and the nodes are returned one at a time in the
+  /// form of events (start tag, end tag, text, reference, processing
+  /// instruction, comment or declaration). No tree is built and only the
+  /// current event node and the open tag names are kept by the reader. The
+  /// subtree of a start tag can be optionally built with the materialize
+  /// method.
   /// @author amaury darsch
 
   class XmlReader : public Object {
+  public:
+    /// the pull event type
+    enum t_xevt {
+      XEVT_NONE, // no event
+      XEVT_STAG, // start tag
+      XEVT_ETAG, // end tag
+      XEVT_TEXT, // text or cdata
+      XEVT_XREF, // character or entity reference
+      XEVT_PI,   // processing instruction
+      XEVT_COMT, // comment
+      XEVT_DECL  // declaration
+    };
+
   protected:
     /// the xml version
     String d_xvid;
     /// the root node
     XmlRoot* p_root;
 
+  private:
+    /// the pull state
+    struct s_xpul* p_xpul;
+
   public:
     /// create an empty reader
     XmlReader (void);
@@ -78,6 +102,33 @@ namespace afnix {
     /// @param value the string to parse
     virtual void parse (const String& value);
 
+    /// set the pull mode input stream
+    /// @param is the input stream to bind
+    virtual void setis (InputStream* is);
+
+    /// set the pull mode input stream by string
+    /// @param value the string to parse
+    virtual void setis (const String& value);
+
+    /// pull the next event - an unclosed tag at the end of the stream is
+    /// an error
+    /// @return false at the end of stream
+    virtual bool next (void);
+
+    /// @return the current pull event
+    virtual t_xevt getxevt (void) const;
+
+    /// @return the current pull event node
+    virtual XmlNode* getxnod (void) const;
+
+    /// @return the current pull depth
+    virtual long getdpth (void) const;
+
+    /// build the subtree of the current start tag event - the reader
+    /// is left on the matching end tag event
+    /// @return the start tag node with its children
+    virtual XmlNode* materialize (void);
+
   private:
     // make the copy constructor private
     XmlReader (const XmlReader&);
@@ -89,6 +140,12 @@ namespace afnix {
     /// @param argv the argument vector
     static Object* mknew (Vector* argv);
 
+    /// evaluate an object data member
+    /// @param zobj  the current evaluable
+    /// @param nset  the current nameset
+    /// @param quark the quark to evaluate
+    static Object* meval (Evaluable* zobj, Nameset* nset, const long quark);
+
     /// @return true if the given quark is defined
     bool isquark (const long quark, const bool hflg) const;
     
@@ -14,6 +14,7 @@
 // - copyright (c) 1999-2021 amaury darsch                                   -
 // ---------------------------------------------------------------------------
 
+#include "XmlTag.hpp"
 #include "XmlRoot.hpp"
 #include "Boolean.hpp"
 #include "Evaluable.hpp"
@@ -23,26 +24,76 @@
 
 namespace afnix {
 
+  // -------------------------------------------------------------------------
+  // - private section                                                       -
+  // -------------------------------------------------------------------------
+
+  // the xml id attribute name
+  static const String XML_ID_ATTR = "id";
+
+  // this procedure finds a tag node by id in a tree
+  static XmlTag* get_id_node (const XmlNode* node, const String& id) {
+    // check the node
+    if (node == nullptr) return nullptr;
+    XmlTag* tag = dynamic_cast <XmlTag*> (const_cast <XmlNode*> (node));
+    if ((tag != nullptr) && (tag->isattr (XML_ID_ATTR, id) == true)) {
+      return tag;
+    }
+    // look in the children
+    long clen = node->lenchild ();
+    for (long k = 0L; k < clen; k++) {
+      XmlTag* result = get_id_node (node->getchild (k), id);
+      if (result != nullptr) return result;
+    }
+    return nullptr;
+  }
+
   // -------------------------------------------------------------------------
   // - class section                                                         -
   // -------------------------------------------------------------------------
 
   // create a default root node
 
-  XmlRoot::XmlRoot (void) {}
+  XmlRoot::XmlRoot (void) {
+    p_xidx = nullptr;
+  }
 
   // create a root node with a declaration node
 
   XmlRoot::XmlRoot (const bool dflg) {
+    p_xidx = nullptr;
     if (dflg == true) addchild (new XmlDecl);
   }
 
+  // destroy this root node
+
+  XmlRoot::~XmlRoot (void) {
+    Object::dref (p_xidx);
+  }
+
   // return the class name
 
   String XmlRoot::repr (void) const {
     return "XmlRoot";
   }
 
+  // release all xml node links
+
+  void XmlRoot::release (void) {
+    wrlock ();
+    try {
+      // the tree is unlinked so the index is no longer valid
+      Object::dref (p_xidx);
+      p_xidx = nullptr;
+      // release the tree
+      XmlNode::release ();
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // get a clone of this node
 
   Object* XmlRoot::clone (void) const {
@@ -161,6 +212,69 @@ namespace afnix {
     }
   }
 
+  // get the tree index
+
+  XmlIndex* XmlRoot::getxidx (void) const {
+    rdlock ();
+    try {
+      XmlIndex* result = (p_xidx == nullptr) ? XmlNode::getxidx () : p_xidx;
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // set the tree index flag
+
+  void XmlRoot::setxidx (const bool xflg) {
+    wrlock ();
+    try {
+      if ((xflg == true) && (p_xidx == nullptr)) {
+	Object::iref (p_xidx = new XmlIndex (this));
+	p_xidx->reset ();
+      }
+      if ((xflg == false) && (p_xidx != nullptr)) {
+	Object::dref (p_xidx);
+	p_xidx = nullptr;
+      }
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // return true if the tree is indexed
+
+  bool XmlRoot::isxidx (void) const {
+    rdlock ();
+    try {
+      bool result = (p_xidx != nullptr);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get a tree node by id
+
+  XmlNode* XmlRoot::getid (const String& id) const {
+    rdlock ();
+    try {
+      XmlNode* result = (p_xidx == nullptr) ? get_id_node (this, id) :
+	p_xidx->getid (id);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // write a node to a buffer
 
   void XmlRoot::write (Buffer& buf) const {
@@ -202,7 +316,7 @@ namespace afnix {
   // -------------------------------------------------------------------------
 
   // the quark zone
-  static const long QUARK_ZONE_LENGTH = 4;
+  static const long QUARK_ZONE_LENGTH = 7;
   static QuarkZone  zone (QUARK_ZONE_LENGTH);
 
   // the object supported quarks
@@ -210,6 +324,9 @@ namespace afnix {
   static const long QUARK_DUPBODY = zone.intern ("dup-body");
   static const long QUARK_GETDECL = zone.intern ("get-declaration");
   static const long QUARK_GETEMOD = zone.intern ("get-encoding");
+  static const long QUARK_SETXIDX = zone.intern ("set-index");
+  static const long QUARK_XIDXP   = zone.intern ("index-p");
+  static const long QUARK_GETID   = zone.intern ("get-id-node");
 
   // create a new object in a generic way
 
@@ -245,6 +362,7 @@ namespace afnix {
     if (argc == 0) {
       if (quark == QUARK_DECLP)   return new Boolean (isdecl ());
       if (quark == QUARK_GETEMOD) return new String  (getemod ());
+      if (quark == QUARK_XIDXP)   return new Boolean (isxidx ());
       if (quark == QUARK_DUPBODY) return bdup ();
       if (quark == QUARK_GETDECL) {
 	rdlock ();
@@ -259,6 +377,27 @@ namespace afnix {
 	}
       }
     }
+    // check for 1 argument
+    if (argc == 1) {
+      if (quark == QUARK_SETXIDX) {
+	bool xflg = argv->getbool (0);
+	setxidx (xflg);
+	return nullptr;
+      }
+      if (quark == QUARK_GETID) {
+	String id = argv->getstring (0);
+	rdlock ();
+	try {
+	  XmlNode* result = getid (id);
+	  zobj->post (result);
+	  unlock ();
+	  return result;
+	} catch (...) {
+	  unlock ();
+	  throw;
+	}
+      }
+    }
     // check the xml node object
     return XmlNode::apply (zobj, nset, quark, argv);
   }
@@ -21,14 +21,24 @@
 #include "XmlDecl.hpp"
 #endif
 
+#ifndef  AFNIX_XMLINDEX_HPP
+#include "XmlIndex.hpp"
+#endif
+
 namespace afnix {
 
   /// The XmlRoot class is the top level root instanciated by the xml
   /// reader when starting to parse a stream. There should be only one
   /// root node in a tree. The root node does not have a parent node.
+  /// The root node can also own an index of its tree which is updated
+  /// when the tree is changed.
   /// @author amaury darsch
 
   class XmlRoot : public XmlNode {
+  private:
+    /// the tree index
+    XmlIndex* p_xidx;
+
   public:
     /// create a default root node
     XmlRoot (void);
@@ -37,9 +47,15 @@ namespace afnix {
     /// @param dflg the declaration flag
     XmlRoot (const bool dflg);
 
+    /// destroy this root node
+    ~XmlRoot (void);
+
     /// @return the class name
     String repr (void) const;
 
+    /// release this object
+    void release (void);
+
     /// @return a clone of this node
     Object* clone (void) const;
 
@@ -55,6 +71,20 @@ namespace afnix {
     /// @return the root encoding mode
     String getemod (void) const;
 
+    /// @return the tree index or nil
+    XmlIndex* getxidx (void) const;
+
+    /// set the tree index flag
+    /// @param xflg the index flag to set
+    void setxidx (const bool xflg);
+
+    /// @return true if the tree is indexed
+    bool isxidx (void) const;
+
+    /// @return a tree node by id or nil
+    /// @param id the node id to find
+    XmlNode* getid (const String& id) const;
+
     /// write a node into a buffer
     /// @param buf the buffer to write
     void write (Buffer& buf) const;
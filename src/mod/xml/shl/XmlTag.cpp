@@ -16,6 +16,7 @@
 
 #include "XmlTag.hpp"
 #include "Utility.hpp"
+#include "XmlIndex.hpp"
 #include "Boolean.hpp"
 #include "Integer.hpp"
 #include "Evaluable.hpp"
@@ -90,6 +91,8 @@ namespace afnix {
   void XmlTag::clrattr (void) {
     wrlock ();
     try {
+      XmlIndex* xidx = getxidx ();
+      if (xidx != nullptr) xidx->rmattr (this);
       d_alst.reset ();
       unlock ();
     } catch (...) {
@@ -145,7 +148,10 @@ namespace afnix {
   void XmlTag::setname (const String& name) {
     wrlock ();
     try {
+      XmlIndex* xidx = getxidx ();
+      if (xidx != nullptr) xidx->rmname (this, d_name);
       d_name = name;
+      if (xidx != nullptr) xidx->addname (this, d_name);
       unlock ();
     } catch (...) {
       unlock ();
@@ -173,6 +179,10 @@ namespace afnix {
     wrlock ();
     try {
       d_alst.add (prop);
+      XmlIndex* xidx = getxidx ();
+      if ((xidx != nullptr) && (prop != nullptr)) {
+	xidx->addattr (this, prop->getname (), prop->getpval ());
+      }
       unlock ();
     } catch (...) {
       unlock ();
@@ -185,7 +195,17 @@ namespace afnix {
   void XmlTag::setattr (const String& name, const Literal& lval) {
     wrlock ();
     try {
+      // remove the old attribute value from the index
+      XmlIndex* xidx = getxidx ();
+      Property* prop = (xidx == nullptr) ? nullptr : d_alst.find (name);
+      if (prop != nullptr) xidx->rmattr (this, name, prop->getpval ());
+      // set the attribute and index it
       d_alst.set (name, lval);
+      if (xidx != nullptr) {
+	prop = d_alst.find (name);
+	if (prop != nullptr) xidx->addattr (this, name, prop->getpval ());
+      }
+      unlock ();
     } catch (...) {
       unlock ();
       throw;
@@ -199,6 +219,7 @@ namespace afnix {
     try {
       String lval = Utility::tostring (xval);
       setattr (name, lval);
+      unlock ();
     } catch (...) {
       unlock ();
       throw;
@@ -212,6 +233,7 @@ namespace afnix {
     try {
       String lval = Utility::tohexa (xval, true, true);
       setattr (name, lval);
+      unlock ();
     } catch (...) {
       unlock ();
       throw;
@@ -283,7 +305,10 @@ namespace afnix {
   void XmlTag::addalst (const Plist& alst) {
     wrlock ();
     try {
+      XmlIndex* xidx = getxidx ();
+      if (xidx != nullptr) xidx->rmattr (this);
       d_alst += alst;
+      if (xidx != nullptr) xidx->addattr (this);
       unlock ();
     } catch (...) {
       unlock ();
@@ -296,7 +321,10 @@ namespace afnix {
   void XmlTag::setalst (const Plist& alst) {
     wrlock ();
     try {
+      XmlIndex* xidx = getxidx ();
+      if (xidx != nullptr) xidx->rmattr (this);
       d_alst = alst;
+      if (xidx != nullptr) xidx->addattr (this);
       unlock ();
     } catch (...) {
       unlock ();
@@ -331,7 +359,10 @@ namespace afnix {
 	throw Exception ("tag-error", "inconsistent tag to merge", d_name);
       }
       // merge the attributes
+      XmlIndex* xidx = getxidx ();
+      if (xidx != nullptr) xidx->rmattr (this);
       d_alst+= node.d_alst;
+      if (xidx != nullptr) xidx->addattr (this);
       // merge the child nodes
       long clen = node.lenchild ();
       for (long k = 0L; k < clen; k++) {
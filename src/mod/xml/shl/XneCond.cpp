@@ -24,6 +24,7 @@
 #include "Boolean.hpp"
 #include "Integer.hpp"
 #include "XneCond.hpp"
+#include "XmlIndex.hpp"
 #include "Evaluable.hpp"
 #include "XmlEntity.hpp"
 #include "QuarkZone.hpp"
@@ -224,6 +225,31 @@ namespace afnix {
     }
   }
 
+  // get the index candidates of this condition
+
+  Vector* XneCond::lookup (XmlIndex& xidx) const {
+    rdlock ();
+    try {
+      // look for an indexed condition
+      Vector* result = nullptr;
+      for (t_cond* cond = p_cond; cond != nullptr; cond = cond->p_next) {
+	if (cond->d_type == Xne::XNE_ID) {
+	  result = xidx.getattr (XML_ID_ATTR, cond->d_name);
+	  break;
+	}
+	if ((cond->d_type == Xne::XNE_TAG) && (cond->d_name.isnil () == false)) {
+	  result = xidx.getname (cond->d_name);
+	  break;
+	}
+      }
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // add a condition by type
   
   void XneCond::add (const Xne::t_xsel type) {
@@ -234,6 +260,7 @@ namespace afnix {
       // link to root
       cond->p_next = p_cond;
       p_cond = cond;
+      unlock ();
     } catch (...) {
       unlock ();
       throw;
@@ -250,6 +277,7 @@ namespace afnix {
       // link to root
       cond->p_next = p_cond;
       p_cond = cond;
+      unlock ();
     } catch (...) {
       unlock ();
       throw;
@@ -266,6 +294,7 @@ namespace afnix {
       // link to root
       cond->p_next = p_cond;
       p_cond = cond;
+      unlock ();
     } catch (...) {
       unlock ();
       throw;
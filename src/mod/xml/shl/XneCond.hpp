@@ -51,6 +51,10 @@ namespace afnix {
     /// @return true if the node satifies this condition
     bool valid (const XmlNode* node) const;
 
+    /// @return the index candidates of this condition or nil
+    /// @param xidx the tree index to query
+    Vector* lookup (class XmlIndex& xidx) const;
+
     /// add a condition by type
     /// @param type the condition type
     void add (const Xne::t_xsel type);
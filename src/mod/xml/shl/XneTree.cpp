@@ -17,6 +17,7 @@
 #include "XmlTag.hpp"
 #include "Integer.hpp"
 #include "XneTree.hpp"
+#include "XmlIndex.hpp"
 #include "Evaluable.hpp"
 #include "QuarkZone.hpp"
 #include "Exception.hpp"
@@ -234,6 +235,41 @@ namespace afnix {
     }
   }
 
+  // this procedure returns true if a node is a child of a parent node
+  static bool is_cond_child (XmlNode* node, XmlNode* pnod, const bool hflg) {
+    if (hflg == false) return (node->getparent () == pnod);
+    while (node != nullptr) {
+      if (node == pnod) return true;
+      node = node->getparent ();
+    }
+    return false;
+  }
+
+  // find the nodes that matches a condition with an index - the index
+  // candidates are in document order and filtered by tree position
+  static bool xidx_cond_xsel (Vector* result, XmlNode* node,
+			      const XneCond& cond, const bool hflg) {
+    // check for an index
+    XmlIndex* xidx = (node == nullptr) ? nullptr : node->getxidx ();
+    if (xidx == nullptr) return false;
+    // get the index candidates
+    Vector* nvec = cond.lookup (*xidx);
+    if (nvec == nullptr) return false;
+    try {
+      long nlen = nvec->length ();
+      for (long k = 0L; k < nlen; k++) {
+	XmlNode* cnod = dynamic_cast <XmlNode*> (nvec->get (k));
+	if (is_cond_child (cnod, node, hflg) == false) continue;
+	if (cond.valid (cnod) == true) result->add (cnod);
+      }
+      delete nvec;
+      return true;
+    } catch (...) {
+      delete nvec;
+      throw;
+    }
+  }
+
   // -------------------------------------------------------------------------
   // - class section                                                         -
   // -------------------------------------------------------------------------
@@ -434,6 +470,10 @@ namespace afnix {
     // create a result set
     Vector* result = new Vector;
     try {
+      if (xidx_cond_xsel (result, p_node, cond, hflg) == true) {
+	unlock ();
+	return result;
+      }
       if (hflg == true) {
 	tree_cond_xsel (result, p_node, cond);
       } else {
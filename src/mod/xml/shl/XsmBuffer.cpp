@@ -101,8 +101,8 @@ namespace afnix {
   void XsmBuffer::stripm (void) {
     // do nothing if negligeable
     if (d_blen == 0) return;
-    // get a new buffer
-    t_quad* ubuf = new t_quad[d_blen];
+    // compact in place since the write index never passes the read one
+    t_quad* ubuf = p_ubuf;
     // loop and accumulate with one space only
     long index = 0;
     for(long i = 0; i < d_blen; i++) {
@@ -121,9 +121,7 @@ namespace afnix {
       // add a space if preceding it nos a space
       if (is_spcc (ubuf[index-1]) == false) ubuf[index++] = blkq;
     }
-    // clean old buffer and update
-    delete [] p_ubuf;
-    p_ubuf = ubuf;
+    // update the length
     d_blen = index;
   }
 
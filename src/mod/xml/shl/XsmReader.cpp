@@ -148,6 +148,7 @@ namespace afnix {
     // state: s_text
     // read some text and accumulate
   s_text:
+    xis.scan (xbuf, "<");
     c = xis.getu ();
     switch (c) {
     case XSM_CHAR_LT:
@@ -184,6 +185,7 @@ namespace afnix {
     // state: s_ntag
     // read a tag with anything inside
   s_ntag:
+    xis.scan (xbuf, ">");
     c = xis.getu ();
     switch (c) {
     case XSM_CHAR_GT:
@@ -199,6 +201,7 @@ namespace afnix {
     // state: s_etag
     // read an end tag
   s_etag:
+    xis.scan (xbuf, ">");
     c = xis.getu ();
     switch (c) {
     case XSM_CHAR_GT:
@@ -301,6 +304,7 @@ namespace afnix {
     // state: s_ctag
     // read a comment node
   s_ctag:
+    xis.scan (xbuf, "-");
     c = xis.getu ();
     switch (c) {
     case XSM_CHAR_MN:
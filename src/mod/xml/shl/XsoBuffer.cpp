@@ -43,28 +43,29 @@ namespace afnix {
 
   XsoBuffer::XsoBuffer (void) {
     d_size = XSO_BUFFER_SIZE;
-    p_ubuf = new t_quad[d_size];
+    p_ubas = new t_quad[d_size];
+    p_ubuf = p_ubas;
     d_blen = 0;
     d_lnum = 0;
-    for (long i = 0; i < d_size; i++) p_ubuf[i] = nilq;
   }
 
   // create a new buffer with a string
 
   XsoBuffer::XsoBuffer (const String& xval) {
     d_size = XSO_BUFFER_SIZE;
-    p_ubuf = new t_quad[d_size];
+    p_ubas = new t_quad[d_size];
+    p_ubuf = p_ubas;
     d_blen = 0;
     d_lnum = 0;
-    for (long i = 0; i < d_size; i++) p_ubuf[i] = nilq;
     add (xval);
   }
 
   // copy construct this buffer
 
   XsoBuffer::XsoBuffer (const XsoBuffer& that){
-    d_size = that.d_size;
-    p_ubuf = new t_quad[d_size];
+    d_size = (that.d_blen < XSO_BUFFER_SIZE) ? XSO_BUFFER_SIZE : that.d_blen;
+    p_ubas = new t_quad[d_size];
+    p_ubuf = p_ubas;
     d_blen = that.d_blen;
     d_lnum = that.d_lnum;
     for (long i = 0; i < d_blen; i++) p_ubuf[i] = that.p_ubuf[i];
@@ -73,7 +74,7 @@ namespace afnix {
   // destroy this buffer
   
   XsoBuffer::~XsoBuffer (void) {
-    delete [] p_ubuf;
+    delete [] p_ubas;
   }
 
   // assign a buffer to this one
@@ -82,10 +83,11 @@ namespace afnix {
     // check for self-assignation
     if (this == &that) return *this;
     // clean the old buffer
-    delete [] p_ubuf;
+    delete [] p_ubas;
     // copy the data
-    d_size = that.d_size;
-    p_ubuf = new t_quad[d_size];
+    d_size = (that.d_blen < XSO_BUFFER_SIZE) ? XSO_BUFFER_SIZE : that.d_blen;
+    p_ubas = new t_quad[d_size];
+    p_ubuf = p_ubas;
     d_blen = that.d_blen;
     d_lnum = that.d_lnum;
     for (long i = 0; i < d_blen; i++) p_ubuf[i] = that.p_ubuf[i];
@@ -96,6 +98,7 @@ namespace afnix {
   // reset this buffer but do not change the size
   
   void XsoBuffer::reset (void) {
+    p_ubuf = p_ubas;
     d_blen = 0;
     d_lnum = 0;
   }
@@ -103,6 +106,7 @@ namespace afnix {
   // clear this buffer content
   
   void XsoBuffer::clear (void) {
+    p_ubuf = p_ubas;
     d_blen = 0;
     for (long i = 0; i < d_size; i++) p_ubuf[i] = nilq;
   }
@@ -143,14 +147,7 @@ namespace afnix {
   
   void XsoBuffer::add (const t_quad c) {
     // first check if we are at the buffer end
-    if (d_blen == d_size) {
-      long size = d_size * 2;
-      t_quad* buf = new t_quad[size];
-      for (long i = 0; i < d_blen; i++) buf[i] = p_ubuf[i];
-      delete [] p_ubuf;
-      d_size = size;
-      p_ubuf = buf;
-    }
+    if ((p_ubuf - p_ubas) + d_blen == d_size) reserve (1);
     p_ubuf[d_blen++] = c;
   }
 
@@ -161,6 +158,19 @@ namespace afnix {
     for (long i = 0; i < len; i++) add (s[i]);
   }
 
+  // add an ascii character array to this buffer
+
+  void XsoBuffer::add (const char* s, const long size) {
+    // check for nil first
+    if ((s == nullptr) || (size <= 0)) return;
+    // make room at the buffer end
+    reserve (size);
+    // copy the characters
+    t_quad* ubuf = p_ubuf + d_blen;
+    for (long i = 0; i < size; i++) ubuf[i] = (t_quad) ((t_byte) s[i]);
+    d_blen += size;
+  }
+
   // get the next unicode character but do not remove it
   
   t_quad XsoBuffer::get (void) const {
@@ -178,28 +188,23 @@ namespace afnix {
   t_quad XsoBuffer::getu (void) {
     // check for empty buffer character
     if (d_blen == 0) return nilq;
-    // get value and shift
-    long     ulen = d_blen - 1;
-    t_quad result = p_ubuf[0];
-    for (long i = 0; i < ulen; i++) p_ubuf[i] = p_ubuf[i+1];
-    p_ubuf[ulen] = nilq;
-    d_blen = ulen;
+    // get value and move the head
+    t_quad result = *p_ubuf++;
+    if (--d_blen == 0) p_ubuf = p_ubas;
     return result;
   }
   
   // pushback a character in this buffer
   
   void XsoBuffer::pushback (const t_quad c) {
-    // first check if we are at the buffer end
-    if (d_blen == d_size) {
-      long size = d_size * 2;
-      t_quad* buf = new t_quad[size];
-      for (long i = 0; i < d_blen; i++) buf[i] = p_ubuf[i];
-      delete [] p_ubuf;
-      d_size = size;
-      p_ubuf = buf;
+    // check if the head can be moved back
+    if (p_ubuf > p_ubas) {
+      *--p_ubuf = c;
+      d_blen++;
+      return;
     }
-    // shift the buffer by one
+    // make room and shift the buffer by one
+    reserve (1);
     for (long i = d_blen; i > 0; i--) p_ubuf[i] = p_ubuf[i-1];
     // pushback the character
     p_ubuf[0] = c;
@@ -309,4 +314,27 @@ namespace afnix {
     if (d_blen == 0) return false;
     return (p_ubuf[d_blen-1] == c);
   }
+
+  // reserve some room at the buffer end
+
+  void XsoBuffer::reserve (const long size) {
+    // check if the room is already there
+    long hpos = p_ubuf - p_ubas;
+    if (hpos + d_blen + size <= d_size) return;
+    // move the content at the buffer start if possible
+    if (d_blen + size <= d_size) {
+      for (long i = 0; i < d_blen; i++) p_ubas[i] = p_ubuf[i];
+      p_ubuf = p_ubas;
+      return;
+    }
+    // grow the buffer
+    long nsiz = d_size * 2;
+    while (nsiz < d_blen + size) nsiz *= 2;
+    t_quad* ubuf = new t_quad[nsiz];
+    for (long i = 0; i < d_blen; i++) ubuf[i] = p_ubuf[i];
+    delete [] p_ubas;
+    d_size = nsiz;
+    p_ubas = ubuf;
+    p_ubuf = ubuf;
+  }
 }
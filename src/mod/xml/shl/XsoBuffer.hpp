@@ -28,14 +28,18 @@ namespace afnix {
   /// accumulates unicode characters but do not provide at this level the
   /// xml/xsm specific verifications. One feature provided at this level is
   /// the character reference transformation which is needed by the xso 
-  /// input stream.
+  /// input stream. The buffer reads its characters by moving its head
+  /// inside the allocated array, so that reading and pushing back a
+  /// character are constant time operations.
   /// @author amaury darsch
 
   class XsoBuffer {
   protected:
     /// the buffer size
     long    d_size;
-    /// the unicode buffer
+    /// the allocated buffer
+    t_quad* p_ubas;
+    /// the unicode buffer head
     t_quad* p_ubuf;
     /// the buffer length
     long    d_blen;
@@ -92,6 +96,11 @@ namespace afnix {
     /// @param s the string to add
     virtual void add (const String& s);
 
+    /// add an ascii character array to this buffer
+    /// @param s    the ascii array to add
+    /// @param size the array size
+    virtual void add (const char* s, const long size);
+
     /// @return the next unicode character but do not remove it
     virtual t_quad get (void) const;
 
@@ -127,6 +136,10 @@ namespace afnix {
     /// compare the last character
     /// @param c the character to compare
     virtual bool islast (const t_quad c) const;
+
+  private:
+    // reserve some room at the buffer end
+    void reserve (const long size);
   };
 }
 
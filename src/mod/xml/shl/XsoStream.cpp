@@ -17,6 +17,7 @@
 #include "Unicode.hpp"
 #include "XsoStream.hpp"
 #include "Exception.hpp"
+#include "InputBuffer.hpp"
 
 namespace afnix {
 
@@ -29,6 +30,9 @@ namespace afnix {
   // the xml character reference
   static const t_quad XSO_CHAR_AM = 0x00000026UL;
   static const t_quad XSO_CHAR_SC = 0x0000003BUL;
+  // the byte window initial and maximum size
+  static const long   XSO_WBUF_MINS = 256L;
+  static const long   XSO_WBUF_SIZE = 4096L;
 
   // -------------------------------------------------------------------------
   // - class section                                                         -
@@ -43,14 +47,21 @@ namespace afnix {
     Object::iref (p_is = is);
     d_lnum = 1;
     d_xbuf.reset ();
- }
+    p_wbuf = nullptr;
+    d_wsiz = 0L;
+    d_wpos = 0L;
+    d_wlen = 0L;
+    bind ();
+  }
 
   // destroy this xml stream
   
   XsoStream::~XsoStream (void) {
     if (p_is != nullptr) {
+      flush ();
       if (d_xbuf.empty () == false) p_is->pushback (d_xbuf.tostring ());
     }
+    delete [] p_wbuf;
     Object::tref (p_is);
   }
 
@@ -63,12 +74,15 @@ namespace afnix {
   // set the stream encoding mode
 
   void XsoStream::setemod (const String& mode) {
+    flush ();
     p_is->setemod (mode);
+    bind ();
   }
 
   // return true if the stream is valid
 
   bool XsoStream::valid (void) const {
+    if (d_wpos < d_wlen) return true;
     return p_is->valid ();
   }
   
@@ -84,7 +98,7 @@ namespace afnix {
     }
 
     // check for & character
-    t_quad c = p_is->getu ();
+    t_quad c = getc ();
     if (c != XSO_CHAR_AM) {
       if (c == eolq) d_lnum++;
       return c;
@@ -93,7 +107,7 @@ namespace afnix {
 
     // accumulate characters until a ; character
   s_sref:
-    c = p_is->getu ();
+    c = getc ();
     switch (c) {
     case XSO_CHAR_SC:
       d_xbuf.add(c);
@@ -107,7 +121,11 @@ namespace afnix {
     case tabq:
     case eolq:
     case eosq:
-      p_is->pushback (c);
+      if (d_wpos > 0L) {
+	p_wbuf[--d_wpos] = (char) c;
+      } else {
+	p_is->pushback (c);
+      }
       c = d_xbuf.getu ();
       if (c == eolq) d_lnum++;
       return c;
@@ -126,4 +144,92 @@ namespace afnix {
     if ((c == eolq) && (d_lnum > 1)) d_lnum--;
     d_xbuf.pushback (c);
   }
+
+  // scan an ascii run into a buffer until a stop character
+
+  long XsoStream::scan (XsoBuffer& xbuf, const char* sset) {
+    // the pending characters must be read first
+    if ((p_wbuf == nullptr) || (d_xbuf.empty () == false)) return 0L;
+    // loop in the window
+    long wpos = d_wpos;
+    while (wpos < d_wlen) {
+      char c = p_wbuf[wpos];
+      // stop on a non ascii byte or a reference
+      if ((c & 0x80) || (c == '&')) break;
+      // check the stop set
+      const char* sptr = sset;
+      while ((*sptr != nilc) && (*sptr != c)) sptr++;
+      if (*sptr != nilc) break;
+      if (c == eolc) d_lnum++;
+      wpos++;
+    }
+    // copy the run
+    long result = wpos - d_wpos;
+    xbuf.add (&p_wbuf[d_wpos], result);
+    d_wpos = wpos;
+    return result;
+  }
+
+  // bind the byte window by stream
+
+  void XsoStream::bind (void) {
+    // check for a buffered utf-8 stream
+    bool wflg = (p_is->getemod () == Encoding::EMOD_UTF8) &&
+      (dynamic_cast <InputBuffer*> (p_is) != nullptr);
+    if (wflg == false) {
+      delete [] p_wbuf;
+      p_wbuf = nullptr;
+    } else if (p_wbuf == nullptr) {
+      p_wbuf = new char[XSO_WBUF_SIZE];
+    }
+    d_wsiz = XSO_WBUF_MINS;
+    d_wpos = 0L;
+    d_wlen = 0L;
+  }
+
+  // flush the byte window into the stream
+
+  void XsoStream::flush (void) {
+    if (d_wpos < d_wlen) p_is->pushback (&p_wbuf[d_wpos], d_wlen - d_wpos);
+    d_wpos = 0L;
+    d_wlen = 0L;
+  }
+
+  // read the next unicode character from the stream
+
+  t_quad XsoStream::getc (void) {
+    // check for a byte window
+    if (p_wbuf == nullptr) return p_is->getu ();
+    // refill the window if needed - the window grows with the reads
+    // so that a short lived stream does not read ahead too much
+    if (d_wpos == d_wlen) {
+      d_wpos = 0L;
+      d_wlen = p_is->copy (p_wbuf, d_wsiz);
+      if (d_wsiz < XSO_WBUF_SIZE) d_wsiz *= 2L;
+      if (d_wlen <= 0L) {
+	d_wlen = 0L;
+	return p_is->getu ();
+      }
+    }
+    // check for an ascii character
+    char* wptr = &p_wbuf[d_wpos];
+    if ((*wptr & 0x80) == 0x00) {
+      d_wpos++;
+      return (t_quad) *wptr;
+    }
+    // validate the utf-8 sequence in the window
+    long wlen = d_wlen - d_wpos;
+    for (long i = 0; i < Unicode::MAX_UTF8_SIZE; i++) {
+      if (i == wlen) {
+	// the sequence crosses the window end
+	flush ();
+	return p_is->getu ();
+      }
+      if (Unicode::valid (Encoding::EMOD_UTF8, wptr, i+1) == true) {
+	d_wpos += i+1;
+	return Unicode::decode (wptr);
+      }
+    }
+    throw Exception ("read-error", "cannot read unicode character");
+  }
 }
@@ -29,7 +29,12 @@ namespace afnix {
 
   /// The XsoStream class is a xml/xsm standard input stream class designed
   /// to handle the inline character reference found with most of sgml/xml
-  /// documents.
+  /// documents. When the input stream is a buffered utf-8 stream, the
+  /// stream reads ahead a byte window which is decoded in place, with
+  /// the unicode validation being only performed on non ascii bytes. The
+  /// scan method can also be used to move ascii runs directly from the
+  /// window into a buffer. The unread window bytes are pushed back into
+  /// the input stream when the xso stream is destroyed.
   /// @author amaury darsch
 
   class XsoStream {
@@ -40,6 +45,14 @@ namespace afnix {
     long   d_lnum;
     /// the xml buffer
     XsoBuffer d_xbuf;
+    /// the byte window
+    char* p_wbuf;
+    /// the window size
+    long  d_wsiz;
+    /// the window position
+    long  d_wpos;
+    /// the window length
+    long  d_wlen;
 
   public:
     /// create a new xml stream by input stream
@@ -66,7 +79,20 @@ namespace afnix {
     /// @param c the unicode character to pushback
     void pushback (const t_quad c);
 
+    /// scan an ascii run into a buffer until a stop character
+    /// @param xbuf the buffer to fill
+    /// @param sset the stop character set
+    /// @return the number of scanned characters
+    long scan (XsoBuffer& xbuf, const char* sset);
+
   private:
+    // bind the byte window by stream
+    void bind (void);
+    // flush the byte window into the stream
+    void flush (void);
+    // read the next unicode character from the stream
+    t_quad getc (void);
+
     // make the copy constuctor private
     XsoStream (const XsoStream&);
     // make the assignment operator private
@@ -25,6 +25,7 @@ namespace afnix {
   //                vvtt pppp pllu uuuu
   // bce serial id [0000 0000 0100 0001][@0x0041]
   static const t_word SRL_RQST_SID = 0x0001U; // request id
+  static const t_word SRL_TRAN_SID = 0x0002U; // transaction id
   static const t_word SRL_BLOK_SID = 0x0010U; // block id
   static const t_word SRL_LGDR_SID = 0x0011U; // ledger id
   static const t_word SRL_BCHN_SID = 0x0012U; // chain id
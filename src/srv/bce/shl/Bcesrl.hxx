@@ -31,6 +31,9 @@ namespace afnix {
     case SRL_RQST_SID:
       return new Request;
       break;
+    case SRL_TRAN_SID:
+      return new Transaction;
+      break;
     case SRL_BLOK_SID:
       return new Block;
       break;
@@ -18,11 +18,14 @@
 #include "Block.hpp"
 #include "Bcesid.hxx"
 #include "Crypto.hpp"
+#include "Sha256.hpp"
 #include "Vector.hpp"
+#include "Boolean.hpp"
 #include "Integer.hpp"
 #include "Evaluable.hpp"
 #include "QuarkZone.hpp"
 #include "Exception.hpp"
+#include "OutputBuffer.hpp"
 
 namespace afnix {
 
@@ -56,6 +59,15 @@ namespace afnix {
     p_sign = nullptr;
   }
 
+  // create an block by transaction and previous hash
+
+  Block::Block (Transaction* tran, const Relatif& hash) {
+    d_stmp = Time::gettclk ();
+    d_hash = hash;
+    Object::iref (p_tran = tran);
+    p_sign = nullptr;
+  }
+
   // copy construct this block
 
   Block::Block (const Block& that) {
@@ -331,17 +343,70 @@ namespace afnix {
     }
   }
   
+  // get the previous block hash
+
+  Relatif Block::getprev (void) const {
+    rdlock ();
+    try {
+      Relatif result = d_hash;
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get the block hash
+
+  Relatif Block::tohash (void) const {
+    rdlock ();
+    try {
+      // serialize the signed content
+      OutputBuffer ob;
+      wrsign (ob);
+      Buffer sbuf = ob.tobuffer ();
+      // hash the content
+      Sha256 hobj;
+      hobj.process (sbuf);
+      hobj.finish ();
+      Relatif result = hobj.gethval ();
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // check if the block is signed
+
+  bool Block::issigned (void) const {
+    rdlock ();
+    try {
+      bool result = (p_sign != nullptr);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // -------------------------------------------------------------------------
   // - object section                                                        -
   // -------------------------------------------------------------------------
 
   // the quark zone
-  static const long QUARK_ZONE_LENGTH = 2;
+  static const long QUARK_ZONE_LENGTH = 5;
   static QuarkZone  zone (QUARK_ZONE_LENGTH);
 
   // the object supported quarks
   static const long QUARK_GETSTMP = zone.intern ("get-timestamp");
   static const long QUARK_GETTRAN = zone.intern ("get-transaction");
+  static const long QUARK_GETPREV = zone.intern ("get-previous-hash");
+  static const long QUARK_TOHASH  = zone.intern ("to-hash");
+  static const long QUARK_SIGNEDP = zone.intern ("signed-p");
 
   // create a new object in a generic way
 
@@ -394,6 +459,9 @@ namespace afnix {
     // check for 0 argument
     if (argc == 0) {
       if (quark == QUARK_GETSTMP) return new Integer (getstmp ());
+      if (quark == QUARK_GETPREV) return new Relatif (getprev ());
+      if (quark == QUARK_TOHASH)  return new Relatif (tohash ());
+      if (quark == QUARK_SIGNEDP) return new Boolean (issigned ());
       if (quark == QUARK_GETTRAN) {
 	rdlock ();
 	try {
@@ -34,6 +34,9 @@ namespace afnix {
   /// The Block class is base constituent of the block chain. The block is
   /// designed to act a linked transaction. It contains the block time, the
   /// hash of the previous block, a transaction and the block signature.
+  /// The block hash is computed with the signed content, that is the block
+  /// time, the previous block hash and the transaction, so that a block can
+  /// be linked before it is signed.
   /// @author amaury darsch
 
   class Block : public virtual Serial, public Signable {
@@ -55,6 +58,11 @@ namespace afnix {
     /// @param tran the block transaction
     Block (Transaction* tran);
 
+    /// create a block by transaction and previous hash
+    /// @param tran the block transaction
+    /// @param hash the previous block hash
+    Block (Transaction* tran, const Relatif& hash);
+
     /// copy construct this block
     /// @param that the object to copy
     Block (const Block& that);
@@ -113,6 +121,15 @@ namespace afnix {
 
     /// @return the block transaction
     virtual Transaction* gettran (void) const;
+
+    /// @return the previous block hash
+    virtual Relatif getprev (void) const;
+
+    /// @return the block hash
+    virtual Relatif tohash (void) const;
+
+    /// @return true if the block is signed
+    virtual bool issigned (void) const;
     
   public:
     /// create a new object in a generic way
@@ -18,10 +18,12 @@
 #include "Chain.hpp"
 #include "Bcesid.hxx"
 #include "Utility.hpp"
+#include "Boolean.hpp"
 #include "Integer.hpp"
 #include "Evaluable.hpp"
 #include "QuarkZone.hpp"
 #include "Exception.hpp"
+#include "cthr.hpp"
 
 namespace afnix {
 
@@ -36,6 +38,82 @@ namespace afnix {
   static const String PI_CHN_MTIM = "CHAIN MODIFICATION TIME";
   static const String PN_CHN_RLEN = "PN-CHN-RLEN";
   static const String PI_CHN_RLEN = "CHAIN REQUEST LENGTH";
+  // the maximum number of validation tasks
+  static const long   CHN_TASK_TMAX = 8L;
+  // the minimum number of requests per task
+  static const long   CHN_TASK_RMIN = 64L;
+
+  // the request validation structure
+  struct s_cvld {
+    // the chain to use
+    const Chain* p_bchn;
+    // the request vector
+    Vector* p_rvec;
+    // the logger object
+    Logger* p_logr;
+    // the validation flags
+    bool*   p_vflg;
+    // the start index
+    long    d_sidx;
+    // the end index
+    long    d_eidx;
+    // the error flag
+    bool    d_eflg;
+    // validate the request range
+    void validate (void) {
+      try {
+	for (long k = d_sidx; k < d_eidx; k++) {
+	  auto rqst = dynamic_cast<Request*>(p_rvec->get (k));
+	  p_vflg[k] = (rqst == nullptr) || p_bchn->validate (*rqst, p_logr);
+	}
+      } catch (...) {
+	d_eflg = true;
+      }
+    }
+  };
+
+  // this procedure runs a request validation task
+  static void* chn_validate_task (void* args) {
+    reinterpret_cast <s_cvld*> (args)->validate ();
+    return nullptr;
+  }
+
+  // this procedure validates a request vector by contiguous ranges
+  static void chn_validate (const Chain& bchn, Vector* rvec, bool* vflg,
+			    const long rlen, Logger* logr) {
+    if (rlen == 0L) return;
+    long tnum = (rlen + CHN_TASK_RMIN - 1L) / CHN_TASK_RMIN;
+    if (tnum > CHN_TASK_TMAX) tnum = CHN_TASK_TMAX;
+    s_cvld* cvld = new s_cvld[tnum];
+    void**  args = new void*[tnum];
+    for (long t = 0L; t < tnum; t++) {
+      cvld[t].p_bchn = &bchn;
+      cvld[t].p_rvec = rvec;
+      cvld[t].p_logr = logr;
+      cvld[t].p_vflg = vflg;
+      cvld[t].d_sidx = (rlen * t) / tnum;
+      cvld[t].d_eidx = (rlen * (t + 1L)) / tnum;
+      cvld[t].d_eflg = false;
+      args[t] = &cvld[t];
+    }
+    c_tskrun (chn_validate_task, args, tnum);
+    bool eflg = false;
+    for (long t = 0L; t < tnum; t++) eflg = eflg || cvld[t].d_eflg;
+    delete [] args;
+    delete [] cvld;
+    if (eflg == true) {
+      throw Exception ("chain-error", "cannot validate chain request");
+    }
+  }
+
+  // this procedure links a transaction batch with a ledger
+  static bool chn_link (Ledger*& lgdr, Vector& tvec, const Key& skey) {
+    if (tvec.length () == 0L) return true;
+    if (lgdr == nullptr) Object::iref (lgdr = new Ledger);
+    bool result = lgdr->link (tvec, skey);
+    tvec.reset ();
+    return result;
+  }
   
   // -------------------------------------------------------------------------
   // - class section                                                         -
@@ -48,6 +126,7 @@ namespace afnix {
     d_mtim = 0L;
     p_rstk = nullptr;
     p_lgdr = nullptr;
+    p_tbch = nullptr;
   }
   
   // copy construct this chain
@@ -59,6 +138,7 @@ namespace afnix {
       d_mtim = that.d_mtim;
       Object::iref (p_rstk = that.p_rstk);
       Object::iref (p_lgdr = that.p_lgdr);
+      p_tbch = nullptr;
       that.unlock ();
     } catch (...) {
       that.unlock ();
@@ -81,12 +161,14 @@ namespace afnix {
       p_rstk = nullptr;
       p_lgdr = nullptr;
     }
+    p_tbch = nullptr;
     that.unlock ();
   }
 
   // destroy this chain
 
   Chain::~Chain (void) {
+    Object::dref (p_rstk);
     Object::dref (p_lgdr);
   }
   
@@ -303,7 +385,7 @@ namespace afnix {
     wrlock ();
     try {
       // add the request
-      if (p_rstk == nullptr) p_rstk = new Vector;
+      if (p_rstk == nullptr) Object::iref (p_rstk = new Vector);
       p_rstk->add (rqst);
       // update the times
       if (d_ctim == 0L) {
@@ -322,21 +404,70 @@ namespace afnix {
   // process the request stack by signing key
 
   bool Chain::process (const Key& skey, Logger* logr) {
+    // collect the requests in order and clean the stack
+    Vector rvec;
+    wrlock ();
+    try {
+      long slen = (p_rstk == nullptr) ? 0L : p_rstk->length ();
+      for (long k = 0L; k < slen; k++) rvec.add (p_rstk->get (k));
+      if (p_rstk != nullptr) p_rstk->reset ();
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+    // validate the requests in parallel without the chain lock
+    long  rlen = rvec.length ();
+    bool* vflg = (rlen == 0L) ? nullptr : new bool[rlen];
+    try {
+      chn_validate (*this, &rvec, vflg, rlen, logr);
+    } catch (...) {
+      delete [] vflg;
+      throw;
+    }
+    // process the requests in order
     wrlock ();
     try {
+      Vector tbch;
+      p_tbch = &tbch;
       bool status = true;
-      while ((p_rstk != nullptr) && (p_rstk->empty () == false)) {
+      for (long k = 0L; (k < rlen) && (status == true); k++) {
 	// get the request
-	auto rqst = dynamic_cast<Request*>(p_rstk->pop ());
-	if ((rqst == nullptr) || (status == false)) continue;
-	status = status & validate (*rqst, logr);
-	if (status == false) continue;
-	// default processing
-	status = status && process (*rqst, skey, logr);
+	auto rqst = dynamic_cast<Request*>(rvec.get (k));
+	if (rqst == nullptr) continue;
+	if (vflg[k] == false) {
+	  status = false;
+	  continue;
+	}
+	// link the batch before any other request
+	if (rqst->getcode () != Request::TR_CODE_LINK) {
+	  status = chn_link (p_lgdr, tbch, skey);
+	  if (status == false) continue;
+	}
+	status = process (*rqst, skey, logr);
       }
-      // restore chain state with bad status
+      // link the remaining batch
+      status = chn_link (p_lgdr, tbch, skey) && status;
+      p_tbch = nullptr;
+      delete [] vflg;
       unlock ();
       return status;
+    } catch (...) {
+      p_tbch = nullptr;
+      delete [] vflg;
+      unlock ();
+      throw;
+    }
+  }
+
+  // verify the blockchain
+
+  bool Chain::verify (void) const {
+    rdlock ();
+    try {
+      bool result = (p_lgdr == nullptr) ? true : p_lgdr->verify ();
+      unlock ();
+      return result;
     } catch (...) {
       unlock ();
       throw;
@@ -362,8 +493,14 @@ namespace afnix {
       long code = rqst.getcode ();
       // check for a link code
       if (code == Request::TR_CODE_LINK) {
-	if (p_lgdr == nullptr) p_lgdr = new Ledger;
-	status = p_lgdr->link (rqst.gettran (), skey);
+	Transaction* tran = rqst.gettran ();
+	if ((p_tbch != nullptr) && (tran != nullptr)) {
+	  // batch the transaction with the processing
+	  p_tbch->add (tran);
+	} else {
+	  if (p_lgdr == nullptr) Object::iref (p_lgdr = new Ledger);
+	  status = p_lgdr->link (tran, skey);
+	}
       } else {
 	if (logr != nullptr) {
 	  String mesg = "[afnix] invalid request code to process ";
@@ -386,11 +523,13 @@ namespace afnix {
   // -------------------------------------------------------------------------
 
   // the quark zone
-  static const long QUARK_ZONE_LENGTH = 4;
+  static const long QUARK_ZONE_LENGTH = 6;
   static QuarkZone  zone (QUARK_ZONE_LENGTH);
 
   // the object supported quarks
   static const long QUARK_PUSH    = zone.intern ("push");
+  static const long QUARK_VERIFY  = zone.intern ("verify");
+  static const long QUARK_PROCESS = zone.intern ("process");
   static const long QUARK_GETLGDR = zone.intern ("get-ledger");
   static const long QUARK_GETCTIM = zone.intern ("get-creation-time");
   static const long QUARK_GETMTIM = zone.intern ("get-modification-time");
@@ -435,6 +574,7 @@ namespace afnix {
     if (argc == 0) {
       if (quark == QUARK_GETCTIM) return new Integer (getctim ());
       if (quark == QUARK_GETMTIM) return new Integer (getmtim ());
+      if (quark == QUARK_VERIFY)  return new Boolean (verify ());
       if (quark == QUARK_GETLGDR) {
 	rdlock ();
 	try {
@@ -460,6 +600,33 @@ namespace afnix {
 	push (rqst);
 	return nullptr;
       }
+      if (quark == QUARK_PROCESS) {
+	Object* obj = argv->get (0);
+	auto skey = dynamic_cast <Key*> (obj);
+	if (skey == nullptr) {
+	  throw Exception ("type-error", "invalid object for chain process",
+			   Object::repr (obj));
+	}
+	return new Boolean (process (*skey, nullptr));
+      }
+    }
+    // check for 2 arguments
+    if (argc == 2) {
+      if (quark == QUARK_PROCESS) {
+	Object* obj = argv->get (0);
+	auto skey = dynamic_cast <Key*> (obj);
+	if (skey == nullptr) {
+	  throw Exception ("type-error", "invalid object for chain process",
+			   Object::repr (obj));
+	}
+	obj = argv->get (1);
+	auto logr = dynamic_cast <Logger*> (obj);
+	if ((obj != nullptr) && (logr == nullptr)) {
+	  throw Exception ("type-error", "invalid object for chain process",
+			   Object::repr (obj));
+	}
+	return new Boolean (process (*skey, logr));
+      }
     }
     // call the serial method
     return Serial::apply (zobj, nset, quark, argv);
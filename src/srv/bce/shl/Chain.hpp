@@ -35,10 +35,17 @@ namespace afnix {
   /// The blockchain is the assocation of a ledger, a request stack and a
   /// public signing key used for the block chain integrity verification.
   /// The chain object is designed to process the request stack and inserts
-  /// the block in the chain.
+  /// the block in the chain. The requests are validated in parallel without
+  /// the chain lock, while the link requests are added in order to the
+  /// ledger by batch.
   /// @author amaury darsch
 
   class Chain : public virtual Serial {
+  private:
+    friend struct s_cvld;
+    /// the link transaction batch
+    Vector* p_tbch;
+
   protected:
     /// the chain creation time
     t_long d_ctim;
@@ -117,15 +124,18 @@ namespace afnix {
     virtual bool process (const Key& skey, Logger* logr);
     
     /// verify the blockchain
-    //virtual bool verify (void) const;
+    virtual bool verify (void) const;
 
   protected:
-    /// validate a request before processing it
+    /// validate a request before processing it - this method is called
+    /// by several threads without the chain lock
     /// @param rqst the request to validate
     /// @param logr the logger object
     virtual bool validate (const Request& rqst, Logger* logr) const;
     
-    /// process a request by signing key
+    /// process a request by signing key - during the stack processing, the
+    /// link requests are batched and the batch is linked before any other
+    /// request is processed
     /// @param rqst the request to process
     /// @param skey the signing key
     /// @param logr the logger object
@@ -15,13 +15,22 @@
 // ---------------------------------------------------------------------------
 
 #include "Date.hpp"
+#include "Ascii.hpp"
 #include "Bcesid.hxx"
 #include "Ledger.hpp"
+#include "System.hpp"
 #include "Boolean.hpp"
 #include "Integer.hpp"
+#include "Utility.hpp"
+#include "Relatif.hpp"
 #include "Evaluable.hpp"
 #include "QuarkZone.hpp"
 #include "Exception.hpp"
+#include "InputOutput.hpp"
+#include "OutputBuffer.hpp"
+#include "cmem.hpp"
+#include "csio.hpp"
+#include "cthr.hpp"
 
 namespace afnix {
 
@@ -36,7 +45,747 @@ namespace afnix {
   static const String PI_LGR_MTIM = "LEDGER MODIFICATION TIME";
   static const String PN_LGR_BLEN = "PN-LGR-BLEN";
   static const String PI_LGR_BLEN = "LEDGER BLOCK LENGTH";
-  
+
+  // the ledger file magic numbers
+  static const long   LGR_MSIZE   = 4;
+  static const char   LGR_IMAGIC[] = {'\177', 'B', 'L', 'I'};
+  static const char   LGR_SMAGIC[] = {'\177', 'B', 'L', 'S'};
+  static const char   LGR_CMAGIC[] = {'\177', 'B', 'L', 'C'};
+  static const char   LGR_RMAGIC[] = {'\177', 'B', 'L', 'R'};
+  // the ledger file version
+  static const t_byte LGR_VERSION = 0x03;
+  // the ledger byte order marker
+  static const t_octa LGR_BOMARK  = 0x0102030405060708ULL;
+  // the ledger file and record header size
+  static const long   LGR_HSIZE   = 32L;
+  // the block hash size
+  static const long   LGR_HLEN    = 32L;
+  // the maximum segment size
+  static const long   LGR_SMAX    = 67108864L;
+  // the block cache size
+  static const long   LGR_CSIZE   = 64L;
+  // the maximum number of block tasks
+  static const long   LGR_TASK_TMAX = 8L;
+  // the minimum number of blocks per task
+  static const long   LGR_TASK_BMIN = 64L;
+  // the fnv checksum basis and prime
+  static const t_octa LGR_FNVBAS  = 0xcbf29ce484222325ULL;
+  static const t_octa LGR_FNVPRM  = 0x00000100000001b3ULL;
+  // the ledger file names
+  static const String LGR_IDXNAME = "ledger.idx";
+  static const String LGR_SUMNAME = "ledger.sum";
+  static const String LGR_SEGPREF = "ledger-";
+  static const String LGR_SEGSUFX = ".seg";
+
+  // the ledger file header
+  struct s_lhdr {
+    // the magic number
+    char   d_magic[LGR_MSIZE];
+    // the version
+    t_byte d_vers;
+    // the padding bytes
+    t_byte d_pads[3];
+    // the byte order marker
+    t_octa d_bomk;
+    // the creation time or segment index
+    t_long d_ctim;
+    // the modification time
+    t_long d_mtim;
+  };
+
+  // the segment record header
+  struct s_lrec {
+    // the magic number
+    char   d_magic[LGR_MSIZE];
+    // the padding bytes
+    t_byte d_pads[4];
+    // the block index
+    t_long d_bidx;
+    // the block size
+    t_long d_bsiz;
+    // the block timestamp
+    t_long d_stmp;
+  };
+
+  // the index entry
+  struct s_lent {
+    // the segment index
+    t_long d_sidx;
+    // the record offset
+    t_long d_boff;
+    // the block size
+    t_long d_bsiz;
+    // the block timestamp
+    t_long d_stmp;
+    // the block hash
+    t_byte d_hash[LGR_HLEN];
+  };
+
+  // the checksum entry
+  struct s_lsum {
+    // the segment checksum
+    t_octa d_csum;
+    // the checksummed segment size
+    t_long d_size;
+  };
+
+  // the segment descriptor
+  struct s_lseg {
+    // the segment size
+    long   d_size;
+    // the segment checksum
+    t_octa d_csum;
+    // the mapped buffer
+    char*  p_mbuf;
+    // the mapped size
+    long   d_msiz;
+  };
+
+  // this function aligns a size on a long
+  static inline long lgr_align (const long size) {
+    long amod = size % (long) sizeof (t_long);
+    return (amod == 0L) ? size : size + (long) sizeof (t_long) - amod;
+  }
+
+  // this function updates a fnv checksum with a buffer
+  static inline t_octa lgr_fnv (t_octa csum, const char* buf,
+				const long size) {
+    for (long k = 0L; k < size; k++) {
+      csum ^= (t_octa) ((t_byte) buf[k]);
+      csum *= LGR_FNVPRM;
+    }
+    return csum;
+  }
+
+  // this function fills a file header
+  static void lgr_tohdr (s_lhdr& lhdr, const char* magic,
+			 const t_long ctim, const t_long mtim) {
+    for (long k = 0L; k < LGR_MSIZE; k++) lhdr.d_magic[k] = magic[k];
+    lhdr.d_vers = LGR_VERSION;
+    for (long k = 0L; k < 3L; k++) lhdr.d_pads[k] = nilc;
+    lhdr.d_bomk = LGR_BOMARK;
+    lhdr.d_ctim = ctim;
+    lhdr.d_mtim = mtim;
+  }
+
+  // this function checks a file header
+  static bool lgr_ishdr (const s_lhdr& lhdr, const char* magic) {
+    for (long k = 0L; k < LGR_MSIZE; k++) {
+      if (lhdr.d_magic[k] != magic[k]) return false;
+    }
+    return (lhdr.d_vers == LGR_VERSION) && (lhdr.d_bomk == LGR_BOMARK);
+  }
+
+  // this function writes a buffer at a file position
+  static void lgr_write (const int sid, const t_long pos, const char* buf,
+			 const long size, const String& name) {
+    if ((c_lseek (sid, pos) == false) ||
+	(c_write (sid, buf, size) != (t_long) size)) {
+      throw Exception ("ledger-error", "cannot write ledger file", name);
+    }
+  }
+
+  // this function reads a whole file - the file size is returned
+  static char* lgr_rdfile (const int sid, long& size, const String& name) {
+    size = c_fsize (sid);
+    if (size < LGR_HSIZE) {
+      throw Exception ("ledger-error", "invalid ledger file", name);
+    }
+    char* result = new char[size];
+    long  rlen   = 0L;
+    while (rlen < size) {
+      t_long blen = c_read (sid, result + rlen, size - rlen);
+      if (blen <= 0LL) {
+	delete [] result;
+	throw Exception ("ledger-error", "cannot read ledger file", name);
+      }
+      rlen += blen;
+    }
+    return result;
+  }
+
+  // this function converts a hexadecimal hash into bytes
+  static bool lgr_tohbuf (const String& hash, t_byte* hbuf) {
+    if (hash.length () != 2L * LGR_HLEN) return false;
+    for (long k = 0L; k < 2L * LGR_HLEN; k++) {
+      t_quad c = hash[k];
+      t_byte v = 0x00;
+      if ((c >= '0') && (c <= '9')) v = (t_byte) (c - '0');
+      else if ((c >= 'a') && (c <= 'f')) v = (t_byte) (c - 'a' + 10);
+      else if ((c >= 'A') && (c <= 'F')) v = (t_byte) (c - 'A' + 10);
+      else return false;
+      hbuf[k/2] = ((k % 2) == 0) ? (t_byte) (v << 4) : (hbuf[k/2] | v);
+    }
+    return true;
+  }
+
+  // this function computes a block hash
+  static void lgr_tohash (const Block& blok, t_byte* hbuf) {
+    blok.tohash().tobyte (hbuf, LGR_HLEN);
+  }
+
+  // the ledger storage
+  struct s_lsto {
+    // the storage path
+    String  d_path;
+    // the index file name
+    String  d_iname;
+    // the checksum file name
+    String  d_cname;
+    // the index file sid
+    int     d_isid;
+    // the checksum file sid
+    int     d_csid;
+    // the active segment sid
+    int     d_ssid;
+    // the index length
+    long    d_llen;
+    // the index capacity
+    long    d_lcap;
+    // the index entries
+    s_lent* p_lidx;
+    // the segment length
+    long    d_slen;
+    // the segment capacity
+    long    d_scap;
+    // the segment descriptors
+    s_lseg* p_segs;
+    // the creation time
+    t_long  d_ctim;
+    // the modification time
+    t_long  d_mtim;
+    // the cache position
+    long    d_cpos;
+    // the cached block indexes
+    long    d_cidx[LGR_CSIZE];
+    // the cached blocks
+    Block*  p_cblk[LGR_CSIZE];
+    // create a ledger storage by path
+    s_lsto (const String& path) {
+      d_path  = path;
+      d_iname = System::join (path, LGR_IDXNAME);
+      d_cname = System::join (path, LGR_SUMNAME);
+      d_isid  = -1;
+      d_csid  = -1;
+      d_ssid  = -1;
+      d_llen  = 0L;
+      d_lcap  = 0L;
+      p_lidx  = nullptr;
+      d_slen  = 0L;
+      d_scap  = 0L;
+      p_segs  = nullptr;
+      d_ctim  = 0LL;
+      d_mtim  = 0LL;
+      d_cpos  = 0L;
+      for (long k = 0L; k < LGR_CSIZE; k++) {
+	d_cidx[k] = -1L;
+	p_cblk[k] = nullptr;
+      }
+    }
+    // destroy this storage
+    ~s_lsto (void) {
+      if (d_isid >= 0) c_close (d_isid);
+      if (d_csid >= 0) c_close (d_csid);
+      if (d_ssid >= 0) c_close (d_ssid);
+      for (long k = 0L; k < d_slen; k++) {
+	if (p_segs[k].p_mbuf != nullptr) {
+	  c_munmap (p_segs[k].p_mbuf, p_segs[k].d_msiz);
+	}
+      }
+      for (long k = 0L; k < LGR_CSIZE; k++) Object::dref (p_cblk[k]);
+      delete [] p_lidx;
+      delete [] p_segs;
+    }
+    // get a segment file name by index
+    String getsname (const long sidx) const {
+      String name = LGR_SEGPREF + Utility::tostring (sidx) + LGR_SEGSUFX;
+      return System::join (d_path, name);
+    }
+    // open a storage file
+    int open (const String& name) const {
+      char* fname = name.tochar ();
+      int   sid   = c_openrw (fname, false, false);
+      delete [] fname;
+      if (sid < 0) {
+	throw Exception ("open-error", "cannot open ledger file", name);
+      }
+      return sid;
+    }
+    // add a segment descriptor
+    void addseg (const long size, const t_octa csum) {
+      if (d_slen == d_scap) {
+	long    scap = (d_scap == 0L) ? 16L : 2L * d_scap;
+	s_lseg* segs = new s_lseg[scap];
+	for (long k = 0L; k < d_slen; k++) segs[k] = p_segs[k];
+	delete [] p_segs;
+	p_segs = segs;
+	d_scap = scap;
+      }
+      p_segs[d_slen].d_size = size;
+      p_segs[d_slen].d_csum = csum;
+      p_segs[d_slen].p_mbuf = nullptr;
+      p_segs[d_slen].d_msiz = 0L;
+      d_slen++;
+    }
+    // add an index entry
+    void addent (const s_lent& lent) {
+      if (d_llen == d_lcap) {
+	long    lcap = (d_lcap == 0L) ? 1024L : 2L * d_lcap;
+	s_lent* lidx = new s_lent[lcap];
+	for (long k = 0L; k < d_llen; k++) lidx[k] = p_lidx[k];
+	delete [] p_lidx;
+	p_lidx = lidx;
+	d_lcap = lcap;
+      }
+      p_lidx[d_llen++] = lent;
+    }
+    // load or create the storage
+    void load (void) {
+      // check the storage directory
+      if ((System::isdir (d_path) == false) &&
+	  (System::mkdir (d_path) == false)) {
+	throw Exception ("ledger-error", "cannot create ledger directory",
+			 d_path);
+      }
+      // open the index and checksum files
+      d_isid = open (d_iname);
+      d_csid = open (d_cname);
+      s_lhdr lhdr;
+      if (c_fsize (d_isid) == 0LL) {
+	lgr_tohdr (lhdr, LGR_IMAGIC, 0LL, 0LL);
+	lgr_write (d_isid, 0LL, (const char*) &lhdr, LGR_HSIZE, d_iname);
+	lgr_tohdr (lhdr, LGR_CMAGIC, 0LL, 0LL);
+	lgr_write (d_csid, 0LL, (const char*) &lhdr, LGR_HSIZE, d_cname);
+	return;
+      }
+      // read the index file
+      long  isiz = 0L;
+      char* ibuf = lgr_rdfile (d_isid, isiz, d_iname);
+      try {
+	const s_lhdr* ihdr = reinterpret_cast <const s_lhdr*> (ibuf);
+	long elen = (long) sizeof (s_lent);
+	if ((lgr_ishdr (*ihdr, LGR_IMAGIC) == false) ||
+	    (((isiz - LGR_HSIZE) % elen) != 0L)) {
+	  throw Exception ("ledger-error", "invalid ledger index", d_iname);
+	}
+	d_ctim = ihdr->d_ctim;
+	d_mtim = ihdr->d_mtim;
+	long llen = (isiz - LGR_HSIZE) / elen;
+	const s_lent* lidx = reinterpret_cast <const s_lent*>(ibuf+LGR_HSIZE);
+	for (long k = 0L; k < llen; k++) {
+	  const s_lent& lent = lidx[k];
+	  if ((lent.d_sidx < d_slen - 1) || (lent.d_sidx > d_slen) ||
+	      (lent.d_boff < LGR_HSIZE) || (lent.d_bsiz < 0LL)) {
+	    throw Exception ("ledger-error", "invalid ledger index", d_iname);
+	  }
+	  if (lent.d_sidx == d_slen) addseg (LGR_HSIZE, 0ULL);
+	  p_segs[d_slen-1].d_size =
+	    lent.d_boff + LGR_HSIZE + lgr_align (lent.d_bsiz);
+	  addent (lent);
+	}
+	delete [] ibuf;
+      } catch (...) {
+	delete [] ibuf;
+	throw;
+      }
+      // read the segment checksums - the checksum is written last, so the
+      // last segment checksum might miss the last appended records
+      long  csiz = 0L;
+      char* cbuf = lgr_rdfile (d_csid, csiz, d_cname);
+      try {
+	const s_lhdr* chdr = reinterpret_cast <const s_lhdr*> (cbuf);
+	long elen = (long) sizeof (s_lsum);
+	long clen = (csiz - LGR_HSIZE) / elen;
+	if ((lgr_ishdr (*chdr, LGR_CMAGIC) == false) ||
+	    (((csiz - LGR_HSIZE) % elen) != 0L) || (clen < d_slen - 1L)) {
+	  throw Exception ("ledger-error", "invalid ledger checksum", d_cname);
+	}
+	const s_lsum* lsum = reinterpret_cast <const s_lsum*>(cbuf+LGR_HSIZE);
+	for (long k = 0L; k < d_slen; k++) {
+	  s_lsum csum = {LGR_FNVBAS, LGR_HSIZE};
+	  if (k < clen) csum = lsum[k];
+	  if (csum.d_size != p_segs[k].d_size) {
+	    if ((k < d_slen - 1L) || (csum.d_size < LGR_HSIZE) ||
+		(csum.d_size > p_segs[k].d_size)) {
+	      throw Exception ("ledger-error", "invalid ledger checksum",
+			       d_cname);
+	    }
+	    // repair the last segment checksum
+	    const char* mbuf = map (k, p_segs[k].d_size);
+	    csum.d_csum = lgr_fnv (csum.d_csum, mbuf + csum.d_size,
+				   p_segs[k].d_size - csum.d_size);
+	    csum.d_size = p_segs[k].d_size;
+	    t_long coff = LGR_HSIZE + k * elen;
+	    lgr_write (d_csid, coff, (const char*) &csum, elen, d_cname);
+	  }
+	  p_segs[k].d_csum = csum.d_csum;
+	}
+	delete [] cbuf;
+      } catch (...) {
+	delete [] cbuf;
+	throw;
+      }
+      // open the active segment
+      if (d_slen > 0L) d_ssid = open (getsname (d_slen - 1L));
+    }
+    // create a new segment
+    void mkseg (void) {
+      long   sidx  = d_slen;
+      String sname = getsname (sidx);
+      int    ssid  = open (sname);
+      try {
+	s_lhdr shdr;
+	lgr_tohdr (shdr, LGR_SMAGIC, sidx, 0LL);
+	lgr_write (ssid, 0LL, (const char*) &shdr, LGR_HSIZE, sname);
+      } catch (...) {
+	c_close (ssid);
+	throw;
+      }
+      if (d_ssid >= 0) c_close (d_ssid);
+      d_ssid = ssid;
+      addseg (LGR_HSIZE, LGR_FNVBAS);
+    }
+    // append a block to the storage
+    void append (const Block& blok) {
+      // serialize the block
+      OutputBuffer ob;
+      blok.serialize (ob);
+      Buffer sbuf = ob.tobuffer ();
+      long   bsiz = sbuf.length ();
+      long   rsiz = LGR_HSIZE + lgr_align (bsiz);
+      // check for a new segment
+      if ((d_slen == 0L) || ((p_segs[d_slen-1].d_size > LGR_HSIZE) &&
+			     (p_segs[d_slen-1].d_size + rsiz > LGR_SMAX))) {
+	mkseg ();
+      }
+      long    sidx = d_slen - 1L;
+      s_lseg& lseg = p_segs[sidx];
+      // prepare the record
+      char* rbuf = new char[rsiz];
+      try {
+	s_lrec* lrec = reinterpret_cast <s_lrec*> (rbuf);
+	for (long k = 0L; k < LGR_MSIZE; k++) {
+	  lrec->d_magic[k] = LGR_RMAGIC[k];
+	}
+	for (long k = 0L; k < 4L; k++) lrec->d_pads[k] = nilc;
+	lrec->d_bidx = d_llen;
+	lrec->d_bsiz = bsiz;
+	lrec->d_stmp = blok.getstmp ();
+	sbuf.tomap (rbuf + LGR_HSIZE, bsiz);
+	for (long k = LGR_HSIZE + bsiz; k < rsiz; k++) rbuf[k] = nilc;
+	// prepare the index entry
+	s_lent lent;
+	lent.d_sidx = sidx;
+	lent.d_boff = lseg.d_size;
+	lent.d_bsiz = bsiz;
+	lent.d_stmp = lrec->d_stmp;
+	lgr_tohash (blok, lent.d_hash);
+	// write the record in a single call
+	lgr_write (d_ssid, lseg.d_size, rbuf, rsiz, getsname (sidx));
+	// update the index
+	t_long ioff = LGR_HSIZE + d_llen * (long) sizeof (s_lent);
+	lgr_write (d_isid, ioff, (const char*) &lent, (long) sizeof (s_lent),
+		   d_iname);
+	addent (lent);
+	// update the segment checksum last
+	lseg.d_csum  = lgr_fnv (lseg.d_csum, rbuf, rsiz);
+	lseg.d_size += rsiz;
+	s_lsum csum  = {lseg.d_csum, lseg.d_size};
+	t_long coff  = LGR_HSIZE + sidx * (long) sizeof (s_lsum);
+	lgr_write (d_csid, coff, (const char*) &csum, (long) sizeof (s_lsum),
+		   d_cname);
+	delete [] rbuf;
+      } catch (...) {
+	delete [] rbuf;
+	throw;
+      }
+    }
+    // update the storage times
+    void settime (const t_long ctim, const t_long mtim) {
+      s_lhdr ihdr;
+      lgr_tohdr (ihdr, LGR_IMAGIC, ctim, mtim);
+      lgr_write (d_isid, 0LL, (const char*) &ihdr, LGR_HSIZE, d_iname);
+      d_ctim = ctim;
+      d_mtim = mtim;
+    }
+    // map a segment up to a size
+    const char* map (const long sidx, const long size) {
+      s_lseg& lseg = p_segs[sidx];
+      if ((lseg.p_mbuf != nullptr) && (lseg.d_msiz >= size)) {
+	return lseg.p_mbuf;
+      }
+      if (lseg.p_mbuf != nullptr) c_munmap (lseg.p_mbuf, lseg.d_msiz);
+      lseg.p_mbuf = nullptr;
+      lseg.d_msiz = 0L;
+      String sname = getsname (sidx);
+      char*  fname = sname.tochar ();
+      int    sid   = c_openr (fname);
+      delete [] fname;
+      if (sid < 0) {
+	throw Exception ("open-error", "cannot open ledger segment", sname);
+      }
+      char* mbuf = (c_fsize (sid) < lseg.d_size)
+	? nullptr
+	: (char*) c_mmap (sid, lseg.d_size, 0);
+      c_close (sid);
+      if (mbuf == nullptr) {
+	throw Exception ("ledger-error", "cannot map ledger segment", sname);
+      }
+      lseg.p_mbuf = mbuf;
+      lseg.d_msiz = lseg.d_size;
+      return mbuf;
+    }
+    // map all segments
+    void mapall (void) {
+      for (long k = 0L; k < d_slen; k++) map (k, p_segs[k].d_size);
+    }
+    // load a block from a mapped segment
+    Block* load (const long bidx) const {
+      const s_lent& lent = p_lidx[bidx];
+      const char*   mbuf = p_segs[lent.d_sidx].p_mbuf;
+      long          rend = lent.d_boff + LGR_HSIZE + lent.d_bsiz;
+      if ((mbuf == nullptr) || (p_segs[lent.d_sidx].d_msiz < rend)) {
+	throw Exception ("ledger-error", "unmapped ledger block record");
+      }
+      const s_lrec* lrec = reinterpret_cast <const s_lrec*>(mbuf+lent.d_boff);
+      for (long k = 0L; k < LGR_MSIZE; k++) {
+	if (lrec->d_magic[k] != LGR_RMAGIC[k]) {
+	  throw Exception ("ledger-error", "invalid ledger block record");
+	}
+      }
+      if ((lrec->d_bidx != bidx) || (lrec->d_bsiz != lent.d_bsiz)) {
+	throw Exception ("ledger-error", "invalid ledger block record");
+      }
+      // deserialize the block
+      char*  bdat = const_cast <char*> (mbuf + lent.d_boff + LGR_HSIZE);
+      Buffer bbuf (lent.d_bsiz, lent.d_bsiz, bdat);
+      InputOutput is (bbuf);
+      Object* obj = Serial::deserialize (is);
+      auto result = dynamic_cast <Block*> (obj);
+      if (result == nullptr) {
+	Object::cref (obj);
+	throw Exception ("ledger-error", "invalid ledger block record");
+      }
+      return result;
+    }
+    // get a referenced block by index
+    Block* get (const long bidx) {
+      if ((bidx < 0L) || (bidx >= d_llen)) {
+	throw Exception ("index-error", "invalid ledger block index");
+      }
+      // check the block cache
+      for (long k = 0L; k < LGR_CSIZE; k++) {
+	if (d_cidx[k] != bidx) continue;
+	Object::iref (p_cblk[k]);
+	return p_cblk[k];
+      }
+      // map and load the block record
+      const s_lent& lent = p_lidx[bidx];
+      map (lent.d_sidx, lent.d_boff + LGR_HSIZE + lent.d_bsiz);
+      Block* result = load (bidx);
+      // update the block cache
+      Object::dref (p_cblk[d_cpos]);
+      Object::iref (p_cblk[d_cpos] = result);
+      d_cidx[d_cpos] = bidx;
+      d_cpos = (d_cpos + 1L) % LGR_CSIZE;
+      Object::iref (result);
+      return result;
+    }
+    // find a block by hash
+    long find (const t_byte* hbuf) const {
+      for (long k = d_llen - 1L; k >= 0L; k--) {
+	const t_byte* hash = p_lidx[k].d_hash;
+	bool status = true;
+	for (long i = 0L; (i < LGR_HLEN) && status; i++) {
+	  status = (hash[i] == hbuf[i]);
+	}
+	if (status == true) return k;
+      }
+      return -1L;
+    }
+    // check the segment checksums
+    bool check (void) {
+      for (long k = 0L; k < d_slen; k++) {
+	const s_lseg& lseg = p_segs[k];
+	const char*   mbuf = map (k, lseg.d_size);
+	t_octa csum = lgr_fnv (LGR_FNVBAS, mbuf + LGR_HSIZE,
+			       lseg.d_size - LGR_HSIZE);
+	if (csum != lseg.d_csum) return false;
+      }
+      return true;
+    }
+    // collect the blocks in a vector
+    Vector* tovec (void) {
+      Vector* result = new Vector;
+      try {
+	for (long k = 0L; k < d_llen; k++) {
+	  Block* blok = get (k);
+	  result->add (blok);
+	  Object::dref (blok);
+	}
+	return result;
+      } catch (...) {
+	delete result;
+	throw;
+      }
+    }
+  };
+
+  // this function returns the hash of the last ledger block
+  static Relatif lgr_toprev (s_lsto* lsto, Vector* blks) {
+    // check the ledger storage
+    if (lsto != nullptr) {
+      if (lsto->d_llen == 0L) return 0;
+      return Relatif (lsto->p_lidx[lsto->d_llen-1L].d_hash, LGR_HLEN);
+    }
+    // check the block vector
+    long blen = (blks == nullptr) ? 0L : blks->length ();
+    if (blen == 0L) return 0;
+    auto blok = dynamic_cast <Block*> (blks->get (blen - 1L));
+    if (blok == nullptr) {
+      throw Exception ("ledger-error", "invalid last ledger block");
+    }
+    return blok->tohash ();
+  }
+
+  // this function appends a block to the ledger storage or vector
+  static void lgr_append (s_lsto* lsto, Vector*& blks, Block* blok) {
+    if (lsto != nullptr) {
+      lsto->append (*blok);
+    } else {
+      if (blks == nullptr) Object::iref (blks = new Vector);
+      blks->add (blok);
+    }
+  }
+
+  // this function computes the number of tasks for a block range
+  static long lgr_tsknum (const long blen) {
+    long tnum = (blen + LGR_TASK_BMIN - 1L) / LGR_TASK_BMIN;
+    if (tnum < 1L) return 1L;
+    return (tnum < LGR_TASK_TMAX) ? tnum : LGR_TASK_TMAX;
+  }
+
+  // the block signing structure
+  struct s_lsgn {
+    // the block array
+    Block** p_bvec;
+    // the signing key
+    const Key* p_skey;
+    // the start index
+    long d_sidx;
+    // the end index
+    long d_eidx;
+    // the error flag
+    bool d_eflg;
+    // sign the block range
+    void sign (void) {
+      try {
+	for (long k = d_sidx; k < d_eidx; k++) p_bvec[k]->sign (*p_skey);
+      } catch (...) {
+	d_eflg = true;
+      }
+    }
+  };
+
+  // this procedure runs a block signing task
+  static void* lgr_sign_task (void* args) {
+    reinterpret_cast <s_lsgn*> (args)->sign ();
+    return nullptr;
+  }
+
+  // this procedure signs a block array by contiguous ranges
+  static void lgr_sign (Block** bvec, const long blen, const Key& skey) {
+    if (blen == 0L) return;
+    long    tnum = lgr_tsknum (blen);
+    s_lsgn* lsgn = new s_lsgn[tnum];
+    void**  args = new void*[tnum];
+    for (long t = 0L; t < tnum; t++) {
+      lsgn[t].p_bvec = bvec;
+      lsgn[t].p_skey = &skey;
+      lsgn[t].d_sidx = (blen * t) / tnum;
+      lsgn[t].d_eidx = (blen * (t + 1L)) / tnum;
+      lsgn[t].d_eflg = false;
+      args[t] = &lsgn[t];
+    }
+    c_tskrun (lgr_sign_task, args, tnum);
+    bool eflg = false;
+    for (long t = 0L; t < tnum; t++) eflg = eflg || lsgn[t].d_eflg;
+    delete [] args;
+    delete [] lsgn;
+    if (eflg == true) {
+      throw Exception ("ledger-error", "cannot sign ledger block");
+    }
+  }
+
+  // the block verification structure
+  struct s_lvrf {
+    // the ledger storage
+    s_lsto* p_lsto;
+    // the block vector
+    Vector* p_blks;
+    // the start index
+    long d_sidx;
+    // the end index
+    long d_eidx;
+    // the unsigned block flag
+    bool d_uflg;
+    // the verification flag
+    bool d_vflg;
+    // the error flag
+    bool d_eflg;
+    // load a block by index
+    Block* load (const long bidx) const {
+      if (p_lsto != nullptr) return p_lsto->load (bidx);
+      return dynamic_cast <Block*> (p_blks->get (bidx));
+    }
+    // get a block hash by index
+    Relatif tohash (const long bidx) const {
+      if (p_lsto != nullptr) {
+	return Relatif (p_lsto->p_lidx[bidx].d_hash, LGR_HLEN);
+      }
+      Block* blok = load (bidx);
+      if (blok == nullptr) {
+	throw Exception ("ledger-error", "invalid ledger block");
+      }
+      return blok->tohash ();
+    }
+    // verify the block range
+    void verify (void) {
+      Block* blok = nullptr;
+      try {
+	Relatif prev = (d_sidx == 0L) ? Relatif (0) : tohash (d_sidx - 1L);
+	for (long k = d_sidx; (k < d_eidx) && d_vflg; k++) {
+	  Object::iref (blok = load (k));
+	  if (blok == nullptr) {
+	    d_vflg = false;
+	    break;
+	  }
+	  // check the hash link and the signature
+	  if (blok->getprev () != prev) d_vflg = false;
+	  if (blok->issigned () == false) {
+	    if (d_uflg == false) d_vflg = false;
+	  } else {
+	    if (blok->verify () == false) d_vflg = false;
+	  }
+	  // check the block hash
+	  Relatif hash = blok->tohash ();
+	  if ((p_lsto != nullptr) && (hash != tohash (k))) d_vflg = false;
+	  prev = hash;
+	  Object::dref (blok); blok = nullptr;
+	}
+      } catch (...) {
+	Object::dref (blok);
+	d_eflg = true;
+      }
+    }
+  };
+
+  // this procedure runs a block verification task
+  static void* lgr_verify_task (void* args) {
+    reinterpret_cast <s_lvrf*> (args)->verify ();
+    return nullptr;
+  }
+
   // -------------------------------------------------------------------------
   // - class section                                                         -
   // -------------------------------------------------------------------------
@@ -47,6 +796,22 @@ namespace afnix {
     d_ctim = 0L;
     d_mtim = 0L;
     p_blks = nullptr;
+    p_lsto = nullptr;
+  }
+
+  // create a stored ledger by path
+
+  Ledger::Ledger (const String& path) {
+    p_blks = nullptr;
+    p_lsto = new s_lsto (path);
+    try {
+      p_lsto->load ();
+      d_ctim = p_lsto->d_ctim;
+      d_mtim = p_lsto->d_mtim;
+    } catch (...) {
+      delete p_lsto;
+      throw;
+    }
   }
   
   // copy construct this ledger
@@ -56,7 +821,13 @@ namespace afnix {
     try {
       d_ctim = that.d_ctim;
       d_mtim = that.d_mtim;
-      Object::iref (p_blks = that.p_blks);
+      p_blks = nullptr;
+      p_lsto = nullptr;
+      if (that.p_lsto == nullptr) {
+	Object::iref (p_blks = that.p_blks);
+      } else {
+	Object::iref (p_blks = that.p_lsto->tovec ());
+      }
       that.unlock ();
     } catch (...) {
       that.unlock ();
@@ -73,10 +844,12 @@ namespace afnix {
       d_ctim = that.d_ctim; that.d_ctim = 0L;
       d_mtim = that.d_mtim; that.d_mtim = 0L;
       p_blks = that.p_blks; that.p_blks = nullptr;
+      p_lsto = that.p_lsto; that.p_lsto = nullptr;
     } catch (...) {
       d_ctim = 0L;
       d_mtim = 0L;
       p_blks = nullptr;
+      p_lsto = nullptr;
     }
     that.unlock ();
   }
@@ -85,6 +858,7 @@ namespace afnix {
 
   Ledger::~Ledger (void) {
     Object::dref (p_blks);
+    delete p_lsto;
   }
   
   // assign a ledger to this one
@@ -98,7 +872,11 @@ namespace afnix {
     try {
       d_ctim = that.d_ctim;
       d_mtim = that.d_mtim;
-      Object::iref (that.p_blks); Object::dref (p_blks); p_blks = that.p_blks;
+      Vector* blks = (that.p_lsto == nullptr)
+	? that.p_blks
+	: that.p_lsto->tovec ();
+      Object::iref (blks); Object::dref (p_blks); p_blks = blks;
+      delete p_lsto; p_lsto = nullptr;
       unlock ();
       that.unlock ();
       return *this;
@@ -124,10 +902,12 @@ namespace afnix {
       d_ctim = that.d_ctim; that.d_ctim = 0L;
       d_mtim = that.d_mtim; that.d_mtim = 0L;
       Object::dref (p_blks); p_blks = that.p_blks; that.p_blks = nullptr;
+      delete p_lsto; p_lsto = that.p_lsto; that.p_lsto = nullptr;
     } catch (...) {
       d_ctim = 0L;
       d_mtim = 0L;
       p_blks = nullptr;
+      p_lsto = nullptr;
     }
     unlock ();
     that.unlock ();
@@ -165,7 +945,16 @@ namespace afnix {
     try {
       Serial::wrlong (d_ctim, os);
       Serial::wrlong (d_mtim, os);
-      if (p_blks == nullptr) {
+      if (p_lsto != nullptr) {
+	Vector* blks = p_lsto->tovec ();
+	try {
+	  blks->serialize (os);
+	  delete blks;
+	} catch (...) {
+	  delete blks;
+	  throw;
+	}
+      } else if (p_blks == nullptr) {
 	Serial::wrnilid (os);
       } else {
 	p_blks->serialize(os);
@@ -182,6 +971,9 @@ namespace afnix {
   void Ledger::rdstream (InputStream& is) {
     wrlock ();
     try {
+      // a deserialized ledger is a memory ledger
+      delete p_lsto; p_lsto = nullptr;
+      Object::dref (p_blks); p_blks = nullptr;
       d_ctim = Serial::rdlong (is);
       d_mtim = Serial::rdlong (is);
       Object::iref (p_blks = dynamic_cast<Vector*>(Serial::deserialize(is)));
@@ -195,7 +987,7 @@ namespace afnix {
   // get the ledger information plist
 
   Plist Ledger::getplst (void) const {
-    rdlock ();
+    wrlock ();
     try {
       // create a result plist
       Plist result;
@@ -207,14 +999,20 @@ namespace afnix {
 	result.add (PN_LGR_MTIM, PI_LGR_MTIM, Date(d_mtim).toiso(true));
       }
       // add the blocks
-      long blen = (p_blks == nullptr) ? 0L : p_blks->length ();
+      long blen = length ();
       result.add (PN_LGR_BLEN, PI_LGR_BLEN, (t_long) blen);
       for (long k = 0L; k < blen; k++) {
 	// get the block
-	auto blok = dynamic_cast<Block*>(p_blks->get (k));
+	auto blok = get (k);
 	if (blok == nullptr) continue;
 	// merge in the result plist
-	result = result.merge (blok->getplst (), k);
+	try {
+	  result = result.merge (blok->getplst (), k);
+	  Object::dref (blok);
+	} catch (...) {
+	  Object::dref (blok);
+	  throw;
+	}
       }
       // here it is
       unlock ();
@@ -258,7 +1056,22 @@ namespace afnix {
   long Ledger::length (void) const {
     rdlock ();
     try {
-      long result = (p_blks == nullptr) ? 0L : p_blks->length ();;
+      long result = (p_lsto != nullptr) ? p_lsto->d_llen
+	: (p_blks == nullptr) ? 0L : p_blks->length ();
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get the ledger storage path
+
+  String Ledger::getpath (void) const {
+    rdlock ();
+    try {
+      String result = (p_lsto == nullptr) ? String ("") : p_lsto->d_path;
       unlock ();
       return result;
     } catch (...) {
@@ -270,11 +1083,88 @@ namespace afnix {
   // get a block by index
 
   Block* Ledger::get (const long bidx) const {
-    rdlock ();
+    wrlock ();
     try {
-      auto result = (p_blks == nullptr)
-	? nullptr
-	: dynamic_cast<Block*>(p_blks->get(bidx));
+      Block* result = nullptr;
+      if (p_lsto != nullptr) {
+	result = p_lsto->get (bidx);
+      } else if (p_blks != nullptr) {
+	result = dynamic_cast<Block*>(p_blks->get(bidx));
+	Object::iref (result);
+      }
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get a block hash by index
+
+  String Ledger::gethash (const long bidx) const {
+    wrlock ();
+    try {
+      t_byte hbuf[LGR_HLEN];
+      if (p_lsto != nullptr) {
+	if ((bidx < 0L) || (bidx >= p_lsto->d_llen)) {
+	  throw Exception ("index-error", "invalid ledger block index");
+	}
+	for (long k = 0L; k < LGR_HLEN; k++) {
+	  hbuf[k] = p_lsto->p_lidx[bidx].d_hash[k];
+	}
+      } else {
+	auto blok = (p_blks == nullptr)
+	  ? nullptr
+	  : dynamic_cast<Block*>(p_blks->get(bidx));
+	if (blok == nullptr) {
+	  throw Exception ("index-error", "invalid ledger block index");
+	}
+	lgr_tohash (*blok, hbuf);
+      }
+      String result = Ascii::btos (hbuf, LGR_HLEN);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // find a block index by hash
+
+  long Ledger::find (const String& hash) const {
+    t_byte hbuf[LGR_HLEN];
+    if (lgr_tohbuf (hash, hbuf) == false) return -1L;
+    wrlock ();
+    try {
+      long result = -1L;
+      if (p_lsto != nullptr) {
+	result = p_lsto->find (hbuf);
+      } else {
+	long blen = (p_blks == nullptr) ? 0L : p_blks->length ();
+	String hval = Ascii::btos (hbuf, LGR_HLEN);
+	for (long k = blen - 1L; k >= 0L; k--) {
+	  if (gethash (k) == hval) {
+	    result = k;
+	    break;
+	  }
+	}
+      }
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // check the ledger storage checksums
+
+  bool Ledger::check (void) const {
+    wrlock ();
+    try {
+      bool result = (p_lsto == nullptr) ? true : p_lsto->check ();
       unlock ();
       return result;
     } catch (...) {
@@ -291,12 +1181,18 @@ namespace afnix {
     // lock and add
     wrlock ();
     try {
-      // check for a block ledger
-      if (p_blks == nullptr) Object::iref (p_blks = new Vector);
-      // create the block by transaction
-      Block* blok = new Block (tran);
-      // add the block to the ledger
-      p_blks->add (blok);
+      // create the block by transaction and previous hash
+      Block* blok = new Block (tran, lgr_toprev (p_lsto, p_blks));
+      Object::iref (blok);
+      try {
+	// sign the block and add it to the ledger
+	if (skey.gettype () != Key::CKEY_KNIL) blok->sign (skey);
+	lgr_append (p_lsto, p_blks, blok);
+	Object::dref (blok);
+      } catch (...) {
+	Object::dref (blok);
+	throw;
+      }
       // update the times
       if (d_ctim == 0L) {
 	d_ctim = Time::gettclk ();
@@ -304,8 +1200,101 @@ namespace afnix {
       } else {
 	d_mtim = Time::gettclk ();
       }
+      if (p_lsto != nullptr) p_lsto->settime (d_ctim, d_mtim);
+      unlock ();
+      return true;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+  
+  // link a transaction vector to the ledger
+
+  bool Ledger::link (const Vector& tvec, const Key& skey) {
+    wrlock ();
+    long    tlen = tvec.length ();
+    Block** bvec = (tlen == 0L) ? nullptr : new Block*[tlen];
+    for (long k = 0L; k < tlen; k++) bvec[k] = nullptr;
+    try {
+      // create the blocks in order with their hash link
+      Relatif prev = lgr_toprev (p_lsto, p_blks);
+      for (long k = 0L; k < tlen; k++) {
+	Object* obj = tvec.get (k);
+	auto tran = dynamic_cast <Transaction*> (obj);
+	if (tran == nullptr) {
+	  throw Exception ("type-error", "invalid object for ledger link",
+			   Object::repr (obj));
+	}
+	Object::iref (bvec[k] = new Block (tran, prev));
+	prev = bvec[k]->tohash ();
+      }
+      // sign the blocks in parallel since the hash is not signed
+      if (skey.gettype () != Key::CKEY_KNIL) lgr_sign (bvec, tlen, skey);
+      // add the blocks in order
+      for (long k = 0L; k < tlen; k++) lgr_append (p_lsto, p_blks, bvec[k]);
+      // update the times
+      if (tlen > 0L) {
+	if (d_ctim == 0L) {
+	  d_ctim = Time::gettclk ();
+	  d_mtim = d_ctim;
+	} else {
+	  d_mtim = Time::gettclk ();
+	}
+	if (p_lsto != nullptr) p_lsto->settime (d_ctim, d_mtim);
+      }
+      for (long k = 0L; k < tlen; k++) Object::dref (bvec[k]);
+      delete [] bvec;
       unlock ();
       return true;
+    } catch (...) {
+      for (long k = 0L; k < tlen; k++) Object::dref (bvec[k]);
+      delete [] bvec;
+      unlock ();
+      throw;
+    }
+  }
+
+  // verify the ledger
+
+  bool Ledger::verify (void) const {
+    return verify (false);
+  }
+
+  // verify the ledger with unsigned blocks
+
+  bool Ledger::verify (const bool uflg) const {
+    wrlock ();
+    try {
+      // map the storage segments
+      if (p_lsto != nullptr) p_lsto->mapall ();
+      // prepare the verification ranges
+      long    blen = length ();
+      long    tnum = lgr_tsknum (blen);
+      s_lvrf* lvrf = new s_lvrf[tnum];
+      void**  args = new void*[tnum];
+      for (long t = 0L; t < tnum; t++) {
+	lvrf[t].p_lsto = p_lsto;
+	lvrf[t].p_blks = p_blks;
+	lvrf[t].d_sidx = (blen * t) / tnum;
+	lvrf[t].d_eidx = (blen * (t + 1L)) / tnum;
+	lvrf[t].d_uflg = uflg;
+	lvrf[t].d_vflg = true;
+	lvrf[t].d_eflg = false;
+	args[t] = &lvrf[t];
+      }
+      // verify the ranges in parallel
+      c_tskrun (lgr_verify_task, args, tnum);
+      bool result = true;
+      for (long t = 0L; t < tnum; t++) {
+	if ((lvrf[t].d_vflg == false) || (lvrf[t].d_eflg == true)) {
+	  result = false;
+	}
+      }
+      delete [] args;
+      delete [] lvrf;
+      unlock ();
+      return result;
     } catch (...) {
       unlock ();
       throw;
@@ -317,11 +1306,16 @@ namespace afnix {
   // -------------------------------------------------------------------------
 
   // the quark zone
-  static const long QUARK_ZONE_LENGTH = 5;
+  static const long QUARK_ZONE_LENGTH = 10;
   static QuarkZone  zone (QUARK_ZONE_LENGTH);
 
   // the object supported quarks
   static const long QUARK_GET     = zone.intern ("get");
+  static const long QUARK_FIND    = zone.intern ("find");
+  static const long QUARK_CHECK   = zone.intern ("check");
+  static const long QUARK_VERIFY  = zone.intern ("verify");
+  static const long QUARK_GETHASH = zone.intern ("get-hash");
+  static const long QUARK_GETPATH = zone.intern ("get-path");
   static const long QUARK_LINK    = zone.intern ("link");
   static const long QUARK_LENGTH  = zone.intern ("length");
   static const long QUARK_GETCTIM = zone.intern ("get-creation-time");
@@ -333,6 +1327,11 @@ namespace afnix {
     long argc = (argv == nullptr) ? 0 : argv->length ();
     // create a default ledger
     if (argc == 0) return new Ledger;
+    // create a stored ledger by path
+    if (argc == 1) {
+      String path = argv->getstring (0);
+      return new Ledger (path);
+    }
     // argument error
     throw Exception ("argument-error",
 		     "too many argument with ledger constructor");
@@ -368,15 +1367,19 @@ namespace afnix {
       if (quark == QUARK_LENGTH)  return new Integer (length ());
       if (quark == QUARK_GETCTIM) return new Integer (getctim ());
       if (quark == QUARK_GETMTIM) return new Integer (getmtim ());
+      if (quark == QUARK_GETPATH) return new String  (getpath ());
+      if (quark == QUARK_CHECK)   return new Boolean (check ());
+      if (quark == QUARK_VERIFY)  return new Boolean (verify ());
     }
     // check for 1 argument
     if (argc == 1) {
       if (quark == QUARK_GET) {
-	rdlock ();
+	wrlock ();
 	try {
 	  long bidx = argv->getlong (0);
 	  Object* result = get (bidx);
 	  zobj->post (result);
+	  Object::tref (result);
 	  unlock ();
 	  return result;
 	} catch (...) {
@@ -384,23 +1387,36 @@ namespace afnix {
 	  throw;
 	}
       }
+      if (quark == QUARK_GETHASH) {
+	long bidx = argv->getlong (0);
+	return new String (gethash (bidx));
+      }
+      if (quark == QUARK_FIND) {
+	String hash = argv->getstring (0);
+	return new Integer (find (hash));
+      }
+      if (quark == QUARK_VERIFY) {
+	bool uflg = argv->getbool (0);
+	return new Boolean (verify (uflg));
+      }
     }
     // check for 2 arguments
     if (argc == 2) {
       if (quark == QUARK_LINK) {
-	Object* obj = argv->get (0);
-	auto tran = dynamic_cast <Transaction*> (obj);
-	if (tran == nullptr) {
+	Object* obj = argv->get (1);
+	auto skey = dynamic_cast <Key*> (obj);
+	if (skey == nullptr) {
 	  throw Exception ("type-error", "invalid object for ledger link",
 			   Object::repr (obj));
 	}
-	obj = argv->get (1);
-	auto skey = dynamic_cast <Key*> (obj);
-	if (skey == nullptr) {
+	obj = argv->get (0);
+	auto tvec = dynamic_cast <Vector*> (obj);
+	if (tvec != nullptr) return new Boolean (link (*tvec, *skey));
+	auto tran = dynamic_cast <Transaction*> (obj);
+	if (tran == nullptr) {
 	  throw Exception ("type-error", "invalid object for ledger link",
 			   Object::repr (obj));
 	}
-	
 	return new Boolean (link (tran, *skey));
       }
     }
@@ -36,7 +36,20 @@ namespace afnix {
   /// with signature carrier. For security reason, each block added to the
   /// chain is linked with the previous block by a signature mechanism based
   /// on a unique hash of the block content itself. Since each block is
-  /// serializable, the ledger is also serializable.
+  /// serializable, the ledger is also serializable. A block holds the hash
+  /// of the previous block and is signed when linked with a signing key.
+  /// The ledger verification checks the hash links and the signatures by
+  /// block ranges processed in parallel. An unsigned block fails the
+  /// verification unless the unsigned block flag is set.
+  /// A ledger can also be bound to a storage directory. In this mode, the
+  /// blocks are not kept in memory but appended to segment files, each
+  /// block being written with a fixed size header in a single write. An
+  /// index file holds the segment offset and the hash of each block, while
+  /// a checksum file holds a running checksum per segment. The checksum
+  /// is written last, so that a checksum left behind by an interrupted
+  /// append is repaired when the ledger is opened. Opening a stored ledger
+  /// only reads the index, and the blocks are fetched by index or hash
+  /// from the mapped segments. A block returned by index is referenced.
   /// @author amaury darsch
 
   class Ledger : public virtual Serial {
@@ -47,11 +60,17 @@ namespace afnix {
     t_long d_mtim;
     /// the block ledger
     Vector* p_blks;
+    /// the ledger storage
+    struct s_lsto* p_lsto;
 
   public:
     /// create default ledger
     Ledger (void);
 
+    /// create a stored ledger by path
+    /// @param path the storage directory
+    Ledger (const String& path);
+
     /// copy construct this ledger
     /// @param that the object to copy
     Ledger (const Ledger& that);
@@ -103,18 +122,43 @@ namespace afnix {
     /// @return the ledger length
     virtual long length (void) const;
 
-    /// get a block by index
+    /// @return the ledger storage path
+    virtual String getpath (void) const;
+
+    /// get a referenced block by index - the caller must release it
     /// @param bidx the block index
     virtual Block* get (const long bidx) const;
 
+    /// get a block hash by index
+    /// @param bidx the block index
+    virtual String gethash (const long bidx) const;
+
+    /// find a block index by hash
+    /// @param hash the block hash
+    /// @return the block index or -1
+    virtual long find (const String& hash) const;
+
+    /// check the ledger storage checksums
+    virtual bool check (void) const;
+
     /// link a transaction with the ledger
     /// @param tran the transaction to link
     /// @param skey the signing key
     virtual bool link (Transaction* tran, const Key& skey);
 
-    /// verify the ledger
+    /// link a transaction vector with the ledger - the blocks are signed
+    /// in parallel and added in order
+    /// @param tvec the transaction vector to link
     /// @param skey the signing key
-    //virtual bool verify (const Key& skey) const;
+    virtual bool link (const Vector& tvec, const Key& skey);
+
+    /// verify the ledger hash links and block signatures - an unsigned
+    /// block fails the verification
+    virtual bool verify (void) const;
+
+    /// verify the ledger hash links and block signatures
+    /// @param uflg the unsigned block flag
+    virtual bool verify (const bool uflg) const;
     
   public:
     /// create a new object in a generic way
@@ -42,6 +42,7 @@ namespace afnix {
     gset->symcst ("Chain",            new Meta (Chain::mknew));
     gset->symcst ("Ledger",           new Meta (Ledger::mknew));
     gset->symcst ("Request",          new Meta (Request::mknew));
+    gset->symcst ("Transaction",      new Meta (Transaction::mknew));
 
     // bind the predicates
     gset->symcst ("block-p",          new Function (bce_blokp));
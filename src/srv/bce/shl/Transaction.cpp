@@ -15,6 +15,7 @@
 // ---------------------------------------------------------------------------
 
 #include "Vector.hpp"
+#include "Bcesid.hxx"
 #include "Boolean.hpp"
 #include "QuarkZone.hpp"
 #include "Exception.hpp"
@@ -130,6 +131,30 @@ namespace afnix {
     return *this;
   }
   
+  // return the transaction class name
+
+  String Transaction::repr (void) const {
+    return "Transaction";
+  }
+
+  // return a clone of this object
+
+  Object* Transaction::clone (void) const {
+    return new Transaction (*this);
+  }
+
+  // return the serial did
+
+  t_word Transaction::getdid (void) const {
+    return SRL_DEOD_BCE;
+  }
+
+  // return the serial sid
+
+  t_word Transaction::getsid (void) const {
+    return SRL_TRAN_SID;
+  }
+
   // serialize this transaction
 
   void Transaction::wrstream (OutputStream& os) const {
@@ -190,6 +215,27 @@ namespace afnix {
   // the object supported quarks
   static const long QUARK_GETPLST = zone.intern ("get-plist");
 
+  // create a new object in a generic way
+
+  Object* Transaction::mknew (Vector* argv) {
+    long argc = (argv == nullptr) ? 0 : argv->length ();
+    // create a default transaction
+    if (argc == 0) return new Transaction;
+    // check for 1 argument
+    if (argc == 1) {
+      String name = argv->getstring (0);
+      return new Transaction (name);
+    }
+    // check for 2 arguments
+    if (argc == 2) {
+      String name = argv->getstring (0);
+      String info = argv->getstring (1);
+      return new Transaction (name, info);
+    }
+    throw Exception ("argument-error",
+		     "too many argument with transaction constructor");
+  }
+
   // return true if the given quark is defined
 
   bool Transaction::isquark (const long quark, const bool hflg) const {
@@ -71,6 +71,18 @@ namespace afnix {
     /// move a transaction to this one
     /// @param that the transaction to move
     Transaction& operator = (Transaction&& that) noexcept;
+
+    /// @return the class name
+    String repr (void) const;
+
+    /// @return a clone of this object
+    Object* clone (void) const;
+
+    /// @return the serial did
+    t_word getdid (void) const;
+
+    /// @return the serial sid
+    t_word getsid (void) const;
     
     /// serialize this transaction
     /// @param os the output stream
@@ -84,6 +96,10 @@ namespace afnix {
     virtual Plist getplst (void) const;
 
   public:
+    /// create a new object in a generic way
+    /// @param argv the argument vector
+    static Object* mknew (Vector* argv);
+
     /// @return true if the given quark is defined
     bool isquark (const long quark, const bool hflg) const;
     
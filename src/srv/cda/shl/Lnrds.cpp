@@ -241,6 +241,110 @@ namespace afnix {
     }
   }
 
+  // fill an integer array by positions
+
+  long Lnrds::getlbuf (long* lbuf, const t_real* pbuf, const long size) {
+    // check for valid arrays
+    if ((lbuf == nullptr) || (pbuf == nullptr) || (size <= 0L)) return 0L;
+    // lock and fill
+    wrlock ();
+    try {
+      // check for valid streamable
+      if (p_strm == nullptr) {
+	long result = Streamable::getlbuf (lbuf, pbuf, size);
+	unlock ();
+	return result;
+      }
+      // get the streamable bounds
+      t_real dp = departure ();
+      t_real ap = arrival ();
+      // the current interval
+      t_real spos = Math::CV_NAN; long sval = 0L;
+      t_real npos = Math::CV_NAN; long nval = 0L;
+      for (long k = 0L; k < size; k++) {
+	t_real pos = pbuf[k];
+	// check for a new interval
+	if ((pos < spos) || (pos >= npos) || Math::isnan (spos)) {
+	  if (pos <= dp) {
+	    pos = p_strm->begin ();
+	  } else if (pos >= ap) {
+	    pos = p_strm->end ();
+	  } else {
+	    p_strm->move (pos);
+	  }
+	  spos = p_strm->locate ();
+	  sval = p_strm->getlong ();
+	  npos = p_strm->next ();
+	  nval = p_strm->getlong ();
+	}
+	// interpolate the value
+	long result = sval;
+	if (pos != spos) {
+	  result += (long) (((nval - sval) / (npos - spos)) * (pos - spos));
+	}
+	lbuf[k] = result;
+      }
+      // leave the streamer at the last position
+      move (pbuf[size-1]);
+      unlock ();
+      return size;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // fill a real array by positions
+
+  long Lnrds::getrbuf (t_real* rbuf, const t_real* pbuf, const long size) {
+    // check for valid arrays
+    if ((rbuf == nullptr) || (pbuf == nullptr) || (size <= 0L)) return 0L;
+    // lock and fill
+    wrlock ();
+    try {
+      // check for valid streamable
+      if (p_strm == nullptr) {
+	long result = Streamable::getrbuf (rbuf, pbuf, size);
+	unlock ();
+	return result;
+      }
+      // get the streamable bounds
+      t_real dp = departure ();
+      t_real ap = arrival ();
+      // the current interval and slope
+      t_real spos = Math::CV_NAN; t_real sval = 0.0;
+      t_real npos = Math::CV_NAN; t_real nval = 0.0;
+      t_real slpe = 0.0;
+      for (long k = 0L; k < size; k++) {
+	t_real pos = pbuf[k];
+	// check for a new interval
+	if ((pos < spos) || (pos >= npos) || Math::isnan (spos)) {
+	  if (pos <= dp) {
+	    pos = p_strm->begin ();
+	  } else if (pos >= ap) {
+	    pos = p_strm->end ();
+	  } else {
+	    p_strm->move (pos);
+	  }
+	  spos = p_strm->locate ();
+	  sval = p_strm->getreal ();
+	  npos = p_strm->next ();
+	  nval = p_strm->getreal ();
+	  slpe = (nval - sval) / (npos - spos);
+	}
+	// interpolate the value
+	rbuf[k] = (pos == spos) ? sval : sval + slpe * (pos - spos);
+      }
+      // leave the streamer at the last position
+      move (pbuf[size-1]);
+      unlock ();
+      return size;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // forward the streamer to the next integer
 
   t_real Lnrds::forward (const long pval) {
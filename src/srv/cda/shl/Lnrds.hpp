@@ -26,7 +26,9 @@ namespace afnix {
   /// The Lnrds class is a linear interpolation streamer which is used to
   /// deliver data as a streambable anywhere between the departure and
   /// arrival position. if a position is given outside the streamable bounds
-  /// the position is reset to the closest boundary.
+  /// the position is reset to the closest boundary. When the data are
+  /// collected in bulk, the streamable values which bound a position are
+  /// kept and reused as long as the positions fall in the same interval.
   /// @author amaury darch
 
   class Lnrds : public Streamable {
@@ -78,6 +80,18 @@ namespace afnix {
     /// @return the streamer real data
     t_real getreal (void) const;
 
+    /// fill an integer array by positions
+    /// @param lbuf the integer array to fill
+    /// @param pbuf the position array
+    /// @param size the array size
+    long getlbuf (long* lbuf, const t_real* pbuf, const long size);
+
+    /// fill a real array by positions
+    /// @param rbuf the real array to fill
+    /// @param pbuf the position array
+    /// @param size the array size
+    long getrbuf (t_real* rbuf, const t_real* pbuf, const long size);
+
     /// forward the streamer to the next integer
     /// @param pval the integer value to find
     t_real forward (const long pval);
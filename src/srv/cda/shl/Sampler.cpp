@@ -275,12 +275,72 @@ namespace afnix {
     }
   }
   
+  // sample an integer array by real positions
+
+  long Sampler::maplbuf (long* lbuf, const t_real* pbuf, const long size) {
+    // check for valid arrays
+    if ((lbuf == nullptr) || (pbuf == nullptr) || (size <= 0L)) return 0L;
+    // lock and sample
+    wrlock ();
+    t_real* sbuf = new t_real[size];
+    try {
+      // localize the positions
+      for (long k = 0L; k < size; k++) {
+	sbuf[k] = (p_lobj == nullptr) ? Math::CV_NAN : p_lobj->locate (pbuf[k]);
+      }
+      // extract the streamable data
+      long result = size;
+      if (p_sobj == nullptr) {
+	for (long k = 0L; k < size; k++) lbuf[k] = 0L;
+      } else {
+	result = p_sobj->getlbuf (lbuf, sbuf, size);
+      }
+      delete [] sbuf;
+      unlock ();
+      return result;
+    } catch (...) {
+      delete [] sbuf;
+      unlock ();
+      throw;
+    }
+  }
+
+  // sample a real array by real positions
+
+  long Sampler::maprbuf (t_real* rbuf, const t_real* pbuf, const long size) {
+    // check for valid arrays
+    if ((rbuf == nullptr) || (pbuf == nullptr) || (size <= 0L)) return 0L;
+    // lock and sample
+    wrlock ();
+    t_real* sbuf = new t_real[size];
+    try {
+      // localize the positions
+      for (long k = 0L; k < size; k++) {
+	sbuf[k] = (p_lobj == nullptr) ? Math::CV_NAN : p_lobj->locate (pbuf[k]);
+      }
+      // extract the streamable data
+      long result = size;
+      if (p_sobj == nullptr) {
+	for (long k = 0L; k < size; k++) rbuf[k] = Math::CV_NAN;
+      } else {
+	result = p_sobj->getrbuf (rbuf, sbuf, size);
+      }
+      delete [] sbuf;
+      unlock ();
+      return result;
+    } catch (...) {
+      delete [] sbuf;
+      unlock ();
+      throw;
+    }
+  }
+
   // -------------------------------------------------------------------------
   // - object section                                                        -
   // -------------------------------------------------------------------------
 
   // the quark zone
-  static const long QUARK_ZONE_LENGTH = 7;
+  static const long QUARK_ZONE_LENGTH = 9;
   static QuarkZone  zone (QUARK_ZONE_LENGTH);
 
   // the object supported quarks
@@ -291,6 +351,8 @@ namespace afnix {
   static const long QUARK_MAPBOOL  = zone.intern ("map-boolean");
   static const long QUARK_MAPLONG  = zone.intern ("map-integer");
   static const long QUARK_VALIDATE = zone.intern ("validate");
+  static const long QUARK_MAPRVEC  = zone.intern ("map-real-vector");
+  static const long QUARK_MAPLVEC  = zone.intern ("map-integer-vector");
   
   // create a new object in a generic way
 
@@ -426,6 +488,43 @@ namespace afnix {
 	t_real pval = argv->getreal (0);
 	return new Boolean (validate (pval));
       }
+      if ((quark == QUARK_MAPRVEC) || (quark == QUARK_MAPLVEC)) {
+	Object* obj = argv->get (0);
+	Vector* pvec = dynamic_cast <Vector*> (obj);
+	if (pvec == nullptr) {
+	  throw Exception ("type-error", "invalid object as position vector",
+			   Object::repr (obj));
+	}
+	// collect the position values
+	long size = pvec->length ();
+	t_real* pbuf = new t_real[size];
+	t_real* rbuf = (quark == QUARK_MAPRVEC) ? new t_real[size] : nullptr;
+	long*   lbuf = (quark == QUARK_MAPLVEC) ? new long[size]   : nullptr;
+	Vector* result = new Vector;
+	try {
+	  for (long k = 0L; k < size; k++) pbuf[k] = pvec->getrint (k);
+	  // sample and map the result
+	  if (quark == QUARK_MAPRVEC) {
+	    long rlen = maprbuf (rbuf, pbuf, size);
+	    for (long k = 0L; k < rlen; k++) result->add (new Real (rbuf[k]));
+	  } else {
+	    long llen = maplbuf (lbuf, pbuf, size);
+	    for (long k = 0L; k < llen; k++) {
+	      result->add (new Integer (lbuf[k]));
+	    }
+	  }
+	  delete [] pbuf;
+	  delete [] rbuf;
+	  delete [] lbuf;
+	  return result;
+	} catch (...) {
+	  delete [] pbuf;
+	  delete [] rbuf;
+	  delete [] lbuf;
+	  delete result;
+	  throw;
+	}
+      }
     }
     // call the object method
     return Object::apply (zobj, nset, quark, argv);
@@ -30,7 +30,9 @@ namespace afnix {
   /// This Sampler class is an abstract class that provides an interface
   /// for data sampling with the help of a localizer object and a streamable.
   /// In other words, the data sampling is performed by localization and
-  /// extraction.
+  /// extraction. An array of position values can be sampled at once, in
+  /// which case all positions are localized first and the data are
+  /// extracted in bulk from the streamable.
   /// @author amaury darsch
 
   class Sampler : public virtual Object {
@@ -103,6 +105,20 @@ namespace afnix {
     /// sample a real by real
     /// @param pval the position value
     virtual t_real mapreal (const t_real pval);
+
+    /// sample an integer array by real positions
+    /// @param lbuf the integer array to fill
+    /// @param pbuf the position value array
+    /// @param size the array size
+    /// @return the number of sampled values
+    virtual long maplbuf (long* lbuf, const t_real* pbuf, const long size);
+
+    /// sample a real array by real positions
+    /// @param rbuf the real array to fill
+    /// @param pbuf the position value array
+    /// @param size the array size
+    /// @return the number of sampled values
+    virtual long maprbuf (t_real* rbuf, const t_real* pbuf, const long size);
     
   private:
     // make the copy constructor private
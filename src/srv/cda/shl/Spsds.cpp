@@ -15,6 +15,7 @@
 // ---------------------------------------------------------------------------
 
 #include "Spsds.hpp"
+#include "Column.hpp"
 #include "Utility.hpp"
 #include "Evaluable.hpp"
 #include "QuarkZone.hpp"
@@ -22,6 +23,85 @@
 
 namespace afnix {
 
+  // -------------------------------------------------------------------------
+  // - private section                                                       -
+  // -------------------------------------------------------------------------
+
+  // get a cell boolean value from a mapped column or a literal
+  static bool spsds_tobool (const Sheet* shto, const long row, const long col,
+			    const bool dval) {
+    long prow = 0L;
+    Column* pcol = shto->getpcol (row, col, prow);
+    try {
+      if ((pcol != nullptr) && (pcol->gettype () == Column::CTYP_BOOL)) {
+	bool result = pcol->isnil (prow) ? dval : pcol->getbool (prow);
+	Object::dref (pcol);
+	return result;
+      }
+      Object::dref (pcol);
+    } catch (...) {
+      Object::dref (pcol);
+      throw;
+    }
+    Literal* lobj = shto->map (row, col);
+    return (lobj == nullptr) ? dval : Utility::tobool (lobj);
+  }
+
+  // get a cell integer value from a mapped column or a literal
+  static long spsds_tolong (const Sheet* shto, const long row, const long col,
+			    const long dval) {
+    long prow = 0L;
+    Column* pcol = shto->getpcol (row, col, prow);
+    try {
+      if ((pcol != nullptr) && (pcol->gettype () == Column::CTYP_INTG)) {
+	long result = pcol->isnil (prow) ? dval : pcol->getlong (prow);
+	Object::dref (pcol);
+	return result;
+      }
+      Object::dref (pcol);
+    } catch (...) {
+      Object::dref (pcol);
+      throw;
+    }
+    Literal* lobj = shto->map (row, col);
+    return (lobj == nullptr) ? dval : Utility::tolong (lobj);
+  }
+
+  // get a cell real value from a mapped column or a literal
+  static t_real spsds_toreal (const Sheet* shto, const long row,
+			      const long col, const t_real dval) {
+    long prow = 0L;
+    Column* pcol = shto->getpcol (row, col, prow);
+    try {
+      Column::t_ctyp ctyp = (pcol == nullptr) ? Column::CTYP_NILL :
+	pcol->gettype ();
+      if (ctyp == Column::CTYP_REAL) {
+	t_real result = pcol->isnil (prow) ? dval : pcol->getreal (prow);
+	Object::dref (pcol);
+	return result;
+      }
+      if (ctyp == Column::CTYP_INTG) {
+	t_real result = pcol->isnil (prow) ? dval : pcol->getlong (prow);
+	Object::dref (pcol);
+	return result;
+      }
+      Object::dref (pcol);
+    } catch (...) {
+      Object::dref (pcol);
+      throw;
+    }
+    Literal* lobj = shto->map (row, col);
+    return (lobj == nullptr) ? dval : Utility::torint (lobj);
+  }
+
+  // clamp a position to an iteration index
+  static inline long spsds_toiidx (const t_real pos, const long slen) {
+    long result = (long) pos;
+    if (result < 0L) result = 0L;
+    if (result >= slen) result = slen - 1L;
+    return result;
+  }
+
   // -------------------------------------------------------------------------
   // - class section                                                         -
   // -------------------------------------------------------------------------
@@ -256,12 +336,10 @@ namespace afnix {
 	return result;
       }
       if (d_meth == METH_ROW) {
-	Literal* lobj = p_shto->map (d_iidx, d_cidx);
-	if (lobj != nullptr) result = Utility::tobool (lobj);
+	result = spsds_tobool (p_shto, d_iidx, d_cidx, result);
       }
       if (d_meth == METH_COL) {
-	Literal* lobj = p_shto->map (d_ridx, d_iidx);
-	if (lobj != nullptr) result = Utility::tobool (lobj);
+	result = spsds_tobool (p_shto, d_ridx, d_iidx, result);
       }
       if (d_meth == METH_BND) {
 	Literal* lobj = p_shto->map (d_ridx, d_cidx);
@@ -296,12 +374,10 @@ namespace afnix {
 	return result;
       }
       if (d_meth == METH_ROW) {
-	Literal* lobj = p_shto->map (d_iidx, d_cidx);
-	if (lobj != nullptr) result = Utility::tolong (lobj);
+	result = spsds_tolong (p_shto, d_iidx, d_cidx, result);
       }
       if (d_meth == METH_COL) {
-	Literal* lobj = p_shto->map (d_ridx, d_iidx);
-	if (lobj != nullptr) result = Utility::tolong (lobj);
+	result = spsds_tolong (p_shto, d_ridx, d_iidx, result);
       }
       if (d_meth == METH_BND) {
 	Literal* lobj = p_shto->map (d_ridx, d_cidx);
@@ -336,12 +412,10 @@ namespace afnix {
 	return result;
       }
       if (d_meth == METH_ROW) {
-	Literal* lobj = p_shto->map (d_iidx, d_cidx);
-	if (lobj != nullptr) result = Utility::torint (lobj);
+	result = spsds_toreal (p_shto, d_iidx, d_cidx, result);
       }
       if (d_meth == METH_COL) {
-	Literal* lobj = p_shto->map (d_ridx, d_iidx);
-	if (lobj != nullptr) result = Utility::torint (lobj);
+	result = spsds_toreal (p_shto, d_ridx, d_iidx, result);
       }
       if (d_meth == METH_BND) {
 	Literal* lobj = p_shto->map (d_ridx, d_cidx);
@@ -365,6 +439,104 @@ namespace afnix {
     }
   }
 
+  // fill an integer array by positions
+
+  long Spsds::getlbuf (long* lbuf, const t_real* pbuf, const long size) {
+    // check for valid arrays
+    if ((lbuf == nullptr) || (pbuf == nullptr) || (size <= 0L)) return 0L;
+    // lock and fill
+    wrlock ();
+    try {
+      // check for valid sheet
+      if (p_shto == nullptr) {
+	long result = Streamable::getlbuf (lbuf, pbuf, size);
+	unlock ();
+	return result;
+      }
+      // get the streamer length and the bundle once
+      long slen = (long) arrival () + 1L;
+      Bundle* lstk = nullptr;
+      if (d_meth == METH_BND) {
+	lstk = dynamic_cast<Bundle*> (p_shto->map (d_ridx, d_cidx));
+      }
+      // read directly the cells
+      long dval = Streamable::getlong ();
+      for (long k = 0L; k < size; k++) {
+	d_iidx = spsds_toiidx (pbuf[k], slen);
+	long result = dval;
+	if (d_meth == METH_ROW) {
+	  result = spsds_tolong (p_shto, d_iidx, d_cidx, dval);
+	}
+	if (d_meth == METH_COL) {
+	  result = spsds_tolong (p_shto, d_ridx, d_iidx, dval);
+	}
+	if (d_meth == METH_BND) {
+	  Literal* lobj = lstk->get (d_iidx);
+	  if (lobj != nullptr) result = Utility::tolong (lobj);
+	}
+	if (d_meth == METH_MRK) {
+	  Literal* lobj = p_shto->getmark (d_iidx);
+	  if (lobj != nullptr) result = Utility::tolong (lobj);
+	}
+	lbuf[k] = result;
+      }
+      unlock ();
+      return size;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // fill a real array by positions
+
+  long Spsds::getrbuf (t_real* rbuf, const t_real* pbuf, const long size) {
+    // check for valid arrays
+    if ((rbuf == nullptr) || (pbuf == nullptr) || (size <= 0L)) return 0L;
+    // lock and fill
+    wrlock ();
+    try {
+      // check for valid sheet
+      if (p_shto == nullptr) {
+	long result = Streamable::getrbuf (rbuf, pbuf, size);
+	unlock ();
+	return result;
+      }
+      // get the streamer length and the bundle once
+      long slen = (long) arrival () + 1L;
+      Bundle* lstk = nullptr;
+      if (d_meth == METH_BND) {
+	lstk = dynamic_cast<Bundle*> (p_shto->map (d_ridx, d_cidx));
+      }
+      // read directly the cells
+      t_real dval = Streamable::getlong ();
+      for (long k = 0L; k < size; k++) {
+	d_iidx = spsds_toiidx (pbuf[k], slen);
+	t_real result = dval;
+	if (d_meth == METH_ROW) {
+	  result = spsds_toreal (p_shto, d_iidx, d_cidx, dval);
+	}
+	if (d_meth == METH_COL) {
+	  result = spsds_toreal (p_shto, d_ridx, d_iidx, dval);
+	}
+	if (d_meth == METH_BND) {
+	  Literal* lobj = lstk->get (d_iidx);
+	  if (lobj != nullptr) result = Utility::torint (lobj);
+	}
+	if (d_meth == METH_MRK) {
+	  Literal* lobj = p_shto->getmark (d_iidx);
+	  if (lobj != nullptr) result = Utility::torint (lobj);
+	}
+	rbuf[k] = result;
+      }
+      unlock ();
+      return size;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // set the sheet row index
 
   void Spsds::setridx (const long ridx) {
@@ -31,6 +31,10 @@ namespace afnix {
   /// content by creating a literal linear view of a sheet element. By default
   /// a marker streamer is used for data streaming. Other streamers are row
   /// based, column based or bundle based streamer.
+  /// When a sheet row is bound to a mapped column, the row and column
+  /// streamers read the typed value directly from the column. The bulk
+  /// methods read the cells directly without moving the streamer for
+  /// each position.
   /// @author amaury darch
 
   class Spsds : public Streamable {
@@ -105,6 +109,18 @@ namespace afnix {
     /// @return the streamer real data
     t_real getreal (void) const;
 
+    /// fill an integer array by positions
+    /// @param lbuf the integer array to fill
+    /// @param pbuf the position array
+    /// @param size the array size
+    long getlbuf (long* lbuf, const t_real* pbuf, const long size);
+
+    /// fill a real array by positions
+    /// @param rbuf the real array to fill
+    /// @param pbuf the position array
+    /// @param size the array size
+    long getrbuf (t_real* rbuf, const t_real* pbuf, const long size);
+
     /// set the streamer row index
     /// @param ridx the row index
     virtual void setridx (const long ridx);
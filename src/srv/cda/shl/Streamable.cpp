@@ -25,6 +25,29 @@
 
 namespace afnix {
 
+  // -------------------------------------------------------------------------
+  // - private section                                                       -
+  // -------------------------------------------------------------------------
+
+  // this procedure returns a position array from a vector object
+  static t_real* stm_to_pbuf (Object* obj, long& size) {
+    auto pvec = dynamic_cast <Vector*> (obj);
+    if ((pvec == nullptr) && (obj != nullptr)) {
+      throw Exception ("type-error", "invalid object as position vector",
+		       Object::repr (obj));
+    }
+    size = (pvec == nullptr) ? 0L : pvec->length ();
+    if (size == 0L) return nullptr;
+    t_real* result = new t_real[size];
+    try {
+      for (long k = 0L; k < size; k++) result[k] = pvec->getrint (k);
+      return result;
+    } catch (...) {
+      delete [] result;
+      throw;
+    }
+  }
+
   // -------------------------------------------------------------------------
   // - class section                                                         -
   // -------------------------------------------------------------------------
@@ -286,6 +309,81 @@ namespace afnix {
     }
   }
 
+  // fill an integer array by positions
+
+  long Streamable::getlbuf (long* lbuf, const t_real* pbuf, const long size) {
+    // check for valid arrays
+    if ((lbuf == nullptr) || (pbuf == nullptr) || (size <= 0L)) return 0L;
+    // lock and fill
+    wrlock ();
+    try {
+      for (long k = 0L; k < size; k++) lbuf[k] = getlong (pbuf[k]);
+      unlock ();
+      return size;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // fill an integer array by step
+
+  long Streamable::getlstp (long* lbuf, const long size, const t_real spos,
+			    const t_real step) {
+    // check for valid arrays
+    if ((lbuf == nullptr) || (size <= 0L)) return 0L;
+    // compute the positions
+    t_real* pbuf = new t_real[size];
+    for (long k = 0L; k < size; k++) pbuf[k] = spos + (k * step);
+    // fill by positions
+    try {
+      long result = getlbuf (lbuf, pbuf, size);
+      delete [] pbuf;
+      return result;
+    } catch (...) {
+      delete [] pbuf;
+      throw;
+    }
+  }
+
+  // fill a real array by positions
+
+  long Streamable::getrbuf (t_real* rbuf, const t_real* pbuf,
+			    const long size) {
+    // check for valid arrays
+    if ((rbuf == nullptr) || (pbuf == nullptr) || (size <= 0L)) return 0L;
+    // lock and fill
+    wrlock ();
+    try {
+      for (long k = 0L; k < size; k++) rbuf[k] = getreal (pbuf[k]);
+      unlock ();
+      return size;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // fill a real array by step
+
+  long Streamable::getrstp (t_real* rbuf, const long size, const t_real spos,
+			    const t_real step) {
+    // check for valid arrays
+    if ((rbuf == nullptr) || (size <= 0L)) return 0L;
+    // compute the positions
+    t_real* pbuf = new t_real[size];
+    for (long k = 0L; k < size; k++) pbuf[k] = spos + (k * step);
+    // fill by positions
+    try {
+      long result = getrbuf (rbuf, pbuf, size);
+      delete [] pbuf;
+      return result;
+    } catch (...) {
+      delete [] pbuf;
+      throw;
+    }
+  }
+
   // forward the streamer to the next boolean
 
   t_real Streamable::forward (const bool pval) {
@@ -461,7 +559,7 @@ namespace afnix {
   // -------------------------------------------------------------------------
 
   // the quark zone
-  static const long QUARK_ZONE_LENGTH = 14;
+  static const long QUARK_ZONE_LENGTH = 16;
   static QuarkZone  zone (QUARK_ZONE_LENGTH);
 
   // the object supported quarks
@@ -479,6 +577,8 @@ namespace afnix {
   static const long QUARK_GETREAL = zone.intern ("get-real");
   static const long QUARK_GETBOOL = zone.intern ("get-boolean");
   static const long QUARK_GETLONG = zone.intern ("get-integer");
+  static const long QUARK_GETRVEC = zone.intern ("get-real-vector");
+  static const long QUARK_GETLVEC = zone.intern ("get-integer-vector");
 
   // return true if the given quark is defined
 
@@ -548,6 +648,42 @@ namespace afnix {
 	t_real pos = argv->getreal(0);
 	return new Integer (getlong (pos));
       }
+      if (quark == QUARK_GETRVEC) {
+	long    size = 0L;
+	t_real* pbuf = stm_to_pbuf (argv->get (0), size);
+	t_real* rbuf = (size == 0L) ? nullptr : new t_real[size];
+	Vector* result = new Vector;
+	try {
+	  long rlen = getrbuf (rbuf, pbuf, size);
+	  for (long k = 0L; k < rlen; k++) result->add (new Real (rbuf[k]));
+	  delete [] pbuf;
+	  delete [] rbuf;
+	  return result;
+	} catch (...) {
+	  delete [] pbuf;
+	  delete [] rbuf;
+	  delete result;
+	  throw;
+	}
+      }
+      if (quark == QUARK_GETLVEC) {
+	long    size = 0L;
+	t_real* pbuf = stm_to_pbuf (argv->get (0), size);
+	long*   lbuf = (size == 0L) ? nullptr : new long[size];
+	Vector* result = new Vector;
+	try {
+	  long llen = getlbuf (lbuf, pbuf, size);
+	  for (long k = 0L; k < llen; k++) result->add (new Integer (lbuf[k]));
+	  delete [] pbuf;
+	  delete [] lbuf;
+	  return result;
+	} catch (...) {
+	  delete [] pbuf;
+	  delete [] lbuf;
+	  delete result;
+	  throw;
+	}
+      }
       if (quark == QUARK_FWARD) {
 	Object* obj = argv->get (0);
 	// check for a boolean
@@ -579,6 +715,43 @@ namespace afnix {
 			 Object::repr (obj));
       }
     }
+    // dispatch 3 arguments
+    if (argc == 3) {
+      if (quark == QUARK_GETRVEC) {
+	t_real  spos = argv->getreal (0);
+	t_real  step = argv->getreal (1);
+	long    size = argv->getlong (2);
+	t_real* rbuf = (size <= 0L) ? nullptr : new t_real[size];
+	Vector* result = new Vector;
+	try {
+	  long rlen = getrstp (rbuf, size, spos, step);
+	  for (long k = 0L; k < rlen; k++) result->add (new Real (rbuf[k]));
+	  delete [] rbuf;
+	  return result;
+	} catch (...) {
+	  delete [] rbuf;
+	  delete result;
+	  throw;
+	}
+      }
+      if (quark == QUARK_GETLVEC) {
+	t_real  spos = argv->getreal (0);
+	t_real  step = argv->getreal (1);
+	long    size = argv->getlong (2);
+	long*   lbuf = (size <= 0L) ? nullptr : new long[size];
+	Vector* result = new Vector;
+	try {
+	  long llen = getlstp (lbuf, size, spos, step);
+	  for (long k = 0L; k < llen; k++) result->add (new Integer (lbuf[k]));
+	  delete [] lbuf;
+	  return result;
+	} catch (...) {
+	  delete [] lbuf;
+	  delete result;
+	  throw;
+	}
+      }
+    }
     // call the object method
     return Object::apply (zobj, nset, quark, argv);
   }
@@ -28,6 +28,9 @@ namespace afnix {
   /// in a sequential form with an optional position. The streamable object
   /// has also capabilities that can be queried. The basic streamable object
   /// is a file which produces data bytes.
+  /// The integer and real data can also be collected in bulk into an array
+  /// for a set of positions or from a position with a step. A streamable
+  /// object can override the bulk methods to avoid a move per position.
   /// @author amaury darsch
 
   class Streamable : public virtual Object {
@@ -97,6 +100,38 @@ namespace afnix {
     /// @return the real data by position
     virtual t_real getreal (const t_real pos);
 
+    /// fill an integer array by positions
+    /// @param lbuf the integer array to fill
+    /// @param pbuf the position array
+    /// @param size the array size
+    /// @return the number of filled values
+    virtual long getlbuf (long* lbuf, const t_real* pbuf, const long size);
+
+    /// fill an integer array by step
+    /// @param lbuf the integer array to fill
+    /// @param size the array size
+    /// @param spos the start position
+    /// @param step the position step
+    /// @return the number of filled values
+    virtual long getlstp (long* lbuf, const long size, const t_real spos,
+			  const t_real step);
+
+    /// fill a real array by positions
+    /// @param rbuf the real array to fill
+    /// @param pbuf the position array
+    /// @param size the array size
+    /// @return the number of filled values
+    virtual long getrbuf (t_real* rbuf, const t_real* pbuf, const long size);
+
+    /// fill a real array by step
+    /// @param rbuf the real array to fill
+    /// @param size the array size
+    /// @param spos the start position
+    /// @param step the position step
+    /// @return the number of filled values
+    virtual long getrstp (t_real* rbuf, const long size, const t_real spos,
+			  const t_real step);
+
     /// forward the streamer to the next boolean
     /// @param pval the boolean value to find
     virtual t_real forward (const bool pval);
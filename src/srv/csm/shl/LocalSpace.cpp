@@ -16,6 +16,8 @@
 
 #include "Vector.hpp"
 #include "System.hpp"
+#include "Integer.hpp"
+#include "Directory.hpp"
 #include "LocalZone.hpp"
 #include "QuarkZone.hpp"
 #include "Exception.hpp"
@@ -51,6 +53,7 @@ namespace afnix {
     d_root = root;
     d_name = System::xbase (root);
     Object::iref (p_lock = new Lockf (System::join (d_root, LS_LOCK_DEF)));
+    d_csiz = 0L;
   }
   
   // create a localspace by root directory
@@ -67,6 +70,7 @@ namespace afnix {
     d_root = root;
     d_name = System::xbase (root);
     Object::iref (p_lock = new Lockf (System::join (d_root, LS_LOCK_DEF)));
+    d_csiz = 0L;
   }
   
   // create a localspace by root and name
@@ -83,6 +87,7 @@ namespace afnix {
     // set the local root
     d_root = root;
     Object::iref (p_lock = new Lockf (System::join (d_root, LS_LOCK_DEF)));
+    d_csiz = 0L;
   }
   
   // create a localspace by root, name and info
@@ -99,6 +104,7 @@ namespace afnix {
     // set the local root
     d_root = root;
     Object::iref (p_lock = new Lockf (System::join (d_root, LS_LOCK_DEF)));
+    d_csiz = 0L;
   }
   
   // destroy the local space
@@ -146,6 +152,8 @@ namespace afnix {
       // get the zone root directory
       String root = System::join (d_root, zone);
       p_lock->wrlock ();
+      // drop the cached zone
+      d_zcch.remove (zone);
       // bind result
       bool result = false;
       // map the zone
@@ -185,10 +193,17 @@ namespace afnix {
       // create a zone
       WorkZone* result = nullptr;
       try {
-	result = new LocalZone (root);
+	if (d_csiz > 0L) {
+	  auto lzon = new LocalZone (root, zone);
+	  d_zcch.add (zone, lzon);
+	  lzon->setcsiz (d_csiz);
+	  result = lzon;
+	} else {
+	  result = new LocalZone (root);
+	}
 	p_lock->unlock ();
       } catch (...) {
-	delete result;
+	if (d_csiz == 0L) delete result;
 	p_lock->unlock ();
 	throw;
       }
@@ -212,7 +227,8 @@ namespace afnix {
       WorkZone* result = nullptr;
       if (iszone (zone) == true) {
 	try {
-	  result = new LocalZone (root);
+	  result = getlz (zone);
+	  if (result == nullptr) result = new LocalZone (root);
 	  p_lock->unlock ();
 	} catch (...) {
 	  delete result;
@@ -234,7 +250,7 @@ namespace afnix {
     rdlock ();
     try {
       // check if the zone exists
-      if (iszone (zone) == false) {
+      if ((getlz (zone) == nullptr) && (iszone (zone) == false)) {
 	throw Exception ("localspace-error", "cannot find zone", zone);
       }
       // get the zone root directory
@@ -259,16 +275,25 @@ namespace afnix {
     rdlock ();
     try {
       // check if the zone exists
-      if (iszone (zone) == false) {
+      if ((getlz (zone) == nullptr) && (iszone (zone) == false)) {
 	unlock ();
 	return false;
       }
       // get the zone root directory
       String root = System::join (d_root, zone);
-      // create a local zone
-      LocalZone lzon (root, zone);
+      // get the cached zone or create a local zone
+      LocalZone* lzon = getlz (zone);
+      if (lzon == nullptr) lzon = new LocalZone (root, zone);
+      Object::iref (lzon);
       // check for existence
-      bool result = lzon.exists (uri);
+      bool result = false;
+      try {
+	result = lzon->exists (uri);
+	Object::dref (lzon);
+      } catch (...) {
+	Object::dref (lzon);
+	throw;
+      }
       unlock ();
       return result;
     } catch (...) {
@@ -283,15 +308,24 @@ namespace afnix {
     rdlock ();
     try {
       // check if the zone exists
-      if (iszone (zone) == false) {
+      if ((getlz (zone) == nullptr) && (iszone (zone) == false)) {
 	throw Exception ("localspace-error", "cannot find zone", zone);
       }
       // get the zone root directory
       String root = System::join (d_root, zone);
-      // create a local zone
-      LocalZone lzon (root, zone);
+      // get the cached zone or create a local zone
+      LocalZone* lzon = getlz (zone);
+      if (lzon == nullptr) lzon = new LocalZone (root, zone);
+      Object::iref (lzon);
       // get the input stream
-      InputStream* is = lzon.getis (uri);
+      InputStream* is = nullptr;
+      try {
+	is = lzon->getis (uri);
+	Object::dref (lzon);
+      } catch (...) {
+	Object::dref (lzon);
+	throw;
+      }
       unlock ();
       return is;
       unlock ();
@@ -308,15 +342,24 @@ namespace afnix {
     rdlock ();
     try {
       // check if the zone exists
-      if (iszone (zone) == false) {
+      if ((getlz (zone) == nullptr) && (iszone (zone) == false)) {
 	throw Exception ("localspace-error", "cannot find zone", zone);
       }
       // get the zone root directory
       String root = System::join (d_root, zone);
-      // create a local zone
-      LocalZone lzon (root, zone);
+      // get the cached zone or create a local zone
+      LocalZone* lzon = getlz (zone);
+      if (lzon == nullptr) lzon = new LocalZone (root, zone);
+      Object::iref (lzon);
       // get the output stream
-      OutputStream* os = lzon.getos (uri);
+      OutputStream* os = nullptr;
+      try {
+	os = lzon->getos (uri);
+	Object::dref (lzon);
+      } catch (...) {
+	Object::dref (lzon);
+	throw;
+      }
       unlock ();
       return os;
     } catch (...) {
@@ -331,15 +374,24 @@ namespace afnix {
     rdlock ();
     try {
       // check if the zone exists
-      if (iszone (zone) == false) {
+      if ((getlz (zone) == nullptr) && (iszone (zone) == false)) {
 	throw Exception ("localspace-error", "cannot find zone", zone);
       }
       // get the zone root directory
       String root = System::join (d_root, zone);
-      // create a local zone
-      LocalZone lzon (root, zone);
+      // get the cached zone or create a local zone
+      LocalZone* lzon = getlz (zone);
+      if (lzon == nullptr) lzon = new LocalZone (root, zone);
+      Object::iref (lzon);
       // get the entity list
-      Strvec* result = lzon.getelst ();
+      Strvec* result = nullptr;
+      try {
+	result = lzon->getelst ();
+	Object::dref (lzon);
+      } catch (...) {
+	Object::dref (lzon);
+	throw;
+      }
       unlock ();
       return result;
     } catch (...) {
@@ -354,15 +406,24 @@ namespace afnix {
     rdlock ();
     try {
       // check if the zone exists
-      if (iszone (zone) == false) {
+      if ((getlz (zone) == nullptr) && (iszone (zone) == false)) {
 	throw Exception ("localspace-error", "cannot find zone", zone);
       }
       // get the zone root directory
       String root = System::join (d_root, zone);
-      // create a local zone
-      LocalZone lzon (root, zone);
+      // get the cached zone or create a local zone
+      LocalZone* lzon = getlz (zone);
+      if (lzon == nullptr) lzon = new LocalZone (root, zone);
+      Object::iref (lzon);
       // get the entity print table
-      PrintTable* result = lzon.toeptbl ();
+      PrintTable* result = nullptr;
+      try {
+	result = lzon->toeptbl ();
+	Object::dref (lzon);
+      } catch (...) {
+	Object::dref (lzon);
+	throw;
+      }
       unlock ();
       return result;
     } catch (...) {
@@ -385,16 +446,73 @@ namespace afnix {
     }
   }
 
+  // set the zone cache size
+
+  void LocalSpace::setcsiz (const long csiz) {
+    wrlock ();
+    p_lock->rdlock ();
+    Strvec* zlst = nullptr;
+    try {
+      // reset the cached zones
+      d_csiz = (csiz < 0L) ? 0L : csiz;
+      d_zcch.reset ();
+      // map the existing zones
+      if (d_csiz > 0L) {
+	Directory rdir (d_root);
+	zlst = rdir.getdirs ();
+	long zlen = (zlst == nullptr) ? 0L : zlst->length ();
+	for (long k = 0L; k < zlen; k++) {
+	  String zone = zlst->get (k);
+	  if ((zone == ".") || (zone == "..")) continue;
+	  auto lzon = new LocalZone (System::join (d_root, zone), zone);
+	  d_zcch.add (zone, lzon);
+	  lzon->setcsiz (d_csiz);
+	}
+      }
+      delete zlst;
+      p_lock->unlock ();
+      unlock ();
+    } catch (...) {
+      delete zlst;
+      p_lock->unlock ();
+      unlock ();
+      throw;
+    }
+  }
+
+  // get the zone cache size
+
+  long LocalSpace::getcsiz (void) const {
+    rdlock ();
+    try {
+      long result = d_csiz;
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get a cached zone by name
+
+  LocalZone* LocalSpace::getlz (const String& zone) const {
+    if (d_csiz == 0L) return nullptr;
+    return dynamic_cast <LocalZone*> (d_zcch.get (zone));
+  }
+
   // -------------------------------------------------------------------------
   // - object section                                                        -
   // -------------------------------------------------------------------------
 
   // the quark zone
-  static const long QUARK_ZONE_LENGTH = 1;
+  static const long QUARK_ZONE_LENGTH = 3;
   static QuarkZone  zone (QUARK_ZONE_LENGTH);
 
   // the object supported quarks
   static const long QUARK_GETROOT  = zone.intern ("get-root");
+  static const long QUARK_SETCSIZ  = zone.intern ("set-cache-size");
+  static const long QUARK_GETCSIZ  = zone.intern ("get-cache-size");
 
   // create a new object in a generic way
 
@@ -451,7 +569,16 @@ namespace afnix {
     
     // check for 0 argument
     if (argc == 0) {
-      if (quark == QUARK_GETROOT) return new String (getroot ());
+      if (quark == QUARK_GETROOT) return new String  (getroot ());
+      if (quark == QUARK_GETCSIZ) return new Integer (getcsiz ());
+    }
+    // check for 1 argument
+    if (argc == 1) {
+      if (quark == QUARK_SETCSIZ) {
+	long csiz = argv->getlong (0);
+	setcsiz (csiz);
+	return nullptr;
+      }
     }
     // call the workspace method
     return WorkSpace::apply (zobj, nset, quark, argv);
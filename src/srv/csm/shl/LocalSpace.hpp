@@ -25,6 +25,10 @@
 #include "WorkSpace.hpp"
 #endif
 
+#ifndef  AFNIX_HASHTABLE_HPP
+#include "HashTable.hpp"
+#endif
+
 namespace afnix {
 
   /// The LocalSpace class is a local implementation of the abstract
@@ -32,7 +36,9 @@ namespace afnix {
   /// which serves as a root place for the whole workspace. Each zone can be
   /// seen as a local directory and with entity as file, the local space is
   /// persistent. There is no protection mechanism with respect to the
-  /// underlying file system hosting the local space.
+  /// underlying file system hosting the local space. When a cache size is
+  /// set, the local space keeps its zones with an entity cache of that
+  /// size, instead of mapping a new zone at each call.
   /// @author amaury darsch
 
   class LocalSpace : public WorkSpace {
@@ -41,6 +47,10 @@ namespace afnix {
     String d_root;
     /// the lock file
     Lockf* p_lock;
+    /// the zone cache size
+    long   d_csiz;
+    /// the cached zones
+    HashTable d_zcch;
     
   public:
     /// create a default local space
@@ -115,7 +125,17 @@ namespace afnix {
     /// @return the local root directory
     virtual String getroot (void) const;
 
+    /// set the zone cache size - a null size disables the cache
+    /// @param csiz the zone cache size in bytes
+    virtual void setcsiz (const long csiz);
+
+    /// @return the zone cache size
+    virtual long getcsiz (void) const;
+
   private:
+    // get a cached zone by name
+    class LocalZone* getlz (const String& zone) const;
+
     // make the copy constructor private
     LocalSpace (const LocalSpace&) =delete;
     // make the assignment operator private
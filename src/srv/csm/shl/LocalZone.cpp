@@ -15,17 +15,23 @@
 // ---------------------------------------------------------------------------
 
 #include "Date.hpp"
+#include "Mutex.hpp"
+#include "Serial.hpp"
 #include "Vector.hpp"
 #include "System.hpp"
+#include "Integer.hpp"
 #include "Utility.hpp"
 #include "Pathname.hpp"
 #include "FileInfo.hpp"
+#include "HashTable.hpp"
 #include "InputFile.hpp"
 #include "Directory.hpp"
 #include "QuarkZone.hpp"
 #include "Exception.hpp"
-#include "OutputFile.hpp"
 #include "LocalZone.hpp"
+#include "OutputFile.hpp"
+#include "InputOutput.hpp"
+#include "csio.hpp"
 
 namespace afnix {
  
@@ -61,6 +67,378 @@ namespace afnix {
     }
     return path;
   }
+
+  // the cache entity size divider
+  static const long LZ_CENT_DIV = 4L;
+
+  // the cache entity
+  struct s_lzce : public Object {
+    // the entity path
+    String  d_path;
+    // the entity data
+    char*   p_data;
+    // the entity size
+    long    d_size;
+    // the entity identity
+    String  d_idty;
+    // the identity flag
+    bool    d_iflg;
+    // the previous entity
+    s_lzce* p_prev;
+    // the next entity
+    s_lzce* p_next;
+    // create a new cache entity
+    s_lzce (const String& path, char* data, const long size) {
+      d_path = path;
+      p_data = data;
+      d_size = size;
+      d_iflg = false;
+      p_prev = nullptr;
+      p_next = nullptr;
+    }
+    // destroy this cache entity
+    ~s_lzce (void) {
+      delete [] p_data;
+    }
+    // return the class name
+    String repr (void) const {
+      return "LocalZoneEntity";
+    }
+  };
+
+  // the local zone cache
+  struct s_lzch {
+    // the cache lock
+    Mutex     d_mtx;
+    // the entity table
+    HashTable d_hash;
+    // the most recent entity
+    s_lzce*   p_head;
+    // the least recent entity
+    s_lzce*   p_tail;
+    // the cache size
+    long      d_csiz;
+    // the cache length
+    long      d_clen;
+    // the cache generation
+    t_long    d_cgen;
+    // the cache hits
+    t_long    d_chit;
+    // the reference count
+    long      d_rcnt;
+    // create a new cache by size
+    s_lzch (const long csiz) {
+      p_head = nullptr;
+      p_tail = nullptr;
+      d_csiz = csiz;
+      d_clen = 0L;
+      d_cgen = 0LL;
+      d_chit = 0LL;
+      d_rcnt = 1L;
+    }
+    // reference this cache
+    void iref (void) {
+      d_mtx.lock ();
+      d_rcnt++;
+      d_mtx.unlock ();
+    }
+    // release a cache
+    static void dref (s_lzch* lzch) {
+      if (lzch == nullptr) return;
+      lzch->d_mtx.lock ();
+      bool dflg = (--lzch->d_rcnt == 0L);
+      lzch->d_mtx.unlock ();
+      if (dflg == true) delete lzch;
+    }
+    // get an entity by path
+    s_lzce* get (const String& path) const {
+      return dynamic_cast <s_lzce*> (d_hash.get (path));
+    }
+    // unlink an entity
+    void unlink (s_lzce* lzce) {
+      if (lzce->p_prev == nullptr) p_head = lzce->p_next;
+      else lzce->p_prev->p_next = lzce->p_next;
+      if (lzce->p_next == nullptr) p_tail = lzce->p_prev;
+      else lzce->p_next->p_prev = lzce->p_prev;
+      lzce->p_prev = nullptr;
+      lzce->p_next = nullptr;
+    }
+    // link an entity as the most recent one
+    void link (s_lzce* lzce) {
+      lzce->p_prev = nullptr;
+      lzce->p_next = p_head;
+      if (p_head != nullptr) p_head->p_prev = lzce;
+      p_head = lzce;
+      if (p_tail == nullptr) p_tail = lzce;
+    }
+    // drop an entity
+    void drop (s_lzce* lzce) {
+      unlink (lzce);
+      d_clen -= lzce->d_size;
+      d_hash.remove (lzce->d_path);
+    }
+    // evict the least recent entities
+    void evict (void) {
+      while ((d_clen > d_csiz) && (p_tail != nullptr)) drop (p_tail);
+    }
+    // get the maximum entity size
+    long getemax (void) {
+      d_mtx.lock ();
+      long result = d_csiz / LZ_CENT_DIV;
+      d_mtx.unlock ();
+      return result;
+    }
+    // get the cache generation
+    t_long getcgen (void) {
+      d_mtx.lock ();
+      t_long result = d_cgen;
+      d_mtx.unlock ();
+      return result;
+    }
+    // set the cache size
+    void setcsiz (const long csiz) {
+      d_mtx.lock ();
+      d_csiz = csiz;
+      evict ();
+      d_mtx.unlock ();
+    }
+    // reset the cache
+    void reset (void) {
+      d_mtx.lock ();
+      while (p_tail != nullptr) drop (p_tail);
+      d_cgen++;
+      d_mtx.unlock ();
+    }
+    // invalidate an entity by path
+    void remove (const String& path) {
+      d_mtx.lock ();
+      s_lzce* lzce = get (path);
+      if (lzce != nullptr) drop (lzce);
+      d_cgen++;
+      d_mtx.unlock ();
+    }
+    // check if an entity is cached
+    bool exists (const String& path) {
+      d_mtx.lock ();
+      bool result = (get (path) != nullptr);
+      d_mtx.unlock ();
+      return result;
+    }
+    // get an input stream by path or nil
+    InputStream* getis (const String& path) {
+      d_mtx.lock ();
+      try {
+	InputStream* result = nullptr;
+	s_lzce* lzce = get (path);
+	if (lzce != nullptr) {
+	  unlink (lzce);
+	  link (lzce);
+	  d_chit++;
+	  Buffer sbuf (lzce->d_size, lzce->d_size, lzce->p_data);
+	  result = new InputOutput (sbuf);
+	}
+	d_mtx.unlock ();
+	return result;
+      } catch (...) {
+	d_mtx.unlock ();
+	throw;
+      }
+    }
+    // add an entity data if the generation is unchanged
+    void add (const String& path, char* data, const long size,
+	      const t_long cgen) {
+      d_mtx.lock ();
+      try {
+	if ((cgen != d_cgen) || (size > (d_csiz / LZ_CENT_DIV))) {
+	  delete [] data;
+	  d_mtx.unlock ();
+	  return;
+	}
+	s_lzce* lzce = get (path);
+	if (lzce != nullptr) drop (lzce);
+	lzce = new s_lzce (path, data, size);
+	d_hash.add (path, lzce);
+	link (lzce);
+	d_clen += size;
+	evict ();
+	d_mtx.unlock ();
+      } catch (...) {
+	d_mtx.unlock ();
+	throw;
+      }
+    }
+    // get an entity identity by path
+    bool getidty (const String& path, String& idty) {
+      d_mtx.lock ();
+      s_lzce* lzce = get (path);
+      bool result = (lzce != nullptr) && (lzce->d_iflg == true);
+      if (result == true) idty = lzce->d_idty;
+      d_mtx.unlock ();
+      return result;
+    }
+    // set an entity identity by path
+    void setidty (const String& path, const String& idty) {
+      d_mtx.lock ();
+      s_lzce* lzce = get (path);
+      if (lzce != nullptr) {
+	lzce->d_idty = idty;
+	lzce->d_iflg = true;
+      }
+      d_mtx.unlock ();
+    }
+    // get the number of cache hits
+    t_long getchit (void) {
+      d_mtx.lock ();
+      t_long result = d_chit;
+      d_mtx.unlock ();
+      return result;
+    }
+  };
+
+  // the cache invalidating output file
+  class LzOutputFile : public OutputFile {
+  private:
+    // the output path
+    String  d_path;
+    // the zone cache
+    s_lzch* p_lzch;
+  public:
+    // create an output file by path and cache
+    LzOutputFile (const String& path, s_lzch* lzch) : OutputFile (path) {
+      d_path = path;
+      p_lzch = lzch;
+      p_lzch->iref ();
+      p_lzch->remove (d_path);
+    }
+    // invalidate and release the cache
+    ~LzOutputFile (void) {
+      close ();
+      p_lzch->remove (d_path);
+      s_lzch::dref (p_lzch);
+    }
+    // close this output file
+    bool close (void) {
+      bool result = OutputFile::close ();
+      p_lzch->remove (d_path);
+      return result;
+    }
+  };
+
+  // read an entity in a new buffer if its size is bounded
+  static char* lz_rdfile (const String& path, const long emax, long& size) {
+    char* name = path.tochar ();
+    int   sid  = c_openr (name);
+    delete [] name;
+    if (sid < 0) return nullptr;
+    t_long fsiz = c_fsize (sid);
+    if ((fsiz < 0LL) || (fsiz > emax)) {
+      c_close (sid);
+      return nullptr;
+    }
+    size = (long) fsiz;
+    char* data = new char[(size == 0L) ? 1L : size];
+    long  rlen = 0L;
+    while (rlen < size) {
+      t_long count = c_read (sid, data + rlen, size - rlen);
+      if (count <= 0LL) break;
+      rlen += (long) count;
+    }
+    c_close (sid);
+    if (rlen != size) {
+      delete [] data;
+      return nullptr;
+    }
+    return data;
+  }
+
+  // get an input stream by path with a cache
+  static InputStream* lz_getis (const String& path, s_lzch* lzch) {
+    // check for no cache
+    if (lzch == nullptr) return new InputFile (path);
+    // check in the cache first
+    InputStream* result = lzch->getis (path);
+    if (result != nullptr) return result;
+    // read the entity in the cache
+    t_long cgen = lzch->getcgen ();
+    long   size = 0L;
+    char*  data = lz_rdfile (path, lzch->getemax (), size);
+    if (data == nullptr) return new InputFile (path);
+    try {
+      Buffer sbuf (size, size, data);
+      result = new InputOutput (sbuf);
+      lzch->add (path, data, size, cgen);
+      return result;
+    } catch (...) {
+      delete result;
+      throw;
+    }
+  }
+
+  // get an output stream by path with a cache
+  static OutputStream* lz_getos (const String& path, s_lzch* lzch) {
+    if (lzch == nullptr) return new OutputFile (path);
+    return new LzOutputFile (path, lzch);
+  }
+
+  // check if an entity exists by path with a cache
+  static bool lz_exists (const String& path, s_lzch* lzch) {
+    if ((lzch != nullptr) && (lzch->exists (path) == true)) return true;
+    return System::isfile (path);
+  }
+
+  // rename an entity by path with a cache
+  static bool lz_rename (const String& name, const String& path,
+			 s_lzch* lzch) {
+    if (lzch != nullptr) {
+      lzch->remove (name);
+      lzch->remove (path);
+    }
+    return System::mvfile (name, path);
+  }
+
+  // remove an entity by path with a cache
+  static bool lz_remove (const String& path, s_lzch* lzch) {
+    if (lzch != nullptr) lzch->remove (path);
+    return System::rmfile (path);
+  }
+
+  // map a plain entity name to a path without uri
+  static bool lz_tname (const String& root, const String& name,
+			String& path) {
+    // check for a plain name
+    long nlen = name.length ();
+    if ((nlen == 0L) || (name == ".") || (name == "..")) return false;
+    for (long k = 0L; k < nlen; k++) {
+      t_quad c = name[k];
+      if ((c == ':') || (c == '/') || (c == '\\')) return false;
+    }
+    // map the path in the root directory
+    path = System::join (root, name);
+    return true;
+  }
+
+  // get an entity identity by path with a cache
+  static String lz_getidty (const String& path, s_lzch* lzch) {
+    // check without cache
+    if (lzch == nullptr) {
+      FileInfo info (path, true);
+      return info.identity ();
+    }
+    // check in the cache
+    String result;
+    if (lzch->getidty (path, result) == true) return result;
+    // compute the identity and save it
+    InputStream* is = lz_getis (path, lzch);
+    try {
+      result = Serial::identify (*is);
+      delete is;
+    } catch (...) {
+      delete is;
+      throw;
+    }
+    lzch->setidty (path, result);
+    return result;
+  }
   
   // -------------------------------------------------------------------------
   // - class section                                                         -
@@ -82,6 +460,7 @@ namespace afnix {
     d_root = root;
     d_name = System::xbase (root);
     Object::iref (p_lock = new Lockf (System::join (d_root, LZ_LOCK_DEF)));
+    p_lzch = nullptr;
   }
   
   // create a local zone by root and name
@@ -100,6 +479,7 @@ namespace afnix {
     d_root = rdir;
     d_name = System::xbase (rdir);
     Object::iref (p_lock = new Lockf (System::join (d_root, LZ_LOCK_DEF)));
+    p_lzch = nullptr;
   }
 
   // create a local zone by root and name
@@ -118,6 +498,7 @@ namespace afnix {
     // set the local root and lock
     d_root = rdir;
     Object::iref (p_lock = new Lockf (System::join (d_root, LZ_LOCK_DEF)));
+    p_lzch = nullptr;
   }
 
   // create a local zone by name, info and root directory
@@ -136,12 +517,14 @@ namespace afnix {
     // set the local root and lock
     d_root = rdir;
     Object::iref (p_lock = new Lockf (System::join (d_root, LZ_LOCK_DEF)));
+    p_lzch = nullptr;
   }
   
   // destroy the local zone
 
   LocalZone::~LocalZone (void) {
     Object::dref (p_lock);
+    s_lzch::dref (p_lzch);
   }
 
   // return the class name
@@ -174,8 +557,8 @@ namespace afnix {
     try {
       // map the uri to a path
       String path = lz_topath (d_root, uri);
-      // check for valid path
-      bool result = System::isfile (path);
+      // check in the cache or for valid path
+      bool result = lz_exists (path, p_lzch);
       unlock ();
       return result;
     } catch (...) {
@@ -193,7 +576,7 @@ namespace afnix {
       String name = lz_topath (d_root, nuri);
       String path = lz_topath (d_root, turi);
       // try to move the file
-      bool result = System::mvfile (name, path);
+      bool result = lz_rename (name, path, p_lzch);
       unlock ();
       return result;
     } catch (...) {
@@ -210,7 +593,56 @@ namespace afnix {
       // map the uri to a path
       String path = lz_topath (d_root, uri);
       // try to remove the file
-      bool result = System::rmfile (path);
+      bool result = lz_remove (path, p_lzch);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // check if an entity exists by string uri
+
+  bool LocalZone::exists (const String& suri) const {
+    rdlock ();
+    try {
+      String path;
+      bool result = lz_tname (d_root, suri, path) ?
+	lz_exists (path, p_lzch) : WorkZone::exists (suri);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // rename an entity by string uri
+
+  bool LocalZone::rename (const String& suri, const String& puri) {
+    wrlock ();
+    try {
+      String name; String path;
+      bool result =
+	(lz_tname (d_root, suri, name) && lz_tname (d_root, puri, path)) ?
+	lz_rename (name, path, p_lzch) : WorkZone::rename (suri, puri);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // remove an entity by string uri
+
+  bool LocalZone::remove (const String& suri) {
+    wrlock ();
+    try {
+      String path;
+      bool result = lz_tname (d_root, suri, path) ?
+	lz_remove (path, p_lzch) : WorkZone::remove (suri);
       unlock ();
       return result;
     } catch (...) {
@@ -243,6 +675,7 @@ namespace afnix {
 	result = result && WorkZone::remove (name);
       }
       if (result == true) p_lock->setrmoc (true);
+      if (p_lzch != nullptr) p_lzch->reset ();
       // clean and return
       delete elst;
       p_lock->unlock ();
@@ -263,8 +696,8 @@ namespace afnix {
     try {
       // map the uri to a path
       String path = lz_topath (d_root, uri);
-      // create a local input stream
-      InputStream* is = new InputFile (path);
+      // create a local or cached input stream
+      InputStream* is = lz_getis (path, p_lzch);
       unlock ();
       return is;
     } catch (...) {
@@ -280,8 +713,40 @@ namespace afnix {
     try {
       // map the uri to a path
       String path = lz_topath (d_root, uri);
-      // create a local input stream
-      OutputStream* os = new OutputFile (path);
+      // create a local or cache invalidating output stream
+      OutputStream* os = lz_getos (path, p_lzch);
+      unlock ();
+      return os;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get an input stream by string uri
+
+  InputStream* LocalZone::getis (const String& suri) const {
+    rdlock ();
+    try {
+      String path;
+      InputStream* is = lz_tname (d_root, suri, path) ?
+	lz_getis (path, p_lzch) : WorkZone::getis (suri);
+      unlock ();
+      return is;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get an output stream by string uri
+
+  OutputStream* LocalZone::getos (const String& suri) const {
+    rdlock ();
+    try {
+      String path;
+      OutputStream* os = lz_tname (d_root, suri, path) ?
+	lz_getos (path, p_lzch) : WorkZone::getos (suri);
       unlock ();
       return os;
     } catch (...) {
@@ -331,11 +796,9 @@ namespace afnix {
       for (long k = 0L; k < elen; k++) {
 	// get the file name and path
 	String name = elst->get (k);
-	String path = lz_topath (d_root, tonuri(name));
-	// get the file information
-	FileInfo info (path, true);
+	String path = System::join (d_root, name);
 	// compare the identity
-	if (info.identity () == idty) result->add (name);
+	if (lz_getidty (path, p_lzch) == idty) result->add (name);
       }
       delete elst;
       // unlock and return
@@ -370,15 +833,17 @@ namespace afnix {
       for (long k = 0L; k < elen; k++) {
 	// get the file name and path
 	String name = elst->get (k);
-	String path = lz_topath (d_root, tonuri(name));
+	String path = System::join (d_root, name);
 	// get the file information
-	FileInfo info (path, true);
+	FileInfo info (path);
+	String   itag = lz_getidty (path, p_lzch);
 	// set the table
 	long row = ptbl->add ();
 	ptbl->set (row, 0, name);
 	ptbl->set (row, 1, Utility::tostring (info.length ()));
-	ptbl->set (row, 2, info.identity().toupper());
+	ptbl->set (row, 2, itag.toupper());
       }
+      delete elst;
       p_lock->unlock ();
       unlock ();
       return ptbl;
@@ -404,16 +869,102 @@ namespace afnix {
     }
   }
 
+  // get a local zone entity information list
+
+  Vector* LocalZone::getilst (void) const {
+    rdlock ();
+    p_lock->rdlock ();
+    Strvec* elst = nullptr;
+    Vector* result = new Vector;
+    try {
+      // get the entity list
+      elst = getelst ();
+      // loop in the list
+      long elen = (elst == nullptr) ? 0L : elst->length ();
+      for (long k = 0L; k < elen; k++) {
+	String path = System::join (d_root, elst->get (k));
+	result->add (new FileInfo (path));
+      }
+      delete elst;
+      p_lock->unlock ();
+      unlock ();
+      return result;
+    } catch (...) {
+      delete elst;
+      delete result;
+      p_lock->unlock ();
+      unlock ();
+      throw;
+    }
+  }
+
+  // set the cache size
+
+  void LocalZone::setcsiz (const long csiz) {
+    wrlock ();
+    try {
+      if (csiz <= 0L) {
+	s_lzch::dref (p_lzch);
+	p_lzch = nullptr;
+      } else if (p_lzch == nullptr) {
+	p_lzch = new s_lzch (csiz);
+      } else {
+	p_lzch->setcsiz (csiz);
+      }
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get the cache size
+
+  long LocalZone::getcsiz (void) const {
+    rdlock ();
+    try {
+      long result = 0L;
+      if (p_lzch != nullptr) {
+	p_lzch->d_mtx.lock ();
+	result = p_lzch->d_csiz;
+	p_lzch->d_mtx.unlock ();
+      }
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get the number of cache hits
+
+  t_long LocalZone::getchit (void) const {
+    rdlock ();
+    try {
+      t_long result = (p_lzch == nullptr) ? 0LL : p_lzch->getchit ();
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // -------------------------------------------------------------------------
   // - object section                                                        -
   // -------------------------------------------------------------------------
 
   // the quark zone
-  static const long QUARK_ZONE_LENGTH = 1;
+  static const long QUARK_ZONE_LENGTH = 5;
   static QuarkZone  zone (QUARK_ZONE_LENGTH);
 
   // the object supported quarks
   static const long QUARK_GETROOT  = zone.intern ("get-root");
+  static const long QUARK_GETILST  = zone.intern ("get-info-list");
+  static const long QUARK_SETCSIZ  = zone.intern ("set-cache-size");
+  static const long QUARK_GETCSIZ  = zone.intern ("get-cache-size");
+  static const long QUARK_GETCHIT  = zone.intern ("get-cache-hits");
 
   // create a new object in a generic way
 
@@ -470,7 +1021,18 @@ namespace afnix {
     
     // check for 0 argument
     if (argc == 0) {
-      if (quark == QUARK_GETROOT) return new String (getroot ());
+      if (quark == QUARK_GETROOT) return new String  (getroot ());
+      if (quark == QUARK_GETCSIZ) return new Integer (getcsiz ());
+      if (quark == QUARK_GETCHIT) return new Integer (getchit ());
+      if (quark == QUARK_GETILST) return getilst ();
+    }
+    // check for 1 argument
+    if (argc == 1) {
+      if (quark == QUARK_SETCSIZ) {
+	long csiz = argv->getlong (0);
+	setcsiz (csiz);
+	return nullptr;
+      }
     }
     // call the workzone method
     return WorkZone::apply (zobj, nset, quark, argv);
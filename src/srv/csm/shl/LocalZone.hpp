@@ -34,6 +34,11 @@ namespace afnix {
   /// the underlying file system hosting the local zone. Note that the
   /// implementation is protected with a lock file, and thus can be used
   /// in a multi process environment.
+  /// A local zone can optionally cache the entity contents in memory. The
+  /// cache is bounded in size and the least recently used entities are
+  /// evicted first. A cached entity is invalidated when it is written,
+  /// renamed or removed through the zone. The cache is not shared with
+  /// other processes.
   /// @author amaury darsch
 
   class LocalZone : public WorkZone {
@@ -42,6 +47,8 @@ namespace afnix {
     String d_root;
     /// the lock file
     Lockf* p_lock;
+    /// the entity cache
+    struct s_lzch* p_lzch;
     
   public:
     /// create a default local zone
@@ -76,26 +83,47 @@ namespace afnix {
     /// @param uri the uri to check
     bool exists (const Uri& uri) const;
 
+    /// check if an entity exists by string uri
+    /// @param suri the string uri
+    bool exists (const String& suri) const;
+
     /// rename an entity by uri
     /// @param nuri the name uri
     /// @param turi the target uri
     bool rename (const Uri& nuri, const Uri& turi);
 
+    /// rename an entity by string uri
+    /// @param suri the string uri
+    /// @param puri the string path
+    bool rename (const String& suri, const String& puri);
+
     /// remove an entity by uria
     /// @param uri the uri to check
     bool remove (const Uri& uri);
 
+    /// remove an entity by string uri
+    /// @param suri the string uri
+    bool remove (const String& suri);
+
     /// clean the zone
     bool clean (void);
     
     /// get an input stream by and uri
     /// @param uri the uri to open
     InputStream* getis (const Uri& uri) const;
+
+    /// get an input stream by string uri
+    /// @param suri the string uri
+    InputStream* getis (const String& suri) const;
     
     /// get an output stream by uri
     /// @param uri the uri to open
     OutputStream* getos (const Uri& uri) const;
 
+    /// get an output stream by string uri
+    /// @param suri the string uri
+    OutputStream* getos (const String& suri) const;
+
     /// @return a local zone entity list
     Strvec* getelst (void) const;
 
@@ -108,6 +136,19 @@ namespace afnix {
     /// @return the local root directory
     virtual String getroot (void) const;
 
+    /// @return a local zone entity information list
+    virtual Vector* getilst (void) const;
+
+    /// set the cache size - a null size disables the cache
+    /// @param csiz the cache size in bytes
+    virtual void setcsiz (const long csiz);
+
+    /// @return the cache size
+    virtual long getcsiz (void) const;
+
+    /// @return the number of cache hits
+    virtual t_long getchit (void) const;
+
   private:
     // make the copy constructor private
     LocalZone (const LocalZone&) =delete;
@@ -24,6 +24,7 @@
 #include "Integer.hpp"
 #include "Evaluable.hpp"
 #include "QuarkZone.hpp"
+#include "HashTable.hpp"
 #include "Exception.hpp"
 #include "InputStream.hpp"
 #include "OutputStream.hpp"
@@ -43,6 +44,11 @@ namespace afnix {
     return rn.tohstr ();
   }
 
+  // mark an expiration change in an expiration table
+  static inline void sess_mark_etbl (HashTable* etbl, const String& ekey) {
+    if (etbl != nullptr) etbl->add (ekey, nullptr);
+  }
+
   // -------------------------------------------------------------------------
   // - class section                                                         -
   // -------------------------------------------------------------------------
@@ -56,6 +62,7 @@ namespace afnix {
     d_mtim = d_ctim;
     d_mage = 0LL;
     p_visa = nullptr;
+    p_etbl = nullptr;
   }
 
   // create a session by name
@@ -67,6 +74,7 @@ namespace afnix {
     d_mtim = d_ctim;
     d_mage = 0LL;
     p_visa = nullptr;
+    p_etbl = nullptr;
   }
 
   // create a session by name and info
@@ -79,6 +87,7 @@ namespace afnix {
     d_mtim = d_ctim;
     d_mage = 0LL;
     p_visa = nullptr;
+    p_etbl = nullptr;
   }
 
   // create a session by name, info and maximum age
@@ -90,6 +99,14 @@ namespace afnix {
     d_mtim = d_ctim;
     d_mage = (mage < 0LL) ? 0LL : mage;
     p_visa = nullptr;
+    p_etbl = nullptr;
+  }
+
+  // destroy this session
+
+  Session::~Session (void) {
+    Object::dref (p_visa);
+    Object::dref (p_etbl);
   }
 
   // copy construct this session object
@@ -106,6 +123,7 @@ namespace afnix {
       d_mtim = that.d_mtim;
       d_mage = that.d_mage;
       Object::iref (p_visa = that.p_visa);
+      p_etbl = nullptr;
       that.unlock ();
     } catch (...) {
       that.unlock ();
@@ -131,6 +149,7 @@ namespace afnix {
       d_mtim = that.d_mtim;
       d_mage = that.d_mage;
       Object::dref (p_visa); Object::iref (p_visa = that.p_visa);
+      sess_mark_etbl (p_etbl, d_ekey);
       unlock ();
       that.unlock ();
       return *this;
@@ -199,7 +218,9 @@ namespace afnix {
       d_ctim = Serial::rdlong (is);
       d_mtim = Serial::rdlong (is);
       d_mage = Serial::rdlong (is);
+      Object::dref (p_visa);
       Object::iref(p_visa = dynamic_cast<Visa*>(Serial::deserialize (is)));
+      sess_mark_etbl (p_etbl, d_ekey);
       unlock ();
     } catch (...) {
       unlock ();
@@ -338,6 +359,7 @@ namespace afnix {
       d_mtim = Time::gettclk ();
       d_mage = etim - d_ctim;
       if (d_mage < 0LL) d_mage = 0LL;
+      sess_mark_etbl (p_etbl, d_ekey);
       unlock ();
     } catch (...) {
       unlock ();
@@ -386,6 +408,7 @@ namespace afnix {
       d_mtim = Time::gettclk ();
       d_mage = mage;
       if (d_mage < 0LL) d_mage = 0LL;
+      sess_mark_etbl (p_etbl, d_ekey);
       unlock ();
     } catch (...) {
       unlock ();
@@ -434,6 +457,38 @@ namespace afnix {
       throw;
     }
   }
+  // attach an expiration table by key
+
+  void Session::attach (HashTable* etbl, const String& ekey) {
+    wrlock ();
+    try {
+      Object::iref (etbl); Object::dref (p_etbl);
+      p_etbl = etbl;
+      d_ekey = ekey;
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // detach an expiration table
+
+  void Session::detach (HashTable* etbl) {
+    wrlock ();
+    try {
+      if ((etbl != nullptr) && (p_etbl == etbl)) {
+	Object::dref (p_etbl);
+	p_etbl = nullptr;
+	d_ekey = "";
+      }
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   
   // bake a new cookie from the session information
 
@@ -29,6 +29,10 @@
 #include "Taggable.hpp"
 #endif
 
+#ifndef  AFNIX_HASHTABLE_HPP
+#include "HashTable.hpp"
+#endif
+
 namespace afnix {
 
   /// The Session class is a class that defines a session to be 
@@ -67,6 +71,10 @@ namespace afnix {
     t_long d_mage;
     /// the session visa
     Visa* p_visa;
+    /// the expiration table
+    HashTable* p_etbl;
+    /// the expiration key
+    String d_ekey;
 
   public:
     /// create an empty session
@@ -87,6 +95,9 @@ namespace afnix {
     /// @param mage the maximum age
     Session (const String& name, const String& info, const t_long mage);
 
+    /// destroy this session
+    ~Session (void);
+
     /// copy construct this object
     /// @param that the object to copy
     Session (const Session& that);
@@ -165,6 +176,16 @@ namespace afnix {
     /// @return the session visa
     virtual Visa* getvisa (void) const;
 
+    /// attach an expiration table which is marked with a key when the
+    /// session expiration time changes
+    /// @param etbl the expiration table
+    /// @param ekey the expiration key
+    virtual void attach (HashTable* etbl, const String& ekey);
+
+    /// detach an expiration table
+    /// @param etbl the expiration table to detach
+    virtual void detach (HashTable* etbl);
+
     /// bake a cookie by name
     /// @param name the cookie name
     virtual Cookie* getcookie (const String& name);
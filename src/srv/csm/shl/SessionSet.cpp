@@ -14,16 +14,287 @@
 // - copyright (c) 1999-2021 amaury darsch                                   -
 // ---------------------------------------------------------------------------
 
+#include "Time.hpp"
+#include "Mutex.hpp"
 #include "Vector.hpp"
 #include "Boolean.hpp"
 #include "Integer.hpp"
 #include "Evaluable.hpp"
+#include "HashTable.hpp"
 #include "QuarkZone.hpp"
 #include "Exception.hpp"
 #include "SessionSet.hpp"
 
 namespace afnix {
 
+  // -------------------------------------------------------------------------
+  // - private section                                                       -
+  // -------------------------------------------------------------------------
+
+  // the number of shards
+  static const long SSET_SNUM = 16L;
+  // the wheel slot bits
+  static const long WHL_BITS = 6L;
+  // the number of slots per level
+  static const long WHL_SLEN = 1L << WHL_BITS;
+  // the slot mask
+  static const long WHL_MASK = WHL_SLEN - 1L;
+  // the number of wheel levels
+  static const long WHL_LEVL = 4L;
+  // the wheel maximum delay
+  static const t_long WHL_MDLY = 1LL << (WHL_BITS * WHL_LEVL);
+
+  // the session node
+  struct s_snod : public Object {
+    // the session key
+    String    d_shid;
+    // the session object
+    Session*  p_sobj;
+    // the scheduled time
+    t_long    d_etim;
+    // the list head
+    s_snod**  p_head;
+    // the previous node
+    s_snod*   p_prev;
+    // the next node
+    s_snod*   p_next;
+    // create a new node
+    s_snod (const String& shid, Session* sobj) {
+      d_shid = shid;
+      Object::iref (p_sobj = sobj);
+      d_etim = 0LL;
+      p_head = nullptr;
+      p_prev = nullptr;
+      p_next = nullptr;
+    }
+    // destroy this node
+    ~s_snod (void) {
+      Object::dref (p_sobj);
+    }
+    // return the class name
+    String repr (void) const {
+      return "SessionNode";
+    }
+    // link this node in a list
+    void link (s_snod** head) {
+      p_head = head;
+      p_prev = nullptr;
+      p_next = *head;
+      if (p_next != nullptr) p_next->p_prev = this;
+      *head = this;
+    }
+    // unlink this node from its list
+    void unlink (void) {
+      if (p_head == nullptr) return;
+      if (p_prev == nullptr) *p_head = p_next; else p_prev->p_next = p_next;
+      if (p_next != nullptr) p_next->p_prev = p_prev;
+      p_head = nullptr;
+      p_prev = nullptr;
+      p_next = nullptr;
+    }
+  };
+
+  // the session shard
+  struct s_sshd {
+    // the shard lock
+    Mutex     d_mtx;
+    // the node table
+    HashTable d_hash;
+    // the expiration change table
+    HashTable* p_etbl;
+    // the wheel time
+    t_long    d_wtim;
+    // the wheel slots
+    s_snod*   p_slot[WHL_LEVL][WHL_SLEN];
+    // the overdue list
+    s_snod*   p_ovrd;
+    // the number of scheduled nodes
+    long      d_slen;
+    // the expired count
+    t_long    d_ecnt;
+    // the contention count
+    t_long    d_ccnt;
+    // create a new shard
+    s_sshd (void) {
+      d_wtim = Time::gettclk ();
+      for (long i = 0L; i < WHL_LEVL; i++) {
+	for (long j = 0L; j < WHL_SLEN; j++) p_slot[i][j] = nullptr;
+      }
+      p_ovrd = nullptr;
+      d_slen = 0L;
+      d_ecnt = 0LL;
+      d_ccnt = 0LL;
+      Object::iref (p_etbl = new HashTable);
+    }
+    // destroy this shard
+    ~s_sshd (void) {
+      reset ();
+      Object::dref (p_etbl);
+    }
+    // lock this shard and count the contention
+    void lock (void) {
+      if (d_mtx.trylock () == true) return;
+      d_mtx.lock ();
+      d_ccnt++;
+    }
+    // unlock this shard
+    void unlock (void) {
+      d_mtx.unlock ();
+    }
+    // reset this shard
+    void reset (void) {
+      long hlen = d_hash.length ();
+      for (long k = 0L; k < hlen; k++) {
+	s_snod* node = dynamic_cast <s_snod*> (d_hash.getobj (k));
+	if (node != nullptr) node->p_sobj->detach (p_etbl);
+      }
+      p_etbl->reset ();
+      for (long i = 0L; i < WHL_LEVL; i++) {
+	for (long j = 0L; j < WHL_SLEN; j++) p_slot[i][j] = nullptr;
+      }
+      p_ovrd = nullptr;
+      d_slen = 0L;
+      d_hash.reset ();
+    }
+    // get a node by key
+    s_snod* get (const String& shid) const {
+      return dynamic_cast <s_snod*> (d_hash.get (shid));
+    }
+    // link a node in the wheel by time
+    void link (s_snod* node) {
+      t_long etim = node->d_etim;
+      if (etim <= d_wtim) {
+	node->link (&p_ovrd);
+	return;
+      }
+      // clamp the delay to the wheel span
+      t_long dlay = etim - d_wtim;
+      if (dlay >= WHL_MDLY) {
+	dlay = WHL_MDLY - 1LL;
+	etim = d_wtim + dlay;
+      }
+      // find the level and slot
+      long lvl = 0L;
+      while (dlay >= (1LL << (WHL_BITS * (lvl + 1L)))) lvl++;
+      long idx = (long) ((etim >> (WHL_BITS * lvl)) & WHL_MASK);
+      node->link (&p_slot[lvl][idx]);
+    }
+    // schedule a node with its session expiration time
+    void schedule (s_snod* node) {
+      if (node->p_head != nullptr) {
+	node->unlink ();
+	d_slen--;
+      }
+      if (node->p_sobj->getmage () == 0LL) return;
+      node->d_etim = node->p_sobj->getetim ();
+      link (node);
+      d_slen++;
+    }
+    // remove a node by key
+    void remove (const String& shid) {
+      s_snod* node = get (shid);
+      if (node == nullptr) return;
+      if (node->p_head != nullptr) {
+	node->unlink ();
+	d_slen--;
+      }
+      node->p_sobj->detach (p_etbl);
+      d_hash.remove (shid);
+    }
+    // reschedule the nodes with a changed expiration time
+    void reschedule (void) {
+      if (p_etbl->empty () == true) return;
+      Vector* keys = p_etbl->getkeys ();
+      try {
+	long klen = keys->length ();
+	for (long k = 0L; k < klen; k++) {
+	  String shid = keys->getstring (k);
+	  p_etbl->remove (shid);
+	  s_snod* node = get (shid);
+	  if (node != nullptr) schedule (node);
+	}
+	delete keys;
+      } catch (...) {
+	delete keys;
+	throw;
+      }
+    }
+    // cascade a wheel slot into the lower levels
+    void cascade (const long lvl, const long idx) {
+      s_snod* node = p_slot[lvl][idx];
+      p_slot[lvl][idx] = nullptr;
+      while (node != nullptr) {
+	s_snod* next = node->p_next;
+	node->p_head = nullptr;
+	node->p_prev = nullptr;
+	node->p_next = nullptr;
+	link (node);
+	node = next;
+      }
+    }
+    // expire a list of nodes
+    void expire (s_snod** head, Vector* rvec) {
+      while (*head != nullptr) {
+	s_snod* node = *head;
+	node->unlink ();
+	d_slen--;
+	// check for a changed expiration time
+	Session* sobj = node->p_sobj;
+	if (sobj->getmage () == 0LL) continue;
+	t_long etim = sobj->getetim ();
+	if (etim > d_wtim) {
+	  node->d_etim = etim;
+	  link (node);
+	  d_slen++;
+	  continue;
+	}
+	// the session has expired
+	rvec->add (sobj);
+	sobj->detach (p_etbl);
+	d_hash.remove (node->d_shid);
+	d_ecnt++;
+      }
+    }
+    // advance the wheel to a time and collect the expired sessions
+    void advance (const t_long time, Vector* rvec) {
+      reschedule ();
+      expire (&p_ovrd, rvec);
+      while (d_wtim < time) {
+	// move directly at time if nothing is scheduled
+	if (d_slen == 0L) {
+	  d_wtim = time;
+	  break;
+	}
+	// skip to the next wrap if the lower level is empty
+	if ((d_wtim & WHL_MASK) == 0LL) {
+	  bool skip = true;
+	  for (long j = 0L; (j < WHL_SLEN) && skip; j++) {
+	    if (p_slot[0][j] != nullptr) skip = false;
+	  }
+	  if (skip == true) {
+	    t_long wtim = d_wtim + WHL_MASK;
+	    d_wtim = (wtim < time) ? wtim : time;
+	    if (d_wtim == time) break;
+	  }
+	}
+	d_wtim++;
+	// cascade the upper levels at each level wrap
+	for (long lvl = 1L; lvl < WHL_LEVL; lvl++) {
+	  if ((d_wtim & ((1LL << (WHL_BITS * lvl)) - 1LL)) != 0LL) break;
+	  cascade (lvl, (long) ((d_wtim >> (WHL_BITS * lvl)) & WHL_MASK));
+	}
+	// expire the current slot and the overdue nodes
+	expire (&p_slot[0][d_wtim & WHL_MASK], rvec);
+	expire (&p_ovrd, rvec);
+      }
+    }
+  };
+
+  // get a shard index by session hash id
+  static inline long sset_sidx (const String& hid) {
+    return hid.hashid () & (SSET_SNUM - 1L);
+  }
+
   // -------------------------------------------------------------------------
   // - class section                                                         -
   // -------------------------------------------------------------------------
@@ -31,7 +302,13 @@ namespace afnix {
   // create an empty session set
 
   SessionSet::SessionSet (void) {
-    reset ();
+    p_sshd = new s_sshd[SSET_SNUM];
+  }
+
+  // destroy this session set
+
+  SessionSet::~SessionSet (void) {
+    delete [] p_sshd;
   }
 
   // return the object class name
@@ -43,54 +320,49 @@ namespace afnix {
   // reset this session set
   
   void SessionSet::reset (void) {
-    wrlock ();
-    try {
-      d_hash.reset ();
-      unlock ();
-    } catch (...) {
-      unlock ();
-      throw;
+    for (long k = 0L; k < SSET_SNUM; k++) {
+      s_sshd& sshd = p_sshd[k];
+      sshd.lock ();
+      try {
+	sshd.reset ();
+	sshd.unlock ();
+      } catch (...) {
+	sshd.unlock ();
+	throw;
+      }
     }
   }
 
   // get the number of session in the session set
 
   long SessionSet::length (void) const {
-    rdlock ();
-    try {
-      long result = d_hash.length ();
-      unlock ();
-      return result;
-    } catch (...) {
-      unlock ();
-      throw;
+    long result = 0L;
+    for (long k = 0L; k < SSET_SNUM; k++) {
+      s_sshd& sshd = p_sshd[k];
+      sshd.lock ();
+      result += sshd.d_hash.length ();
+      sshd.unlock ();
     }
+    return result;
   }
 	
   // return true if the session set is empty
 
   bool SessionSet::empty (void) const {
-    rdlock ();
-    try {
-      bool result = d_hash.empty ();
-      unlock ();
-      return result;
-    } catch (...) {
-      unlock ();
-      throw;
-    }
+    return (length () == 0L);
   }
 
   // check if a session exists by hash id
 
   bool SessionSet::exists (const String& hid) const {
-    rdlock ();
+    s_sshd& sshd = p_sshd[sset_sidx (hid)];
+    sshd.lock ();
     try {
-      bool result = d_hash.exists (hid);
-      unlock ();
+      bool result = sshd.d_hash.exists (hid);
+      sshd.unlock ();
       return result;
     } catch (...) {
-      unlock ();
+      sshd.unlock ();
       throw;
     }
   }
@@ -100,17 +372,21 @@ namespace afnix {
   void SessionSet::add (Session* sobj) {
     // check for nil first
     if (sobj == nullptr) return;
-    // lock and add
-    wrlock ();
+    // get the shard and add
+    String hid = sobj->getshid ();
+    s_sshd& sshd = p_sshd[sset_sidx (hid)];
+    sshd.lock ();
     try {
-      String hid = sobj->getshid ();
-      if (exists (hid) == true) {
+      if (sshd.d_hash.exists (hid) == true) {
 	throw Exception ("session-error", "duplicate session in add");
       }
-      d_hash.add (hid, sobj);
-      unlock ();
+      s_snod* node = new s_snod (hid, sobj);
+      sshd.d_hash.add (hid, node);
+      sobj->attach (sshd.p_etbl, hid);
+      sshd.schedule (node);
+      sshd.unlock ();
     } catch (...) {
-      unlock ();
+      sshd.unlock ();
       throw;
     }
   }
@@ -118,27 +394,40 @@ namespace afnix {
   // get a session by index
 
   Session* SessionSet::get (const long idx) const {
-    rdlock ();
-    try {
-      Session* result = dynamic_cast <Session*> (d_hash.getobj (idx));
-      unlock ();
-      return result;
-    } catch (...) {
-      unlock ();
-      throw;
+    long npos = idx;
+    for (long k = 0L; (npos >= 0L) && (k < SSET_SNUM); k++) {
+      s_sshd& sshd = p_sshd[k];
+      sshd.lock ();
+      try {
+	long hlen = sshd.d_hash.length ();
+	if (npos < hlen) {
+	  s_snod* node = dynamic_cast <s_snod*> (sshd.d_hash.getobj (npos));
+	  Session* result = (node == nullptr) ? nullptr : node->p_sobj;
+	  sshd.unlock ();
+	  return result;
+	}
+	npos -= hlen;
+	sshd.unlock ();
+      } catch (...) {
+	sshd.unlock ();
+	throw;
+      }
     }
+    throw Exception ("index-error", "index is out of range");
   }
 
   // get a session by hash id
 
   Session* SessionSet::lookup (const String& hid) const {
-    rdlock ();
+    s_sshd& sshd = p_sshd[sset_sidx (hid)];
+    sshd.lock ();
     try {
-      Session* result = dynamic_cast <Session*> (d_hash.lookup (hid));
-      unlock ();
+      s_snod* node = dynamic_cast <s_snod*> (sshd.d_hash.lookup (hid));
+      Session* result = (node == nullptr) ? nullptr : node->p_sobj;
+      sshd.unlock ();
       return result;
     } catch (...) {
-      unlock ();
+      sshd.unlock ();
       throw;
     }
   }
@@ -146,32 +435,87 @@ namespace afnix {
   // remove a session by hash id
 
   void SessionSet::remove (const String& hid) {
-    wrlock ();
+    s_sshd& sshd = p_sshd[sset_sidx (hid)];
+    sshd.lock ();
     try {
-      d_hash.remove (hid);
-      unlock ();
+      sshd.remove (hid);
+      sshd.unlock ();
     } catch (...) {
-      unlock ();
+      sshd.unlock ();
       throw;
     }
   }
 
+  // reap the expired sessions
+
+  Vector* SessionSet::reap (void) {
+    return reap (Time::gettclk ());
+  }
+
+  // reap the sessions expired at a given time
+
+  Vector* SessionSet::reap (const t_long time) {
+    Vector* result = new Vector;
+    for (long k = 0L; k < SSET_SNUM; k++) {
+      s_sshd& sshd = p_sshd[k];
+      sshd.lock ();
+      try {
+	sshd.advance (time, result);
+	sshd.unlock ();
+      } catch (...) {
+	sshd.unlock ();
+	delete result;
+	throw;
+      }
+    }
+    return result;
+  }
+
+  // get the number of expired sessions
+
+  t_long SessionSet::getecnt (void) const {
+    t_long result = 0LL;
+    for (long k = 0L; k < SSET_SNUM; k++) {
+      s_sshd& sshd = p_sshd[k];
+      sshd.lock ();
+      result += sshd.d_ecnt;
+      sshd.unlock ();
+    }
+    return result;
+  }
+
+  // get the number of contended shard locks
+
+  t_long SessionSet::getccnt (void) const {
+    t_long result = 0LL;
+    for (long k = 0L; k < SSET_SNUM; k++) {
+      s_sshd& sshd = p_sshd[k];
+      sshd.lock ();
+      result += sshd.d_ccnt;
+      sshd.unlock ();
+    }
+    return result;
+  }
+
   // -------------------------------------------------------------------------
   // - object section                                                        -
   // -------------------------------------------------------------------------
 
   // the quark zone
-  static const long QUARK_ZONE_LENGTH = 7;
+  static const long QUARK_ZONE_LENGTH = 10;
   static QuarkZone  zone (QUARK_ZONE_LENGTH);
 
   // the object supported quarks
   static const long QUARK_ADD     = zone.intern ("add");
   static const long QUARK_GET     = zone.intern ("get");
+  static const long QUARK_REAP    = zone.intern ("reap");
   static const long QUARK_REMOVE  = zone.intern ("remove");
   static const long QUARK_LOOKUP  = zone.intern ("lookup");
   static const long QUARK_LENGTH  = zone.intern ("length");
   static const long QUARK_EMPTYP  = zone.intern ("empty-p");
   static const long QUARK_EXISTSP = zone.intern ("exists-p");
+  static const long QUARK_GETECNT = zone.intern ("get-expired-count");
+  static const long QUARK_GETCCNT = zone.intern ("get-contention-count");
 
   // create a new object in a generic way
 
@@ -207,7 +551,10 @@ namespace afnix {
     // check for 0 argument
     if (argc == 0) {
       if (quark == QUARK_EMPTYP) return new Boolean (empty  ());
-      if (quark == QUARK_LENGTH) return new Integer (length ());
+      if (quark == QUARK_LENGTH)  return new Integer (length ());
+      if (quark == QUARK_GETECNT) return new Integer (getecnt ());
+      if (quark == QUARK_GETCCNT) return new Integer (getccnt ());
+      if (quark == QUARK_REAP)    return reap ();
     }
     // check for 1 argument
     if (argc == 1) {
@@ -222,30 +569,20 @@ namespace afnix {
 	return nullptr;
       }
       if (quark == QUARK_GET) {
-	rdlock ();
-	try {
-	  long idx = argv->getlong (0);
-	  Session* so = get (idx);
-	  zobj->post (so);
-	  unlock ();
-	  return so;
-	} catch (...) {
-	  unlock ();
-	  throw;
-	}
+	long idx = argv->getlong (0);
+	Session* so = get (idx);
+	zobj->post (so);
+	return so;
       }
       if (quark == QUARK_LOOKUP) {
-	rdlock ();
-	try {
-	  String hid = argv->getstring (0);
-	  Session* so = lookup (hid);
-	  zobj->post (so);
-	  unlock ();
-	  return so;
-	} catch (...) {
-	  unlock ();
-	  throw;
-	}
+	String hid = argv->getstring (0);
+	Session* so = lookup (hid);
+	zobj->post (so);
+	return so;
+      }
+      if (quark == QUARK_REAP) {
+	t_long time = argv->getlong (0);
+	return reap (time);
       }
       if (quark == QUARK_REMOVE) {
 	String hid = argv->getstring (0);
@@ -21,10 +21,6 @@
 #include "Session.hpp"
 #endif
 
-#ifndef  AFNIX_HASHTABLE_HPP
-#include "HashTable.hpp"
-#endif
-
 namespace afnix {
 
   /// The SessionSet class is a collection of session object organized
@@ -34,17 +30,26 @@ namespace afnix {
   /// session which has timed-out. Futhermore, for security purpose, the
   /// session hash id must be carefully generated from the session itself
   /// but in a way which cannot be guessed from the client side.
+  /// The session set is split into shards selected by the session hash id,
+  /// each shard having its own lock. A shard also keeps a hierarchical
+  /// timer wheel with the session expiration time, so that the expired
+  /// sessions can be reaped without scanning the whole set. A session
+  /// marks a change of its expiration time in its shard, so that it is
+  /// rescheduled before the next reap.
   /// @author amaury darsch
 
   class SessionSet : public Object {
   private:
-    /// the hash table
-    HashTable d_hash;
+    /// the session shards
+    struct s_sshd* p_sshd;
 
   public:
     /// create an empty set
     SessionSet (void);
 
+    /// destroy this session set
+    ~SessionSet (void);
+
     /// @return the class name
     String repr (void) const;
 
@@ -77,6 +82,21 @@ namespace afnix {
     /// @param hid the session hash id to remove
     virtual void remove (const String& hid);
 
+    /// reap the expired sessions
+    /// @return a vector of reaped sessions
+    virtual Vector* reap (void);
+
+    /// reap the sessions expired at a given time
+    /// @param time the reference time
+    /// @return a vector of reaped sessions
+    virtual Vector* reap (const t_long time);
+
+    /// @return the number of expired sessions
+    virtual t_long getecnt (void) const;
+
+    /// @return the number of contended shard locks
+    virtual t_long getccnt (void) const;
+
   private:
     // make the copy constructor private
     SessionSet (const SessionSet&);
@@ -17,6 +17,7 @@
 #include "Cons.hpp"
 #include "Vector.hpp"
 #include "Netpbm.hpp"
+#include "Imaging.hpp"
 #include "Boolean.hpp"
 #include "DipCalls.hpp"
 #include "Exception.hpp"
@@ -115,4 +116,209 @@ namespace afnix {
       throw;
     }
   }
+
+  // this procedure returns a slice argument
+  static const Slice& dip_to_slice (Vector* argv, const long index) {
+    Object* obj = argv->get (index);
+    auto slc = dynamic_cast<Slice*>(obj);
+    if (slc == nullptr) {
+      throw Exception ("type-error", "invalid object as slice",
+		       Object::repr (obj));
+    }
+    return *slc;
+  }
+
+  // this procedure returns a kernel argument
+  static t_real* dip_to_kern (Vector* argv, const long index, long& klen) {
+    Object* obj = argv->get (index);
+    auto kvec = dynamic_cast<Vector*>(obj);
+    if (kvec == nullptr) {
+      throw Exception ("type-error", "invalid object as kernel vector",
+		       Object::repr (obj));
+    }
+    klen = kvec->length ();
+    t_real* result = new t_real[(klen == 0L) ? 1L : klen];
+    try {
+      for (long k = 0L; k < klen; k++) result[k] = kvec->getrint (k);
+      return result;
+    } catch (...) {
+      delete [] result;
+      throw;
+    }
+  }
+
+  // convolve a slice with a separable kernel
+
+  Object* dip_convolve (Evaluable* zobj, Nameset* nset, Cons* args) {
+    // get the arguments
+    Vector* argv = Vector::eval (zobj, nset, args);
+    long    argc = (argv == nullptr) ? 0 : argv->length ();
+    if (argc != 3) {
+      delete argv;
+      throw Exception ("argument-error", 
+		       "invalid number of arguments with convolve");
+    }
+    t_real* hker = nullptr;
+    t_real* vker = nullptr;
+    try {
+      long hlen = 0L; hker = dip_to_kern (argv, 1, hlen);
+      long vlen = 0L; vker = dip_to_kern (argv, 2, vlen);
+      Slice* result =
+	Imaging::convolve (dip_to_slice (argv, 0), hlen, hker, vlen, vker);
+      delete [] hker;
+      delete [] vker;
+      delete argv;
+      return result;
+    } catch (...) {
+      delete [] hker;
+      delete [] vker;
+      delete argv;
+      throw;
+    }
+  }
+
+  // blur a slice with a box filter
+
+  Object* dip_boxblur (Evaluable* zobj, Nameset* nset, Cons* args) {
+    // get the arguments
+    Vector* argv = Vector::eval (zobj, nset, args);
+    long    argc = (argv == nullptr) ? 0 : argv->length ();
+    if (argc != 2) {
+      delete argv;
+      throw Exception ("argument-error", 
+		       "invalid number of arguments with box-blur");
+    }
+    try {
+      long rads = argv->getlong (1);
+      Slice* result = Imaging::boxblur (dip_to_slice (argv, 0), rads);
+      delete argv;
+      return result;
+    } catch (...) {
+      delete argv;
+      throw;
+    }
+  }
+
+  // blur a slice with a gaussian filter
+
+  Object* dip_gaussblur (Evaluable* zobj, Nameset* nset, Cons* args) {
+    // get the arguments
+    Vector* argv = Vector::eval (zobj, nset, args);
+    long    argc = (argv == nullptr) ? 0 : argv->length ();
+    if (argc != 2) {
+      delete argv;
+      throw Exception ("argument-error", 
+		       "invalid number of arguments with gaussian-blur");
+    }
+    try {
+      t_real sigm = argv->getrint (1);
+      Slice* result = Imaging::gaussblur (dip_to_slice (argv, 0), sigm);
+      delete argv;
+      return result;
+    } catch (...) {
+      delete argv;
+      throw;
+    }
+  }
+
+  // resize a slice with a bilinear filter
+
+  Object* dip_rsbiln (Evaluable* zobj, Nameset* nset, Cons* args) {
+    // get the arguments
+    Vector* argv = Vector::eval (zobj, nset, args);
+    long    argc = (argv == nullptr) ? 0 : argv->length ();
+    if (argc != 3) {
+      delete argv;
+      throw Exception ("argument-error", 
+		       "invalid number of arguments with resize-bilinear");
+    }
+    try {
+      long wdth = argv->getlong (1);
+      long hght = argv->getlong (2);
+      Slice* result = Imaging::resize (dip_to_slice (argv, 0), wdth, hght,
+				       Imaging::RSMD_BILN);
+      delete argv;
+      return result;
+    } catch (...) {
+      delete argv;
+      throw;
+    }
+  }
+
+  // resize a slice with a lanczos filter
+
+  Object* dip_rslncz (Evaluable* zobj, Nameset* nset, Cons* args) {
+    // get the arguments
+    Vector* argv = Vector::eval (zobj, nset, args);
+    long    argc = (argv == nullptr) ? 0 : argv->length ();
+    if (argc != 3) {
+      delete argv;
+      throw Exception ("argument-error", 
+		       "invalid number of arguments with resize-lanczos");
+    }
+    try {
+      long wdth = argv->getlong (1);
+      long hght = argv->getlong (2);
+      Slice* result = Imaging::resize (dip_to_slice (argv, 0), wdth, hght,
+				       Imaging::RSMD_LNCZ);
+      delete argv;
+      return result;
+    } catch (...) {
+      delete argv;
+      throw;
+    }
+  }
+
+  // compute a slice component histogram
+
+  Object* dip_histogram (Evaluable* zobj, Nameset* nset, Cons* args) {
+    // get the arguments
+    Vector* argv = Vector::eval (zobj, nset, args);
+    long    argc = (argv == nullptr) ? 0 : argv->length ();
+    if (argc != 3) {
+      delete argv;
+      throw Exception ("argument-error", 
+		       "invalid number of arguments with histogram");
+    }
+    try {
+      long cidx = argv->getlong (1);
+      long hnum = argv->getlong (2);
+      Vector* result = Imaging::histogram (dip_to_slice (argv, 0), cidx, hnum);
+      delete argv;
+      return result;
+    } catch (...) {
+      delete argv;
+      throw;
+    }
+  }
+
+  // compute a slice or tranche statistics
+
+  Object* dip_statistics (Evaluable* zobj, Nameset* nset, Cons* args) {
+    // get the arguments
+    Vector* argv = Vector::eval (zobj, nset, args);
+    long    argc = (argv == nullptr) ? 0 : argv->length ();
+    if (argc != 1) {
+      delete argv;
+      throw Exception ("argument-error", 
+		       "invalid number of arguments with statistics");
+    }
+    try {
+      Object* obj = argv->get (0);
+      // check for a tranche
+      auto trch = dynamic_cast<Tranche*>(obj);
+      if (trch != nullptr) {
+	Vector* result = Imaging::statistics (*trch);
+	delete argv;
+	return result;
+      }
+      // check for a slice
+      Vector* result = Imaging::statistics (dip_to_slice (argv, 0));
+      delete argv;
+      return result;
+    } catch (...) {
+      delete argv;
+      throw;
+    }
+  }
 }
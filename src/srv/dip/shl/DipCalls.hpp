@@ -38,6 +38,48 @@ namespace afnix {
   /// @param nset the current nameset
   /// @param args the argument list
   Object* dip_wrpbm (Evaluable* zobj, Nameset* nset, Cons* args);
+
+  /// convolve a slice with a separable kernel
+  /// @param zobj the current evaluable
+  /// @param nset the current nameset
+  /// @param args the argument list
+  Object* dip_convolve (Evaluable* zobj, Nameset* nset, Cons* args);
+
+  /// blur a slice with a box filter
+  /// @param zobj the current evaluable
+  /// @param nset the current nameset
+  /// @param args the argument list
+  Object* dip_boxblur (Evaluable* zobj, Nameset* nset, Cons* args);
+
+  /// blur a slice with a gaussian filter
+  /// @param zobj the current evaluable
+  /// @param nset the current nameset
+  /// @param args the argument list
+  Object* dip_gaussblur (Evaluable* zobj, Nameset* nset, Cons* args);
+
+  /// resize a slice with a bilinear filter
+  /// @param zobj the current evaluable
+  /// @param nset the current nameset
+  /// @param args the argument list
+  Object* dip_rsbiln (Evaluable* zobj, Nameset* nset, Cons* args);
+
+  /// resize a slice with a lanczos filter
+  /// @param zobj the current evaluable
+  /// @param nset the current nameset
+  /// @param args the argument list
+  Object* dip_rslncz (Evaluable* zobj, Nameset* nset, Cons* args);
+
+  /// compute a slice component histogram
+  /// @param zobj the current evaluable
+  /// @param nset the current nameset
+  /// @param args the argument list
+  Object* dip_histogram (Evaluable* zobj, Nameset* nset, Cons* args);
+
+  /// compute a slice or mixmap statistics
+  /// @param zobj the current evaluable
+  /// @param nset the current nameset
+  /// @param args the argument list
+  Object* dip_statistics (Evaluable* zobj, Nameset* nset, Cons* args);
   
 }
 
@@ -0,0 +1,727 @@
+// ---------------------------------------------------------------------------
+// - Imaging.cpp                                                             -
+// - afnix:dip service - image processing class implementation               -
+// ---------------------------------------------------------------------------
+// - This program is free software;  you can redistribute it  and/or  modify -
+// - it provided that this copyright notice is kept intact.                  -
+// -                                                                         -
+// - This program  is  distributed in  the hope  that it will be useful, but -
+// - without  any  warranty;  without  even   the   implied    warranty   of -
+// - merchantability or fitness for a particular purpose.  In no event shall -
+// - the copyright holder be liable for any  direct, indirect, incidental or -
+// - special damages arising in any way out of the use of this software.     -
+// ---------------------------------------------------------------------------
+// - copyright (c) 1999-2021 amaury darsch                                   -
+// ---------------------------------------------------------------------------
+
+#include "Math.hpp"
+#include "Real.hpp"
+#include "Vector.hpp"
+#include "Mixmap.hpp"
+#include "Pixmap.hpp"
+#include "Imaging.hpp"
+#include "Integer.hpp"
+#include "Utility.hpp"
+#include "Exception.hpp"
+#include "cthr.hpp"
+
+namespace afnix {
+
+  // -------------------------------------------------------------------------
+  // - private section                                                       -
+  // -------------------------------------------------------------------------
+
+  // the maximum number of processing tasks
+  static const long IMG_TASK_TMAX = 8L;
+  // the minimum number of bytes per processing task
+  static const long IMG_TASK_SMIN = 1048576L;
+  // the lanczos filter order
+  static const long IMG_LNCZ_ORDR = 3L;
+
+  // the processing row function
+  using t_irow = void (*) (void*, const long, const long, const long);
+
+  // the row band processing task
+  struct s_itsk {
+    // the row function
+    t_irow p_func;
+    // the function arguments
+    void*  p_args;
+    // the task index
+    long   d_tidx;
+    // the row band
+    long   d_ybeg;
+    long   d_yend;
+    // process the row band
+    void run (void) {
+      p_func (p_args, d_tidx, d_ybeg, d_yend);
+    }
+  };
+
+  // this procedure runs a row band processing task
+  static void* img_task (void* args) {
+    auto itsk = reinterpret_cast <s_itsk*> (args);
+    itsk->run ();
+    return nullptr;
+  }
+
+  // this procedure processes a set of rows by parallel bands and returns
+  // the number of bands
+  static long img_prun (t_irow func, void* args, const long hght,
+			const long rsiz) {
+    // compute the number of bands
+    long tnum = (hght * rsiz) / IMG_TASK_SMIN;
+    if (tnum > IMG_TASK_TMAX) tnum = IMG_TASK_TMAX;
+    if (tnum > hght) tnum = hght;
+    if (tnum < 1L) tnum = 1L;
+    // prepare the bands
+    s_itsk* itsk = new s_itsk[tnum];
+    for (long t = 0L; t < tnum; t++) {
+      itsk[t].p_func = func;
+      itsk[t].p_args = args;
+      itsk[t].d_tidx = t;
+      itsk[t].d_ybeg = (t * hght) / tnum;
+      itsk[t].d_yend = ((t + 1L) * hght) / tnum;
+    }
+    // run the bands
+    void** targ = new void*[tnum];
+    for (long t = 0L; t < tnum; t++) targ[t] = &itsk[t];
+    c_tskrun (img_task, targ, tnum);
+    delete [] targ;
+    delete [] itsk;
+    return tnum;
+  }
+
+  // this procedure returns the pixmap to process
+  static const Pixmap& img_to_pixm (const Slice& slc) {
+    auto pixm = dynamic_cast <const Pixmap*> (&slc);
+    if (pixm == nullptr) {
+      throw Exception ("imaging-error", "invalid slice to process");
+    }
+    if ((pixm->getpfmt () == Pixel::PFMT_NONE) || (pixm->tosize () == 0L)) {
+      throw Exception ("imaging-error", "invalid empty slice to process");
+    }
+    return *pixm;
+  }
+
+  // this procedure returns a tranche band as a new slice
+  static Slice* img_to_band (const Tranche& trch, const long d) {
+    // a mixmap copies its band rows
+    auto mixm = dynamic_cast <const Mixmap*> (&trch);
+    if (mixm != nullptr) return mixm->getslice (d);
+    // copy the band pixels
+    long wdth = trch.getwdth ();
+    long hght = trch.gethght ();
+    Pixmap* result = new Pixmap (trch.getpfmt (), wdth, hght);
+    try {
+      for (long y = 0L; y < hght; y++) {
+	for (long x = 0L; x < wdth; x++) {
+	  result->setpixl (x, y, trch.getpixl (x, y, d));
+	}
+      }
+      return result;
+    } catch (...) {
+      delete result;
+      throw;
+    }
+  }
+
+  // the image processing data
+  struct s_imgd {
+    // the pixel format
+    Pixel::t_pfmt d_pfmt;
+    // the work format
+    Pixel::t_pfmt d_wfmt;
+    // the number of work components
+    long d_cnum;
+    // the image geometry
+    long d_wdth;
+    long d_hght;
+    long d_strd;
+    // the image data
+    t_byte* p_data;
+    // create a processing data by pixmap
+    s_imgd (const Pixmap& pixm) {
+      d_pfmt = pixm.getpfmt ();
+      bool bflg = (d_pfmt == Pixel::PFMT_BYTE) ||
+	(d_pfmt == Pixel::PFMT_WORD) || (d_pfmt == Pixel::PFMT_REAL) ||
+	(d_pfmt == Pixel::PFMT_FLOT);
+      d_wfmt = bflg ? Pixel::PFMT_FLOT : Pixel::PFMT_RGBF;
+      d_cnum = bflg ? 1L : 4L;
+      d_wdth = pixm.getwdth ();
+      d_hght = pixm.gethght ();
+      d_strd = pixm.tosize () / d_hght;
+      p_data = const_cast <t_byte*> (pixm.tobyte ());
+    }
+    // create a processing data by pixmap and geometry
+    s_imgd (Pixmap* pixm, const s_imgd& that) {
+      d_pfmt = that.d_pfmt;
+      d_wfmt = that.d_wfmt;
+      d_cnum = that.d_cnum;
+      d_wdth = pixm->getwdth ();
+      d_hght = pixm->gethght ();
+      d_strd = pixm->tosize () / d_hght;
+      p_data = pixm->tobyte ();
+    }
+    // decode an image row into a work row
+    void getrow (const long y, float* frow) const {
+      auto sbuf = &p_data[y * d_strd];
+      auto dbuf = reinterpret_cast <t_byte*> (frow);
+      Pixmap::cnvrow (d_pfmt, sbuf, d_wfmt, dbuf, d_wdth);
+    }
+    // encode a work row into an image row
+    void setrow (const long y, const float* frow) {
+      auto sbuf = reinterpret_cast <const t_byte*> (frow);
+      Pixmap::cnvrow (d_wfmt, sbuf, d_pfmt, &p_data[y * d_strd], d_wdth);
+    }
+  };
+
+  // this procedure clamps a row index
+  static inline long img_clamp (const long y, const long hght) {
+    if (y < 0L) return 0L;
+    if (y >= hght) return hght - 1L;
+    return y;
+  }
+
+  // the convolution arguments
+  struct s_conv {
+    // the source and target image
+    s_imgd* p_simg;
+    s_imgd* p_dimg;
+    // the horizontal kernel
+    long   d_hlen;
+    float* p_hker;
+    // the vertical kernel
+    long   d_vlen;
+    float* p_vker;
+  };
+
+  // this procedure convolves a work row horizontally
+  static void img_hconv (const s_conv* conv, const float* srow, float* prow,
+			 float* drow) {
+    long wdth = conv->p_simg->d_wdth;
+    long cnum = conv->p_simg->d_cnum;
+    long klen = conv->d_hlen;
+    long rlen = wdth * cnum;
+    long klft = klen / 2L;
+    long krgt = klen - 1L - klft;
+    // pad the row with the border pixels
+    for (long k = 0L; k < klft * cnum; k++) prow[k] = srow[k % cnum];
+    for (long i = 0L; i < rlen; i++) prow[klft * cnum + i] = srow[i];
+    float* pend = &prow[(klft + wdth) * cnum];
+    const float* slst = &srow[rlen - cnum];
+    for (long k = 0L; k < krgt * cnum; k++) pend[k] = slst[k % cnum];
+    // accumulate the kernel taps
+    for (long i = 0L; i < rlen; i++) drow[i] = 0.0f;
+    for (long k = 0L; k < klen; k++) {
+      float kval = conv->p_hker[k];
+      const float* prd = &prow[k * cnum];
+      for (long i = 0L; i < rlen; i++) drow[i] += kval * prd[i];
+    }
+  }
+
+  // this procedure convolves a row band - the horizontally convolved
+  // rows are kept in a ring of rows for the vertical convolution
+  static void img_conv (void* args, const long, const long ybeg,
+			const long yend) {
+    auto conv = reinterpret_cast <s_conv*> (args);
+    long wdth = conv->p_simg->d_wdth;
+    long hght = conv->p_simg->d_hght;
+    long cnum = conv->p_simg->d_cnum;
+    long rlen = wdth * cnum;
+    long vlen = conv->d_vlen;
+    long vtop = vlen / 2L;
+    // allocate the work rows
+    float* srow = new float[rlen];
+    float* prow = new float[(wdth + conv->d_hlen) * cnum];
+    float* orow = new float[rlen];
+    float* ring = new float[vlen * rlen];
+    long*  rtag = new long[vlen];
+    for (long k = 0L; k < vlen; k++) rtag[k] = -1L;
+    // loop in the band rows
+    for (long y = ybeg; y < yend; y++) {
+      for (long i = 0L; i < rlen; i++) orow[i] = 0.0f;
+      for (long k = 0L; k < vlen; k++) {
+	// get the convolved source row
+	long sy = img_clamp (y + k - vtop, hght);
+	long ri = sy % vlen;
+	float* rrow = &ring[ri * rlen];
+	if (rtag[ri] != sy) {
+	  conv->p_simg->getrow (sy, srow);
+	  img_hconv (conv, srow, prow, rrow);
+	  rtag[ri] = sy;
+	}
+	// accumulate the vertical tap
+	float kval = conv->p_vker[k];
+	for (long i = 0L; i < rlen; i++) orow[i] += kval * rrow[i];
+      }
+      conv->p_dimg->setrow (y, orow);
+    }
+    delete [] rtag;
+    delete [] ring;
+    delete [] orow;
+    delete [] prow;
+    delete [] srow;
+  }
+
+  // this procedure computes a resize filter value
+  static inline t_real img_rsflt (const t_real x, const Imaging::t_rsmd rsmd) {
+    t_real ax = (x < 0.0) ? -x : x;
+    if (rsmd == Imaging::RSMD_BILN) return (ax < 1.0) ? 1.0 - ax : 0.0;
+    if (ax < 1.0e-8) return 1.0;
+    if (ax >= (t_real) IMG_LNCZ_ORDR) return 0.0;
+    t_real px = Math::CV_PI * x;
+    t_real sx = Math::sin (px) * Math::sin (px / IMG_LNCZ_ORDR);
+    return (IMG_LNCZ_ORDR * sx) / (px * px);
+  }
+
+  // the resize weight table
+  struct s_rtab {
+    // the number of taps
+    long d_tnum;
+    // the tap indexes
+    long* p_tidx;
+    // the tap weights
+    float* p_twgt;
+    // create a weight table
+    s_rtab (const long slen, const long dlen, const Imaging::t_rsmd rsmd) {
+      // compute the filter scale and support
+      t_real scal = (t_real) slen / (t_real) dlen;
+      t_real fscl = (scal > 1.0) ? scal : 1.0;
+      t_real ordr = (rsmd == Imaging::RSMD_BILN) ? 1.0 : IMG_LNCZ_ORDR;
+      t_real sprt = ordr * fscl;
+      d_tnum = (long) Math::ceiling (2.0 * sprt) + 1L;
+      p_tidx = new long[dlen * d_tnum];
+      p_twgt = new float[dlen * d_tnum];
+      // compute the taps
+      for (long o = 0L; o < dlen; o++) {
+	t_real cntr = (o + 0.5) * scal - 0.5;
+	long   left = (long) Math::ceiling (cntr - sprt);
+	t_real wsum = 0.0;
+	for (long t = 0L; t < d_tnum; t++) {
+	  long   j = left + t;
+	  t_real w = img_rsflt ((j - cntr) / fscl, rsmd);
+	  p_tidx[o * d_tnum + t] = img_clamp (j, slen);
+	  p_twgt[o * d_tnum + t] = (float) w;
+	  wsum += w;
+	}
+	// normalize the weights
+	if (wsum != 0.0) {
+	  for (long t = 0L; t < d_tnum; t++) p_twgt[o * d_tnum + t] /= wsum;
+	}
+      }
+    }
+    // destroy this table
+    ~s_rtab (void) {
+      delete [] p_tidx;
+      delete [] p_twgt;
+    }
+  };
+
+  // the resize arguments
+  struct s_rsiz {
+    // the source and target image
+    s_imgd* p_simg;
+    s_imgd* p_dimg;
+    // the horizontal and vertical weight tables
+    s_rtab* p_htab;
+    s_rtab* p_vtab;
+  };
+
+  // this procedure resizes a work row horizontally
+  static void img_hrsiz (const s_rsiz* rsiz, const float* srow, float* drow) {
+    long cnum = rsiz->p_simg->d_cnum;
+    long dwth = rsiz->p_dimg->d_wdth;
+    long tnum = rsiz->p_htab->d_tnum;
+    for (long x = 0L; x < dwth; x++) {
+      const long*  tidx = &rsiz->p_htab->p_tidx[x * tnum];
+      const float* twgt = &rsiz->p_htab->p_twgt[x * tnum];
+      for (long c = 0L; c < cnum; c++) {
+	float sval = 0.0f;
+	for (long t = 0L; t < tnum; t++) {
+	  sval += twgt[t] * srow[tidx[t] * cnum + c];
+	}
+	drow[x * cnum + c] = sval;
+      }
+    }
+  }
+
+  // this procedure resizes a row band - the horizontally resized rows
+  // are kept in a ring of rows for the vertical resize
+  static void img_rsiz (void* args, const long, const long ybeg,
+			const long yend) {
+    auto rsiz = reinterpret_cast <s_rsiz*> (args);
+    long cnum = rsiz->p_simg->d_cnum;
+    long rlen = rsiz->p_dimg->d_wdth * cnum;
+    long tnum = rsiz->p_vtab->d_tnum;
+    // allocate the work rows
+    float* srow = new float[rsiz->p_simg->d_wdth * cnum];
+    float* orow = new float[rlen];
+    float* ring = new float[tnum * rlen];
+    long*  rtag = new long[tnum];
+    for (long t = 0L; t < tnum; t++) rtag[t] = -1L;
+    // loop in the band rows
+    for (long y = ybeg; y < yend; y++) {
+      const long*  tidx = &rsiz->p_vtab->p_tidx[y * tnum];
+      const float* twgt = &rsiz->p_vtab->p_twgt[y * tnum];
+      for (long i = 0L; i < rlen; i++) orow[i] = 0.0f;
+      for (long t = 0L; t < tnum; t++) {
+	// get the resized source row
+	long sy = tidx[t];
+	long ri = sy % tnum;
+	float* rrow = &ring[ri * rlen];
+	if (rtag[ri] != sy) {
+	  rsiz->p_simg->getrow (sy, srow);
+	  img_hrsiz (rsiz, srow, rrow);
+	  rtag[ri] = sy;
+	}
+	// accumulate the vertical tap
+	float tval = twgt[t];
+	for (long i = 0L; i < rlen; i++) orow[i] += tval * rrow[i];
+      }
+      rsiz->p_dimg->setrow (y, orow);
+    }
+    delete [] rtag;
+    delete [] ring;
+    delete [] orow;
+    delete [] srow;
+  }
+
+  // the histogram arguments
+  struct s_hist {
+    // the source image
+    s_imgd* p_simg;
+    // the component index
+    long d_cidx;
+    // the number of bins
+    long d_hnum;
+    // the band histograms
+    t_long* p_hist;
+  };
+
+  // this procedure computes a row band histogram
+  static void img_hist (void* args, const long tidx, const long ybeg,
+			const long yend) {
+    auto hist = reinterpret_cast <s_hist*> (args);
+    long wdth = hist->p_simg->d_wdth;
+    long cnum = hist->p_simg->d_cnum;
+    long hnum = hist->d_hnum;
+    t_long* hbuf = &hist->p_hist[tidx * hnum];
+    float*  srow = new float[wdth * cnum];
+    for (long y = ybeg; y < yend; y++) {
+      hist->p_simg->getrow (y, srow);
+      for (long x = 0L; x < wdth; x++) {
+	float sval = srow[x * cnum + hist->d_cidx];
+	long  hidx = (sval <= 0.0f) ? 0L : (long) (sval * hnum);
+	if (hidx >= hnum) hidx = hnum - 1L;
+	hbuf[hidx]++;
+      }
+    }
+    delete [] srow;
+  }
+
+  // the statistics arguments
+  struct s_stat {
+    // the source image
+    s_imgd* p_simg;
+    // the band minimum, maximum, sum and square sum by component
+    t_real* p_vmin;
+    t_real* p_vmax;
+    t_real* p_vsum;
+    t_real* p_vsqr;
+  };
+
+  // this procedure computes a row band statistics
+  static void img_stat (void* args, const long tidx, const long ybeg,
+			const long yend) {
+    auto stat = reinterpret_cast <s_stat*> (args);
+    long wdth = stat->p_simg->d_wdth;
+    long cnum = stat->p_simg->d_cnum;
+    // preset the band statistics
+    t_real* vmin = &stat->p_vmin[tidx * cnum];
+    t_real* vmax = &stat->p_vmax[tidx * cnum];
+    t_real* vsum = &stat->p_vsum[tidx * cnum];
+    t_real* vsqr = &stat->p_vsqr[tidx * cnum];
+    float*  srow = new float[wdth * cnum];
+    stat->p_simg->getrow (ybeg, srow);
+    for (long c = 0L; c < cnum; c++) {
+      vmin[c] = srow[c];
+      vmax[c] = srow[c];
+      vsum[c] = 0.0;
+      vsqr[c] = 0.0;
+    }
+    // accumulate the rows
+    for (long y = ybeg; y < yend; y++) {
+      stat->p_simg->getrow (y, srow);
+      for (long x = 0L; x < wdth; x++) {
+	for (long c = 0L; c < cnum; c++) {
+	  t_real sval = srow[x * cnum + c];
+	  if (sval < vmin[c]) vmin[c] = sval;
+	  if (sval > vmax[c]) vmax[c] = sval;
+	  vsum[c] += sval;
+	  vsqr[c] += sval * sval;
+	}
+      }
+    }
+    delete [] srow;
+  }
+
+  // -------------------------------------------------------------------------
+  // - class section                                                         -
+  // -------------------------------------------------------------------------
+
+  // convolve a slice with a separable kernel
+
+  Slice* Imaging::convolve (const Slice& slc,
+			    const long hlen, const t_real* hker,
+			    const long vlen, const t_real* vker) {
+    // check the kernels
+    if ((hlen <= 0L) || (hker == nullptr) || (vlen <= 0L) ||
+	(vker == nullptr)) {
+      throw Exception ("imaging-error", "invalid convolution kernel");
+    }
+    // lock and convolve
+    slc.rdlock ();
+    Pixmap* result = nullptr;
+    s_conv  conv;
+    conv.p_hker = nullptr;
+    conv.p_vker = nullptr;
+    try {
+      // prepare the images
+      const Pixmap& pixm = img_to_pixm (slc);
+      s_imgd simg (pixm);
+      result = new Pixmap (simg.d_pfmt, simg.d_wdth, simg.d_hght);
+      s_imgd dimg (result, simg);
+      // prepare the kernels
+      conv.p_simg = &simg;
+      conv.p_dimg = &dimg;
+      conv.d_hlen = hlen;
+      conv.p_hker = new float[hlen];
+      for (long k = 0L; k < hlen; k++) conv.p_hker[k] = (float) hker[k];
+      conv.d_vlen = vlen;
+      conv.p_vker = new float[vlen];
+      for (long k = 0L; k < vlen; k++) conv.p_vker[k] = (float) vker[k];
+      // convolve by row bands
+      long rsiz = simg.d_wdth * simg.d_cnum * (hlen + vlen);
+      img_prun (img_conv, &conv, simg.d_hght, rsiz);
+      delete [] conv.p_hker;
+      delete [] conv.p_vker;
+      slc.unlock ();
+      return result;
+    } catch (...) {
+      delete [] conv.p_hker;
+      delete [] conv.p_vker;
+      delete result;
+      slc.unlock ();
+      throw;
+    }
+  }
+
+  // blur a slice with a box filter
+
+  Slice* Imaging::boxblur (const Slice& slc, const long rads) {
+    // check the radius
+    if (rads < 0L) {
+      throw Exception ("imaging-error", "invalid negative box radius");
+    }
+    // create the box kernel
+    long    klen = 2L * rads + 1L;
+    t_real* kern = new t_real[klen];
+    for (long k = 0L; k < klen; k++) kern[k] = 1.0 / klen;
+    try {
+      Slice* result = convolve (slc, klen, kern, klen, kern);
+      delete [] kern;
+      return result;
+    } catch (...) {
+      delete [] kern;
+      throw;
+    }
+  }
+
+  // blur a slice with a gaussian filter
+
+  Slice* Imaging::gaussblur (const Slice& slc, const t_real sigm) {
+    // check the deviation
+    if (sigm <= 0.0) {
+      throw Exception ("imaging-error", "invalid gaussian deviation");
+    }
+    // create the gaussian kernel
+    long    rads = (long) Math::ceiling (3.0 * sigm);
+    long    klen = 2L * rads + 1L;
+    t_real* kern = new t_real[klen];
+    t_real  ksum = 0.0;
+    for (long k = 0L; k < klen; k++) {
+      t_real x = (t_real) (k - rads);
+      kern[k] = Math::exp (-(x * x) / (2.0 * sigm * sigm));
+      ksum += kern[k];
+    }
+    for (long k = 0L; k < klen; k++) kern[k] /= ksum;
+    try {
+      Slice* result = convolve (slc, klen, kern, klen, kern);
+      delete [] kern;
+      return result;
+    } catch (...) {
+      delete [] kern;
+      throw;
+    }
+  }
+
+  // resize a slice
+
+  Slice* Imaging::resize (const Slice& slc, const long wdth, const long hght,
+			  const t_rsmd rsmd) {
+    // check the geometry
+    if ((wdth <= 0L) || (hght <= 0L)) {
+      throw Exception ("imaging-error", "invalid resize geometry");
+    }
+    // lock and resize
+    slc.rdlock ();
+    Pixmap* result = nullptr;
+    s_rsiz  rsiz;
+    rsiz.p_htab = nullptr;
+    rsiz.p_vtab = nullptr;
+    try {
+      // prepare the images
+      const Pixmap& pixm = img_to_pixm (slc);
+      s_imgd simg (pixm);
+      result = new Pixmap (simg.d_pfmt, wdth, hght);
+      s_imgd dimg (result, simg);
+      // prepare the weight tables
+      rsiz.p_simg = &simg;
+      rsiz.p_dimg = &dimg;
+      rsiz.p_htab = new s_rtab (simg.d_wdth, wdth, rsmd);
+      rsiz.p_vtab = new s_rtab (simg.d_hght, hght, rsmd);
+      // resize by row bands
+      long bsiz = wdth * simg.d_cnum * rsiz.p_vtab->d_tnum;
+      img_prun (img_rsiz, &rsiz, hght, bsiz);
+      delete rsiz.p_htab;
+      delete rsiz.p_vtab;
+      slc.unlock ();
+      return result;
+    } catch (...) {
+      delete rsiz.p_htab;
+      delete rsiz.p_vtab;
+      delete result;
+      slc.unlock ();
+      throw;
+    }
+  }
+
+  // compute a slice component histogram
+
+  Vector* Imaging::histogram (const Slice& slc, const long cidx,
+			      const long hnum) {
+    // check the number of bins
+    if (hnum <= 0L) {
+      throw Exception ("imaging-error", "invalid histogram size");
+    }
+    // lock and compute
+    slc.rdlock ();
+    s_hist hist;
+    hist.p_hist = nullptr;
+    try {
+      // prepare the image
+      const Pixmap& pixm = img_to_pixm (slc);
+      s_imgd simg (pixm);
+      if ((cidx < 0L) || (cidx >= simg.d_cnum)) {
+	throw Exception ("imaging-error", "invalid histogram component");
+      }
+      // compute the band histograms
+      hist.p_simg = &simg;
+      hist.d_cidx = cidx;
+      hist.d_hnum = hnum;
+      hist.p_hist = new t_long[IMG_TASK_TMAX * hnum];
+      Utility::tonull (hist.p_hist, IMG_TASK_TMAX * hnum * sizeof (t_long));
+      long rsiz = simg.d_wdth * simg.d_cnum;
+      long tnum = img_prun (img_hist, &hist, simg.d_hght, rsiz);
+      // merge the histograms
+      Vector* result = new Vector;
+      for (long h = 0L; h < hnum; h++) {
+	t_long hval = 0LL;
+	for (long t = 0L; t < tnum; t++) hval += hist.p_hist[t * hnum + h];
+	result->add (new Integer (hval));
+      }
+      delete [] hist.p_hist;
+      slc.unlock ();
+      return result;
+    } catch (...) {
+      delete [] hist.p_hist;
+      slc.unlock ();
+      throw;
+    }
+  }
+
+  // compute the slice component statistics
+
+  Vector* Imaging::statistics (const Slice& slc) {
+    // lock and compute
+    slc.rdlock ();
+    s_stat stat;
+    stat.p_vmin = nullptr;
+    try {
+      // prepare the image
+      const Pixmap& pixm = img_to_pixm (slc);
+      s_imgd simg (pixm);
+      long   cnum = simg.d_cnum;
+      // compute the band statistics
+      stat.p_simg = &simg;
+      stat.p_vmin = new t_real[4L * IMG_TASK_TMAX * cnum];
+      stat.p_vmax = &stat.p_vmin[IMG_TASK_TMAX * cnum];
+      stat.p_vsum = &stat.p_vmax[IMG_TASK_TMAX * cnum];
+      stat.p_vsqr = &stat.p_vsum[IMG_TASK_TMAX * cnum];
+      long rsiz = simg.d_wdth * cnum;
+      long tnum = img_prun (img_stat, &stat, simg.d_hght, rsiz);
+      // merge the statistics by component
+      t_real vnum = (t_real) simg.d_wdth * (t_real) simg.d_hght;
+      Vector* result = new Vector;
+      for (long c = 0L; c < cnum; c++) {
+	t_real vmin = stat.p_vmin[c];
+	t_real vmax = stat.p_vmax[c];
+	t_real vsum = 0.0;
+	t_real vsqr = 0.0;
+	for (long t = 0L; t < tnum; t++) {
+	  long k = t * cnum + c;
+	  if (stat.p_vmin[k] < vmin) vmin = stat.p_vmin[k];
+	  if (stat.p_vmax[k] > vmax) vmax = stat.p_vmax[k];
+	  vsum += stat.p_vsum[k];
+	  vsqr += stat.p_vsqr[k];
+	}
+	t_real mean = vsum / vnum;
+	t_real vvar = (vsqr / vnum) - (mean * mean);
+	Vector* cvec = new Vector;
+	cvec->add (new Real (vmin));
+	cvec->add (new Real (vmax));
+	cvec->add (new Real (mean));
+	cvec->add (new Real ((vvar > 0.0) ? Math::sqrt (vvar) : 0.0));
+	result->add (cvec);
+      }
+      delete [] stat.p_vmin;
+      slc.unlock ();
+      return result;
+    } catch (...) {
+      delete [] stat.p_vmin;
+      slc.unlock ();
+      throw;
+    }
+  }
+
+  // compute the tranche band statistics
+
+  Vector* Imaging::statistics (const Tranche& trch) {
+    Vector* result = new Vector;
+    Slice*  slc = nullptr;
+    try {
+      long dpth = trch.getdpth ();
+      for (long d = 0L; d < dpth; d++) {
+	slc = img_to_band (trch, d);
+	result->add (statistics (*slc));
+	delete slc; slc = nullptr;
+      }
+      return result;
+    } catch (...) {
+      delete slc;
+      delete result;
+      throw;
+    }
+  }
+}
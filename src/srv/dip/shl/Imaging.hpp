@@ -0,0 +1,94 @@
+// ---------------------------------------------------------------------------
+// - Imaging.hpp                                                             -
+// - afnix:dip service - image processing class definition                   -
+// ---------------------------------------------------------------------------
+// - This program is free software;  you can redistribute it  and/or  modify -
+// - it provided that this copyright notice is kept intact.                  -
+// -                                                                         -
+// - This program  is  distributed in  the hope  that it will be useful, but -
+// - without  any  warranty;  without  even   the   implied    warranty   of -
+// - merchantability or fitness for a particular purpose.  In no event shall -
+// - the copyright holder be liable for any  direct, indirect, incidental or -
+// - special damages arising in any way out of the use of this software.     -
+// ---------------------------------------------------------------------------
+// - copyright (c) 1999-2021 amaury darsch                                   -
+// ---------------------------------------------------------------------------
+
+#ifndef  AFNIX_IMAGING_HPP
+#define  AFNIX_IMAGING_HPP
+
+#ifndef  AFNIX_SLICE_HPP
+#include "Slice.hpp"
+#endif
+
+#ifndef  AFNIX_TRANCHE_HPP
+#include "Tranche.hpp"
+#endif
+
+namespace afnix {
+  
+  /// The Imaging class is a collection of image processing operators. The
+  /// operators work on a normalized floating point copy of the slice and
+  /// the result slice is converted back to the original slice format. The
+  /// image rows are processed by tiles and the large images are split in
+  /// row bands which are processed by parallel tasks. The statistics are
+  /// computed with the normalized component values, which are the raw
+  /// values for the real formats. A tranche is processed band by band
+  /// for the statistics only.
+  /// @author amaury darsch
+
+  class Imaging {
+  public:
+    /// the resize mode
+    enum t_rsmd {
+      RSMD_BILN, // bilinear resize
+      RSMD_LNCZ  // lanczos resize
+    };
+
+    /// convolve a slice with a separable kernel - the kernels are
+    /// centered at the half kernel length
+    /// @param slc  the slice to convolve
+    /// @param hlen the horizontal kernel length
+    /// @param hker the horizontal kernel
+    /// @param vlen the vertical kernel length
+    /// @param vker the vertical kernel
+    static Slice* convolve (const Slice& slc,
+			    const long hlen, const t_real* hker,
+			    const long vlen, const t_real* vker);
+
+    /// blur a slice with a box filter
+    /// @param slc  the slice to blur
+    /// @param rads the box radius
+    static Slice* boxblur (const Slice& slc, const long rads);
+
+    /// blur a slice with a gaussian filter
+    /// @param slc  the slice to blur
+    /// @param sigm the gaussian standard deviation
+    static Slice* gaussblur (const Slice& slc, const t_real sigm);
+
+    /// resize a slice
+    /// @param slc  the slice to resize
+    /// @param wdth the new slice width
+    /// @param hght the new slice height
+    /// @param rsmd the resize mode
+    static Slice* resize (const Slice& slc, const long wdth, const long hght,
+			  const t_rsmd rsmd);
+
+    /// @return a slice component histogram
+    /// @param slc  the slice to process
+    /// @param cidx the component index
+    /// @param hnum the number of bins
+    static Vector* histogram (const Slice& slc, const long cidx,
+			      const long hnum);
+
+    /// @return the slice component statistics
+    /// @param slc the slice to process
+    static Vector* statistics (const Slice& slc);
+
+    /// @return the tranche band statistics
+    /// @param trch the tranche to process
+    static Vector* statistics (const Tranche& trch);
+  };
+}
+
+#endif
@@ -55,6 +55,13 @@ namespace afnix {
     // bind other functions
     gset->symcst ("netpbm-read",     new Function (dip_rdpbm));
     gset->symcst ("netpbm-write",    new Function (dip_wrpbm));
+    gset->symcst ("convolve",        new Function (dip_convolve));
+    gset->symcst ("box-blur",        new Function (dip_boxblur));
+    gset->symcst ("gaussian-blur",   new Function (dip_gaussblur));
+    gset->symcst ("resize-bilinear", new Function (dip_rsbiln));
+    gset->symcst ("resize-lanczos",  new Function (dip_rslncz));
+    gset->symcst ("histogram",       new Function (dip_histogram));
+    gset->symcst ("statistics",      new Function (dip_statistics));
     
     // not used but needed
     return nullptr;
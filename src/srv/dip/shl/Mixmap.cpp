@@ -18,6 +18,7 @@
 #include "Dipsid.hxx"
 #include "Vector.hpp"
 #include "Mixmap.hpp"
+#include "Pixmap.hpp"
 #include "Utility.hpp"
 #include "Integer.hpp"
 #include "QuarkZone.hpp"
@@ -386,9 +387,6 @@ namespace afnix {
 	  // get pixel equivalent position
 	  auto pp = reinterpret_cast<Pixel::t_pixl*>(&p_data[bpos]);
 	  pp->d_b[0] = pc.d_b[0];
-	  pp->d_b[1] = pc.d_b[1];
-	  pp->d_b[2] = pc.d_b[2];
-	  pp->d_b[3] = pc.d_b[3];
 	}
 	break;
       case Pixel::PFMT_WORD:
@@ -398,9 +396,6 @@ namespace afnix {
 	  // get pixel equivalent position
 	  auto pp = reinterpret_cast<Pixel::t_pixl*>(&p_data[bpos]);
 	  pp->d_w[0] = pc.d_w[0];
-	  pp->d_w[1] = pc.d_w[1];
-	  pp->d_w[2] = pc.d_w[2];
-	  pp->d_w[3] = pc.d_w[3];
 	}
 	break;
       case Pixel::PFMT_REAL:
@@ -410,9 +405,6 @@ namespace afnix {
 	  // get pixel equivalent position
 	  auto pp = reinterpret_cast<Pixel::t_pixl*>(&p_data[bpos]);
 	  pp->d_r[0] = pc.d_r[0];
-	  pp->d_r[1] = pc.d_r[1];
-	  pp->d_r[2] = pc.d_r[2];
-	  pp->d_r[3] = pc.d_r[3];
 	}
 	break;
       case Pixel::PFMT_FLOT:
@@ -422,9 +414,6 @@ namespace afnix {
 	  // get pixel equivalent position
 	  auto pp = reinterpret_cast<Pixel::t_pixl*>(&p_data[bpos]);
 	  pp->d_f[0] = pc.d_f[0];
-	  pp->d_f[1] = pc.d_f[1];
-	  pp->d_f[2] = pc.d_f[2];
-	  pp->d_f[3] = pc.d_f[3];
 	}
 	break;
       case Pixel::PFMT_RGBA:
@@ -532,9 +521,6 @@ namespace afnix {
 	  // get pixel equivalent position
 	  auto pp = reinterpret_cast<Pixel::t_pixl*>(&p_data[bpos]);
 	  pixl.d_b[0] = pp->d_b[0];
-	  pixl.d_b[1] = pp->d_b[1];
-	  pixl.d_b[2] = pp->d_b[2];
-	  pixl.d_b[3] = pp->d_b[3];
 	}
 	break;
       case Pixel::PFMT_WORD:
@@ -544,9 +530,6 @@ namespace afnix {
 	  // get pixel equivalent position
 	  auto pp = reinterpret_cast<Pixel::t_pixl*>(&p_data[bpos]);
 	  pixl.d_w[0] = pp->d_w[0];
-	  pixl.d_w[1] = pp->d_w[1];
-	  pixl.d_w[2] = pp->d_w[2];
-	  pixl.d_w[3] = pp->d_w[3];
 	}
 	break;
       case Pixel::PFMT_REAL:
@@ -556,9 +539,6 @@ namespace afnix {
 	  // get pixel equivalent position
 	  auto pp = reinterpret_cast<Pixel::t_pixl*>(&p_data[bpos]);
 	  pixl.d_r[0] = pp->d_r[0];
-	  pixl.d_r[1] = pp->d_r[1];
-	  pixl.d_r[2] = pp->d_r[2];
-	  pixl.d_r[3] = pp->d_r[3];
 	}
 	break;
       case Pixel::PFMT_FLOT:
@@ -568,9 +548,6 @@ namespace afnix {
 	  // get pixel equivalent position
 	  auto pp = reinterpret_cast<Pixel::t_pixl*>(&p_data[bpos]);
 	  pixl.d_f[0] = pp->d_f[0];
-	  pixl.d_f[1] = pp->d_f[1];
-	  pixl.d_f[2] = pp->d_f[2];
-	  pixl.d_f[3] = pp->d_f[3];
 	}
 	break;
       case Pixel::PFMT_RGBA:
@@ -694,6 +671,41 @@ namespace afnix {
     }
   }
 
+  // get a mixmap slice by depth
+
+  Slice* Mixmap::getslice (const long d) const {
+    rdlock ();
+    Pixmap* result = nullptr;
+    try {
+      // check valid depth
+      if ((d < 0L) || (d >= d_dpth)) {
+	throw Exception ("mixmap-error", "invalid slice depth");
+      }
+      // get the depth offset, stride and format
+      long doff = 0L;
+      long strd = d_rtrd;
+      Pixel::t_pfmt pfmt = d_pfmt;
+      if (d > 0L) {
+	doff = d_rtrd * d_hght + d_btrd * d_hght * (d - 1L);
+	strd = d_btrd;
+	pfmt = mixm_to_bfmt (pfmt);
+      }
+      // create the slice and copy the rows
+      result = new Pixmap (pfmt, d_wdth, d_hght);
+      t_byte* data = result->tobyte ();
+      long    rsiz = (d_hght == 0L) ? 0L : result->tosize () / d_hght;
+      for (long y = 0L; y < d_hght; y++) {
+	Utility::tobcpy (&data[y * rsiz], rsiz, &p_data[doff + y * strd]);
+      }
+      unlock ();
+      return result;
+    } catch (...) {
+      delete result;
+      unlock ();
+      throw;
+    }
+  }
+
   // -------------------------------------------------------------------------
   // - object section                                                        -
   // -------------------------------------------------------------------------
@@ -722,4 +734,47 @@ namespace afnix {
     throw Exception ("argument-error", 
                      "invalid arguments with with mixmap constructor"); 
   }
+
+  // the quark zone
+  static const long QUARK_ZONE_LENGTH = 1;
+  static QuarkZone  zone (QUARK_ZONE_LENGTH);
+
+  // the object supported quarks
+  static const long QUARK_GETSLICE = zone.intern ("get-slice");
+
+  // return true if the given quark is defined
+  
+  bool Mixmap::isquark (const long quark, const bool hflg) const {
+    rdlock ();
+    try {
+      if (zone.exists (quark) == true) {
+	unlock ();
+	return true;
+      }
+      bool result = hflg ? Tranche::isquark (quark, hflg) : false;
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+  
+  // apply this object with a set of arguments and a quark
+
+  Object* Mixmap::apply (Evaluable* zobj, Nameset* nset, const long quark,
+			 Vector* argv) {
+    // get the number of arguments
+    long argc = (argv == nullptr) ? 0 : argv->length ();
+    
+    // dispatch 1 argument
+    if (argc == 1) {
+      if (quark == QUARK_GETSLICE) {
+	long d = argv->getlong (0);
+	return getslice (d);
+      }
+    }
+    // call the tranche method
+    return Tranche::apply (zobj, nset, quark, argv);
+  }
 }
@@ -17,6 +17,10 @@
 #ifndef  AFNIX_MIXMAP_HPP
 #define  AFNIX_MIXMAP_HPP
 
+#ifndef  AFNIX_SLICE_HPP
+#include "Slice.hpp"
+#endif
+
 #ifndef  AFNIX_TRANCHE_HPP
 #include "Tranche.hpp"
 #endif
@@ -110,6 +114,10 @@ namespace afnix {
     /// @return a pixel by position
     Pixel getpixl (const long x, const long y, const long d) const;
     
+    /// @return a slice copy by depth
+    /// @param d the slice depth
+    virtual Slice* getslice (const long d) const;
+
     /// @return the mixmap byte size
     long tosize (void) const;
 
@@ -123,6 +131,17 @@ namespace afnix {
     /// create a new object in a generic way
     /// @param argv the argument vector
     static Object* mknew (Vector* argv);
+
+    /// @return true if the given quark is defined
+    bool isquark (const long quark, const bool hflg) const;
+
+    /// apply this object with a set of arguments and a quark
+    /// @param zobj  the current evaluable
+    /// @param nset  the current nameset    
+    /// @param quark the quark to apply these arguments
+    /// @param argv  the arguments to apply
+    Object* apply (Evaluable* zobj, Nameset* nset, const long quark,
+                   Vector* argv);
   };
 }
 
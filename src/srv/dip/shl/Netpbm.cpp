@@ -20,8 +20,11 @@
 #include "System.hpp"
 #include "Utility.hpp"
 #include "TcpClient.hpp"
+#include "InputFile.hpp"
 #include "UriStream.hpp"
 #include "Exception.hpp"
+#include "cmem.hpp"
+#include "csio.hpp"
 
 namespace afnix {
 
@@ -105,9 +108,8 @@ namespace afnix {
       return Pixel(Pixel::PFMT_BYTE, pixl);
     }
     if (cbsz == 2L) {
-      pixl.d_w[0]  = Utility::tolong (pnm_token (is)); pixl.d_w[0] <<= 8;
-      pixl.d_w[0] |= Utility::tolong (pnm_token (is));
-      pixl.d_w[1]  = pixl.d_w[0];
+      pixl.d_w[0] = Utility::tolong (pnm_token (is));
+      pixl.d_w[1] = pixl.d_w[0];
       pixl.d_w[2]  = pixl.d_w[0];
       pixl.d_w[3]  = 0xFFFFU;
       return Pixel(Pixel::PFMT_WORD, pixl);
@@ -126,18 +128,140 @@ namespace afnix {
       return Pixel(Pixel::PFMT_RGBA, pixl);
     }
     if (cbsz == 2L) {
-      pixl.d_w[0]  = Utility::tolong (pnm_token (is)); pixl.d_w[0] <<= 8;
-      pixl.d_w[0] |= Utility::tolong (pnm_token (is));
-      pixl.d_w[1]  = Utility::tolong (pnm_token (is)); pixl.d_w[1] <<= 8;
-      pixl.d_w[1] |= Utility::tolong (pnm_token (is));
-      pixl.d_w[2]  = Utility::tolong (pnm_token (is)); pixl.d_w[2] <<= 8;
-      pixl.d_w[2] |= Utility::tolong (pnm_token (is));
-      pixl.d_w[3]  = 0xFFFFU;
+      pixl.d_w[0] = Utility::tolong (pnm_token (is));
+      pixl.d_w[1] = Utility::tolong (pnm_token (is));
+      pixl.d_w[2] = Utility::tolong (pnm_token (is));
+      pixl.d_w[3] = 0xFFFFU;
       return Pixel(Pixel::PFMT_RGBO, pixl);
     }
     throw Exception("netpbm-error", "invalid pixel size to read");
   }
   
+  // the minimum raw block size to map
+  static const long PNM_MMAP_SMIN = 65536L;
+
+  // the raw pixel block
+  struct s_pblk {
+    // the block data
+    const t_byte* p_data;
+    // the mapped file
+    char* p_mbuf;
+    // the mapped size
+    long  d_msiz;
+    // the copied block
+    char* p_cbuf;
+    // create a nil block
+    s_pblk (void) {
+      p_data = nullptr;
+      p_mbuf = nullptr;
+      d_msiz = 0L;
+      p_cbuf = nullptr;
+    }
+    // destroy this block
+    ~s_pblk (void) {
+      if (p_mbuf != nullptr) c_munmap (p_mbuf, d_msiz);
+      delete [] p_cbuf;
+    }
+    // map a raw block from an input file
+    bool map (InputStream* is, const long size) {
+      // check for a large block in a regular file
+      auto ifs = dynamic_cast<InputFile*>(is);
+      if ((ifs == nullptr) || (size < PNM_MMAP_SMIN)) return false;
+      int sid = ifs->getsid ();
+      if ((sid < 0) || (c_fsize (sid) < 0L)) return false;
+      // check the block position
+      t_long boff = ifs->tell ();
+      if (boff + size > ifs->length ()) return false;
+      // map the file up to the block end
+      d_msiz = boff + size;
+      p_mbuf = (char*) c_mmap (sid, d_msiz, 0L);
+      if (p_mbuf == nullptr) return false;
+      p_data = reinterpret_cast<const t_byte*>(&p_mbuf[boff]);
+      // leave the file after the block
+      ifs->lseek (boff + size);
+      return true;
+    }
+    // load a raw block from an input stream
+    bool load (InputStream* is, const long size) {
+      // check for nil
+      if ((is == nullptr) || (size <= 0L)) return false;
+      // try to map the block first
+      if (map (is, size) == true) return true;
+      // copy the block by chunk
+      p_cbuf = new char[size];
+      long blen = 0L;
+      while (blen < size) {
+	long clen = is->copy (&p_cbuf[blen], size - blen);
+	if (clen <= 0L) break;
+	blen += clen;
+      }
+      p_data = reinterpret_cast<const t_byte*>(p_cbuf);
+      return (blen == size);
+    }
+  };
+
+  // decode a raw row into a pixmap row
+  static void pnm_row_raw (const t_byte* sbuf, t_byte* dbuf,
+			   const long wdth, const long cnum,
+			   const long cbsz) {
+    // band byte row
+    if ((cnum == 1L) && (cbsz == 1L)) {
+      Utility::tobcpy (dbuf, wdth, sbuf);
+      return;
+    }
+    // band word row in big endian
+    if ((cnum == 1L) && (cbsz == 2L)) {
+      auto wbuf = reinterpret_cast<t_word*>(dbuf);
+      for (long x = 0L; x < wdth; x++) {
+	wbuf[x] = ((t_word) sbuf[2*x] << 8) | (t_word) sbuf[2*x+1];
+      }
+      return;
+    }
+    // rgb byte row
+    if ((cnum == 3L) && (cbsz == 1L)) {
+      for (long x = 0L; x < wdth; x++) {
+	dbuf[4*x]   = sbuf[3*x];
+	dbuf[4*x+1] = sbuf[3*x+1];
+	dbuf[4*x+2] = sbuf[3*x+2];
+	dbuf[4*x+3] = 0xFFU;
+      }
+      return;
+    }
+    // rgb word row in big endian
+    if ((cnum == 3L) && (cbsz == 2L)) {
+      auto wbuf = reinterpret_cast<t_word*>(dbuf);
+      for (long x = 0L; x < wdth; x++) {
+	const t_byte* sp = &sbuf[6*x];
+	wbuf[4*x]   = ((t_word) sp[0] << 8) | (t_word) sp[1];
+	wbuf[4*x+1] = ((t_word) sp[2] << 8) | (t_word) sp[3];
+	wbuf[4*x+2] = ((t_word) sp[4] << 8) | (t_word) sp[5];
+	wbuf[4*x+3] = 0xFFFFU;
+      }
+      return;
+    }
+    throw Exception ("netpbm-error", "invalid pixel size");
+  }
+
+  // read a raw block into a pixmap
+  static void pnm_raw_img (InputStream* is, Pixmap* pixm, const long cnum,
+			   const long cbsz) {
+    // get the pixmap geometry
+    long wdth = pixm->getwdth ();
+    long hght = pixm->gethght ();
+    long rsiz = wdth * cnum * cbsz;
+    long strd = pixm->tosize () / hght;
+    // load the raw block
+    s_pblk pblk;
+    if (pblk.load (is, rsiz * hght) == false) {
+      throw Exception ("netpbm-error", "cannot read pixmap data");
+    }
+    // decode the rows
+    t_byte* data = pixm->tobyte ();
+    for (long y = 0L; y < hght; y++) {
+      pnm_row_raw (&pblk.p_data[y*rsiz], &data[y*strd], wdth, cnum, cbsz);
+    }
+  }
+
   // read a pbm from an input stream
   static Image* pnm_pbm_img (InputStream* is, const bool bflg) {
     throw Exception ("netpbm-error", "unimplemented pbm reader");
@@ -154,7 +278,6 @@ namespace afnix {
     long maxv = Utility::tolong (pnm_token (is));
     long cbsz = pnm_max_tocbsz (maxv);
     auto pfmt = pnm_pgm_topfmt (maxv);
-    if (pfmt != Pixel::PFMT_BYTE) return nullptr;
     // check for valid image
     if ((wdth <= 0L) || (hght <= 0L)) return nullptr;
     // create a target pixmap as an image
@@ -176,37 +299,7 @@ namespace afnix {
 	  if (row >= hght) break;
 	}
       } else {
-	// compute the image planar size in byte
-	long size = wdth * hght * cbsz;
-	// allocate and read the image block
-	char* blok = new char[size];
-	if (is->copy (blok, size) != size) {
-	  delete pixm;
-	  throw Exception ("netpbm-error", "cannot read pixmap data");
-	}
-	// map the color components
-	long bidx = 0L; Pixel::t_pixl pixl;
-	for (long row = 0L; row < hght; row++) {
-	  for (long col = 0L; col < wdth; col++) {
-	    if (cbsz == 1L) {
-	      pixl.d_b[0] = blok[bidx++];
-	      pixl.d_b[1] = pixl.d_b[0];
-	      pixl.d_b[2] = pixl.d_b[0];
-	      pixl.d_b[3] = 0xFFU;
-	      pixm->setpixl (col, row, Pixel (Pixel::PFMT_BYTE, pixl));
-	    } else if (cbsz == 2L) {
-	      t_word w = blok[bidx++]; w <<= 8; w |= blok[bidx++];
-	      pixl.d_w[0] = System::wswap(w);
-	      pixl.d_w[1] = pixl.d_w[0];
-	      pixl.d_w[2] = pixl.d_w[0];
-	      pixl.d_w[3] = 0xFFFFU;
-	      pixm->setpixl (col, row, Pixel (Pixel::PFMT_WORD, pixl));
-	    } else {
-	      throw Exception ("netpbm-error", "invalid pixel size");
-	    }
-	  }
-	}
-	delete [] blok;
+	pnm_raw_img (is, pixm, 1L, cbsz);
       }
       return pixm;
     } catch (...) {
@@ -247,36 +340,7 @@ namespace afnix {
 	  if (row >= hght) break;
 	}
       } else {
-	// compute the image planar size in byte
-	long size = wdth * hght * 3 * cbsz;
-	// allocate and read the image block
-	char* blok = new char[size];
-	if (is->copy (blok, size) != size) {
-	  delete pixm;
-	  throw Exception ("netpbm-error", "cannot read pixmap data");
-	}
-	// map the color components
-	long bidx = 0L; 
-	for (long row = 0L; row < hght; row++) {
-	  for (long col = 0L; col < wdth; col++) {
-	    Pixel::t_pixl pixl;
-	    if (cbsz == 1L) {
-	      for (long k = 0L; k < 3L; k++) pixl.d_b[k] = blok[bidx++];
-	      pixl.d_b[3] = 0xFFU;
-	    } else if (cbsz == 2L) {
-	      for (long k = 0L; k < 3L; k++) {
-		t_word w = blok[bidx++]; w <<= 8; w |= blok[bidx++];
-		pixl.d_w[k] = System::wswap(w);
-	      }
-	      pixl.d_w[3] = 0xFFFFU;
-	    } else {
-	      throw Exception ("netpbm-error", "invalid pixel size");
-	    }
-	    // set the pixmap component value
-	    pixm->setpixl (col, row, Pixel(pfmt, pixl));
-	  }
-	}
-	delete [] blok;
+	pnm_raw_img (is, pixm, 3L, cbsz);
       }
       return pixm;
     } catch (...) {
@@ -362,37 +426,51 @@ namespace afnix {
     return true;
   }
 
+  // get a slice row in a byte or rgba format
+  static void slc_row_get (const Slice& slc, const long y,
+			   const Pixel::t_pfmt tfmt, t_byte* tbuf) {
+    long wdth = slc.getwdth ();
+    // convert directly the pixmap row
+    auto pixm = dynamic_cast<const Pixmap*>(&slc);
+    if (pixm != nullptr) {
+      long strd = pixm->tosize () / pixm->gethght ();
+      const t_byte* data = pixm->tobyte ();
+      Pixmap::cnvrow (pixm->getpfmt (), &data[y*strd], tfmt, tbuf, wdth);
+      return;
+    }
+    // convert the row pixel by pixel
+    long bnum = (tfmt == Pixel::PFMT_BYTE) ? 1L : 4L;
+    for (long x = 0L; x < wdth; x++) {
+      Pixel::t_pixl pixl = slc.getpixl(x, y).convert(tfmt).getpixl ();
+      for (long k = 0L; k < bnum; k++) tbuf[x*bnum+k] = pixl.d_b[k];
+    }
+  }
+
   // write a raw pgm slice to an output stream
   static bool slc_pgm_raw (OutputStream& os, const Slice& slc) {
     // collect width and height
     long wdth = slc.getwdth ();
     long hght = slc.gethght ();
-    long size = wdth * hght;
     if ((wdth <= 0L) || (hght <= 0L)) return false;
     // write the header
     os << "P5" << eolc;
     os << wdth << ' ' << hght << eolc;
     os << "255" << eolc;
-    // allocate a temporay conversion buffer
-    char* data = new char[size];
-    long  bidx = 0L;
-    // loop inside the slice for pixel conversion
-    for (long y = 0L; y < hght; y++) {
-      for (long x = 0L; x < wdth; x++) {
-	// get the source pixel
-	Pixel spix = slc.getpixl (x, y);
-	// convert to a byte pixel
-	Pixel tpix = spix.convert (Pixel::PFMT_BYTE);
-	// get the pixel value
-	Pixel::t_pixl pixl = tpix.getpixl ();
-	// set the block value
-	data[bidx++] = pixl.d_b[0];
+    // allocate a row conversion buffer
+    t_byte* rbuf = new t_byte[wdth];
+    try {
+      // convert and write the rows
+      bool result = true;
+      for (long y = 0L; (y < hght) && (result == true); y++) {
+	slc_row_get (slc, y, Pixel::PFMT_BYTE, rbuf);
+	result = (os.write ((char*) rbuf, wdth) == wdth);
       }
+      delete [] rbuf;
+      return result;
+    } catch (...) {
+      delete [] rbuf;
+      throw;
     }
-    // write the data buffer
-    bool result = (os.write(data, size) == size) ? true : false;
-    delete [] data;
-    return result;
   }
   
   // write a raw ppm slice to an output stream
@@ -400,34 +478,35 @@ namespace afnix {
     // collect width and height
     long wdth = slc.getwdth ();
     long hght = slc.gethght ();
-    long size = wdth * hght * 3;
+    long rsiz = wdth * 3;
     if ((wdth <= 0L) || (hght <= 0L)) return false;
     // write the header
     os << "P6" << eolc;
     os << wdth << ' ' << hght << eolc;
     os << "255" << eolc;
-    // allocate a temporay conversion buffer
-    char* data = new char[size];
-    long  bidx = 0L;
-    // loop inside the slice
-    for (long y = 0L; y < hght; y++) {
-      for (long x = 0L; x < wdth; x++) {
-	// get the source pixel
-	Pixel spix = slc.getpixl (x, y);
-	// convert to a rgba pixel
-	Pixel tpix = spix.convert (Pixel::PFMT_RGBA);
-	// get the pixel value
-	Pixel::t_pixl pixl = tpix.getpixl ();
-	// set the blobk value
-	data[bidx++] = pixl.d_b[0];
-	data[bidx++] = pixl.d_b[1];
-	data[bidx++] = pixl.d_b[2];
+    // allocate the row conversion buffers
+    t_byte* cbuf = new t_byte[wdth * 4];
+    t_byte* rbuf = new t_byte[rsiz];
+    try {
+      // convert, pack and write the rows
+      bool result = true;
+      for (long y = 0L; (y < hght) && (result == true); y++) {
+	slc_row_get (slc, y, Pixel::PFMT_RGBA, cbuf);
+	for (long x = 0L; x < wdth; x++) {
+	  rbuf[3*x]   = cbuf[4*x];
+	  rbuf[3*x+1] = cbuf[4*x+1];
+	  rbuf[3*x+2] = cbuf[4*x+2];
+	}
+	result = (os.write ((char*) rbuf, rsiz) == rsiz);
       }
+      delete [] cbuf;
+      delete [] rbuf;
+      return result;
+    } catch (...) {
+      delete [] cbuf;
+      delete [] rbuf;
+      throw;
     }
-    // write the data buffer
-    bool result = (os.write(data, size) == size) ? true : false;
-    delete [] data;
-    return result;
   }
   
   // write a raw slice to an output stream
@@ -455,7 +534,15 @@ namespace afnix {
       break;
     }
     // write pgm/ppm slice
-    return ppm ? slc_ppm_raw (os, slc) : slc_pgm_raw (os, slc);
+    slc.rdlock ();
+    try {
+      bool result = ppm ? slc_ppm_raw (os, slc) : slc_pgm_raw (os, slc);
+      slc.unlock ();
+      return result;
+    } catch (...) {
+      slc.unlock ();
+      throw;
+    }
   }
 
   // write a text slice to an output stream
@@ -506,8 +593,16 @@ namespace afnix {
     UriStream uris (iosm);
     // get the input stream
     InputStream* is = uris.istream (uri);
+    Object::iref (is);
     // get the image
-    return pnm_xxx_img (is);
+    try {
+      Image* result = pnm_xxx_img (is);
+      Object::dref (is);
+      return result;
+    } catch (...) {
+      Object::dref (is);
+      throw;
+    }
   }
 
   // read an image by string uri
@@ -520,8 +615,16 @@ namespace afnix {
     UriStream uris (iosm);
     // get the input stream
     InputStream* is = uris.istream (suri);
+    Object::iref (is);
     // get the image
-    return pnm_xxx_img (is);
+    try {
+      Image* result = pnm_xxx_img (is);
+      Object::dref (is);
+      return result;
+    } catch (...) {
+      Object::dref (is);
+      throw;
+    }
   }
 
   // write an image to an output stream
@@ -549,8 +652,16 @@ namespace afnix {
     UriStream uris (iosm);
     // get the output stream
     OutputStream* os = uris.ostream (uri);
+    Object::iref (os);
     // write in raw or text mode
-    return raw ? slc_xxx_raw (*os, *slc) : slc_xxx_txt (*os, *slc);
+    try {
+      bool result = raw ? slc_xxx_raw (*os, *slc) : slc_xxx_txt (*os, *slc);
+      Object::dref (os);
+      return result;
+    } catch (...) {
+      Object::dref (os);
+      throw;
+    }
   }
 
   // write an image by string uri
@@ -564,9 +675,17 @@ namespace afnix {
       return new TcpClient (host, port);
     };
     UriStream uris (iosm);
-     // get the output stream
+    // get the output stream
     OutputStream* os = uris.ostream (suri);
+    Object::iref (os);
     // write in raw or text mode
-    return raw ? slc_xxx_raw (*os, *slc) : slc_xxx_txt (*os, *slc);
+    try {
+      bool result = raw ? slc_xxx_raw (*os, *slc) : slc_xxx_txt (*os, *slc);
+      Object::dref (os);
+      return result;
+    } catch (...) {
+      Object::dref (os);
+      throw;
+    }
   }
 }
@@ -24,6 +24,7 @@
 #include "Exception.hpp"
 #include "InputStream.hpp"
 #include "OutputStream.hpp"
+#include "cthr.hpp"
 
 namespace afnix {
 
@@ -79,6 +80,402 @@ namespace afnix {
     long result = strd * hght;
     return result;
   }
+
+  // the maximum number of conversion tasks
+  static const long PIXM_TASK_TMAX = 8L;
+  // the minimum number of bytes per conversion task
+  static const long PIXM_TASK_SMIN = 1048576L;
+
+  // this procedure returns true if a format is a 4x8 bits format
+  static inline bool pixm_is_b4 (const Pixel::t_pfmt pfmt) {
+    return (pfmt == Pixel::PFMT_RGBA) || (pfmt == Pixel::PFMT_BGRA);
+  }
+
+  // this procedure returns true if a format is a 4x16 bits format
+  static inline bool pixm_is_w4 (const Pixel::t_pfmt pfmt) {
+    return (pfmt == Pixel::PFMT_RGBO) || (pfmt == Pixel::PFMT_BGRO);
+  }
+
+  // this procedure returns true if a format is a bgra format
+  static inline bool pixm_is_bgr (const Pixel::t_pfmt pfmt) {
+    return (pfmt == Pixel::PFMT_BGRA) || (pfmt == Pixel::PFMT_BGRO);
+  }
+
+  // this procedure maps a normalized value to a byte
+  static inline t_byte pixm_to_byte (const t_real v) {
+    if (v <= 0.0) return 0x00U;
+    if (v >= 1.0) return 0xFFU;
+    return (t_byte) (v * 255.0 + 0.5);
+  }
+
+  // this procedure maps a normalized value to a word
+  static inline t_word pixm_to_word (const t_real v) {
+    if (v <= 0.0) return 0x0000U;
+    if (v >= 1.0) return 0xFFFFU;
+    return (t_word) (v * 65535.0 + 0.5);
+  }
+
+  // this procedure converts a row with a direct kernel and returns
+  // false if no kernel is defined for the formats
+  static bool pixm_row_dir (const Pixel::t_pfmt sfmt, const t_byte* sbuf,
+			    const Pixel::t_pfmt dfmt, t_byte* dbuf,
+			    const long wdth) {
+    // check for a red/blue swap
+    long ri = (pixm_is_bgr (sfmt) == pixm_is_bgr (dfmt)) ? 0L : 2L;
+    long bi = 2L - ri;
+    // 4x8 bits to 4x8 bits
+    if ((pixm_is_b4 (sfmt) == true) && (pixm_is_b4 (dfmt) == true)) {
+      for (long x = 0L; x < wdth; x++) {
+	const t_byte* sp = &sbuf[4*x];
+	t_byte*       dp = &dbuf[4*x];
+	dp[0] = sp[ri]; dp[1] = sp[1]; dp[2] = sp[bi]; dp[3] = sp[3];
+      }
+      return true;
+    }
+    // 4x16 bits to 4x16 bits
+    if ((pixm_is_w4 (sfmt) == true) && (pixm_is_w4 (dfmt) == true)) {
+      auto sw = reinterpret_cast<const t_word*>(sbuf);
+      auto dw = reinterpret_cast<t_word*>(dbuf);
+      for (long x = 0L; x < wdth; x++) {
+	const t_word* sp = &sw[4*x];
+	t_word*       dp = &dw[4*x];
+	dp[0] = sp[ri]; dp[1] = sp[1]; dp[2] = sp[bi]; dp[3] = sp[3];
+      }
+      return true;
+    }
+    // 4x8 bits to 4x16 bits
+    if ((pixm_is_b4 (sfmt) == true) && (pixm_is_w4 (dfmt) == true)) {
+      auto dw = reinterpret_cast<t_word*>(dbuf);
+      for (long x = 0L; x < wdth; x++) {
+	const t_byte* sp = &sbuf[4*x];
+	t_word*       dp = &dw[4*x];
+	dp[0] = sp[ri] * 257U; dp[1] = sp[1] * 257U;
+	dp[2] = sp[bi] * 257U; dp[3] = sp[3] * 257U;
+      }
+      return true;
+    }
+    // 4x16 bits to 4x8 bits
+    if ((pixm_is_w4 (sfmt) == true) && (pixm_is_b4 (dfmt) == true)) {
+      auto sw = reinterpret_cast<const t_word*>(sbuf);
+      for (long x = 0L; x < wdth; x++) {
+	const t_word* sp = &sw[4*x];
+	t_byte*       dp = &dbuf[4*x];
+	dp[0] = (sp[ri] + 128U) / 257U; dp[1] = (sp[1] + 128U) / 257U;
+	dp[2] = (sp[bi] + 128U) / 257U; dp[3] = (sp[3] + 128U) / 257U;
+      }
+      return true;
+    }
+    // 8 bits band to 4x8 bits
+    if ((sfmt == Pixel::PFMT_BYTE) && (pixm_is_b4 (dfmt) == true)) {
+      for (long x = 0L; x < wdth; x++) {
+	t_byte* dp = &dbuf[4*x];
+	dp[0] = sbuf[x]; dp[1] = sbuf[x]; dp[2] = sbuf[x]; dp[3] = 0xFFU;
+      }
+      return true;
+    }
+    // 4x8 bits to 8 bits band
+    if ((pixm_is_b4 (sfmt) == true) && (dfmt == Pixel::PFMT_BYTE)) {
+      for (long x = 0L; x < wdth; x++) {
+	const t_byte* sp = &sbuf[4*x];
+	dbuf[x] = (t_byte) ((sp[0] + sp[1] + sp[2] + 1U) / 3U);
+      }
+      return true;
+    }
+    // 8 bits band to 16 bits band
+    if ((sfmt == Pixel::PFMT_BYTE) && (dfmt == Pixel::PFMT_WORD)) {
+      auto dw = reinterpret_cast<t_word*>(dbuf);
+      for (long x = 0L; x < wdth; x++) dw[x] = sbuf[x] * 257U;
+      return true;
+    }
+    // 16 bits band to 8 bits band
+    if ((sfmt == Pixel::PFMT_WORD) && (dfmt == Pixel::PFMT_BYTE)) {
+      auto sw = reinterpret_cast<const t_word*>(sbuf);
+      for (long x = 0L; x < wdth; x++) dbuf[x] = (sw[x] + 128U) / 257U;
+      return true;
+    }
+    // 8 or 16 bits band to float band
+    if ((sfmt == Pixel::PFMT_BYTE) && (dfmt == Pixel::PFMT_FLOT)) {
+      auto df = reinterpret_cast<float*>(dbuf);
+      for (long x = 0L; x < wdth; x++) df[x] = (float) (sbuf[x] / 255.0);
+      return true;
+    }
+    if ((sfmt == Pixel::PFMT_WORD) && (dfmt == Pixel::PFMT_FLOT)) {
+      auto sw = reinterpret_cast<const t_word*>(sbuf);
+      auto df = reinterpret_cast<float*>(dbuf);
+      for (long x = 0L; x < wdth; x++) df[x] = (float) (sw[x] / 65535.0);
+      return true;
+    }
+    // float band to 8 or 16 bits band
+    if ((sfmt == Pixel::PFMT_FLOT) && (dfmt == Pixel::PFMT_BYTE)) {
+      auto sf = reinterpret_cast<const float*>(sbuf);
+      for (long x = 0L; x < wdth; x++) dbuf[x] = pixm_to_byte (sf[x]);
+      return true;
+    }
+    if ((sfmt == Pixel::PFMT_FLOT) && (dfmt == Pixel::PFMT_WORD)) {
+      auto sf = reinterpret_cast<const float*>(sbuf);
+      auto dw = reinterpret_cast<t_word*>(dbuf);
+      for (long x = 0L; x < wdth; x++) dw[x] = pixm_to_word (sf[x]);
+      return true;
+    }
+    // 4x8 bits to 4x float
+    if ((pixm_is_b4 (sfmt) == true) && (dfmt == Pixel::PFMT_RGBF)) {
+      auto df = reinterpret_cast<float*>(dbuf);
+      for (long x = 0L; x < wdth; x++) {
+	const t_byte* sp = &sbuf[4*x];
+	float*        dp = &df[4*x];
+	dp[0] = (float) (sp[ri] / 255.0); dp[1] = (float) (sp[1] / 255.0);
+	dp[2] = (float) (sp[bi] / 255.0); dp[3] = (float) (sp[3] / 255.0);
+      }
+      return true;
+    }
+    // 4x float to 4x8 bits
+    if ((sfmt == Pixel::PFMT_RGBF) && (pixm_is_b4 (dfmt) == true)) {
+      auto sf = reinterpret_cast<const float*>(sbuf);
+      for (long x = 0L; x < wdth; x++) {
+	const float* sp = &sf[4*x];
+	t_byte*      dp = &dbuf[4*x];
+	dp[ri] = pixm_to_byte (sp[0]); dp[1] = pixm_to_byte (sp[1]);
+	dp[bi] = pixm_to_byte (sp[2]); dp[3] = pixm_to_byte (sp[3]);
+      }
+      return true;
+    }
+    return false;
+  }
+
+  // this procedure decodes a row into a normalized rgba row
+  static void pixm_row_dec (const Pixel::t_pfmt sfmt, const t_byte* sbuf,
+			    t_real* rbuf, const long wdth) {
+    // check for a red/blue swap
+    long ri = pixm_is_bgr (sfmt) ? 2L : 0L;
+    long bi = 2L - ri;
+    // decode by format
+    switch (sfmt) {
+    case Pixel::PFMT_BYTE:
+      for (long x = 0L; x < wdth; x++) {
+	t_real  v = sbuf[x] / 255.0;
+	t_real* rp = &rbuf[4*x];
+	rp[0] = v; rp[1] = v; rp[2] = v; rp[3] = 1.0;
+      }
+      break;
+    case Pixel::PFMT_WORD:
+      {
+	auto sw = reinterpret_cast<const t_word*>(sbuf);
+	for (long x = 0L; x < wdth; x++) {
+	  t_real  v = sw[x] / 65535.0;
+	  t_real* rp = &rbuf[4*x];
+	  rp[0] = v; rp[1] = v; rp[2] = v; rp[3] = 1.0;
+	}
+      }
+      break;
+    case Pixel::PFMT_REAL:
+      {
+	auto sr = reinterpret_cast<const t_real*>(sbuf);
+	for (long x = 0L; x < wdth; x++) {
+	  t_real* rp = &rbuf[4*x];
+	  rp[0] = sr[x]; rp[1] = sr[x]; rp[2] = sr[x]; rp[3] = 1.0;
+	}
+      }
+      break;
+    case Pixel::PFMT_FLOT:
+      {
+	auto sf = reinterpret_cast<const float*>(sbuf);
+	for (long x = 0L; x < wdth; x++) {
+	  t_real* rp = &rbuf[4*x];
+	  rp[0] = sf[x]; rp[1] = sf[x]; rp[2] = sf[x]; rp[3] = 1.0;
+	}
+      }
+      break;
+    case Pixel::PFMT_RGBA:
+    case Pixel::PFMT_BGRA:
+      for (long x = 0L; x < wdth; x++) {
+	const t_byte* sp = &sbuf[4*x];
+	t_real*       rp = &rbuf[4*x];
+	rp[0] = sp[ri] / 255.0; rp[1] = sp[1] / 255.0;
+	rp[2] = sp[bi] / 255.0; rp[3] = sp[3] / 255.0;
+      }
+      break;
+    case Pixel::PFMT_RGBO:
+    case Pixel::PFMT_BGRO:
+      {
+	auto sw = reinterpret_cast<const t_word*>(sbuf);
+	for (long x = 0L; x < wdth; x++) {
+	  const t_word* sp = &sw[4*x];
+	  t_real*       rp = &rbuf[4*x];
+	  rp[0] = sp[ri] / 65535.0; rp[1] = sp[1] / 65535.0;
+	  rp[2] = sp[bi] / 65535.0; rp[3] = sp[3] / 65535.0;
+	}
+      }
+      break;
+    case Pixel::PFMT_RGBR:
+      {
+	auto sr = reinterpret_cast<const t_real*>(sbuf);
+	for (long k = 0L; k < 4L * wdth; k++) rbuf[k] = sr[k];
+      }
+      break;
+    case Pixel::PFMT_RGBF:
+      {
+	auto sf = reinterpret_cast<const float*>(sbuf);
+	for (long k = 0L; k < 4L * wdth; k++) rbuf[k] = sf[k];
+      }
+      break;
+    default:
+      break;
+    }
+  }
+
+  // this procedure encodes a normalized rgba row into a row
+  static void pixm_row_enc (const Pixel::t_pfmt dfmt, const t_real* rbuf,
+			    t_byte* dbuf, const long wdth) {
+    // check for a red/blue swap
+    long ri = pixm_is_bgr (dfmt) ? 2L : 0L;
+    long bi = 2L - ri;
+    // encode by format
+    switch (dfmt) {
+    case Pixel::PFMT_BYTE:
+      for (long x = 0L; x < wdth; x++) {
+	const t_real* rp = &rbuf[4*x];
+	dbuf[x] = pixm_to_byte ((rp[0] + rp[1] + rp[2]) / 3.0);
+      }
+      break;
+    case Pixel::PFMT_WORD:
+      {
+	auto dw = reinterpret_cast<t_word*>(dbuf);
+	for (long x = 0L; x < wdth; x++) {
+	  const t_real* rp = &rbuf[4*x];
+	  dw[x] = pixm_to_word ((rp[0] + rp[1] + rp[2]) / 3.0);
+	}
+      }
+      break;
+    case Pixel::PFMT_REAL:
+      {
+	auto dr = reinterpret_cast<t_real*>(dbuf);
+	for (long x = 0L; x < wdth; x++) {
+	  const t_real* rp = &rbuf[4*x];
+	  dr[x] = (rp[0] + rp[1] + rp[2]) / 3.0;
+	}
+      }
+      break;
+    case Pixel::PFMT_FLOT:
+      {
+	auto df = reinterpret_cast<float*>(dbuf);
+	for (long x = 0L; x < wdth; x++) {
+	  const t_real* rp = &rbuf[4*x];
+	  df[x] = (float) ((rp[0] + rp[1] + rp[2]) / 3.0);
+	}
+      }
+      break;
+    case Pixel::PFMT_RGBA:
+    case Pixel::PFMT_BGRA:
+      for (long x = 0L; x < wdth; x++) {
+	const t_real* rp = &rbuf[4*x];
+	t_byte*       dp = &dbuf[4*x];
+	dp[ri] = pixm_to_byte (rp[0]); dp[1] = pixm_to_byte (rp[1]);
+	dp[bi] = pixm_to_byte (rp[2]); dp[3] = pixm_to_byte (rp[3]);
+      }
+      break;
+    case Pixel::PFMT_RGBO:
+    case Pixel::PFMT_BGRO:
+      {
+	auto dw = reinterpret_cast<t_word*>(dbuf);
+	for (long x = 0L; x < wdth; x++) {
+	  const t_real* rp = &rbuf[4*x];
+	  t_word*       dp = &dw[4*x];
+	  dp[ri] = pixm_to_word (rp[0]); dp[1] = pixm_to_word (rp[1]);
+	  dp[bi] = pixm_to_word (rp[2]); dp[3] = pixm_to_word (rp[3]);
+	}
+      }
+      break;
+    case Pixel::PFMT_RGBR:
+      {
+	auto dr = reinterpret_cast<t_real*>(dbuf);
+	for (long k = 0L; k < 4L * wdth; k++) dr[k] = rbuf[k];
+      }
+      break;
+    case Pixel::PFMT_RGBF:
+      {
+	auto df = reinterpret_cast<float*>(dbuf);
+	for (long k = 0L; k < 4L * wdth; k++) df[k] = (float) rbuf[k];
+      }
+      break;
+    default:
+      break;
+    }
+  }
+
+  // the row band conversion task
+  struct s_pcnv {
+    // the source format and data
+    Pixel::t_pfmt d_sfmt;
+    const t_byte* p_sbuf;
+    long d_sstr;
+    // the target format and data
+    Pixel::t_pfmt d_dfmt;
+    t_byte* p_dbuf;
+    long d_dstr;
+    // the row width
+    long d_wdth;
+    // the row band
+    long d_ybeg;
+    long d_yend;
+    // convert the row band
+    void run (void) {
+      t_real* rbuf = nullptr;
+      for (long y = d_ybeg; y < d_yend; y++) {
+	const t_byte* sbuf = &p_sbuf[y * d_sstr];
+	t_byte*       dbuf = &p_dbuf[y * d_dstr];
+	if (pixm_row_dir (d_sfmt, sbuf, d_dfmt, dbuf, d_wdth) == true) continue;
+	if (rbuf == nullptr) rbuf = new t_real[4 * d_wdth];
+	pixm_row_dec (d_sfmt, sbuf, rbuf, d_wdth);
+	pixm_row_enc (d_dfmt, rbuf, dbuf, d_wdth);
+      }
+      delete [] rbuf;
+    }
+  };
+
+  // this procedure runs a row band conversion task
+  static void* pixm_cnv_task (void* args) {
+    auto pcnv = reinterpret_cast <s_pcnv*> (args);
+    pcnv->run ();
+    return nullptr;
+  }
+
+  // this procedure converts a pixmap data by row bands
+  static void pixm_cnv (const Pixel::t_pfmt sfmt, const t_byte* sbuf,
+			const long sstr, const Pixel::t_pfmt dfmt,
+			t_byte* dbuf, const long dstr, const long wdth,
+			const long hght) {
+    // check for nil data
+    if ((sbuf == nullptr) || (dbuf == nullptr)) return;
+    // check for the same format
+    if (sfmt == dfmt) {
+      Utility::tobcpy (dbuf, sstr * hght, sbuf);
+      return;
+    }
+    // compute the number of bands
+    long tnum = ((sstr + dstr) * hght) / PIXM_TASK_SMIN;
+    if (tnum > PIXM_TASK_TMAX) tnum = PIXM_TASK_TMAX;
+    if (tnum > hght) tnum = hght;
+    if (tnum < 1L) tnum = 1L;
+    // prepare the bands
+    s_pcnv* pcnv = new s_pcnv[tnum];
+    for (long t = 0L; t < tnum; t++) {
+      pcnv[t].d_sfmt = sfmt;
+      pcnv[t].p_sbuf = sbuf;
+      pcnv[t].d_sstr = sstr;
+      pcnv[t].d_dfmt = dfmt;
+      pcnv[t].p_dbuf = dbuf;
+      pcnv[t].d_dstr = dstr;
+      pcnv[t].d_wdth = wdth;
+      pcnv[t].d_ybeg = (t * hght) / tnum;
+      pcnv[t].d_yend = ((t + 1L) * hght) / tnum;
+    }
+    // run the bands
+    void** args = new void*[tnum];
+    for (long t = 0L; t < tnum; t++) args[t] = &pcnv[t];
+    c_tskrun (pixm_cnv_task, args, tnum);
+    delete [] args;
+    delete [] pcnv;
+  }
   
   // -------------------------------------------------------------------------
   // - class section                                                         -
@@ -364,9 +761,6 @@ namespace afnix {
 	  // get pixel equivalent position
 	  auto pp = reinterpret_cast<Pixel::t_pixl*>(&p_data[bpos]);
 	  pp->d_b[0] = pc.d_b[0];
-	  pp->d_b[1] = pc.d_b[1];
-	  pp->d_b[2] = pc.d_b[2];
-	  pp->d_b[3] = pc.d_b[3];
 	}
 	break;
       case Pixel::PFMT_WORD:
@@ -376,9 +770,6 @@ namespace afnix {
 	  // get pixel equivalent position
 	  auto pp = reinterpret_cast<Pixel::t_pixl*>(&p_data[bpos]);
 	  pp->d_w[0] = pc.d_w[0];
-	  pp->d_w[1] = pc.d_w[1];
-	  pp->d_w[2] = pc.d_w[2];
-	  pp->d_w[3] = pc.d_w[3];
 	}
 	break;
       case Pixel::PFMT_REAL:
@@ -388,9 +779,6 @@ namespace afnix {
 	  // get pixel equivalent position
 	  auto pp = reinterpret_cast<Pixel::t_pixl*>(&p_data[bpos]);
 	  pp->d_r[0] = pc.d_r[0];
-	  pp->d_r[1] = pc.d_r[1];
-	  pp->d_r[2] = pc.d_r[2];
-	  pp->d_r[3] = pc.d_r[3];
 	}
 	break;
       case Pixel::PFMT_FLOT:
@@ -400,9 +788,6 @@ namespace afnix {
 	  // get pixel equivalent position
 	  auto pp = reinterpret_cast<Pixel::t_pixl*>(&p_data[bpos]);
 	  pp->d_f[0] = pc.d_f[0];
-	  pp->d_f[1] = pc.d_f[1];
-	  pp->d_f[2] = pc.d_f[2];
-	  pp->d_f[3] = pc.d_f[3];
 	}
 	break;
       case Pixel::PFMT_RGBA:
@@ -486,9 +871,6 @@ namespace afnix {
 	  // get pixel equivalent position
 	  auto pp = reinterpret_cast<Pixel::t_pixl*>(&p_data[bpos]);
 	  pixl.d_b[0] = pp->d_b[0];
-	  pixl.d_b[1] = pp->d_b[1];
-	  pixl.d_b[2] = pp->d_b[2];
-	  pixl.d_b[3] = pp->d_b[3];
 	}
 	break;
       case Pixel::PFMT_WORD:
@@ -498,9 +880,6 @@ namespace afnix {
 	  // get pixel equivalent position
 	  auto pp = reinterpret_cast<Pixel::t_pixl*>(&p_data[bpos]);
 	  pixl.d_w[0] = pp->d_w[0];
-	  pixl.d_w[1] = pp->d_w[1];
-	  pixl.d_w[2] = pp->d_w[2];
-	  pixl.d_w[3] = pp->d_w[3];
 	}
 	break;
       case Pixel::PFMT_REAL:
@@ -510,9 +889,6 @@ namespace afnix {
 	  // get pixel equivalent position
 	  auto pp = reinterpret_cast<Pixel::t_pixl*>(&p_data[bpos]);
 	  pixl.d_r[0] = pp->d_r[0];
-	  pixl.d_r[1] = pp->d_r[1];
-	  pixl.d_r[2] = pp->d_r[2];
-	  pixl.d_r[3] = pp->d_r[3];
 	}
 	break;
       case Pixel::PFMT_FLOT:
@@ -522,9 +898,6 @@ namespace afnix {
 	  // get pixel equivalent position
 	  auto pp = reinterpret_cast<Pixel::t_pixl*>(&p_data[bpos]);
 	  pixl.d_f[0] = pp->d_f[0];
-	  pixl.d_f[1] = pp->d_f[1];
-	  pixl.d_f[2] = pp->d_f[2];
-	  pixl.d_f[3] = pp->d_f[3];
 	}
 	break;
       case Pixel::PFMT_RGBA:
@@ -598,16 +971,9 @@ namespace afnix {
     try {
       // create the result pixmap
       result = new Pixmap (pfmt, d_wdth, d_hght);
-      for (long y = 0L; y < d_hght; y++) {
-	for (long x = 0L; x < d_wdth; x++) {
-	  // get the initial pixel
-	  Pixel pixl = getpixl (x, y);
-	  // convert it to the new format
-	  Pixel pixt = pixl.convert (pfmt);
-	  // set the result pixel
-	  result->setpixl (x, y, pixt);
-	}
-      }
+      // convert by row bands
+      pixm_cnv (d_pfmt, p_data, d_strd,
+		result->d_pfmt, result->p_data, result->d_strd, d_wdth, d_hght);
       unlock ();
       return result;
     } catch (...) {
@@ -617,6 +983,113 @@ namespace afnix {
     }
   }
   
+  // convert a pixel row between formats
+
+  void Pixmap::cnvrow (const Pixel::t_pfmt sfmt, const t_byte* sbuf,
+		       const Pixel::t_pfmt dfmt, t_byte* dbuf,
+		       const long wdth) {
+    // check for nil data
+    if ((sbuf == nullptr) || (dbuf == nullptr) || (wdth <= 0L)) return;
+    // check for the same format
+    if (sfmt == dfmt) {
+      Utility::tobcpy (dbuf, pixm_to_strd (sfmt, wdth), sbuf);
+      return;
+    }
+    // convert with a direct kernel or by normalized row
+    if (pixm_row_dir (sfmt, sbuf, dfmt, dbuf, wdth) == true) return;
+    t_real* rbuf = new t_real[4 * wdth];
+    pixm_row_dec (sfmt, sbuf, rbuf, wdth);
+    pixm_row_enc (dfmt, rbuf, dbuf, wdth);
+    delete [] rbuf;
+  }
+
+  // get a pixmap region as a buffer
+
+  Buffer* Pixmap::getregion (const long x, const long y,
+			     const long w, const long h) const {
+    rdlock ();
+    Buffer* result = nullptr;
+    try {
+      // check for a valid region
+      if ((x < 0L) || (y < 0L) || (w <= 0L) || (h <= 0L) ||
+	  (x + w > d_wdth) || (y + h > d_hght) || (p_data == nullptr)) {
+	throw Exception ("pixmap-error", "invalid pixmap region in get");
+      }
+      // compute the region row size
+      long psiz = d_strd / d_wdth;
+      long rsiz = w * psiz;
+      // copy the region rows
+      result = new Buffer (rsiz * h);
+      for (long k = 0L; k < h; k++) {
+	const t_byte* rbuf = &p_data[(y + k) * d_strd + x * psiz];
+	result->add (reinterpret_cast<const char*>(rbuf), rsiz);
+      }
+      unlock ();
+      return result;
+    } catch (...) {
+      delete result;
+      unlock ();
+      throw;
+    }
+  }
+
+  // set a pixmap region by buffer
+
+  void Pixmap::setregion (const long x, const long y, const long w,
+			  const long h, const Buffer& rbuf) {
+    wrlock ();
+    try {
+      // check for a valid region
+      if ((x < 0L) || (y < 0L) || (w <= 0L) || (h <= 0L) ||
+	  (x + w > d_wdth) || (y + h > d_hght) || (p_data == nullptr)) {
+	throw Exception ("pixmap-error", "invalid pixmap region in set");
+      }
+      // compute the region row size
+      long psiz = d_strd / d_wdth;
+      long rsiz = w * psiz;
+      if (rbuf.tosize () != rsiz * h) {
+	throw Exception ("pixmap-error", "invalid buffer size in setregion");
+      }
+      // copy the region rows
+      const t_byte* sbuf = rbuf.tobyte ();
+      for (long k = 0L; k < h; k++) {
+	t_byte* dbuf = &p_data[(y + k) * d_strd + x * psiz];
+	Utility::tobcpy (dbuf, rsiz, &sbuf[k * rsiz]);
+      }
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // get a pixmap row as a buffer
+
+  Buffer* Pixmap::getrow (const long y) const {
+    rdlock ();
+    try {
+      Buffer* result = getregion (0L, y, d_wdth, 1L);
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
+  // set a pixmap row by buffer
+
+  void Pixmap::setrow (const long y, const Buffer& rbuf) {
+    wrlock ();
+    try {
+      setregion (0L, y, d_wdth, 1L, rbuf);
+      unlock ();
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+
   // get the pixmap byte size
 
   long Pixmap::tosize (void) const {
@@ -686,4 +1159,91 @@ namespace afnix {
     throw Exception ("argument-error", 
                      "invalid arguments with with pixmap constructor"); 
   }
+
+  // the quark zone
+  static const long QUARK_ZONE_LENGTH = 4;
+  static QuarkZone  zone (QUARK_ZONE_LENGTH);
+
+  // the object supported quarks
+  static const long QUARK_GETROW  = zone.intern ("get-row");
+  static const long QUARK_SETROW  = zone.intern ("set-row");
+  static const long QUARK_GETRGN  = zone.intern ("get-region");
+  static const long QUARK_SETRGN  = zone.intern ("set-region");
+
+  // return true if the given quark is defined
+  
+  bool Pixmap::isquark (const long quark, const bool hflg) const {
+    rdlock ();
+    try {
+      if (zone.exists (quark) == true) {
+	unlock ();
+	return true;
+      }
+      bool result = hflg ? Slice::isquark (quark, hflg) : false;
+      unlock ();
+      return result;
+    } catch (...) {
+      unlock ();
+      throw;
+    }
+  }
+  
+  // apply this object with a set of arguments and a quark
+
+  Object* Pixmap::apply (Evaluable* zobj, Nameset* nset, const long quark,
+			 Vector* argv) {
+    // get the number of arguments
+    long argc = (argv == nullptr) ? 0 : argv->length ();
+    
+    // dispatch 1 argument
+    if (argc == 1) {
+      if (quark == QUARK_GETROW) {
+	long y = argv->getlong (0);
+	return getrow (y);
+      }
+    }
+    // dispatch 2 arguments
+    if (argc == 2) {
+      if (quark == QUARK_SETROW) {
+	long y = argv->getlong (0);
+	Object* obj = argv->get (1);
+	auto rbuf = dynamic_cast<Buffer*>(obj);
+	if (rbuf == nullptr) {
+	  throw Exception ("type-error", "invalid object as row buffer",
+			   Object::repr (obj));
+	}
+	setrow (y, *rbuf);
+	return nullptr;
+      }
+    }
+    // dispatch 4 arguments
+    if (argc == 4) {
+      if (quark == QUARK_GETRGN) {
+	long x = argv->getlong (0);
+	long y = argv->getlong (1);
+	long w = argv->getlong (2);
+	long h = argv->getlong (3);
+	return getregion (x, y, w, h);
+      }
+    }
+    // dispatch 5 arguments
+    if (argc == 5) {
+      if (quark == QUARK_SETRGN) {
+	long x = argv->getlong (0);
+	long y = argv->getlong (1);
+	long w = argv->getlong (2);
+	long h = argv->getlong (3);
+	Object* obj = argv->get (4);
+	auto rbuf = dynamic_cast<Buffer*>(obj);
+	if (rbuf == nullptr) {
+	  throw Exception ("type-error", "invalid object as region buffer",
+			   Object::repr (obj));
+	}
+	setregion (x, y, w, h, *rbuf);
+	return nullptr;
+      }
+    }
+    // call the slice method
+    return Slice::apply (zobj, nset, quark, argv);
+  }
 }
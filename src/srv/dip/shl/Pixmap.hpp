@@ -25,7 +25,10 @@ namespace afnix {
   
   /// The Pixmap class is a pixel block image stored as a continuous pixel
   /// stride. The pixmap structure follows the standard implementation with
-  /// a line stride directly computed from the image width.
+  /// a line stride directly computed from the image width. A pixmap is
+  /// converted to another format row by row, with the large pixmaps
+  /// converted by row bands in parallel. The pixmap rows or regions can
+  /// be read or written as a buffer with the pixmap native layout.
   /// @author amaury darsch
 
   class Pixmap : public Slice {
@@ -110,6 +113,32 @@ namespace afnix {
     /// @param pfmt the pixel format
     Slice* convert (const Pixel::t_pfmt pfmt) const override;
     
+    /// @return a pixmap region as a buffer
+    /// @param x the region x position
+    /// @param y the region y position
+    /// @param w the region width
+    /// @param h the region height
+    virtual Buffer* getregion (const long x, const long y,
+			       const long w, const long h) const;
+
+    /// set a pixmap region by buffer
+    /// @param x the region x position
+    /// @param y the region y position
+    /// @param w the region width
+    /// @param h the region height
+    /// @param rbuf the region buffer
+    virtual void setregion (const long x, const long y, const long w,
+			    const long h, const Buffer& rbuf);
+
+    /// @return a pixmap row as a buffer
+    /// @param y the row position
+    virtual Buffer* getrow (const long y) const;
+
+    /// set a pixmap row by buffer
+    /// @param y the row position
+    /// @param rbuf the row buffer
+    virtual void setrow (const long y, const Buffer& rbuf);
+
     /// @return the pixmap byte size
     long tosize (void) const override;
 
@@ -119,10 +148,32 @@ namespace afnix {
     /// @return the pixmap byte data
     const t_byte* tobyte (void) const override;
     
+  public:
+    /// convert a pixel row between formats
+    /// @param sfmt the source format
+    /// @param sbuf the source row
+    /// @param dfmt the target format
+    /// @param dbuf the target row
+    /// @param wdth the row width
+    static void cnvrow (const Pixel::t_pfmt sfmt, const t_byte* sbuf,
+			const Pixel::t_pfmt dfmt, t_byte* dbuf,
+			const long wdth);
+
   public:
     /// create a new object in a generic way
     /// @param argv the argument vector
     static Object* mknew (Vector* argv);
+
+    /// @return true if the given quark is defined
+    bool isquark (const long quark, const bool hflg) const override;
+
+    /// apply this object with a set of arguments and a quark
+    /// @param zobj  the current evaluable
+    /// @param nset  the current nameset    
+    /// @param quark the quark to apply these arguments
+    /// @param argv  the arguments to apply
+    Object* apply (Evaluable* zobj, Nameset* nset, const long quark,
+                   Vector* argv) override;
   };
 }
 